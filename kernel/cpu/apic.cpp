@@ -0,0 +1,162 @@
+#include "apic.h"
+
+#include <assert.h>
+
+#include "paging.h"
+#include "pit.h"
+#include "vmm.h"
+#include "x86.h"
+
+// Virtual address the local APIC register page is mapped at. Mirrors the
+// usual physical address and sits above the framebuffer window.
+static constexpr vaddr_t kLapicVirtBase{0xFEE00000};
+
+static constexpr uint32_t IA32_APIC_BASE_MSR = 0x1B;
+static constexpr uint64_t APIC_BASE_ENABLE = 1U << 11;
+static constexpr uint32_t CPUID_FEAT_EDX_APIC = 1U << 9;
+
+// Register offsets (Intel SDM Vol. 3 §10.4.1, Table 10-1).
+static constexpr uint32_t LAPIC_ID = 0x020;
+static constexpr uint32_t LAPIC_TPR = 0x080;
+static constexpr uint32_t LAPIC_EOI = 0x0B0;
+static constexpr uint32_t LAPIC_SVR = 0x0F0;
+static constexpr uint32_t LAPIC_ICR_LOW = 0x300;
+static constexpr uint32_t LAPIC_ICR_HIGH = 0x310;
+static constexpr uint32_t LAPIC_LVT_TIMER = 0x320;
+static constexpr uint32_t LAPIC_LVT_LINT0 = 0x350;
+static constexpr uint32_t LAPIC_LVT_LINT1 = 0x360;
+static constexpr uint32_t LAPIC_LVT_ERROR = 0x370;
+static constexpr uint32_t LAPIC_TIMER_INIT = 0x380;
+static constexpr uint32_t LAPIC_TIMER_CURRENT = 0x390;
+static constexpr uint32_t LAPIC_TIMER_DIVIDE = 0x3E0;
+
+static constexpr uint32_t SVR_ENABLE = 1U << 8;
+static constexpr uint32_t LVT_MASKED = 1U << 16;
+static constexpr uint32_t TIMER_DIVIDE_BY_16 = 0x3;
+
+// ICR fields.
+static constexpr uint32_t ICR_DELIVERY_FIXED = 0x000;
+static constexpr uint32_t ICR_DELIVERY_INIT = 0x500;
+static constexpr uint32_t ICR_DELIVERY_STARTUP = 0x600;
+static constexpr uint32_t ICR_LEVEL_ASSERT = 1U << 14;
+static constexpr uint32_t ICR_SEND_PENDING = 1U << 12;
+
+// Calibration window for the APIC timer.
+static constexpr uint64_t kCalibrateNs = 10'000'000;
+
+// Longest one-shot interval; keeps the tick conversion within 64 bits.
+static constexpr uint64_t kMaxOneShotNs = 1'000'000'000;
+
+namespace {
+
+bool enabled = false;
+uint32_t timer_ticks_per_ms = 0;  // APIC timer counts per millisecond (divide-by-16)
+
+uint32_t reg_read(uint32_t reg) { return *kLapicVirtBase.ptr_at<volatile uint32_t>(reg); }
+
+void reg_write(uint32_t reg, uint32_t value) {
+  *kLapicVirtBase.ptr_at<volatile uint32_t>(reg) = value;
+}
+
+void wait_for_delivery() {
+  while ((reg_read(LAPIC_ICR_LOW) & ICR_SEND_PENDING) != 0U) {
+    __asm__ volatile("pause");
+  }
+}
+
+void send_icr(uint8_t apic_id, uint32_t low) {
+  reg_write(LAPIC_ICR_HIGH, static_cast<uint32_t>(apic_id) << 24);
+  reg_write(LAPIC_ICR_LOW, low);
+  wait_for_delivery();
+}
+
+// Enable the calling CPU's APIC and accept all interrupt priorities.
+void enable_local() {
+  reg_write(LAPIC_SVR, SVR_ENABLE | LAPIC::kSpuriousVector);
+  reg_write(LAPIC_TPR, 0);
+  reg_write(LAPIC_LVT_ERROR, LVT_MASKED);
+  reg_write(LAPIC_LVT_TIMER, LVT_MASKED | LAPIC::kTimerVector);
+  reg_write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
+}
+
+// Count APIC timer ticks across a PIT-timed busy wait.
+void calibrate_timer() {
+  reg_write(LAPIC_TIMER_INIT, UINT32_MAX);
+  const uint64_t start = PIT::now_ns();
+  while (PIT::now_ns() - start < kCalibrateNs) {
+    __asm__ volatile("pause");
+  }
+  const uint32_t elapsed = UINT32_MAX - reg_read(LAPIC_TIMER_CURRENT);
+  reg_write(LAPIC_TIMER_INIT, 0);
+  timer_ticks_per_ms = elapsed / static_cast<uint32_t>(kCalibrateNs / 1'000'000);
+  if (timer_ticks_per_ms == 0) {
+    timer_ticks_per_ms = 1;
+  }
+}
+
+}  // namespace
+
+namespace LAPIC {
+
+bool init() {
+  assert(!enabled && "LAPIC::init(): called more than once");
+
+  if ((cpuid(1).edx & CPUID_FEAT_EDX_APIC) == 0U) {
+    return false;
+  }
+
+  uint64_t base = rdmsr(IA32_APIC_BASE_MSR);
+  base |= APIC_BASE_ENABLE;
+  wrmsr(IA32_APIC_BASE_MSR, base);
+
+  const paddr_t phys{static_cast<uint32_t>(base) & ~(PAGE_SIZE - 1)};
+  VMM::map(kLapicVirtBase, phys, /*writeable=*/true, /*user=*/false);
+
+  // LINT0 is left as the BIOS configured it (ExtINT), so PIC interrupts
+  // keep reaching the BSP.
+  enable_local();
+  calibrate_timer();
+
+  enabled = true;
+  return true;
+}
+
+void init_ap() {
+  assert(enabled && "LAPIC::init_ap(): BSP APIC not initialised");
+  wrmsr(IA32_APIC_BASE_MSR, rdmsr(IA32_APIC_BASE_MSR) | APIC_BASE_ENABLE);
+  enable_local();
+  reg_write(LAPIC_LVT_LINT0, LVT_MASKED);
+  reg_write(LAPIC_LVT_LINT1, LVT_MASKED);
+}
+
+bool is_enabled() { return enabled; }
+
+uint8_t id() { return enabled ? static_cast<uint8_t>(reg_read(LAPIC_ID) >> 24) : 0; }
+
+void eoi() { reg_write(LAPIC_EOI, 0); }
+
+void send_ipi(uint8_t apic_id, uint8_t vector) {
+  send_icr(apic_id, ICR_DELIVERY_FIXED | ICR_LEVEL_ASSERT | vector);
+}
+
+void send_init(uint8_t apic_id) { send_icr(apic_id, ICR_DELIVERY_INIT | ICR_LEVEL_ASSERT); }
+
+void send_startup(uint8_t apic_id, uint8_t page) {
+  send_icr(apic_id, ICR_DELIVERY_STARTUP | page);
+}
+
+void set_oneshot(uint64_t delta_ns) {
+  if (delta_ns > kMaxOneShotNs) {
+    delta_ns = kMaxOneShotNs;
+  }
+  const uint64_t ticks = ((delta_ns * timer_ticks_per_ms) / 1'000'000) + 1;
+  reg_write(LAPIC_LVT_TIMER, kTimerVector);  // one-shot, unmasked
+  reg_write(LAPIC_TIMER_INIT, ticks > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(ticks));
+}
+
+void stop_timer() {
+  reg_write(LAPIC_LVT_TIMER, LVT_MASKED | kTimerVector);
+  reg_write(LAPIC_TIMER_INIT, 0);
+}
+
+}  // namespace LAPIC
@@ -0,0 +1,198 @@
+#include "fpu.h"
+
+#include <array.h>
+#include <assert.h>
+#include <stdio.h>
+#include <sys/cdefs.h>
+
+#include "idt.h"
+#include "interrupt.h"
+#include "process.h"
+#include "scheduler.h"
+#include "smp.h"
+#include "x86.h"
+
+static constexpr uint32_t CR0_MP = 1U << 1;  // WAIT/FWAIT honours TS
+static constexpr uint32_t CR0_EM = 1U << 2;  // no x87: trap every FP instruction
+static constexpr uint32_t CR0_TS = 1U << 3;  // task switched: next FP use raises #NM
+static constexpr uint32_t CR0_NE = 1U << 5;  // native x87 error reporting (#MF)
+
+static constexpr uint32_t CR4_OSFXSR = 1U << 9;       // FXSAVE/FXRSTOR and SSE enabled
+static constexpr uint32_t CR4_OSXMMEXCPT = 1U << 10;  // unmasked SSE exceptions raise #XM
+
+static constexpr uint32_t CPUID_FEAT_EDX_FXSR = 1U << 24;
+static constexpr uint32_t CPUID_FEAT_EDX_SSE = 1U << 25;
+
+// MXCSR power-on value: all SIMD exceptions masked, round to nearest.
+static constexpr uint32_t kDefaultMxcsr = 0x1F80;
+
+__BEGIN_DECLS
+
+// Assembly entry point defined in trap_entry.S.
+void fpu_trap_entry();
+
+__END_DECLS
+
+namespace {
+
+bool fxsr = false;
+bool sse = false;
+
+// Process whose FP state is live in each CPU's registers, or nullptr.
+std::array<Process*, Smp::kMaxCpus> owner;
+
+uint32_t read_cr0() {
+  uint32_t cr0;
+  __asm__ volatile("mov %%cr0, %0" : "=r"(cr0));
+  return cr0;
+}
+
+void write_cr0(uint32_t cr0) { __asm__ volatile("mov %0, %%cr0" ::"r"(cr0) : "memory"); }
+
+uint32_t read_cr4() {
+  uint32_t cr4;
+  __asm__ volatile("mov %%cr4, %0" : "=r"(cr4));
+  return cr4;
+}
+
+void write_cr4(uint32_t cr4) { __asm__ volatile("mov %0, %%cr4" ::"r"(cr4) : "memory"); }
+
+void clts() { __asm__ volatile("clts" ::: "memory"); }
+
+void set_ts() { write_cr0(read_cr0() | CR0_TS); }
+
+// Store the registers into p's image, leaving them loaded. FNSAVE resets
+// the x87 unit, so the x87-only path reloads what it just stored.
+void save(Process* p) {
+  if (fxsr) {
+    __asm__ volatile("fxsave %0" : "=m"(p->fpu_state));
+  } else {
+    __asm__ volatile("fnsave %0\n\tfrstor %0" : "+m"(p->fpu_state));
+  }
+  p->fpu_saved = true;
+}
+
+void restore(const Process* p) {
+  if (fxsr) {
+    __asm__ volatile("fxrstor %0" ::"m"(p->fpu_state));
+  } else {
+    __asm__ volatile("frstor %0" ::"m"(p->fpu_state));
+  }
+}
+
+void load_clean_state() {
+  __asm__ volatile("fninit");
+  if (sse) {
+    const uint32_t mxcsr = kDefaultMxcsr;
+    __asm__ volatile("ldmxcsr %0" ::"m"(mxcsr));
+  }
+}
+
+void init_cpu() {
+  write_cr0((read_cr0() & ~CR0_EM) | CR0_MP | CR0_NE);
+  if (fxsr) {
+    write_cr4(read_cr4() | CR4_OSFXSR | (sse ? CR4_OSXMMEXCPT : 0U));
+  }
+  __asm__ volatile("fninit");
+  // Nobody owns the registers yet: the first FP instruction traps.
+  set_ts();
+}
+
+}  // namespace
+
+__BEGIN_DECLS
+
+// Device-not-available (#NM) dispatch. Called from fpu_trap_entry in
+// trap_entry.S when a process executes an FP/SSE instruction with CR0.TS
+// set. Hands this CPU's FP registers to the current process.
+uint32_t fpu_trap_dispatch(uint32_t esp) {
+  const auto* regs = reinterpret_cast<TrapFrame*>(esp);
+  if ((regs->cs & 3) != 3) {
+    printf("Kernel used the FPU (eip=0x%08x)\n", static_cast<unsigned>(regs->eip));
+    halt_and_catch_fire();
+  }
+
+  clts();
+  Process* self = Scheduler::current();
+  Process*& mine = owner[Smp::current_cpu()];
+  if (mine == self) {
+    return esp;
+  }
+  if (mine != nullptr) {
+    save(mine);
+  }
+  // Any other CPU still holding our registers now has a stale copy.
+  for (Process*& other : owner) {
+    if (other == self) {
+      other = nullptr;
+    }
+  }
+  if (self->fpu_saved) {
+    restore(self);
+  } else {
+    load_clean_state();
+  }
+  mine = self;
+  return esp;
+}
+
+__END_DECLS
+
+namespace Fpu {
+
+void init() {
+  assert(Interrupt::is_initialized() && "Fpu::init(): Interrupt must be initialized first");
+  const uint32_t edx = cpuid(1).edx;
+  fxsr = (edx & CPUID_FEAT_EDX_FXSR) != 0U;
+  sse = fxsr && (edx & CPUID_FEAT_EDX_SSE) != 0U;
+  init_cpu();
+
+  // Override the ISRWrapper<7> installed by Interrupt::init() with a full
+  // TRAP_ENTRY stub so the handler runs under the kernel lock.
+  IDT::set_entry(static_cast<uint8_t>(ISR::DeviceNotAvailable),
+                 reinterpret_cast<uintptr_t>(fpu_trap_entry), IDT::Gate::Interrupt,
+                 IDT::Ring::Kernel);
+}
+
+void init_ap() { init_cpu(); }
+
+bool has_fxsr() { return fxsr; }
+
+void switch_to(Process* prev, Process* next) {
+  Process* const mine = owner[Smp::current_cpu()];
+  // TS clear means prev may have changed its registers during this slice.
+  // Save them now if it could be resumed on another CPU.
+  if (mine == prev && Smp::cpu_count() > 1 && (read_cr0() & CR0_TS) == 0U) {
+    save(prev);
+  }
+  if (mine == next) {
+    clts();
+  } else {
+    set_ts();
+  }
+}
+
+void copy_state(Process* parent, Process* child) {
+  if (owner[Smp::current_cpu()] == parent) {
+    clts();
+    save(parent);
+  }
+  child->fpu_state = parent->fpu_state;
+  child->fpu_saved = parent->fpu_saved;
+}
+
+void release(Process* p) {
+  // Make the next FP instruction on this CPU trap instead of reusing the
+  // registers (e.g. after exec, for the new program).
+  if (owner[Smp::current_cpu()] == p) {
+    set_ts();
+  }
+  for (Process*& o : owner) {
+    if (o == p) {
+      o = nullptr;
+    }
+  }
+  p->fpu_saved = false;
+}
+
+}  // namespace Fpu
@@ -4,13 +4,15 @@
 #include <assert.h>
 #include <stddef.h>
 
+#include "smp.h"
 #include "tss.h"
 
 namespace GDT {
 
-static constexpr size_t kEntryCount = 6;
+static constexpr size_t kEntryCount = kTlsIndexBase + Smp::kMaxCpus;
 
-// 6 entries: null, kernel code, kernel data, TSS, user code, user data
+// null, kernel code, kernel data, user code, user data, TSS (CPU 0), one
+// TSS per additional CPU, then one TLS segment per CPU.
 static std::array<Entry, kEntryCount> gdt;
 static Descriptor gdtp;
 static bool initialized = false;
@@ -38,21 +40,40 @@ void init() {
   // Kernel data segment (ring 0)
   gdt[2] = create_gdt_entry(/*base=*/0, /*limit=*/SEGMENT_LIMIT, /*access=*/DATA_ACCESS,
                             /*flags=*/FLAGS_4K_32BIT);
-  // TSS descriptor - base = address of TSS struct, limit = size-1 bytes,
-  // flags = 0 (byte granularity, no size/granularity bits for system seg)
-  gdt[3] = create_gdt_entry(/*base=*/reinterpret_cast<size_t>(&TSS::tss),
-                            /*limit=*/sizeof(TSS::Entry) - 1, /*access=*/TSS_ACCESS,
-                            /*flags=*/0x0);
   // User code segment (ring 3)
-  gdt[4] = create_gdt_entry(/*base=*/0, /*limit=*/SEGMENT_LIMIT, /*access=*/USER_CODE_ACCESS,
+  gdt[3] = create_gdt_entry(/*base=*/0, /*limit=*/SEGMENT_LIMIT, /*access=*/USER_CODE_ACCESS,
                             /*flags=*/FLAGS_4K_32BIT);
   // User data segment (ring 3)
-  gdt[5] = create_gdt_entry(/*base=*/0, /*limit=*/SEGMENT_LIMIT, /*access=*/USER_DATA_ACCESS,
+  gdt[4] = create_gdt_entry(/*base=*/0, /*limit=*/SEGMENT_LIMIT, /*access=*/USER_DATA_ACCESS,
                             /*flags=*/FLAGS_4K_32BIT);
+  // TSS descriptor - base = address of TSS struct, limit = size-1 bytes,
+  // flags = 0 (byte granularity, no size/granularity bits for system seg)
+  gdt[5] = create_gdt_entry(/*base=*/reinterpret_cast<size_t>(&TSS::tss[0]),
+                            /*limit=*/sizeof(TSS::Entry) - 1, /*access=*/TSS_ACCESS,
+                            /*flags=*/0x0);
+  // TSS descriptors for the application processors
+  for (uint32_t cpu = 1; cpu < Smp::kMaxCpus; ++cpu) {
+    gdt[kApTssIndexBase + cpu - 1] =
+        create_gdt_entry(/*base=*/reinterpret_cast<size_t>(&TSS::tss[cpu]),
+                         /*limit=*/sizeof(TSS::Entry) - 1, /*access=*/TSS_ACCESS,
+                         /*flags=*/0x0);
+  }
+
+  // TLS segments (ring 3, base 0 until a thread with TLS runs there)
+  for (uint32_t cpu = 0; cpu < Smp::kMaxCpus; ++cpu) {
+    set_tls(cpu, 0);
+  }
 
   gdtp.size = sizeof(gdt) - 1;
   gdtp.offset = reinterpret_cast<uintptr_t>(gdt.data());
 
+  load();
+  initialized = true;
+}
+
+bool is_initialized() { return initialized; }
+
+void load() {
   // Load the GDTR
   __asm__ volatile(
       "lgdt %0\n"
@@ -69,9 +90,30 @@ void init() {
       :
       : "m"(gdtp), "i"(KERNEL_DATA_SELECTOR), "i"(KERNEL_CODE_SELECTOR)
       : "ax", "memory");
+}
 
-  initialized = true;
+uint16_t tss_selector(uint32_t cpu) {
+  assert(cpu < Smp::kMaxCpus && "GDT::tss_selector(): cpu out of range");
+  if (cpu == 0) {
+    return TSS_SELECTOR;
+  }
+  return static_cast<uint16_t>((kApTssIndexBase + cpu - 1) * sizeof(Entry));
 }
 
-bool is_initialized() { return initialized; }
+uint16_t tls_selector(uint32_t cpu) {
+  assert(cpu < Smp::kMaxCpus && "GDT::tls_selector(): cpu out of range");
+  return static_cast<uint16_t>(((kTlsIndexBase + cpu) * sizeof(Entry)) | 3);
+}
+
+bool is_tls_selector(uint32_t selector) {
+  const uint32_t index = selector / sizeof(Entry);
+  return (selector & 7) == 3 && index >= kTlsIndexBase && index < kTlsIndexBase + Smp::kMaxCpus;
+}
+
+void set_tls(uint32_t cpu, uint32_t base) {
+  assert(cpu < Smp::kMaxCpus && "GDT::set_tls(): cpu out of range");
+  gdt[kTlsIndexBase + cpu] = create_gdt_entry(/*base=*/base, /*limit=*/SEGMENT_LIMIT,
+                                              /*access=*/USER_DATA_ACCESS,
+                                              /*flags=*/FLAGS_4K_32BIT);
+}
 }  // namespace GDT
@@ -15,9 +15,11 @@ void init() {
   idtp.size = sizeof(idt) - 1;
   idtp.offset = reinterpret_cast<uintptr_t>(idt.data());
   memset(idt.data(), 0, sizeof(idt));
-  __asm__ volatile("lidt %0" : : "m"(idtp));
+  load();
 }
 
+void load() { __asm__ volatile("lidt %0" : : "m"(idtp)); }
+
 void set_entry(size_t index, uintptr_t handler, Gate gate, Ring ring) {
   assert(index < kEntryCount && "IDT::set_entry(): index out of range (0-255)");
   idt[index] = Entry(handler, gate, ring);
@@ -6,6 +6,7 @@
 #include "gdt.h"
 #include "idt.h"
 #include "pic.h"
+#include "smp.h"
 
 static handler_t isr_handlers[32] = {nullptr};
 static handler_t irq_handlers[16] = {nullptr};
@@ -44,10 +45,12 @@ struct ISRWrapper {
 template <uint8_t N>
 struct IRQWrapper {
   static __attribute__((interrupt)) void handle(interrupt_frame* frame) {
+    kernel_lock();
     if (irq_handlers[N] != nullptr) {
       irq_handlers[N](frame);
     }
     PIC::send_eoi(N);
+    kernel_unlock();
   }
 };
 
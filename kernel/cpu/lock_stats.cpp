@@ -0,0 +1,136 @@
+#include "lock_stats.h"
+
+#include <stdio.h>
+#include <sys/io.h>
+
+static constexpr uint16_t kDebugconPort = 0xE9;
+static constexpr uint32_t EFLAGS_IF = 1U << 9;
+
+namespace {
+
+// Registered locks, most recently registered first, guarded by
+// registry_busy. The registry cannot use a SpinLock (those record into
+// it), so it takes a bare flag with interrupts off: a lock may first be
+// acquired from an IRQ handler.
+LockStats* registry_head = nullptr;
+bool registry_busy = false;
+
+class RegistryGuard {
+ public:
+  RegistryGuard() {
+    __asm__ volatile(
+        "pushfl\n"
+        "popl %0\n"
+        "cli\n"
+        : "=r"(eflags_)
+        :
+        : "memory");
+    while (__atomic_exchange_n(&registry_busy, true, __ATOMIC_ACQUIRE)) {
+      __asm__ volatile("pause");
+    }
+  }
+  ~RegistryGuard() {
+    __atomic_store_n(&registry_busy, false, __ATOMIC_RELEASE);
+    if ((eflags_ & EFLAGS_IF) != 0U) {
+      __asm__ volatile("sti" ::: "memory");
+    }
+  }
+
+  RegistryGuard(const RegistryGuard&) = delete;
+  RegistryGuard& operator=(const RegistryGuard&) = delete;
+
+ private:
+  uint32_t eflags_;
+};
+
+void debugcon_write(const char* s) {
+  while (*s != '\0') {
+    outb(kDebugconPort, static_cast<uint8_t>(*s++));
+  }
+}
+
+// printf has no 64-bit conversions, so format cycle counts by hand.
+void debugcon_write_u64(uint64_t value) {
+  char buf[21];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  do {
+    *--p = static_cast<char>('0' + (value % 10));
+    value /= 10;
+  } while (value != 0);
+  debugcon_write(p);
+}
+
+}  // namespace
+
+LockStats::~LockStats() {
+  if (!__atomic_load_n(&registered, __ATOMIC_ACQUIRE)) {
+    return;
+  }
+  const RegistryGuard guard;
+  if (prev != nullptr) {
+    prev->next = next;
+  } else {
+    registry_head = next;
+  }
+  if (next != nullptr) {
+    next->prev = prev;
+  }
+  registered = false;
+}
+
+void LockStats::record_acquire() {
+  if (!__atomic_load_n(&registered, __ATOMIC_ACQUIRE)) {
+    const RegistryGuard guard;
+    if (!registered) {
+      prev = nullptr;
+      next = registry_head;
+      if (next != nullptr) {
+        next->prev = this;
+      }
+      registry_head = this;
+      __atomic_store_n(&registered, true, __ATOMIC_RELEASE);
+    }
+  }
+  __atomic_fetch_add(&acquisitions, 1, __ATOMIC_RELAXED);
+}
+
+void LockStats::record_contention(uint64_t waited) {
+  __atomic_fetch_add(&contentions, 1, __ATOMIC_RELAXED);
+  // Concurrent readers of an RwLock may race here; the total is advisory.
+  wait_cycles += waited;
+}
+
+void LockStats::record_release(uint64_t held) {
+  hold_cycles += held;
+  if (held > max_hold_cycles) {
+    max_hold_cycles = held;
+  }
+}
+
+void lock_stats_dump() {
+  debugcon_write("lockstat: name acquisitions contentions wait_cycles hold_cycles max_hold\n");
+  const RegistryGuard guard;
+  for (const LockStats* s = registry_head; s != nullptr; s = s->next) {
+    char line[96];
+    snprintf(line, sizeof(line), "lockstat: %s %u %u ", s->name, s->acquisitions, s->contentions);
+    debugcon_write(line);
+    debugcon_write_u64(s->wait_cycles);
+    debugcon_write(" ");
+    debugcon_write_u64(s->hold_cycles);
+    debugcon_write(" ");
+    debugcon_write_u64(s->max_hold_cycles);
+    debugcon_write("\n");
+  }
+}
+
+void lock_stats_reset() {
+  const RegistryGuard guard;
+  for (LockStats* s = registry_head; s != nullptr; s = s->next) {
+    s->acquisitions = 0;
+    s->contentions = 0;
+    s->wait_cycles = 0;
+    s->hold_cycles = 0;
+    s->max_hold_cycles = 0;
+  }
+}
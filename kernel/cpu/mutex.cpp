@@ -0,0 +1,39 @@
+#include "mutex.h"
+
+#include <assert.h>
+
+#include "scheduler.h"
+#include "x86.h"
+
+// Wait queue and owner updates rely on the same serialisation as the rest
+// of the scheduler's wait queues (the kernel lock taken on trap entry);
+// the owner itself is claimed with a compare-and-swap.
+
+bool Mutex::try_lock() {
+  Process* self = Scheduler::current();
+  Process* expected = nullptr;
+  if (!__atomic_compare_exchange_n(&owner_, &expected, self, /*weak=*/false, __ATOMIC_ACQUIRE,
+                                   __ATOMIC_RELAXED)) {
+    return false;
+  }
+  acquired_at_ = rdtsc();
+  stats_.record_acquire();
+  return true;
+}
+
+bool Mutex::lock_or_wait() {
+  if (try_lock()) {
+    return true;
+  }
+  assert(owner_ != Scheduler::current() && "Mutex::lock_or_wait(): already held by caller");
+  stats_.record_contention(0);
+  Scheduler::wait_on(waiters_);
+  return false;
+}
+
+void Mutex::unlock() {
+  assert(owner_ != nullptr && "Mutex::unlock(): mutex not held");
+  stats_.record_release(rdtsc() - acquired_at_);
+  __atomic_store_n(&owner_, nullptr, __ATOMIC_RELEASE);
+  Scheduler::wake_all(waiters_);
+}
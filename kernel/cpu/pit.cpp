@@ -3,26 +3,87 @@
 #include <assert.h>
 #include <sys/io.h>
 
+#include "vdso.h"
+
 static constexpr uint16_t PIT_CHANNEL0_DATA = 0x40;
 static constexpr uint16_t PIT_COMMAND = 0x43;
 
-// Command byte = 0x34 = 0b00_11_010_0
+// Command byte = 0x30 = 0b00_11_000_0
 //   bits 7-6: 00      = channel 0
 //   bits 5-4: 11      = access lobyte then hibyte
-//   bits 3-1: 010     = mode 2 (rate generator - reloads divisor automatically)
+//   bits 3-1: 000     = mode 0 (interrupt on terminal count, one-shot)
 //   bit  0:   0       = 16-bit binary (not BCD)
-static constexpr uint8_t PIT_CMD_CHANNEL0_RATE = 0x34;
+static constexpr uint8_t PIT_CMD_CHANNEL0_ONESHOT = 0x30;
+
+// Command byte = 0x00: latch channel 0's current count for reading.
+static constexpr uint8_t PIT_CMD_CHANNEL0_LATCH = 0x00;
 
 static constexpr uint32_t PIT_BASE_FREQ = 1193182;
-static constexpr uint32_t PIT_TARGET_HZ = 100;
-static constexpr uint16_t PIT_DIVISOR =
-    static_cast<uint16_t>(PIT_BASE_FREQ / PIT_TARGET_HZ);  // 11932
+static constexpr uint64_t NS_PER_SEC = 1'000'000'000;
+
+// Countdown bounds in PIT cycles. The maximum stays below 0xFFFF so a
+// counter that has wrapped past zero (reads back > armed count) is
+// distinguishable from one still counting. The minimum (~10 us) keeps a
+// stale deadline from turning into an interrupt storm.
+static constexpr uint16_t PIT_MAX_COUNT = 0xFFFE;
+static constexpr uint16_t PIT_MIN_COUNT = 12;
 
 namespace {
 
-volatile uint64_t ticks = 0;
+uint64_t base_cycles = 0;     // cycles elapsed before the current countdown
+uint16_t armed_count = 0;     // length of the current countdown
+uint64_t armed_deadline = 0;  // deadline the current countdown was armed for
+uint64_t last_cycles = 0;     // last value returned by now_cycles() (monotonic clamp)
 bool initialized = false;
 
+uint16_t read_counter() {
+  outb(PIT_COMMAND, PIT_CMD_CHANNEL0_LATCH);
+  const uint8_t lo = inb(PIT_CHANNEL0_DATA);
+  const uint8_t hi = inb(PIT_CHANNEL0_DATA);
+  return static_cast<uint16_t>((hi << 8) | lo);
+}
+
+// Cycles since init(). After terminal count a mode-0 counter keeps
+// decrementing from 0xFFFF, so a reading above the armed count means the
+// countdown has expired and tick() has not run yet.
+uint64_t now_cycles() {
+  const uint16_t counter = read_counter();
+  const uint16_t progress =
+      counter > armed_count ? armed_count : static_cast<uint16_t>(armed_count - counter);
+  uint64_t now = base_cycles + progress;
+  if (now < last_cycles) {
+    now = last_cycles;
+  }
+  last_cycles = now;
+  return now;
+}
+
+uint64_t cycles_to_ns(uint64_t cycles) {
+  const uint64_t secs = cycles / PIT_BASE_FREQ;
+  const uint64_t rem = cycles % PIT_BASE_FREQ;
+  return (secs * NS_PER_SEC) + ((rem * NS_PER_SEC) / PIT_BASE_FREQ);
+}
+
+// Start a new countdown of `count` cycles from the current position.
+void arm(uint16_t count, uint64_t deadline_ns) {
+  base_cycles = now_cycles();
+  armed_count = count;
+  armed_deadline = deadline_ns;
+  outb(PIT_COMMAND, PIT_CMD_CHANNEL0_ONESHOT);
+  outb(PIT_CHANNEL0_DATA, static_cast<uint8_t>(count & 0xFF));
+  outb(PIT_CHANNEL0_DATA, static_cast<uint8_t>(count >> 8));
+}
+
+uint16_t ns_to_count(uint64_t delta_ns) {
+  static constexpr uint64_t kMaxDeltaNs = (PIT_MAX_COUNT * NS_PER_SEC) / PIT_BASE_FREQ;
+  if (delta_ns >= kMaxDeltaNs) {
+    return PIT_MAX_COUNT;
+  }
+  // Round up so the interrupt never lands just short of the deadline.
+  const uint64_t cycles = ((delta_ns * PIT_BASE_FREQ) + NS_PER_SEC - 1) / NS_PER_SEC;
+  return cycles < PIT_MIN_COUNT ? PIT_MIN_COUNT : static_cast<uint16_t>(cycles);
+}
+
 }  // namespace
 
 namespace PIT {
@@ -30,31 +91,66 @@ namespace PIT {
 void init() {
   assert(!initialized && "PIT::init(): called more than once");
 
-  outb(PIT_COMMAND, PIT_CMD_CHANNEL0_RATE);
-  outb(PIT_CHANNEL0_DATA, static_cast<uint8_t>(PIT_DIVISOR & 0xFF));
-  outb(PIT_CHANNEL0_DATA, static_cast<uint8_t>(PIT_DIVISOR >> 8));
+  arm(ns_to_count(kTickNs), kTickNs);
 
   initialized = true;
 }
 
-void tick() { ticks = ticks + 1; }
+void tick() {
+  // Fold the finished countdown (plus however far the counter has run past
+  // terminal count) into the base before starting the next one.
+  const uint16_t counter = read_counter();
+  const uint32_t overshoot = counter > armed_count ? 0x10000U - counter : 0;
+  base_cycles += armed_count + overshoot;
+  if (base_cycles > last_cycles) {
+    last_cycles = base_cycles;
+  }
+  armed_count = 0;
+
+  // Default to the next tick boundary so get_ticks() advances on every
+  // default expiry.
+  const uint64_t now = cycles_to_ns(base_cycles);
+  const uint64_t next_tick = ((now / kTickNs) + 1) * kTickNs;
+  arm(ns_to_count(next_tick - now), next_tick);
+
+  Vdso::update();
+}
+
+uint64_t now_ns() {
+  assert(initialized && "PIT::now_ns(): called before PIT::init()");
+  return cycles_to_ns(now_cycles());
+}
 
 uint64_t get_ticks() {
   assert(initialized && "PIT::get_ticks(): called before PIT::init()");
-  return ticks;
+  return now_ns() / kTickNs;
+}
+
+void set_deadline(uint64_t deadline_ns) {
+  assert(initialized && "PIT::set_deadline(): called before PIT::init()");
+  if (deadline_ns == armed_deadline) {
+    return;
+  }
+  const uint64_t now = now_ns();
+  arm(ns_to_count(deadline_ns > now ? deadline_ns - now : 0), deadline_ns);
 }
 
 void sleep_ticks(uint64_t n) {
   assert(initialized && "PIT::sleep_ticks(): called before PIT::init()");
-  const uint64_t target = ticks + n;
-  while (ticks < target) {
+  const uint64_t target = get_ticks() + n;
+  while (get_ticks() < target) {
     __asm__ volatile("hlt");
   }
 }
 
 void sleep_ms(uint32_t ms) {
   assert(initialized && "PIT::sleep_ms(): called before PIT::init()");
-  sleep_ticks((static_cast<uint64_t>(ms) + 9) / 10);
+  const uint64_t target = now_ns() + (static_cast<uint64_t>(ms) * 1'000'000);
+  while (now_ns() < target) {
+    // Re-arm each pass: long sleeps are clamped to one countdown.
+    set_deadline(target);
+    __asm__ volatile("hlt");
+  }
 }
 
 }  // namespace PIT
@@ -0,0 +1,152 @@
+#include "process_table.h"
+
+#include <array.h>
+#include <assert.h>
+#include <string.h>
+
+#include "heap.h"
+#include "process.h"
+
+namespace {
+
+std::array<uint32_t, ProcessTable::kMaxPid / 32> pid_bitmap;
+uint32_t last_pid = ProcessTable::kMaxPid - 1;  // so the first PID handed out is 0
+
+std::array<Process*, ProcessTable::kHashBuckets> pid_hash;
+
+Process* live_head = nullptr;
+uint32_t live_count = 0;
+
+Process* free_list = nullptr;  // recycled PCBs, linked via table_next
+
+bool pid_in_use(uint32_t pid) { return (pid_bitmap[pid / 32] & (1U << (pid % 32))) != 0U; }
+
+// Claim the next free PID after last_pid, wrapping. Returns kMaxPid if
+// every PID is taken.
+uint32_t alloc_pid() {
+  for (uint32_t i = 1; i <= ProcessTable::kMaxPid; ++i) {
+    const uint32_t pid = (last_pid + i) % ProcessTable::kMaxPid;
+    if (pid_bitmap[pid / 32] == UINT32_MAX) {
+      // Skip to the end of a full word.
+      i += 31 - (pid % 32);
+      continue;
+    }
+    if (!pid_in_use(pid)) {
+      pid_bitmap[pid / 32] |= 1U << (pid % 32);
+      last_pid = pid;
+      return pid;
+    }
+  }
+  return ProcessTable::kMaxPid;
+}
+
+uint32_t bucket(uint32_t pid) { return pid & (ProcessTable::kHashBuckets - 1); }
+
+}  // namespace
+
+namespace ProcessTable {
+
+Process* alloc() {
+  const uint32_t pid = alloc_pid();
+  if (pid == kMaxPid) {
+    return nullptr;
+  }
+
+  Process* p = free_list;
+  if (p != nullptr) {
+    free_list = p->table_next;
+  } else {
+    p = static_cast<Process*>(kmalloc(sizeof(Process)));
+    if (p == nullptr) {
+      pid_bitmap[pid / 32] &= ~(1U << (pid % 32));
+      return nullptr;
+    }
+  }
+  assert((reinterpret_cast<uintptr_t>(p) % alignof(Process)) == 0 &&
+         "ProcessTable::alloc(): misaligned PCB");
+
+  memset(p, 0, sizeof(Process));
+  p->pid = pid;
+  p->state = ProcessState::Ready;
+
+  Process*& chain = pid_hash[bucket(pid)];
+  p->hash_next = chain;
+  chain = p;
+
+  p->table_next = live_head;
+  if (live_head != nullptr) {
+    live_head->table_prev = p;
+  }
+  live_head = p;
+  ++live_count;
+  return p;
+}
+
+void free(Process* p) {
+  assert(p != nullptr && "ProcessTable::free(): null process");
+  assert(pid_in_use(p->pid) && "ProcessTable::free(): pid not allocated");
+  assert(p->pid != 0 && "ProcessTable::free(): cannot free the idle process");
+  assert(p->first_child == nullptr && "ProcessTable::free(): process still has children");
+  assert(p->parent == nullptr && "ProcessTable::free(): process still linked to its parent");
+
+  Process** link = &pid_hash[bucket(p->pid)];
+  while (*link != p) {
+    assert(*link != nullptr && "ProcessTable::free(): process not in pid hash");
+    link = &(*link)->hash_next;
+  }
+  *link = p->hash_next;
+
+  if (p->table_prev != nullptr) {
+    p->table_prev->table_next = p->table_next;
+  } else {
+    live_head = p->table_next;
+  }
+  if (p->table_next != nullptr) {
+    p->table_next->table_prev = p->table_prev;
+  }
+  --live_count;
+
+  pid_bitmap[p->pid / 32] &= ~(1U << (p->pid % 32));
+
+  p->state = ProcessState::Empty;
+  p->table_next = free_list;
+  free_list = p;
+}
+
+Process* find(uint32_t pid) {
+  for (Process* p = pid_hash[bucket(pid)]; p != nullptr; p = p->hash_next) {
+    if (p->pid == pid) {
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+Process* head() { return live_head; }
+
+uint32_t count() { return live_count; }
+
+void add_child(Process* parent, Process* child) {
+  assert(parent != nullptr && child != nullptr && "ProcessTable::add_child(): null process");
+  assert(child->parent == nullptr && "ProcessTable::add_child(): child already has a parent");
+  child->parent = parent;
+  child->next_sibling = parent->first_child;
+  parent->first_child = child;
+}
+
+void remove_child(Process* child) {
+  Process* parent = child->parent;
+  if (parent == nullptr) {
+    return;
+  }
+  Process** link = &parent->first_child;
+  while (*link != child) {
+    assert(*link != nullptr && "ProcessTable::remove_child(): not on parent's child list");
+    link = &(*link)->next_sibling;
+  }
+  *link = child->next_sibling;
+  child->next_sibling = nullptr;
+  child->parent = nullptr;
+}
+
+}  // namespace ProcessTable
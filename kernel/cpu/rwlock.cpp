@@ -0,0 +1,63 @@
+#include "rwlock.h"
+
+#include <assert.h>
+
+#include "x86.h"
+
+void RwLock::read_lock() {
+  uint64_t start = 0;
+  for (;;) {
+    uint32_t state = __atomic_load_n(&state_, __ATOMIC_RELAXED);
+    if ((state & kWriter) == 0U && __atomic_load_n(&writers_waiting_, __ATOMIC_RELAXED) == 0 &&
+        __atomic_compare_exchange_n(&state_, &state, state + 1, /*weak=*/true, __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED)) {
+      break;
+    }
+    if (start == 0) {
+      start = rdtsc();
+    }
+    __asm__ volatile("pause");
+  }
+  if (start != 0) {
+    stats_.record_contention(rdtsc() - start);
+  }
+  stats_.record_acquire();
+}
+
+void RwLock::read_unlock() {
+  assert(readers() > 0 && "RwLock::read_unlock(): no readers");
+  __atomic_fetch_sub(&state_, 1, __ATOMIC_RELEASE);
+}
+
+void RwLock::write_lock() {
+  __atomic_fetch_add(&writers_waiting_, 1, __ATOMIC_RELAXED);
+  uint64_t start = 0;
+  uint32_t expected = 0;
+  while (!__atomic_compare_exchange_n(&state_, &expected, kWriter, /*weak=*/true,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    expected = 0;
+    if (start == 0) {
+      start = rdtsc();
+    }
+    __asm__ volatile("pause");
+  }
+  __atomic_fetch_sub(&writers_waiting_, 1, __ATOMIC_RELAXED);
+
+  if (start != 0) {
+    stats_.record_contention(rdtsc() - start);
+  }
+  acquired_at_ = rdtsc();
+  stats_.record_acquire();
+}
+
+void RwLock::write_unlock() {
+  assert(is_write_locked() && "RwLock::write_unlock(): not write-locked");
+  stats_.record_release(rdtsc() - acquired_at_);
+  __atomic_store_n(&state_, 0, __ATOMIC_RELEASE);
+}
+
+uint32_t RwLock::readers() const { return __atomic_load_n(&state_, __ATOMIC_RELAXED) & ~kWriter; }
+
+bool RwLock::is_write_locked() const {
+  return (__atomic_load_n(&state_, __ATOMIC_RELAXED) & kWriter) != 0U;
+}
@@ -9,12 +9,16 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/cdefs.h>
+#include <sys/schedstat.h>
 #include <sys/syscall.h>
 #include <utility.h>
 
 #include "address_space.h"
+#include "apic.h"
 #include "elf.h"
 #include "file.h"
+#include "fpu.h"
+#include "futex.h"
 #include "gdt.h"
 #include "heap.h"
 #include "idt.h"
@@ -24,14 +28,21 @@
 #include "pit.h"
 #include "pmm.h"
 #include "process.h"
+#include "process_table.h"
+#include "ring.h"
 #include "shm.h"
+#include "smp.h"
+#include "trace.h"
 #include "tss.h"
+#include "uaccess.h"
+#include "vdso.h"
 #include "vfs.h"
 
 __BEGIN_DECLS
 
-// Assembly entry point defined in timer_entry.S.
+// Assembly entry points defined in trap_entry.S.
 void timer_entry();
+void kthread_yield_entry();
 
 // Kernel stack symbol from arch/boot.S.
 extern char stack_top[];
@@ -44,15 +55,27 @@ uint32_t timer_dispatch(uint32_t esp) {
   return Scheduler::schedule(esp);
 }
 
+// Kernel thread switch (kKthreadYieldVector). The thread raised it with the
+// kernel lock held; drop that hold here. The entry stub's own hold keeps
+// the lock until the next process's stack is live, and the thread takes
+// the lock again once it is resumed (see kthread_switch()).
+uint32_t kthread_yield_dispatch(uint32_t esp) {
+  kernel_unlock();
+  return Scheduler::schedule(esp);
+}
+
 // Page fault dispatch. Called from page_fault_entry in trap_entry.S after the
 // CPU's error code has been discarded. Delivers SIGSEGV for user-mode faults;
-// panics for kernel-mode faults.
+// kernel-mode faults resume at their exception table fixup (a bad user
+// pointer in copy_from_user() and friends) or panic.
 uint32_t page_fault_dispatch(uint32_t esp) {
   auto* regs = reinterpret_cast<TrapFrame*>(esp);
   if ((regs->cs & 3) == 3) {
     // User-mode page fault: deliver SIGSEGV.
     Scheduler::send_signal(Scheduler::current()->pid, SIGSEGV);
     Scheduler::check_pending_signals(regs);
+  } else if (fixup_exception(regs)) {
+    return esp;
   } else {
     uint32_t fault_addr = 0;  // NOLINT(misc-const-correctness)
     __asm__ volatile("mov %%cr2, %0" : "=r"(fault_addr));
@@ -81,84 +104,294 @@ __END_DECLS
 
 namespace {
 
-std::array<Process, kMaxProcesses> process_table;
-uint32_t next_pid = 0;
-
-Process* current_process = nullptr;
-Process* ready_head = nullptr;
-Process* ready_tail = nullptr;
-Process* blocked_head = nullptr;
-Process* idle_process = nullptr;
+// Per-CPU scheduling state. Each CPU runs processes from its own FIFO and
+// steals from the longest other queue when its own runs dry.
+struct RunQueue {
+  Process* current;       // process running on this CPU
+  Process* idle;          // this CPU's idle process
+  Process* head;          // oldest entry in the ready FIFO
+  Process* tail;          // newest entry in the ready FIFO
+  uint32_t length;        // number of processes in the FIFO
+  uint64_t slice_end_ns;  // when the running process's time slice expires
+  Process* exited;        // exited process nobody will reap, freed once switched away
+  uint64_t account_ns;    // when CPU time was last charged on this CPU
+  uint64_t idle_ns;       // time spent running the idle process
+  bool in_syscall;        // current entered the kernel through a syscall
+  Process idle_storage;   // idle process of an AP (the BSP's is pid 0 in the table)
+};
+
+std::array<RunQueue, Smp::kMaxCpus> run_queues;
 
 bool initialized = false;
 bool started = false;
 
-Process* alloc_process() {
-  if (next_pid >= kMaxProcesses) {
-    return nullptr;
+// Load averages, fixed point with LOAD_FSHIFT fractional bits. Decayed by
+// exp(-kLoadSampleNs / period) per sample, as in Linux's calc_load().
+constexpr std::array<uint32_t, 3> kLoadExp = {
+    1884,  // 1 minute
+    2014,  // 5 minutes
+    2037,  // 15 minutes
+};
+std::array<uint32_t, 3> load_avg;
+Timer load_timer;
+
+RunQueue& this_rq() { return run_queues[Smp::current_cpu()]; }
+
+Process* current_process() { return this_rq().current; }
+
+Process* idle_process() { return this_rq().idle; }
+
+// Free what is left of a zombie: its kernel stack and PCB. Its stack must
+// no longer be in use (true once another process runs on its last CPU).
+void destroy_process(Process* p) {
+  ProcessTable::remove_child(p);
+  if (p->kernel_stack != nullptr) {
+    kfree(p->kernel_stack);
+  }
+  ProcessTable::free(p);
+}
+
+// Free this CPU's parentless exited process once it is no longer running.
+void reap_exited(RunQueue& rq) {
+  if (rq.exited != nullptr && rq.exited != rq.current) {
+    destroy_process(rq.exited);
+    rq.exited = nullptr;
   }
-  Process* p = &process_table[next_pid];
-  memset(p, 0, sizeof(Process));
-  p->pid = next_pid++;
-  p->state = ProcessState::Ready;
-  p->cwd[0] = '/';
-  p->cwd[1] = '\0';
-  return p;
 }
 
-void enqueue_ready(Process* p) {
-  assert(p != nullptr && "enqueue_ready(): null process");
+// Arrange for the exiting current process p to be freed once this CPU has
+// switched away from it: nobody will ever waitpid() for it.
+void reap_after_switch(Process* p) {
+  RunQueue& rq = this_rq();
+  reap_exited(rq);
+  rq.exited = p;
+}
+
+void push_ready(RunQueue& rq, Process* p) {
+  assert(p != nullptr && "push_ready(): null process");
   p->next = nullptr;
   p->state = ProcessState::Ready;
-  if (ready_tail == nullptr) {
-    ready_head = ready_tail = p;
+  p->ready_since_ns = PIT::now_ns();
+  if (rq.tail == nullptr) {
+    rq.head = rq.tail = p;
   } else {
-    ready_tail->next = p;
-    ready_tail = p;
+    rq.tail->next = p;
+    rq.tail = p;
   }
+  ++rq.length;
 }
 
-Process* dequeue_ready() {
-  if (ready_head == nullptr) {
+Process* pop_ready(RunQueue& rq) {
+  if (rq.head == nullptr) {
     return nullptr;
   }
-  Process* p = ready_head;
-  ready_head = ready_head->next;
-  if (ready_head == nullptr) {
-    ready_tail = nullptr;
+  Process* p = rq.head;
+  rq.head = rq.head->next;
+  if (rq.head == nullptr) {
+    rq.tail = nullptr;
   }
+  --rq.length;
   p->next = nullptr;
   return p;
 }
 
-void enqueue_blocked(Process* p) {
-  p->state = ProcessState::Blocked;
-  p->next = blocked_head;
-  blocked_head = p;
+// Queue p to run. An idle CPU is preferred, starting with the one p last
+// ran on; otherwise p goes back to its last CPU. A remote CPU whose queue
+// was empty gets a reschedule IPI: it is either idle or running alone
+// with no slice timer armed.
+void make_ready(Process* p) {
+  const uint32_t cpus = Smp::cpu_count();
+  uint32_t target = p->cpu < cpus ? p->cpu : 0;
+  for (uint32_t i = 0; i < cpus; ++i) {
+    const uint32_t cpu = (p->cpu + i) % cpus;
+    const RunQueue& rq = run_queues[cpu];
+    if (rq.current == rq.idle && rq.length == 0) {
+      target = cpu;
+      break;
+    }
+  }
+
+  RunQueue& rq = run_queues[target];
+  const bool was_empty = rq.length == 0;
+  push_ready(rq, p);
+  if (was_empty) {
+    Smp::send_reschedule(target);
+  }
 }
 
-void wake_sleepers() {
-  const uint64_t now = PIT::get_ticks();
-  Process* prev = nullptr;
-  Process* p = blocked_head;
+// Take the oldest ready process from the longest run queue other than
+// `self`'s. Returns nullptr if every other queue is empty.
+Process* steal(uint32_t self) {
+  RunQueue* victim = nullptr;
+  for (uint32_t cpu = 0; cpu < Smp::cpu_count(); ++cpu) {
+    RunQueue& rq = run_queues[cpu];
+    if (cpu != self && rq.length > (victim != nullptr ? victim->length : 0)) {
+      victim = &rq;
+    }
+  }
+  return victim != nullptr ? pop_ready(*victim) : nullptr;
+}
 
-  while (p != nullptr) {
-    Process* next = p->next;
-    if (now >= p->wake_tick) {
-      if (prev != nullptr) {
-        prev->next = next;
-      } else {
-        blocked_head = next;
-      }
-      // Only re-queue if still blocked; processes killed while blocked will be Zombie.
-      if (p->state == ProcessState::Blocked) {
-        enqueue_ready(p);
-      }
-    } else {
-      prev = p;
+// Detach a Blocked process from whatever it sleeps on: its wait queue, its
+// sleep timer, or both (wait_on_until). Does not change its state.
+void unlink_blocked(Process* p) {
+  if (p->wait_queue != nullptr) {
+    p->wait_queue->remove(p);
+    p->wait_queue = nullptr;
+  }
+  cancel_timer(&p->sleep_timer);
+}
+
+// A leader whose threads are all gone is Zombie with no thread_count.
+bool group_dead(const Process* leader) {
+  return leader->state == ProcessState::Zombie && leader->thread_count == 0;
+}
+
+// Release what a thread group shares once its last thread has exited, then
+// hand the leader to its parent's waitpid() or free it.
+void release_group(Process* leader) {
+  // Close all file descriptors before destroying the address space.
+  leader->fds.close_all();
+
+  // Detach all shared memory regions so AddressSpace::destroy() does
+  // not free the shared physical pages.
+  Shm::detach_all(leader);
+  Ring::release(leader);
+  Vfs::node_put(leader->cwd);
+  leader->cwd = nullptr;
+
+  // Free address space. Must switch to boot page directory first since
+  // we cannot free the currently loaded page directory.
+  AddressSpace::load(virt_to_phys(vaddr_t{&boot_page_directory}));
+  AddressSpace::destroy(leader->page_directory, leader->page_directory_phys);
+  leader->page_directory = nullptr;
+  leader->page_directory_phys = 0;
+
+  // Orphan the children. Zombies nobody can wait for any more are freed
+  // now; live ones free themselves when they exit.
+  while (Process* child = leader->first_child) {
+    ProcessTable::remove_child(child);
+    if (group_dead(child)) {
+      destroy_process(child);
+    }
+  }
+
+  // Wake the parent if it is blocked in waitpid, or free the leader if
+  // there is nobody to collect the exit code: once switched away if it is
+  // the exiting thread, now if it exited earlier.
+  Process* parent = leader->parent;
+  if (parent != nullptr) {
+    Scheduler::wake_all(parent->child_exit_waiters);
+  } else if (leader == current_process()) {
+    reap_after_switch(leader);
+  } else {
+    destroy_process(leader);
+  }
+}
+
+// Per-thread part of exiting: leave any wait queue or sleep timer, drop
+// the FPU, and clear and wake the clear_tid word (pthread_join).
+void exit_thread_state(Process* self) {
+  // A process killed right after parking (signal delivered on the syscall
+  // return path) is still linked on a wait queue or has a sleep timer armed.
+  if (self->state == ProcessState::Blocked) {
+    unlink_blocked(self);
+  }
+  self->wait_queue = nullptr;
+  // A wait_on_until() timer outlives an early wakeup until the syscall
+  // retries; it must not fire on a freed PCB.
+  cancel_timer(&self->sleep_timer);
+
+  Fpu::release(self);
+
+  if (self->clear_tid != 0) {
+    const paddr_t word = AddressSpace::user_phys(self->page_directory, self->clear_tid);
+    if (word != 0) {
+      *phys_to_virt(word).ptr<uint32_t>() = 0;
+      static_cast<void>(Futex::wake(self->clear_tid, UINT32_MAX));
+    }
+    self->clear_tid = 0;
+  }
+
+  self->state = ProcessState::Zombie;
+}
+
+// Account for the exited thread `self` in its group, releasing the group
+// if it was the last one.
+void leave_group(Process* self) {
+  Process* leader = self->group();
+  if (self != leader) {
+    --leader->thread_count;
+    reap_after_switch(self);
+  }
+  if (group_dead(leader)) {
+    release_group(leader);
+  }
+}
+
+// Timer callback for sleep_current().
+void sleep_expired(void* arg) {
+  auto* p = static_cast<Process*>(arg);
+  // Only re-queue if still blocked; processes killed while blocked will be Zombie.
+  if (p->state == ProcessState::Blocked) {
+    make_ready(p);
+  }
+}
+
+// Timer callback for wait_on_until(): the deadline passed first.
+void wait_expired(void* arg) {
+  auto* p = static_cast<Process*>(arg);
+  if (p->state == ProcessState::Blocked) {
+    unlink_blocked(p);
+    make_ready(p);
+  }
+}
+
+// Charge the time since rq's last accounting point to whatever ran on it.
+// `user` says the current process was interrupted in ring 3.
+void account(RunQueue& rq, bool user) {
+  const uint64_t now = PIT::now_ns();
+  const uint64_t delta = now - rq.account_ns;
+  rq.account_ns = now;
+  Process* p = rq.current;
+  if (p == rq.idle) {
+    rq.idle_ns += delta;
+  } else if (user) {
+    p->user_ns += delta;
+  } else {
+    p->system_ns += delta;
+  }
+}
+
+// Add the time p spent in a run queue to its wait time. p was just popped.
+void account_wait(Process* p, uint64_t now) {
+  if (now > p->ready_since_ns) {
+    p->wait_ns += now - p->ready_since_ns;
+  }
+}
+
+// Number of processes running or waiting for a CPU, for the load average.
+uint32_t active_processes() {
+  uint32_t active = 0;
+  for (uint32_t cpu = 0; cpu < Smp::cpu_count(); ++cpu) {
+    const RunQueue& rq = run_queues[cpu];
+    active += rq.length;
+    if (rq.current != rq.idle && rq.current->state == ProcessState::Running) {
+      ++active;
     }
-    p = next;
   }
+  return active;
+}
+
+// Timer callback: fold the current number of active processes into the
+// load averages and re-arm for the next sample.
+void sample_load(void* /*arg*/) {
+  const uint32_t active = active_processes() << LOAD_FSHIFT;
+  for (size_t i = 0; i < load_avg.size(); ++i) {
+    const uint32_t exp = kLoadExp[i];
+    load_avg[i] = ((load_avg[i] * exp) + (active * (LOAD_FIXED_1 - exp))) >> LOAD_FSHIFT;
+  }
+  add_timer(&load_timer, PIT::now_ns() + Scheduler::kLoadSampleNs, sample_load, nullptr);
 }
 
 // Switches from the current process to the target process. This updates
@@ -167,18 +400,140 @@ void wake_sleepers() {
 uint32_t switch_to(Process* target) {
   assert(target != nullptr && "switch_to(): null process");
 
-  current_process = target;
+  RunQueue& rq = this_rq();
+  Process* const prev = rq.current;
+  if (prev != rq.idle && prev != target) {
+    if (prev->state == ProcessState::Ready) {
+      ++prev->involuntary_switches;
+    } else {
+      ++prev->voluntary_switches;
+    }
+  }
+
+  const uint64_t now = PIT::now_ns();
+  if (target != rq.idle) {
+    account_wait(target, now);
+  }
+
+  Fpu::switch_to(prev, target);
+  rq.current = target;
   target->state = ProcessState::Running;
+  target->cpu = Smp::current_cpu();
+  rq.slice_end_ns = now + Scheduler::kTimeSliceNs;
 
   // Update TSS.esp0 so ring-3 interrupts land on this process's kernel stack.
   TSS::set_kernel_stack(reinterpret_cast<uint32_t>(target->kernel_stack) + kKernelStackSize);
 
+  // Point this CPU's TLS segment at the thread's TLS block. A thread that
+  // last ran on another CPU still has that CPU's selector saved in %gs.
+  if (target != rq.idle && !target->kernel_thread) {
+    GDT::set_tls(target->cpu, target->tls_base);
+    auto* frame = reinterpret_cast<TrapFrame*>(target->kernel_esp);
+    if (GDT::is_tls_selector(frame->gs)) {
+      frame->gs = GDT::tls_selector(target->cpu);
+    }
+  }
+
   AddressSpace::sync_kernel_mappings(target->page_directory);
   AddressSpace::load(target->page_directory_phys);
 
   return target->kernel_esp;
 }
 
+// Program the PIT for the earliest kernel timer, or the BSP's slice end if
+// someone is waiting for that CPU. Kernel timers only fire on the BSP, so
+// every CPU calls this after a scheduling decision that may have added one.
+void rearm_pit() {
+  const RunQueue& bsp = run_queues[0];
+  uint64_t deadline = next_timer_deadline();
+  if (bsp.head != nullptr && bsp.slice_end_ns < deadline) {
+    deadline = bsp.slice_end_ns;
+  }
+  PIT::set_deadline(deadline);
+}
+
+// Program the one-shot timers for the next event: the end of the current
+// slice if someone is waiting for this CPU, or the earliest kernel timer.
+// With neither, the PIT only runs to keep the clock ticking over and an
+// AP's APIC timer is stopped.
+void rearm_timer() {
+  rearm_pit();
+  if (Smp::current_cpu() == 0) {
+    return;
+  }
+  const RunQueue& rq = this_rq();
+  if (rq.head == nullptr) {
+    LAPIC::stop_timer();
+    return;
+  }
+  const uint64_t now = PIT::now_ns();
+  LAPIC::set_oneshot(rq.slice_end_ns > now ? rq.slice_end_ns - now : 0);
+}
+
+// Pick the next process to run and switch to it. See schedule().
+uint32_t pick_next(uint32_t esp) {
+  RunQueue& rq = this_rq();
+  Process* const prev = rq.current;
+
+  // Save current process's kernel ESP so we can resume it later.
+  prev->kernel_esp = esp;
+
+  // A process that exited on this CPU with nobody to reap it has been
+  // switched away from by now, so nothing runs on its stack any more.
+  reap_exited(rq);
+
+  // Fire expired kernel timers (e.g. wake sleepers that have waited long enough).
+  run_timers(PIT::now_ns());
+
+  Process* next = pop_ready(rq);
+  if (next == nullptr) {
+    next = steal(Smp::current_cpu());
+  }
+  if (next == nullptr) {
+    // Nothing ready - stay on current if it's still running, or idle.
+    if (prev->state == ProcessState::Running) {
+      return esp;
+    }
+    // Current was blocked/zombie, switch to idle.
+    return switch_to(rq.idle);
+  }
+
+  // If current is still running (preempted), put it back in the ready
+  // queue so it can run again later.
+  if (prev->state == ProcessState::Running && prev != rq.idle) {
+    push_ready(rq, prev);
+  }
+
+  // If it's the same process? We can just keep running.
+  if (next == prev) {
+    const uint64_t now = PIT::now_ns();
+    account_wait(next, now);
+    next->state = ProcessState::Running;
+    rq.slice_end_ns = now + Scheduler::kTimeSliceNs;
+    return esp;
+  }
+
+  return switch_to(next);
+}
+
+// Switch away from the calling kernel thread through kKthreadYieldVector,
+// and take the kernel lock back once it is resumed. The caller has already
+// updated its state (still Running to yield, Blocked or Zombie otherwise).
+void kthread_switch() {
+  assert(current_process()->kernel_thread && "kthread_switch(): not a kernel thread");
+  __asm__ volatile("int %0" ::"i"(Scheduler::kKthreadYieldVector) : "memory");
+  kernel_lock();
+}
+
+// First code a kernel thread runs, entered by iret from the TrapFrame built
+// in kthread_create() with interrupts disabled and no lock held.
+[[noreturn]] void kthread_start() {
+  kernel_lock();
+  const Process* self = current_process();
+  self->kthread_fn(self->kthread_arg);
+  Scheduler::kthread_exit();
+}
+
 }  // namespace
 
 namespace Scheduler {
@@ -187,27 +542,52 @@ void init() {
   assert(!initialized && "Scheduler::init(): called more than once");
 
   // Create the idle process. This process runs when no other process is ready to run.
-  idle_process = alloc_process();
-  assert(idle_process && "Scheduler::init(): failed to allocate idle process");
-  idle_process->state = ProcessState::Running;
-  idle_process->page_directory = &boot_page_directory;
-  idle_process->page_directory_phys = virt_to_phys(vaddr_t{&boot_page_directory});
-  idle_process->kernel_stack =
+  Process* idle = ProcessTable::alloc();
+  assert(idle && "Scheduler::init(): failed to allocate idle process");
+  idle->state = ProcessState::Running;
+  idle->page_directory = &boot_page_directory;
+  idle->page_directory_phys = virt_to_phys(vaddr_t{&boot_page_directory});
+  idle->kernel_stack =
       reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(stack_top) - kKernelStackSize);
-  idle_process->kernel_esp = 0;  // will be set on first schedule()
-  fd_init_stdio(idle_process->fds);
+  idle->kernel_esp = 0;  // will be set on first schedule()
+  assert(idle->fds.init_stdio() && "Scheduler::init(): failed to allocate idle fd table");
 
-  current_process = idle_process;
+  run_queues[0].idle = idle;
+  run_queues[0].current = idle;
   initialized = true;
 
   // Install the timer interrupt handler. Scheduling is gated by start().
   IDT::set_entry(32, reinterpret_cast<uintptr_t>(timer_entry), IDT::Gate::Interrupt,
                  IDT::Ring::Kernel);
+  IDT::set_entry(kKthreadYieldVector, reinterpret_cast<uintptr_t>(kthread_yield_entry),
+                 IDT::Gate::Interrupt, IDT::Ring::Kernel);
   PIC::unmask(0);
 }
 
+void init_ap(uint32_t cpu, uint8_t* kernel_stack) {
+  assert(initialized && "Scheduler::init_ap(): must call init() first");
+  assert(cpu > 0 && cpu < Smp::kMaxCpus && "Scheduler::init_ap(): cpu out of range");
+
+  // AP idle processes live outside the process table: they share pid 0
+  // with the BSP's and are never looked up, signalled or reaped.
+  RunQueue& rq = run_queues[cpu];
+  Process* idle = &rq.idle_storage;
+  memset(idle, 0, sizeof(Process));
+  idle->state = ProcessState::Running;
+  idle->cpu = cpu;
+  idle->page_directory = &boot_page_directory;
+  idle->page_directory_phys = virt_to_phys(vaddr_t{&boot_page_directory});
+  idle->kernel_stack = kernel_stack;
+
+  rq.idle = idle;
+  rq.current = idle;
+  rq.account_ns = PIT::now_ns();
+}
+
 void start() {
   assert(initialized && "Scheduler::start(): must call init() first");
+  run_queues[0].account_ns = PIT::now_ns();
+  add_timer(&load_timer, PIT::now_ns() + kLoadSampleNs, sample_load, nullptr);
   started = true;
 }
 
@@ -220,83 +600,188 @@ uint32_t schedule(uint32_t esp) {
     return esp;
   }
 
-  // Save current process's kernel ESP so we can resume it later.
-  current_process->kernel_esp = esp;
+  // Charge the time since the last kernel entry before anything switches.
+  RunQueue& rq = this_rq();
+  const auto* frame = reinterpret_cast<const TrapFrame*>(esp);
+  account(rq, (frame->cs & 3) == 3 && !rq.in_syscall);
+  rq.in_syscall = false;
 
-  // Check if any sleeping processes have waited long enough.
-  wake_sleepers();
+  const uint32_t next_esp = pick_next(esp);
+  rearm_timer();
+  return next_esp;
+}
 
-  Process* next = dequeue_ready();
-  if (next == nullptr) {
-    // Nothing ready - stay on current if it's still running, or idle.
-    if (current_process->state == ProcessState::Running) {
-      return esp;
-    }
-    // Current was blocked/zombie, switch to idle.
-    return switch_to(idle_process);
-  }
+Process* kthread_create(KthreadFn fn, void* arg) {
+  assert(initialized && "Scheduler::kthread_create(): scheduler not initialized");
+  assert(fn != nullptr && "Scheduler::kthread_create(): null entry point");
 
-  // If current is still running (preempted), put it back in the ready
-  // queue so it can run again later.
-  if (current_process->state == ProcessState::Running && current_process != idle_process) {
-    enqueue_ready(current_process);
+  Process* p = ProcessTable::alloc();
+  if (p == nullptr) {
+    return nullptr;
   }
 
-  // If it's the same process? We can just keep running.
-  if (next == current_process) {
-    next->state = ProcessState::Running;
-    return esp;
+  p->kernel_stack = static_cast<uint8_t*>(kmalloc(kKernelStackSize));
+  if (p->kernel_stack == nullptr) {
+    ProcessTable::free(p);
+    return nullptr;
   }
+  memset(p->kernel_stack, 0, kKernelStackSize);
 
-  return switch_to(next);
+  set_name(p, "kthread");
+  p->kernel_thread = true;
+  p->kthread_fn = fn;
+  p->kthread_arg = arg;
+  p->cpu = Smp::current_cpu();
+  p->page_directory = &boot_page_directory;
+  p->page_directory_phys = virt_to_phys(vaddr_t{&boot_page_directory});
+
+  // iret without a privilege change pops only eip/cs/eflags, leaving ESP
+  // at the frame's user_esp slot: that becomes kthread_start()'s (unused)
+  // return address.
+  auto* frame = reinterpret_cast<TrapFrame*>(p->kernel_stack + kKernelStackSize -
+                                             sizeof(TrapFrame));
+  frame->eip = reinterpret_cast<uint32_t>(kthread_start);
+  frame->cs = GDT::KERNEL_CODE_SELECTOR;
+  frame->eflags = 0x002;  // IF clear: kernel threads are not preempted
+  frame->ds = GDT::KERNEL_DATA_SELECTOR;
+  frame->es = GDT::KERNEL_DATA_SELECTOR;
+  frame->fs = GDT::KERNEL_DATA_SELECTOR;
+  frame->gs = GDT::KERNEL_DATA_SELECTOR;
+  p->kernel_esp = reinterpret_cast<uint32_t>(frame);
+
+  make_ready(p);
+  return p;
 }
 
-void exit_current(uint32_t exit_code) {
-  assert(current_process != idle_process && "exit_current(): cannot exit idle process");
+void kthread_yield() { kthread_switch(); }
 
-  printf("Process %u exited with code %u\n", current_process->pid, exit_code);
+void kthread_wait(WaitQueue& wq) {
+  Process* self = current_process();
+  self->state = ProcessState::Blocked;
+  self->wait_queue = &wq;
+  wq.push(self);
+  kthread_switch();
+}
 
-  // Close all file descriptors before destroying the address space.
-  for (auto& fd : current_process->fds) {
-    if (fd != nullptr) {
-      file_close(fd);
-      fd = nullptr;
+void kthread_sleep(uint64_t ns) {
+  Process* self = current_process();
+  self->state = ProcessState::Blocked;
+  add_timer(&self->sleep_timer, PIT::now_ns() + ns, sleep_expired, self);
+  kthread_switch();
+}
+
+void kthread_exit() {
+  Process* self = current_process();
+  assert(self->kernel_thread && "kthread_exit(): not a kernel thread");
+  self->state = ProcessState::Zombie;
+  reap_after_switch(self);
+  kthread_switch();
+  __builtin_unreachable();
+}
+
+void exit_current(uint32_t exit_code) {
+  assert(current_process() != idle_process() && "exit_current(): cannot exit idle process");
+
+  Process* self = current_process();
+  Process* leader = self->group();
+  printf("Process %u exited with code %u\n", self->pid, exit_code);
+
+  // The first thread to exit the whole group sets its exit code and kills
+  // the other threads; they run leave_group() as they die.
+  if (!leader->group_exiting) {
+    leader->group_exiting = true;
+    leader->exit_code = static_cast<int32_t>(exit_code);
+    for (const Process* p = ProcessTable::head(); p != nullptr; p = p->table_next) {
+      if (p != self && p->group() == leader && p->state != ProcessState::Zombie) {
+        send_signal(p->pid, SIGKILL);
+      }
     }
   }
+  Trace::process_exited(self, leader->exit_code);
 
-  // Detach all shared memory regions so AddressSpace::destroy() does
-  // not free the shared physical pages.
-  Shm::detach_all(current_process);
+  exit_thread_state(self);
+  leave_group(self);
+}
 
-  current_process->state = ProcessState::Zombie;
-  current_process->exit_code = static_cast<int32_t>(exit_code);
+void exit_thread() {
+  assert(current_process() != idle_process() && "exit_thread(): cannot exit idle process");
 
-  // Free address space. Must switch to boot page directory first since
-  // we cannot free the currently loaded page directory.
-  if (current_process != idle_process) {
-    AddressSpace::load(virt_to_phys(vaddr_t{&boot_page_directory}));
-    AddressSpace::destroy(current_process->page_directory, current_process->page_directory_phys);
-    current_process->page_directory = nullptr;
-    current_process->page_directory_phys = 0;
+  Process* self = current_process();
+  if (self == self->group() && self->thread_count == 0) {
+    exit_current(0);
+    return;
   }
+  exit_thread_state(self);
+  leave_group(self);
 }
 
-void sleep_current(uint32_t ms) {
-  assert(current_process != idle_process && "sleep_current(): cannot sleep idle process");
+void sleep_current(uint64_t ns) {
+  assert(current_process() != idle_process() && "sleep_current(): cannot sleep idle process");
 
-  current_process->wake_tick = PIT::get_ticks() + ((static_cast<uint64_t>(ms) + 9) / 10);
-  enqueue_blocked(current_process);
+  current_process()->state = ProcessState::Blocked;
+  add_timer(&current_process()->sleep_timer, PIT::now_ns() + ns, sleep_expired, current_process());
   // The schedule() call will switch away from us.
 }
 
+void wait_on(WaitQueue& wq) {
+  if (current_process() == idle_process()) {
+    return;
+  }
+  current_process()->wait_queue = &wq;
+}
+
+void wait_on_until(WaitQueue& wq, uint64_t deadline_ns) {
+  if (current_process() == idle_process()) {
+    return;
+  }
+  current_process()->wait_queue = &wq;
+  add_timer(&current_process()->sleep_timer, deadline_ns, wait_expired, current_process());
+}
+
+void cancel_wait() {
+  current_process()->wait_queue = nullptr;
+  cancel_timer(&current_process()->sleep_timer);
+}
+
 void block_current() {
-  assert(current_process != idle_process && "block_current(): cannot block idle process");
+  assert(current_process() != idle_process() && "block_current(): cannot block idle process");
+
+  WaitQueue* wq = current_process()->wait_queue;
+  assert(wq != nullptr && "block_current(): kSyscallRestart without a prior wait_on()");
+
+  // Let check_pending_signals() deliver the signal first; the rewound
+  // syscall re-executes (and parks again) once the handler returns.
+  if (current_process()->pending_signals != 0) {
+    cancel_wait();
+    return;
+  }
+
+  current_process()->state = ProcessState::Blocked;
+  wq->push(current_process());
+}
+
+void wake_all(WaitQueue& wq) {
+  if (wq.empty()) {
+    return;
+  }
+  while (Process* p = wq.pop()) {
+    p->wait_queue = nullptr;
+    if (p->state == ProcessState::Blocked) {
+      make_ready(p);
+    }
+  }
+  // The running process may have been alone with no slice deadline armed.
+  if (started) {
+    rearm_timer();
+  }
+}
 
-  // TODO: This creates a 100 Hz polling loop (block, wake, retry syscall,
-  // block again). A proper wait queue on the pipe/resource would be more
-  // efficient, waking the process only when data is available.
-  current_process->wake_tick = 0;
-  enqueue_blocked(current_process);
+uint32_t preempt_idle(uint32_t esp) {
+  const RunQueue& rq = this_rq();
+  if (!started || rq.current != rq.idle || rq.head == nullptr) {
+    return esp;
+  }
+  return schedule(esp);
 }
 
 uint32_t alloc_user_stack(PageTable* pd, std::span<const char*> argv, std::span<const char*> envp) {
@@ -404,24 +889,30 @@ Process* create_process(std::span<const uint8_t> elf_data, const char* name) {
     name = "";
   }
 
-  Process* p = alloc_process();
+  Process* p = ProcessTable::alloc();
   if (p == nullptr) {
     printf("Scheduler: failed to allocate process\n");
     return nullptr;
   }
 
-  fd_init_stdio(p->fds);
+  if (!p->fds.init_stdio()) {
+    printf("Scheduler: failed to allocate fd table\n");
+    ProcessTable::free(p);
+    return nullptr;
+  }
+  set_name(p, name);
 
   auto [pd_phys, pd_virt] = AddressSpace::create();
   p->page_directory_phys = pd_phys;
   p->page_directory = pd_virt;
+  Vdso::map(pd_virt);
 
   vaddr_t entry = 0;
   vaddr_t brk = 0;
   if (!Elf::load(elf_data, pd_virt, entry, brk)) {
     printf("Scheduler: failed to load ELF for process %u\n", p->pid);
     AddressSpace::destroy(pd_virt, pd_phys);
-    p->state = ProcessState::Zombie;
+    ProcessTable::free(p);
     return nullptr;
   }
   p->heap_break = brk;
@@ -443,7 +934,7 @@ Process* create_process(std::span<const uint8_t> elf_data, const char* name) {
 
   p->kernel_esp = reinterpret_cast<uint32_t>(frame);
 
-  enqueue_ready(p);
+  make_ready(p);
 
   printf("Scheduler: created process %u from ELF (entry=0x%08x)\n", p->pid,
          static_cast<unsigned>(entry));
@@ -451,33 +942,35 @@ Process* create_process(std::span<const uint8_t> elf_data, const char* name) {
 }
 
 uint32_t fork_current(const TrapFrame* parent_regs) {
-  assert(current_process != idle_process && "fork_current(): cannot fork idle process");
+  assert(current_process() != idle_process() && "fork_current(): cannot fork idle process");
 
-  Process* child = alloc_process();
+  Process* child = ProcessTable::alloc();
   if (child == nullptr) {
     return static_cast<uint32_t>(-1);
   }
 
-  auto [child_pd_phys, child_pd] = AddressSpace::copy(current_process->page_directory);
-  child->page_directory_phys = child_pd_phys;
-  child->page_directory = child_pd;
-  child->heap_break = current_process->heap_break;
-  child->parent_pid = current_process->pid;
+  // Only the calling thread is duplicated; the child's shared state comes
+  // from the group, and its parent is the group leader.
+  Process* const parent = current_process()->group();
 
   // Inherit the parent's file descriptor table and per-fd flags.
-  child->fds = current_process->fds;
-  child->fd_flags = current_process->fd_flags;
-  for (auto* fd : child->fds) {
-    if (fd != nullptr) {
-      fd->ref();
-    }
+  if (!child->fds.copy_from(parent->fds)) {
+    ProcessTable::free(child);
+    return static_cast<uint32_t>(-1);
   }
 
+  auto [child_pd_phys, child_pd] = AddressSpace::copy(parent->page_directory);
+  child->page_directory_phys = child_pd_phys;
+  child->page_directory = child_pd;
+  child->heap_break = parent->heap_break;
+  memcpy(child->name, parent->name, sizeof(child->name));
+  ProcessTable::add_child(parent, child);
+
   // Re-map shared memory in the child. AddressSpace::copy() deep-copied all user pages,
   // but shared memory pages should reference the same physical frames.
   // Unmap the spurious copies and re-map the originals.
-  for (uint32_t i = 0; i < current_process->shm_mapping_count; ++i) {
-    const ShmMapping& m = current_process->shm_mappings[i];
+  for (uint32_t i = 0; i < parent->shm_mapping_count; ++i) {
+    const ShmMapping& m = parent->shm_mappings[i];
     ShmRegion* region = Shm::find_region(m.shm_id);
     if (region == nullptr) {
       continue;
@@ -494,13 +987,17 @@ uint32_t fork_current(const TrapFrame* parent_regs) {
   }
 
   // Inherit signal handlers; child starts with no pending signals.
-  memcpy(child->signal_handlers, current_process->signal_handlers, sizeof(child->signal_handlers));
+  memcpy(child->signal_handlers, parent->signal_handlers, sizeof(child->signal_handlers));
   child->pending_signals = 0;
 
+  Fpu::copy_state(current_process(), child);
+  child->tls_base = current_process()->tls_base;
+
   // Inherit working directory and credentials.
-  memcpy(child->cwd, current_process->cwd, sizeof(child->cwd));
-  child->uid = current_process->uid;
-  child->gid = current_process->gid;
+  child->cwd = parent->cwd;
+  Vfs::node_get(child->cwd);
+  child->uid = parent->uid;
+  child->gid = parent->gid;
 
   child->kernel_stack = reinterpret_cast<uint8_t*>(kmalloc(kKernelStackSize));
   assert(child->kernel_stack && "fork_current(): failed to allocate kernel stack");
@@ -517,36 +1014,69 @@ uint32_t fork_current(const TrapFrame* parent_regs) {
 
   child->kernel_esp = reinterpret_cast<uint32_t>(child_frame);
 
-  enqueue_ready(child);
+  make_ready(child);
 
-  printf("Scheduler: forked process %u -> child %u\n", current_process->pid, child->pid);
+  printf("Scheduler: forked process %u -> child %u\n", current_process()->pid, child->pid);
   return child->pid;
 }
 
+int32_t clone_current(const TrapFrame* regs, uint32_t user_esp, vaddr_t tls, vaddr_t clear_tid) {
+  assert(current_process() != idle_process() && "clone_current(): cannot clone idle process");
+
+  Process* thread = ProcessTable::alloc();
+  if (thread == nullptr) {
+    return -EAGAIN;
+  }
+
+  Process* const leader = current_process()->group();
+  thread->group_leader = leader;
+  ++leader->thread_count;
+  thread->page_directory_phys = leader->page_directory_phys;
+  thread->page_directory = leader->page_directory;
+  memcpy(thread->name, leader->name, sizeof(thread->name));
+  thread->clear_tid = clear_tid;
+  thread->tls_base = tls;
+  Fpu::copy_state(current_process(), thread);
+
+  thread->kernel_stack = reinterpret_cast<uint8_t*>(kmalloc(kKernelStackSize));
+  assert(thread->kernel_stack && "clone_current(): failed to allocate kernel stack");
+  memset(thread->kernel_stack, 0, kKernelStackSize);
+
+  // The thread resumes from the same syscall as its creator, returning 0 on
+  // its own stack. switch_to() retargets %gs to its CPU's TLS segment.
+  auto* kstack_top = reinterpret_cast<uint32_t*>(thread->kernel_stack + kKernelStackSize);
+  auto* frame =
+      reinterpret_cast<TrapFrame*>(reinterpret_cast<uintptr_t>(kstack_top) - sizeof(TrapFrame));
+  *frame = *regs;
+  frame->eax = 0;
+  frame->user_esp = user_esp;
+  if (tls != 0) {
+    frame->gs = GDT::tls_selector(0);
+  }
+  thread->kernel_esp = reinterpret_cast<uint32_t>(frame);
+
+  make_ready(thread);
+  return static_cast<int32_t>(thread->pid);
+}
+
 int32_t waitpid_current(int32_t pid, int32_t* exit_code_ptr) {
-  assert(current_process != idle_process && "waitpid_current(): cannot wait on idle process");
+  assert(current_process() != idle_process() && "waitpid_current(): cannot wait on idle process");
 
+  Process* const self = current_process()->group();
   bool found_child = false;
 
-  for (uint32_t i = 1; i < next_pid; ++i) {
-    Process& child = process_table[i];
-    if (child.parent_pid != current_process->pid) {
-      continue;
-    }
+  for (Process* child = self->first_child; child != nullptr;
+       child = child->next_sibling) {
     // When waiting for a specific pid, skip non-matching children.
-    if (pid > 0 && std::cmp_not_equal(child.pid, pid)) {
+    if (pid > 0 && std::cmp_not_equal(child->pid, pid)) {
       continue;
     }
-    if (child.state == ProcessState::Zombie) {
+    if (group_dead(child)) {
       if (exit_code_ptr != nullptr) {
-        *exit_code_ptr = child.exit_code;
-      }
-      const uint32_t child_pid = child.pid;
-      // Free the kernel stack before clearing the slot.
-      if (child.kernel_stack != nullptr) {
-        kfree(child.kernel_stack);
+        *exit_code_ptr = child->exit_code;
       }
-      child = Process{};
+      const uint32_t child_pid = child->pid;
+      destroy_process(child);
       return static_cast<int32_t>(child_pid);
     }
     // Child exists but is not a zombie yet.
@@ -557,57 +1087,113 @@ int32_t waitpid_current(int32_t pid, int32_t* exit_code_ptr) {
     return -ECHILD;
   }
 
-  // Child exists but hasn't exited; signal syscall_dispatch to block and retry.
+  // Child exists but hasn't exited; sleep until exit_current() wakes us.
+  wait_on(self->child_exit_waiters);
   return kSyscallRestart;
 }
 
-Process* current() { return current_process; }
+void set_name(Process* p, const char* path) {
+  const char* base = strrchr(path, '/');
+  base = base != nullptr ? base + 1 : path;
+  strncpy(p->name, base, kProcessNameLen - 1);
+  p->name[kProcessNameLen - 1] = '\0';
+}
 
-void send_signal(uint32_t pid, uint32_t signum) {
-  if (signum == 0 || signum >= 32) {
+void account_syscall_entry() {
+  if (!started) {
     return;
   }
-  for (uint32_t i = 0; i < next_pid; ++i) {
-    Process& p = process_table[i];
-    if (p.pid != pid || p.state == ProcessState::Zombie) {
-      continue;
+  RunQueue& rq = this_rq();
+  account(rq, /*user=*/true);
+  rq.in_syscall = true;
+}
+
+static_assert(SCHEDSTAT_MAX_CPUS == Smp::kMaxCpus, "sched_stat::idle_ns must cover every CPU");
+
+uint32_t get_stats(sched_stat* stat, std::span<proc_stat> procs) {
+  memset(stat, 0, sizeof(*stat));
+  stat->uptime_ns = PIT::now_ns();
+  stat->cpu_count = Smp::cpu_count();
+  for (uint32_t cpu = 0; cpu < stat->cpu_count; ++cpu) {
+    stat->idle_ns[cpu] = run_queues[cpu].idle_ns;
+  }
+  for (size_t i = 0; i < load_avg.size(); ++i) {
+    stat->loadavg[i] = load_avg[i];
+  }
+  stat->nr_running = active_processes();
+  stat->nr_procs = ProcessTable::count() - 1;  // not counting the idle process
+
+  uint32_t n = 0;
+  for (const Process* p = ProcessTable::head(); p != nullptr && n < procs.size();
+       p = p->table_next) {
+    if (p->pid == 0) {
+      continue;  // the idle process is reported as idle_ns
     }
-    p.pending_signals |= (1U << signum);
-    // Wake a blocked process so it can have the signal delivered.
-    if (p.state == ProcessState::Blocked) {
-      Process* prev = nullptr;
-      Process* cur = blocked_head;
-      while (cur != nullptr) {
-        if (cur == &p) {
-          if (prev != nullptr) {
-            prev->next = cur->next;
-          } else {
-            blocked_head = cur->next;
-          }
-          enqueue_ready(cur);
-          break;
-        }
-        prev = cur;
-        cur = cur->next;
-      }
+    proc_stat& out = procs[n++];
+    memset(&out, 0, sizeof(out));
+    out.pid = p->pid;
+    out.ppid = p->parent != nullptr ? p->parent->pid : 0;
+    memcpy(out.name, p->name, sizeof(out.name));
+    switch (p->state) {
+      case ProcessState::Running:
+        out.state = PROC_STATE_RUNNING;
+        break;
+      case ProcessState::Ready:
+        out.state = PROC_STATE_READY;
+        break;
+      case ProcessState::Blocked:
+        out.state = PROC_STATE_BLOCKED;
+        break;
+      default:
+        out.state = PROC_STATE_ZOMBIE;
+        break;
     }
+    out.kernel_thread = p->kernel_thread ? 1 : 0;
+    out.cpu = p->cpu;
+    out.user_ns = p->user_ns;
+    out.system_ns = p->system_ns;
+    out.wait_ns = p->wait_ns;
+    out.voluntary_switches = p->voluntary_switches;
+    out.involuntary_switches = p->involuntary_switches;
+  }
+  return n;
+}
+
+Process* current() { return current_process(); }
+
+void send_signal(uint32_t pid, uint32_t signum) {
+  if (signum == 0 || signum >= 32) {
+    return;
+  }
+  Process* p = ProcessTable::find(pid);
+  if (p == nullptr || p->state == ProcessState::Zombie || p->kernel_thread) {
     return;
   }
+  p->pending_signals |= (1U << signum);
+  // Wake a blocked process so it can have the signal delivered.
+  if (p->state == ProcessState::Blocked) {
+    unlink_blocked(p);
+    make_ready(p);
+    if (started) {
+      rearm_timer();
+    }
+  } else if (p->state == ProcessState::Running) {
+    // Running on another CPU: interrupt it so the signal is delivered now.
+    Smp::send_reschedule(p->cpu);
+  }
 }
 
 void broadcast_signal(uint32_t signum) {
-  for (uint32_t i = 1; i < next_pid; ++i) {  // skip idle (pid 0)
-    const Process& p = process_table[i];
-    if (p.state != ProcessState::Zombie && p.state != ProcessState::Empty) {
-      send_signal(p.pid, signum);  // NOLINT(readability-magic-numbers)
+  for (const Process* p = ProcessTable::head(); p != nullptr; p = p->table_next) {
+    if (p->pid != 0 && p->state != ProcessState::Zombie && !p->kernel_thread) {
+      send_signal(p->pid, signum);  // NOLINT(readability-magic-numbers)
     }
   }
 }
 
 bool has_user_processes() {
-  for (uint32_t i = 1; i < next_pid; ++i) {  // skip idle (pid 0)
-    const auto s = process_table[i].state;
-    if (s != ProcessState::Zombie && s != ProcessState::Empty) {
+  for (const Process* p = ProcessTable::head(); p != nullptr; p = p->table_next) {
+    if (p->pid != 0 && p->state != ProcessState::Zombie && !p->kernel_thread) {
       return true;
     }
   }
@@ -656,8 +1242,8 @@ static void deliver_to_user_handler(TrapFrame* frame, uint32_t sig, uint32_t han
 }
 
 void check_pending_signals(TrapFrame* frame) {
-  Process* proc = current_process;
-  if (proc == idle_process || proc->pending_signals == 0) {
+  Process* proc = current_process();
+  if (proc == idle_process() || proc->pending_signals == 0) {
     return;
   }
   // Only deliver signals when returning to user mode.
@@ -671,11 +1257,11 @@ void check_pending_signals(TrapFrame* frame) {
     }
     proc->pending_signals &= ~(1U << sig);
 
-    const uint32_t handler = proc->signal_handlers[sig];
-    if (handler == kSigIgn) {
+    const uint32_t handler = proc->group()->signal_handlers[sig];
+    if (handler == kSigIgn && sig != SIGKILL) {
       continue;
     }
-    if (handler == kSigDfl) {
+    if (handler == kSigDfl || sig == SIGKILL) {
       // Default action: terminate the process.
       exit_current(sig);
       return;
@@ -686,14 +1272,22 @@ void check_pending_signals(TrapFrame* frame) {
   }
 }
 
-bool is_vfs_node_open(const VfsNode* node) {
-  for (uint32_t i = 0; i < kMaxProcesses; ++i) {
-    if (process_table[i].state == ProcessState::Empty) {
-      continue;
+bool group_running_elsewhere(const Process* leader) {
+  const uint32_t self = Smp::current_cpu();
+  for (uint32_t cpu = 0; cpu < Smp::cpu_count(); ++cpu) {
+    const Process* running = run_queues[cpu].current;
+    if (cpu != self && running != nullptr && running->group() == leader) {
+      return true;
     }
-    for (uint32_t j = 0; j < kMaxFds; ++j) {
-      const FileDescription* fd = process_table[i].fds[j];
-      if (fd == nullptr || fd->type != FileType::VfsNode || fd->vfs == nullptr) {
+  }
+  return false;
+}
+
+bool is_vfs_node_open(const VfsNode* node) {
+  for (const Process* p = ProcessTable::head(); p != nullptr; p = p->table_next) {
+    for (auto j = p->fds.next_open(0); j; j = p->fds.next_open(*j + 1)) {
+      const FileDescription* fd = p->fds[*j];
+      if (fd->type != FileType::VfsNode || fd->vfs == nullptr) {
         continue;
       }
       if (fd->vfs->node == node) {
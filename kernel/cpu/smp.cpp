@@ -0,0 +1,418 @@
+#include "smp.h"
+
+#include <array.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "address_space.h"
+#include "apic.h"
+#include "fpu.h"
+#include "gdt.h"
+#include "heap.h"
+#include "idt.h"
+#include "interrupt.h"
+#include "pit.h"
+#include "process.h"
+#include "scheduler.h"
+#include "syscall.h"
+#include "tss.h"
+#include "vmm.h"
+
+__BEGIN_DECLS
+
+// Defined in ap_trampoline.S. The cr3/stack slots are patched in the copy
+// at kTrampolinePhys, not in the kernel image.
+extern char ap_trampoline_start[];
+extern char ap_trampoline_end[];
+extern char ap_trampoline_cr3[];
+extern char ap_trampoline_stack[];
+
+// Assembly entry points defined in trap_entry.S.
+void lapic_timer_entry();
+void reschedule_entry();
+
+__END_DECLS
+
+// =============================================================================
+// MP specification tables (Intel MultiProcessor Specification v1.4, ch. 4)
+// =============================================================================
+
+struct MpFloatingPointer {
+  char signature[4];      // "_MP_"
+  uint32_t config_table;  // physical address of the MP configuration table
+  uint8_t length;         // in 16-byte units (1)
+  uint8_t spec_rev;
+  uint8_t checksum;
+  uint8_t features[5];
+} __attribute__((packed));
+
+static_assert(sizeof(MpFloatingPointer) == 16, "MP floating pointer must be 16 bytes");
+
+struct MpConfigHeader {
+  char signature[4];  // "PCMP"
+  uint16_t length;    // base table length including this header
+  uint8_t spec_rev;
+  uint8_t checksum;
+  char oem_id[8];
+  char product_id[12];
+  uint32_t oem_table;
+  uint16_t oem_table_size;
+  uint16_t entry_count;
+  uint32_t lapic_addr;
+  uint16_t ext_length;
+  uint8_t ext_checksum;
+  uint8_t reserved;
+} __attribute__((packed));
+
+static_assert(sizeof(MpConfigHeader) == 44, "MP config header must be 44 bytes");
+
+struct MpProcessorEntry {
+  uint8_t type;  // kMpEntryProcessor
+  uint8_t apic_id;
+  uint8_t apic_version;
+  uint8_t flags;  // bit 0: enabled, bit 1: bootstrap processor
+  uint32_t signature;
+  uint32_t features;
+  uint32_t reserved[2];
+} __attribute__((packed));
+
+static_assert(sizeof(MpProcessorEntry) == 20, "MP processor entry must be 20 bytes");
+
+static constexpr uint8_t kMpEntryProcessor = 0;
+static constexpr uint32_t kMpOtherEntrySize = 8;  // bus, I/O APIC, interrupt entries
+static constexpr uint8_t kMpProcessorEnabled = 1U << 0;
+
+// BIOS data area words locating the EBDA and the top of base memory.
+static constexpr paddr_t kBdaEbdaSegment{0x40E};
+static constexpr paddr_t kBdaBaseMemoryKb{0x413};
+static constexpr uint32_t kBiosRomStart = 0xF0000;
+static constexpr uint32_t kBiosRomSize = 0x10000;
+static constexpr uint32_t kLowMemoryEnd = 0x100000;
+
+// INIT-SIPI-SIPI timing (MP spec §B.4).
+static constexpr uint64_t kInitDelayNs = 10'000'000;
+static constexpr uint64_t kStartupDelayNs = 200'000;
+static constexpr uint64_t kApTimeoutNs = 100'000'000;
+
+namespace {
+
+struct Cpu {
+  uint8_t apic_id;
+  bool online;  // set by the AP at the end of ap_main()'s setup
+};
+
+std::array<Cpu, Smp::kMaxCpus> cpus;
+uint32_t cpus_online = 1;
+uint32_t booting_cpu = 0;  // index handed to the AP being started
+std::array<uint8_t, 256> cpu_index_by_apic_id;
+
+// Big kernel lock: owning CPU index + 1, or 0 when free.
+uint32_t lock_owner = 0;
+uint32_t lock_depth = 0;
+
+// Pending TLB shootdown, published by tlb_shootdown() under the kernel lock.
+uint32_t shootdown_addr = 0;
+uint32_t shootdown_acks_pending = 0;
+std::array<bool, Smp::kMaxCpus> shootdown_requested;
+
+bool checksum_ok(const void* data, uint32_t len) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  uint8_t sum = 0;
+  for (uint32_t i = 0; i < len; ++i) {
+    sum = static_cast<uint8_t>(sum + bytes[i]);
+  }
+  return sum == 0;
+}
+
+// Search [phys, phys + len) on 16-byte boundaries for the MP floating pointer.
+const MpFloatingPointer* scan_mp(uint32_t phys, uint32_t len) {
+  const auto* base = phys_to_virt(paddr_t{phys}).ptr<const uint8_t>();
+  for (uint32_t off = 0; off + sizeof(MpFloatingPointer) <= len; off += 16) {
+    const auto* mp = reinterpret_cast<const MpFloatingPointer*>(base + off);
+    if (memcmp(mp->signature, "_MP_", 4) == 0 && checksum_ok(mp, sizeof(*mp))) {
+      return mp;
+    }
+  }
+  return nullptr;
+}
+
+// The MP spec places the floating pointer in the first KiB of the EBDA, the
+// last KiB of base memory, or the BIOS ROM.
+const MpFloatingPointer* find_mp() {
+  const uint32_t ebda = static_cast<uint32_t>(*phys_to_virt(kBdaEbdaSegment).ptr<uint16_t>()) << 4;
+  if (ebda != 0) {
+    if (const auto* mp = scan_mp(ebda, 1024)) {
+      return mp;
+    }
+  }
+  const uint32_t base_kb = *phys_to_virt(kBdaBaseMemoryKb).ptr<uint16_t>();
+  if (base_kb != 0) {
+    if (const auto* mp = scan_mp((base_kb - 1) * 1024, 1024)) {
+      return mp;
+    }
+  }
+  return scan_mp(kBiosRomStart, kBiosRomSize);
+}
+
+// Collect the APIC IDs of enabled processors other than the BSP.
+// Returns the number written to `ids`.
+uint32_t find_aps(std::array<uint8_t, Smp::kMaxCpus>& ids, uint8_t bsp_id) {
+  const MpFloatingPointer* mp = find_mp();
+  if (mp == nullptr || mp->config_table == 0 || mp->config_table >= kLowMemoryEnd) {
+    return 0;
+  }
+  const auto* header = phys_to_virt(paddr_t{mp->config_table}).ptr<const MpConfigHeader>();
+  if (memcmp(header->signature, "PCMP", 4) != 0 || !checksum_ok(header, header->length)) {
+    return 0;
+  }
+
+  uint32_t count = 0;
+  const auto* entry = reinterpret_cast<const uint8_t*>(header + 1);
+  for (uint16_t i = 0; i < header->entry_count; ++i) {
+    if (*entry != kMpEntryProcessor) {
+      entry += kMpOtherEntrySize;
+      continue;
+    }
+    const auto* cpu = reinterpret_cast<const MpProcessorEntry*>(entry);
+    entry += sizeof(MpProcessorEntry);
+    if ((cpu->flags & kMpProcessorEnabled) == 0U || cpu->apic_id == bsp_id) {
+      continue;
+    }
+    // The BSP occupies one slot.
+    if (count + 1 >= Smp::kMaxCpus) {
+      break;
+    }
+    ids[count++] = cpu->apic_id;
+  }
+  return count;
+}
+
+void delay_ns(uint64_t ns) {
+  const uint64_t start = PIT::now_ns();
+  while (PIT::now_ns() - start < ns) {
+    __asm__ volatile("pause");
+  }
+}
+
+bool is_online(uint32_t index) { return __atomic_load_n(&cpus[index].online, __ATOMIC_ACQUIRE); }
+
+// Pointer to `symbol` inside the trampoline copy at kTrampolinePhys.
+template <typename T>
+T* trampoline_slot(char* symbol) {
+  return phys_to_virt(paddr_t{Smp::kTrampolinePhys})
+      .ptr_at<T>(static_cast<uintptr_t>(symbol - ap_trampoline_start));
+}
+
+// Start the AP with `apic_id` as the next CPU index. Returns false if it
+// did not come online in time.
+bool start_ap(uint8_t apic_id) {
+  const uint32_t index = cpus_online;
+  auto* stack = static_cast<uint8_t*>(kmalloc(kKernelStackSize));
+  if (stack == nullptr) {
+    return false;
+  }
+
+  cpus[index] = Cpu{.apic_id = apic_id, .online = false};
+  cpu_index_by_apic_id[apic_id] = static_cast<uint8_t>(index);
+  booting_cpu = index;
+  *trampoline_slot<uint32_t>(ap_trampoline_stack) =
+      reinterpret_cast<uint32_t>(stack) + kKernelStackSize;
+
+  LAPIC::send_init(apic_id);
+  delay_ns(kInitDelayNs);
+  for (int attempt = 0; attempt < 2 && !is_online(index); ++attempt) {
+    LAPIC::send_startup(apic_id, static_cast<uint8_t>(Smp::kTrampolinePhys / PAGE_SIZE));
+    delay_ns(kStartupDelayNs);
+  }
+
+  const uint64_t deadline = PIT::now_ns() + kApTimeoutNs;
+  while (!is_online(index) && PIT::now_ns() < deadline) {
+    __asm__ volatile("pause");
+  }
+  if (!is_online(index)) {
+    // The stack is leaked on purpose: a late AP may still be about to use it.
+    printf("SMP: CPU with APIC ID %u did not start\n", static_cast<unsigned>(apic_id));
+    return false;
+  }
+  ++cpus_online;
+  return true;
+}
+
+// Acknowledge a pending shootdown for the calling CPU, if any.
+void service_shootdown() {
+  const uint32_t self = Smp::current_cpu();
+  if (!__atomic_exchange_n(&shootdown_requested[self], false, __ATOMIC_ACQUIRE)) {
+    return;
+  }
+  const uint32_t addr = __atomic_load_n(&shootdown_addr, __ATOMIC_RELAXED);
+  if (addr == Smp::kFlushAll) {
+    VMM::flush_tlb();
+  } else {
+    __asm__ volatile("invlpg (%0)" ::"r"(addr) : "memory");
+  }
+  __atomic_fetch_sub(&shootdown_acks_pending, 1, __ATOMIC_RELEASE);
+}
+
+// TLB shootdown IPI. Runs without the kernel lock: the sender holds it
+// while waiting for every CPU's acknowledgement.
+__attribute__((interrupt)) void tlb_shootdown_handler(interrupt_frame* /*frame*/) {
+  service_shootdown();
+  LAPIC::eoi();
+}
+
+// Spurious APIC interrupts must not be acknowledged.
+__attribute__((interrupt)) void spurious_handler(interrupt_frame* /*frame*/) {}
+
+}  // namespace
+
+__BEGIN_DECLS
+
+// First C++ code run by an AP, on the stack set up by start_ap().
+__attribute__((noreturn)) void ap_main() {
+  const uint32_t index = booting_cpu;
+  GDT::load();
+  TSS::init_ap(index);
+  IDT::load();
+  LAPIC::init_ap();
+  Fpu::init_ap();
+  Syscall::init_ap(index);
+
+  const uint32_t stack_top = *trampoline_slot<uint32_t>(ap_trampoline_stack);
+  Scheduler::init_ap(index, reinterpret_cast<uint8_t*>(stack_top - kKernelStackSize));
+
+  __atomic_store_n(&cpus[index].online, true, __ATOMIC_RELEASE);
+
+  // Idle: wait for a reschedule IPI once work is queued on this CPU.
+  interrupt_enable();
+  while (true) {
+    __asm__ volatile("hlt");
+  }
+}
+
+// APIC timer (kTimerVector): the AP's time slice or deadline expired.
+uint32_t lapic_timer_dispatch(uint32_t esp) {
+  LAPIC::eoi();
+  Scheduler::check_pending_signals(reinterpret_cast<TrapFrame*>(esp));
+  return Scheduler::schedule(esp);
+}
+
+// Reschedule IPI: work was queued on this CPU, or a signal was sent to the
+// process running on it.
+uint32_t reschedule_dispatch(uint32_t esp) {
+  LAPIC::eoi();
+  Scheduler::check_pending_signals(reinterpret_cast<TrapFrame*>(esp));
+  return Scheduler::schedule(esp);
+}
+
+void kernel_lock() {
+  const uint32_t self = Smp::current_cpu() + 1;
+  if (__atomic_load_n(&lock_owner, __ATOMIC_RELAXED) == self) {
+    ++lock_depth;
+    return;
+  }
+  uint32_t expected = 0;
+  while (!__atomic_compare_exchange_n(&lock_owner, &expected, self, /*weak=*/false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    expected = 0;
+    service_shootdown();
+    __asm__ volatile("pause");
+  }
+  lock_depth = 1;
+}
+
+void kernel_unlock() {
+  assert(__atomic_load_n(&lock_owner, __ATOMIC_RELAXED) == Smp::current_cpu() + 1 &&
+         "kernel_unlock(): lock not held by this CPU");
+  if (--lock_depth == 0) {
+    __atomic_store_n(&lock_owner, 0, __ATOMIC_RELEASE);
+  }
+}
+
+__END_DECLS
+
+namespace Smp {
+
+void init() {
+  if (!LAPIC::init()) {
+    printf("SMP: no local APIC, running on 1 CPU\n");
+    return;
+  }
+
+  const uint8_t bsp_id = LAPIC::id();
+  cpus[0] = Cpu{.apic_id = bsp_id, .online = true};
+  cpu_index_by_apic_id[bsp_id] = 0;
+
+  IDT::set_entry(LAPIC::kTimerVector, reinterpret_cast<uintptr_t>(lapic_timer_entry),
+                 IDT::Gate::Interrupt, IDT::Ring::Kernel);
+  IDT::set_entry(LAPIC::kRescheduleVector, reinterpret_cast<uintptr_t>(reschedule_entry),
+                 IDT::Gate::Interrupt, IDT::Ring::Kernel);
+  IDT::set_entry(LAPIC::kTlbShootdownVector, reinterpret_cast<uintptr_t>(tlb_shootdown_handler),
+                 IDT::Gate::Interrupt, IDT::Ring::Kernel);
+  IDT::set_entry(LAPIC::kSpuriousVector, reinterpret_cast<uintptr_t>(spurious_handler),
+                 IDT::Gate::Interrupt, IDT::Ring::Kernel);
+
+  std::array<uint8_t, kMaxCpus> ap_ids{};
+  const uint32_t ap_count = find_aps(ap_ids, bsp_id);
+  if (ap_count == 0) {
+    printf("SMP: 1 CPU online\n");
+    return;
+  }
+
+  // The trampoline turns paging on while still executing from its low
+  // physical address, so identity-map the first 4 MiB for the duration.
+  const size_t tramp_size = static_cast<size_t>(ap_trampoline_end - ap_trampoline_start);
+  memcpy(phys_to_virt(paddr_t{kTrampolinePhys}).ptr<void>(), ap_trampoline_start, tramp_size);
+  *trampoline_slot<uint32_t>(ap_trampoline_cr3) =
+      virt_to_phys(vaddr_t{&boot_page_directory});
+  boot_page_directory.entry[0] = boot_page_directory.entry[AddressSpace::kKernelPdeStart];
+  VMM::flush_tlb();
+
+  for (uint32_t i = 0; i < ap_count; ++i) {
+    start_ap(ap_ids[i]);
+  }
+
+  boot_page_directory.entry[0] = PageEntry{};
+  VMM::flush_tlb();
+
+  printf("SMP: %u CPUs online\n", cpus_online);
+}
+
+uint32_t current_cpu() {
+  if (!LAPIC::is_enabled()) {
+    return 0;
+  }
+  return cpu_index_by_apic_id[LAPIC::id()];
+}
+
+uint32_t cpu_count() { return cpus_online; }
+
+void send_reschedule(uint32_t cpu) {
+  if (cpu == current_cpu() || cpu >= cpus_online) {
+    return;
+  }
+  LAPIC::send_ipi(cpus[cpu].apic_id, LAPIC::kRescheduleVector);
+}
+
+void tlb_shootdown(vaddr_t virt) {
+  const uint32_t online = cpus_online;
+  if (online <= 1) {
+    return;
+  }
+  const uint32_t self = current_cpu();
+
+  __atomic_store_n(&shootdown_addr, static_cast<uint32_t>(virt), __ATOMIC_RELAXED);
+  __atomic_store_n(&shootdown_acks_pending, online - 1, __ATOMIC_RELAXED);
+  for (uint32_t cpu = 0; cpu < online; ++cpu) {
+    if (cpu == self) {
+      continue;
+    }
+    __atomic_store_n(&shootdown_requested[cpu], true, __ATOMIC_RELEASE);
+    LAPIC::send_ipi(cpus[cpu].apic_id, LAPIC::kTlbShootdownVector);
+  }
+  while (__atomic_load_n(&shootdown_acks_pending, __ATOMIC_ACQUIRE) != 0) {
+    __asm__ volatile("pause");
+  }
+}
+
+}  // namespace Smp
@@ -0,0 +1,73 @@
+#include "spinlock.h"
+
+#include <assert.h>
+
+#include "x86.h"
+
+static constexpr uint32_t EFLAGS_IF = 1U << 9;
+
+namespace {
+
+uint32_t save_and_disable_interrupts() {
+  uint32_t eflags;
+  __asm__ volatile(
+      "pushfl\n"
+      "popl %0\n"
+      "cli\n"
+      : "=r"(eflags)
+      :
+      : "memory");
+  return eflags;
+}
+
+void restore_interrupts(uint32_t eflags) {
+  if ((eflags & EFLAGS_IF) != 0U) {
+    __asm__ volatile("sti" ::: "memory");
+  }
+}
+
+}  // namespace
+
+void SpinLock::lock() {
+  const uint32_t eflags = save_and_disable_interrupts();
+  const uint32_t ticket = __atomic_fetch_add(&next_ticket_, 1, __ATOMIC_RELAXED);
+
+  if (__atomic_load_n(&now_serving_, __ATOMIC_ACQUIRE) != ticket) {
+    const uint64_t start = rdtsc();
+    while (__atomic_load_n(&now_serving_, __ATOMIC_ACQUIRE) != ticket) {
+      __asm__ volatile("pause");
+    }
+    stats_.record_contention(rdtsc() - start);
+  }
+
+  saved_eflags_ = eflags;
+  acquired_at_ = rdtsc();
+  stats_.record_acquire();
+}
+
+bool SpinLock::try_lock() {
+  const uint32_t eflags = save_and_disable_interrupts();
+  uint32_t ticket = __atomic_load_n(&now_serving_, __ATOMIC_ACQUIRE);
+  if (!__atomic_compare_exchange_n(&next_ticket_, &ticket, ticket + 1, /*weak=*/false,
+                                   __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    restore_interrupts(eflags);
+    return false;
+  }
+  saved_eflags_ = eflags;
+  acquired_at_ = rdtsc();
+  stats_.record_acquire();
+  return true;
+}
+
+void SpinLock::unlock() {
+  assert(is_locked() && "SpinLock::unlock(): lock not held");
+  stats_.record_release(rdtsc() - acquired_at_);
+  const uint32_t eflags = saved_eflags_;
+  __atomic_store_n(&now_serving_, now_serving_ + 1, __ATOMIC_RELEASE);
+  restore_interrupts(eflags);
+}
+
+bool SpinLock::is_locked() const {
+  return __atomic_load_n(&now_serving_, __ATOMIC_RELAXED) !=
+         __atomic_load_n(&next_ticket_, __ATOMIC_RELAXED);
+}
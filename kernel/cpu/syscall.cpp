@@ -4,30 +4,53 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <string.h>
+#include <sys/futex.h>
 #include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/ring.h>
+#include <sys/schedstat.h>
 #include <sys/stat.h>
+#include <sys/trace.h>
+#include <sys/uio.h>
 #include <termios.h>
+#include <time.h>
 #include <unique_ptr.h>
 
 #include "address_space.h"
 #include "elf.h"
 #include "file.h"
+#include "fpu.h"
 #include "framebuffer.h"
+#include "futex.h"
+#include "gdt.h"
 #include "idt.h"
 #include "interrupt.h"
 #include "paging.h"
 #include "pipe.h"
 #include "pit.h"
 #include "pmm.h"
+#include "poller.h"
+#include "ring.h"
 #include "scheduler.h"
 #include "shm.h"
+#include "trace.h"
 #include "tss.h"
+#include "uaccess.h"
+#include "vdso.h"
 #include "vfs.h"
+#include "x86.h"
 
 static constexpr uint32_t SYSCALL_VECTOR = 0x80;
 
+// SYSENTER MSRs (Intel SDM Vol. 3 §5.8.7.1).
+static constexpr uint32_t IA32_SYSENTER_CS = 0x174;
+static constexpr uint32_t IA32_SYSENTER_ESP = 0x175;
+static constexpr uint32_t IA32_SYSENTER_EIP = 0x176;
+static constexpr uint32_t CPUID_FEAT_EDX_SEP = 1U << 11;
+
 // ===========================================================================
 // Syscall handlers
 // ===========================================================================
@@ -35,6 +58,9 @@ static constexpr uint32_t SYSCALL_VECTOR = 0x80;
 // Validate that a user pointer range [ptr, ptr+len) is entirely below the
 // kernel virtual base and that every page in the range is present and
 // user-accessible. writeable additionally requires each PTE to have rw=1.
+// Only needed for buffers handed on to code that dereferences them without
+// an exception table entry (file backends, the ring); the handlers here
+// copy everything else with copy_from_user() / copy_to_user().
 static bool validate_user_buffer(uint32_t ptr, uint32_t len, bool writeable) {
   if (len == 0) {
     return true;
@@ -60,8 +86,8 @@ static int32_t sys_write(TrapFrame* regs) {
   const uint32_t buf = regs->ecx;
   const uint32_t count = regs->edx;
 
-  const Process* proc = Scheduler::current();
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
     return -EBADF;
   }
 
@@ -80,8 +106,8 @@ static int32_t sys_read(TrapFrame* regs) {
   const uint32_t buf = regs->ecx;
   const uint32_t count = regs->edx;
 
-  const Process* proc = Scheduler::current();
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
     return -EBADF;
   }
 
@@ -102,7 +128,7 @@ static int32_t sys_exit(TrapFrame* regs) {
 // SYS_SLEEP(ms=ebx)
 static int32_t sys_sleep(TrapFrame* regs) {
   const uint32_t ms = regs->ebx;
-  Scheduler::sleep_current(ms);
+  Scheduler::sleep_current(static_cast<uint64_t>(ms) * 1'000'000);
   return 0;
 }
 
@@ -110,7 +136,7 @@ static int32_t sys_sleep(TrapFrame* regs) {
 // Returns old break on success, or (uint32_t)-1 on failure.
 static int32_t sys_sbrk(TrapFrame* regs) {
   auto increment = static_cast<int32_t>(regs->ebx);
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
   const vaddr_t old_break = proc->heap_break;
 
@@ -153,9 +179,10 @@ static int32_t sys_sbrk(TrapFrame* regs) {
 }
 
 // SYS_GETPID()
-// Returns the PID of the calling process.
+// Returns the PID of the calling process: its initial thread's, in every
+// thread.
 static int32_t sys_getpid([[maybe_unused]] TrapFrame* regs) {
-  return static_cast<int32_t>(Scheduler::current()->pid);
+  return static_cast<int32_t>(Scheduler::current()->group()->pid);
 }
 
 // Resolves '.' and '..' components in an absolute path in-place.
@@ -223,18 +250,24 @@ static void canonicalize_path(char* path, size_t size) {
 // Resolve a user path to an absolute canonicalized path.
 // Returns 0 on success or negative errno on failure.
 static int32_t resolve_abs_path(uint32_t path_ptr, char* abs_path, size_t abs_len) {
-  if (!validate_user_buffer(path_ptr, 1, /*writeable=*/false)) {
-    return -EFAULT;
+  char upath[kMaxPathLen];
+  const int32_t len = strncpy_from_user(upath, path_ptr, sizeof(upath));
+  if (len < 0) {
+    return len;
   }
-  const char* upath = reinterpret_cast<const char*>(path_ptr);
   if (upath[0] != '/') {
-    const Process* proc = Scheduler::current();
-    const size_t cwd_len = strlen(proc->cwd);
-    const size_t path_len = strlen(upath);
+    const Process* proc = Scheduler::current()->group();
+    char cwd[kMaxPathLen];
+    const int32_t cwd_rc = Vfs::node_path(proc->cwd, cwd, sizeof(cwd));
+    if (cwd_rc < 0) {
+      return cwd_rc == -ERANGE ? -ENAMETOOLONG : cwd_rc;
+    }
+    const auto cwd_len = static_cast<size_t>(cwd_rc);
+    const auto path_len = static_cast<size_t>(len);
     if (cwd_len + 1 + path_len + 1 > abs_len) {
       return -ENAMETOOLONG;
     }
-    memcpy(abs_path, proc->cwd, cwd_len);
+    memcpy(abs_path, cwd, cwd_len);
     if (abs_path[cwd_len - 1] != '/') {
       abs_path[cwd_len] = '/';
       memcpy(abs_path + cwd_len + 1, upath, path_len + 1);
@@ -249,47 +282,92 @@ static int32_t resolve_abs_path(uint32_t path_ptr, char* abs_path, size_t abs_le
   return 0;
 }
 
-// SYS_OPEN(path=ebx)
-// Opens a file by path. Returns fd on success, or negative errno on failure.
-// Supports relative paths by prepending the process CWD.
-static int32_t sys_open(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
+// Copy the user path at path_ptr into path (kMaxPathLen bytes) and find
+// the directory a relative path starts from: the working directory for
+// AT_FDCWD (nullptr: the root), otherwise the directory open on dirfd. An
+// absolute path ignores dirfd. The walk then starts at that node instead
+// of joining the path to a string and walking down from the root.
+// Returns 0, -ENOENT for an empty path, -EBADF, -ENOTDIR or -EFAULT.
+static int32_t user_path_at(int32_t dirfd, uint32_t path_ptr, char* path, VfsNode** base) {
+  const int32_t len = strncpy_from_user(path, path_ptr, kMaxPathLen);
+  if (len < 0) {
+    return len;
+  }
+  if (len == 0) {
+    return -ENOENT;
+  }
+  *base = nullptr;
+  if (path[0] == '/') {
+    return 0;
+  }
 
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
+  const Process* proc = Scheduler::current()->group();
+  if (dirfd == AT_FDCWD) {
+    *base = proc->cwd;
+    return 0;
+  }
+  const auto fd_num = static_cast<uint32_t>(dirfd);
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
+  }
+  const FileDescription* fd = proc->fds[fd_num];
+  if (fd->type != FileType::VfsNode || fd->vfs == nullptr || fd->vfs->node == nullptr ||
+      fd->vfs->node->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
+  }
+  *base = fd->vfs->node;
+  return 0;
+}
+
+static int32_t do_openat(int32_t dirfd, uint32_t path_ptr, int32_t flags, uint32_t mode) {
+  char path[kMaxPathLen];
+  VfsNode* base = nullptr;
+  const int32_t rc = user_path_at(dirfd, path_ptr, path, &base);
   if (rc < 0) {
     return rc;
   }
+  return Vfs::open_at(base, path, flags, (flags & O_CREAT) != 0 ? static_cast<mode_t>(mode) : 0);
+}
 
-  const auto flags = static_cast<int32_t>(regs->ecx);
-  const mode_t mode = (flags & O_CREAT) != 0 ? static_cast<mode_t>(regs->edx) : 0;
-  return Vfs::open(abs_path, flags, mode);
+// SYS_OPEN(path=ebx, flags=ecx, mode=edx)
+// Opens a file by path. Returns fd on success, or negative errno on failure.
+// Relative paths start at the process CWD.
+static int32_t sys_open(TrapFrame* regs) {
+  return do_openat(AT_FDCWD, regs->ebx, static_cast<int32_t>(regs->ecx), regs->edx);
+}
+
+// SYS_OPENAT(dirfd=ebx, path=ecx, flags=edx, mode=edi)
+// open() with a relative path starting at the directory open on dirfd.
+// Opening a directory with O_DIRECTORY gives such a dirfd.
+static int32_t sys_openat(TrapFrame* regs) {
+  return do_openat(static_cast<int32_t>(regs->ebx), regs->ecx, static_cast<int32_t>(regs->edx),
+                   regs->edi);
 }
 
 // SYS_CHDIR(path=ebx)
-// Changes the calling process's current working directory.
+// Changes the calling process's current working directory. The cwd holds
+// a reference to the directory node, so relative lookups start there.
 // Returns 0 on success, or negative errno on error.
 static int32_t sys_chdir(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
-
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
+  char path[kMaxPathLen];
+  VfsNode* base = nullptr;
+  const int32_t rc = user_path_at(AT_FDCWD, regs->ebx, path, &base);
   if (rc < 0) {
     return rc;
   }
 
-  const size_t len = strlen(abs_path);
-  if (len > 1 && abs_path[len - 1] == '/') {
-    abs_path[len - 1] = '\0';
-  }
-
-  if (!Vfs::is_directory(abs_path)) {
+  VfsNode* node = Vfs::lookup_at(base, path);
+  if (node == nullptr) {
     return -ENOENT;
   }
+  if (node->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
+  }
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, abs_path, sizeof(proc->cwd) - 1);
-  proc->cwd[sizeof(proc->cwd) - 1] = '\0';
+  Process* proc = Scheduler::current()->group();
+  Vfs::node_get(node);
+  Vfs::node_put(proc->cwd);
+  proc->cwd = node;
   return 0;
 }
 
@@ -303,41 +381,46 @@ static int32_t sys_getcwd(TrapFrame* regs) {
   if (size == 0) {
     return -EINVAL;
   }
-  if (!validate_user_buffer(buf_ptr, size, /*writeable=*/true)) {
-    return -EFAULT;
-  }
 
-  const Process* proc = Scheduler::current();
-  const size_t cwd_len = strlen(proc->cwd) + 1;
-  if (cwd_len > size) {
+  const Process* proc = Scheduler::current()->group();
+  char cwd[kMaxPathLen];
+  const int32_t len = Vfs::node_path(proc->cwd, cwd, sizeof(cwd));
+  if (len < 0) {
+    return len;
+  }
+  if (static_cast<uint32_t>(len) + 1 > size) {
     return -ERANGE;
   }
-  memcpy(reinterpret_cast<char*>(buf_ptr), proc->cwd, cwd_len);
-  return 0;
+  return copy_to_user(buf_ptr, cwd, static_cast<size_t>(len) + 1);
 }
 
-// SYS_GETDENTS(path=ebx, buf=ecx, count=edx)
-// Fills buf with up to count dirent entries for the given directory path.
-// Returns the number of entries written, or negative errno on error.
+// SYS_GETDENTS(fd=ebx, buf=ecx, count=edx, flags=edi)
+// Fills buf with up to count dirent entries of the directory open on fd,
+// resuming where the last call on that description stopped; lseek(fd, 0,
+// SEEK_SET) starts over. GETDENTS_ATTRS in flags also fills d_size and
+// d_mode. Returns the number of entries written (0 at the end), or
+// negative errno on error.
 static int32_t sys_getdents(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
+  const uint32_t fd_num = regs->ebx;
   const uint32_t buf_ptr = regs->ecx;
   const uint32_t count = regs->edx;
+  const uint32_t flags = regs->edi;
 
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
-  if (rc < 0) {
-    return rc;
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
   }
-  if (count == 0) {
-    return 0;
+  FileDescription* fd = proc->fds[fd_num];
+  if (fd->type != FileType::VfsNode) {
+    return -ENOTDIR;
   }
-  if (!validate_user_buffer(buf_ptr, count * sizeof(dirent), /*writeable=*/true)) {
+  if (count > UINT32_MAX / sizeof(dirent) ||
+      !validate_user_buffer(buf_ptr, count * sizeof(dirent), /*writeable=*/true)) {
     return -EFAULT;
   }
 
-  auto* entries = reinterpret_cast<dirent*>(buf_ptr);
-  return static_cast<int32_t>(Vfs::getdents(abs_path, entries, count));
+  const std::span<dirent> entries{reinterpret_cast<dirent*>(buf_ptr), count};
+  return Vfs::getdents(fd, entries, (flags & GETDENTS_ATTRS) != 0);
 }
 
 // SYS_EXEC(path=ebx, argv=ecx, envp=edx)
@@ -355,12 +438,12 @@ static int32_t sys_exec(TrapFrame* regs) {
   const uint32_t argv_ptr = regs->ecx;
   const uint32_t envp_ptr = regs->edx;
 
-  if (!validate_user_buffer(path_ptr, 1, /*writeable=*/false)) {
-    return -EFAULT;
+  char path[kMaxPathLen];
+  const int32_t path_len = strncpy_from_user(path, path_ptr, sizeof(path));
+  if (path_len < 0) {
+    return path_len;
   }
 
-  const char* path = reinterpret_cast<const char*>(path_ptr);
-
   // TODO: these buffers are static to avoid blowing the 16 KB kernel stack (arg_bufs alone is 4 KB,
   // env_bufs is 16 KB).
   // Ideally this should allocate the new user stack pages first, then copy argv/envp strings
@@ -371,27 +454,18 @@ static int32_t sys_exec(TrapFrame* regs) {
   const char* argv_ptrs[kMaxExecArgs];
 
   if (argv_ptr != 0) {
-    if (!validate_user_buffer(argv_ptr, 4, /*writeable=*/false)) {
-      return -EFAULT;
-    }
-    const auto* uargv = reinterpret_cast<const uint32_t*>(argv_ptr);
     while (argc < kMaxExecArgs) {
-      // Validate the pointer slot itself.
-      if (!validate_user_buffer(argv_ptr + (static_cast<uint32_t>(argc) * 4), 4,
-                                /*writeable=*/false)) {
+      uint32_t str_ptr = 0;
+      if (copy_from_user(&str_ptr, argv_ptr + (static_cast<uint32_t>(argc) * 4), 4) < 0) {
         return -EFAULT;
       }
-      const uint32_t str_ptr = uargv[argc];
       if (str_ptr == 0) {
         break;
       }
-      if (!validate_user_buffer(str_ptr, 1, /*writeable=*/false)) {
+      if (strncpy_from_user(arg_bufs[argc], str_ptr, kMaxArgLen) == -EFAULT) {
         return -EFAULT;
       }
-      const char* src = reinterpret_cast<const char*>(str_ptr);
-      strncpy(arg_bufs[argc], src, kMaxArgLen - 1);
-      arg_bufs[argc][kMaxArgLen - 1] = '\0';
-      argv_ptrs[argc] = arg_bufs[argc];
+      argv_ptrs[argc] = arg_bufs[argc];  // overlong arguments are truncated
       ++argc;
     }
   }
@@ -410,25 +484,17 @@ static int32_t sys_exec(TrapFrame* regs) {
   const char* env_ptrs[kMaxExecEnv];
 
   if (envp_ptr != 0) {
-    if (!validate_user_buffer(envp_ptr, 4, /*writeable=*/false)) {
-      return -EFAULT;
-    }
-    const auto* uenvp = reinterpret_cast<const uint32_t*>(envp_ptr);
     while (envc < kMaxExecEnv) {
-      if (!validate_user_buffer(envp_ptr + (static_cast<uint32_t>(envc) * 4), 4,
-                                /*writeable=*/false)) {
+      uint32_t str_ptr = 0;
+      if (copy_from_user(&str_ptr, envp_ptr + (static_cast<uint32_t>(envc) * 4), 4) < 0) {
         return -EFAULT;
       }
-      const uint32_t str_ptr = uenvp[envc];
       if (str_ptr == 0) {
         break;
       }
-      if (!validate_user_buffer(str_ptr, 1, /*writeable=*/false)) {
+      if (strncpy_from_user(env_bufs[envc], str_ptr, kMaxEnvLen) == -EFAULT) {
         return -EFAULT;
       }
-      const char* src = reinterpret_cast<const char*>(str_ptr);
-      strncpy(env_bufs[envc], src, kMaxEnvLen - 1);
-      env_bufs[envc][kMaxEnvLen - 1] = '\0';
       env_ptrs[envc] = env_bufs[envc];
       ++envc;
     }
@@ -442,10 +508,16 @@ static int32_t sys_exec(TrapFrame* regs) {
   Process* proc = Scheduler::current();
   assert(proc != nullptr && "sys_exec(): no current process");
 
+  // Other threads would be left running on the old image.
+  if (proc->group() != proc || proc->thread_count != 0) {
+    return -EBUSY;
+  }
+
   auto [new_pd_phys, new_pd_virt] = AddressSpace::create();
   if (new_pd_virt == nullptr) {
     return -ENOMEM;
   }
+  Vdso::map(new_pd_virt);
 
   vaddr_t entry = 0;
   vaddr_t brk = 0;
@@ -468,6 +540,7 @@ static int32_t sys_exec(TrapFrame* regs) {
   proc->page_directory_phys = new_pd_phys;
   proc->page_directory = new_pd_virt;
   proc->heap_break = brk;
+  Scheduler::set_name(proc, argv_ptrs[0]);
 
   AddressSpace::load(new_pd_phys);
   AddressSpace::sync_kernel_mappings(new_pd_virt);
@@ -481,14 +554,13 @@ static int32_t sys_exec(TrapFrame* regs) {
     AddressSpace::load(new_pd_phys);
   }
 
+  // The new program starts with a clean FPU, no TLS and no syscall ring.
+  Fpu::release(proc);
+  proc->tls_base = 0;
+  Ring::release(proc);
+
   // Close file descriptors marked FD_CLOEXEC.
-  for (uint32_t i = 0; i < kMaxFds; ++i) {
-    if (proc->fds[i] != nullptr && (proc->fd_flags[i] & FD_CLOEXEC) != 0) {
-      file_close(proc->fds[i]);
-      proc->fds[i] = nullptr;
-      proc->fd_flags[i] = 0;
-    }
-  }
+  proc->fds.close_on_exec();
 
   // Overwrite the current syscall TrapFrame in-place with the new process's
   // initial register state. When syscall_dispatch returns through TRAP_ENTRY,
@@ -512,31 +584,36 @@ static int32_t sys_fork(TrapFrame* regs) {
 static int32_t sys_waitpid(TrapFrame* regs) {
   auto pid = static_cast<int32_t>(regs->ebx);
   const uint32_t exit_code_ptr = regs->ecx;
-  int32_t* exit_code = nullptr;
-  if (exit_code_ptr != 0) {
-    exit_code = reinterpret_cast<int32_t*>(exit_code_ptr);
+  int32_t exit_code = 0;
+  const int32_t rc = Scheduler::waitpid_current(pid, exit_code_ptr != 0 ? &exit_code : nullptr);
+  if (rc > 0 && exit_code_ptr != 0 &&
+      copy_to_user(exit_code_ptr, &exit_code, sizeof(exit_code)) < 0) {
+    return -EFAULT;
   }
-  return Scheduler::waitpid_current(pid, exit_code);
+  return rc;
 }
 
-// SYS_PIPE(pipefd_ptr=ebx)
+// SYS_PIPE(pipefd_ptr=ebx, flags=ecx)
 // Creates a pipe and writes the read/write fd pair into the user-supplied
-// int[2] array. Returns 0 on success, -1 on failure.
+// int[2] array. flags may hold O_NONBLOCK and O_CLOEXEC, applied to both
+// ends. Returns 0 on success, -1 on failure.
 static int32_t sys_pipe(TrapFrame* regs) {
   const uint32_t pipefd_ptr = regs->ebx;
+  const auto flags = static_cast<int32_t>(regs->ecx);
+  const int32_t status_flags = flags & O_NONBLOCK;
 
-  if (!validate_user_buffer(pipefd_ptr, 2 * sizeof(int32_t), /*writeable=*/true)) {
+  if (!user_range_ok(pipefd_ptr, 2 * sizeof(int32_t))) {
     return -1;
   }
 
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
-  auto rfd = fd_alloc(proc->fds);
+  auto rfd = proc->fds.alloc();
   if (!rfd) {
     return -1;
   }
 
-  auto wfd = fd_alloc_from(proc->fds, *rfd + 1);
+  auto wfd = proc->fds.alloc(*rfd + 1);
   if (!wfd) {
     return -1;
   }
@@ -547,9 +624,11 @@ static int32_t sys_pipe(TrapFrame* regs) {
   }
 
   auto rd = std::make_unique<FileDescription>(FileDescription{
-      .type = FileType::PipeRead, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr});
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = status_flags});
   auto wr = std::make_unique<FileDescription>(FileDescription{
-      .type = FileType::PipeWrite, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr});
+      .type = FileType::PipeWrite, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = status_flags});
   if (!rd || !wr) {
     return -1;
   }
@@ -557,14 +636,17 @@ static int32_t sys_pipe(TrapFrame* regs) {
   ++pipe->readers;
   ++pipe->writers;
 
-  proc->fds[*rfd] = rd.release();
-  proc->fds[*wfd] = wr.release();
+  const uint32_t fd_flags = ((flags & O_CLOEXEC) != 0) ? FD_CLOEXEC : 0;
+  proc->fds.install(*rfd, rd.release(), fd_flags);
+  proc->fds.install(*wfd, wr.release(), fd_flags);
   (void)pipe.release();
 
-  auto* user_fds = reinterpret_cast<int32_t*>(pipefd_ptr);
-  user_fds[0] = static_cast<int32_t>(*rfd);
-  user_fds[1] = static_cast<int32_t>(*wfd);
-
+  const int32_t user_fds[2] = {static_cast<int32_t>(*rfd), static_cast<int32_t>(*wfd)};
+  if (copy_to_user(pipefd_ptr, user_fds, sizeof(user_fds)) < 0) {
+    file_close(proc->fds.remove(*rfd));
+    file_close(proc->fds.remove(*wfd));
+    return -1;
+  }
   return 0;
 }
 
@@ -572,40 +654,58 @@ static int32_t sys_pipe(TrapFrame* regs) {
 // Closes a file descriptor. Returns 0 on success, or negative errno on error.
 static int32_t sys_close(TrapFrame* regs) {
   const uint32_t fd_num = regs->ebx;
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  FileDescription* desc = proc->fds.remove(fd_num);
+  if (desc == nullptr) {
     return -EBADF;
   }
 
-  file_close(proc->fds[fd_num]);
-  proc->fds[fd_num] = nullptr;
+  file_close(desc);
   return 0;
 }
 
+// SYS_FSYNC(fd=ebx)
+// Writes the file's dirty cached pages back to its filesystem. Returns 0,
+// -EBADF, -EINVAL for fds that are not VFS files, or the backend's error.
+static int32_t sys_fsync(TrapFrame* regs) {
+  FileDescription* desc = Scheduler::current()->group()->fds[regs->ebx];
+  if (desc == nullptr) {
+    return -EBADF;
+  }
+  if (desc->type != FileType::VfsNode) {
+    return -EINVAL;
+  }
+  return Vfs::fsync(desc);
+}
+
 // SYS_DUP2(oldfd=ebx, newfd=ecx)
 // Duplicates oldfd onto newfd. Returns newfd on success, or negative errno on error.
 static int32_t sys_dup2(TrapFrame* regs) {
   const uint32_t oldfd = regs->ebx;
   const uint32_t newfd = regs->ecx;
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
-  if (oldfd >= kMaxFds || newfd >= kMaxFds || proc->fds[oldfd] == nullptr) {
+  FileDescription* desc = proc->fds[oldfd];
+  if (desc == nullptr || newfd >= proc->fds.limit()) {
     return -EBADF;
   }
 
   if (oldfd == newfd) {
     return static_cast<int32_t>(newfd);
   }
+  if (!proc->fds.reserve(newfd)) {
+    return -ENOMEM;
+  }
 
   // Close existing description at newfd if open.
-  if (proc->fds[newfd] != nullptr) {
-    file_close(proc->fds[newfd]);
+  FileDescription* old = proc->fds.remove(newfd);
+  if (old != nullptr) {
+    file_close(old);
   }
 
-  proc->fds[newfd] = proc->fds[oldfd];
-  proc->fds[newfd]->ref();
-  proc->fd_flags[newfd] = 0;  // dup2 clears FD_CLOEXEC on the new fd
+  desc->ref();
+  proc->fds.install(newfd, desc);  // dup2 clears FD_CLOEXEC on the new fd
   return static_cast<int32_t>(newfd);
 }
 
@@ -646,18 +746,14 @@ static int32_t sys_clock_gettime(TrapFrame* regs) {
     return -EINVAL;
   }
 
-  if (!validate_user_buffer(tp_ptr, 8, /*writeable=*/true)) {
-    return -EFAULT;
-  }
-
-  const uint64_t ticks = PIT::get_ticks();
-  constexpr uint32_t kTicksPerSec = 100;
-  constexpr uint32_t kNsPerTick = 10'000'000;  // 10 ms = 10,000,000 ns
+  const uint64_t ns = PIT::now_ns();
+  constexpr uint64_t kNsPerSec = 1'000'000'000;
 
-  auto* tp = reinterpret_cast<int32_t*>(tp_ptr);
-  tp[0] = static_cast<int32_t>(ticks / kTicksPerSec);                 // tv_sec
-  tp[1] = static_cast<int32_t>((ticks % kTicksPerSec) * kNsPerTick);  // tv_nsec
-  return 0;
+  const int32_t tp[2] = {
+      static_cast<int32_t>(ns / kNsPerSec),  // tv_sec
+      static_cast<int32_t>(ns % kNsPerSec),  // tv_nsec
+  };
+  return copy_to_user(tp_ptr, tp, sizeof(tp));
 }
 
 // SYS_LSEEK(fd=ebx, offset=ecx, whence=edx)
@@ -669,8 +765,8 @@ static int32_t sys_lseek(TrapFrame* regs) {
   const auto offset = static_cast<int32_t>(regs->ecx);
   const uint32_t whence = regs->edx;
 
-  const Process* proc = Scheduler::current();
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
     return -1;
   }
 
@@ -680,8 +776,9 @@ static int32_t sys_lseek(TrapFrame* regs) {
   }
 
   VfsFileDescription* vfs_fd = fd->vfs;
-  if (vfs_fd->node == nullptr || vfs_fd->node->type != VfsNodeType::File) {
-    return -1;  // only regular files support seeking
+  // Regular files seek by byte; directories by entry, for getdents.
+  if (vfs_fd->node == nullptr || vfs_fd->node->type == VfsNodeType::CharDev) {
+    return -1;
   }
 
   int64_t base = 0;
@@ -724,15 +821,25 @@ static int32_t sys_fb_flip(TrapFrame* regs) {
   }
 
   // Guard against overflow before multiplying.
-  if (src_w > 4096 || src_h > 4096) {
+  static constexpr uint32_t kMaxFlipDim = 4096;
+  if (src_w > kMaxFlipDim || src_h > kMaxFlipDim) {
     return -EINVAL;
   }
-  const uint32_t buf_size = src_w * src_h * 4;
-  if (!validate_user_buffer(buf, buf_size, /*writeable=*/false)) {
+  const uint32_t row_size = src_w * 4;
+  if (!user_range_ok(buf, row_size * src_h)) {
     return -EFAULT;
   }
 
-  Framebuffer::blit_scaled(reinterpret_cast<const uint32_t*>(buf), src_w, src_h);
+  // Pull the image in a row at a time; static to keep 16 KiB off the
+  // kernel stack (the big kernel lock serializes callers).
+  static uint32_t row[kMaxFlipDim];
+  Framebuffer::clear_letterbox(src_w, src_h);
+  for (uint32_t y = 0; y < src_h; ++y) {
+    if (copy_from_user(row, buf + (y * row_size), row_size) < 0) {
+      return -EFAULT;
+    }
+    Framebuffer::blit_scaled_row(row, src_w, src_h, y);
+  }
   return 0;
 }
 
@@ -762,17 +869,15 @@ static int32_t sys_sigaction(TrapFrame* regs) {
   const uint32_t new_handler = regs->ecx;
   const uint32_t old_ptr = regs->edx;
 
-  if (sig == 0 || sig >= 32) {
+  if (sig == 0 || sig >= 32 || sig == SIGKILL) {
     return -EINVAL;
   }
 
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
-  if (old_ptr != 0) {
-    if (!validate_user_buffer(old_ptr, sizeof(uint32_t), /*writeable=*/true)) {
-      return -EFAULT;
-    }
-    *reinterpret_cast<uint32_t*>(old_ptr) = proc->signal_handlers[sig];
+  if (old_ptr != 0 &&
+      copy_to_user(old_ptr, &proc->signal_handlers[sig], sizeof(uint32_t)) < 0) {
+    return -EFAULT;
   }
 
   proc->signal_handlers[sig] = new_handler;
@@ -788,21 +893,20 @@ static int32_t sys_sigreturn(TrapFrame* regs) {
   // After handler ret: user_esp = signal_frame_addr + sizeof(return_addr).
   const uint32_t sf_addr = regs->user_esp - sizeof(uint32_t);
 
-  if (!validate_user_buffer(sf_addr, sizeof(SignalFrame), /*writeable=*/false)) {
+  SignalFrame sf;
+  if (copy_from_user(&sf, sf_addr, sizeof(sf)) < 0) {
     Scheduler::exit_current(SIGSEGV);
     return 0;  // not reached for the current process
   }
 
-  const auto* sf = reinterpret_cast<const SignalFrame*>(sf_addr);
-
-  regs->eip = sf->saved_eip;
-  regs->eflags = sf->saved_eflags | 0x200U;  // preserve IF
-  regs->user_esp = sf->saved_esp;
-  regs->ecx = sf->saved_ecx;
-  regs->edx = sf->saved_edx;
+  regs->eip = sf.saved_eip;
+  regs->eflags = sf.saved_eflags | 0x200U;  // preserve IF
+  regs->user_esp = sf.saved_esp;
+  regs->ecx = sf.saved_ecx;
+  regs->edx = sf.saved_edx;
 
   // Return saved_eax; syscall_dispatch will write this back to regs->eax.
-  return static_cast<int32_t>(sf->saved_eax);
+  return static_cast<int32_t>(sf.saved_eax);
 }
 
 // SYS_IOCTL(fd=ebx, request=ecx, arg=edx)
@@ -813,59 +917,73 @@ static int32_t sys_ioctl(TrapFrame* regs) {
   const uint32_t request = regs->ecx;
   const uint32_t arg_ptr = regs->edx;
 
-  const Process* proc = Scheduler::current();
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
     return -EBADF;
   }
 
   FileDescription* fd = proc->fds[fd_num];
-
-  void* arg = reinterpret_cast<void*>(arg_ptr);
-
-  // Validate the argument buffer for known requests.
-  if (request == TIOCGWINSZ &&
-      !validate_user_buffer(arg_ptr, sizeof(struct winsize), /*writeable=*/true)) {
-    return -EFAULT;
-  }
-  if ((request == TCGETS) &&
-      !validate_user_buffer(arg_ptr, sizeof(struct termios), /*writeable=*/true)) {
-    return -EFAULT;
+  const bool is_terminal =
+      fd->type == FileType::TerminalRead || fd->type == FileType::TerminalWrite;
+  if (!is_terminal && (fd->type != FileType::VfsNode || fd->vfs == nullptr)) {
+    return -ENOTTY;
   }
-  if ((request == TCSETS) &&
-      !validate_user_buffer(arg_ptr, sizeof(struct termios), /*writeable=*/false)) {
+
+  // Drivers see a kernel copy of the argument: copied in for requests that
+  // read it, copied back out for requests that fill it in.
+  union {
+    struct winsize ws;
+    struct termios tio;
+  } arg = {};
+  size_t arg_size = 0;
+  const bool arg_out = request == TIOCGWINSZ || request == TCGETS;
+  if (request == TIOCGWINSZ) {
+    arg_size = sizeof(arg.ws);
+  } else if (request == TCGETS || request == TCSETS) {
+    arg_size = sizeof(arg.tio);
+  }
+  if (request == TCSETS && copy_from_user(&arg, arg_ptr, arg_size) < 0) {
     return -EFAULT;
   }
 
   // Terminal fds (stdin/stdout/stderr) are not backed by VFS nodes, but
   // they still support tty ioctls (TIOCGWINSZ, TCGETS, TCSETS).
-  if (fd->type == FileType::TerminalRead || fd->type == FileType::TerminalWrite) {
-    return Vfs::tty_ioctl(request, arg);
+  const int32_t rc =
+      is_terminal ? Vfs::tty_ioctl(request, &arg) : Vfs::ioctl(fd, request, &arg);
+  if (rc == 0 && arg_out && copy_to_user(arg_ptr, &arg, arg_size) < 0) {
+    return -EFAULT;
   }
+  return rc;
+}
 
-  if (fd->type != FileType::VfsNode || fd->vfs == nullptr) {
-    return -ENOTTY;
+static int32_t do_fstatat(int32_t dirfd, uint32_t path_ptr, uint32_t buf_ptr) {
+  char path[kMaxPathLen];
+  VfsNode* base = nullptr;
+  const int32_t rc = user_path_at(dirfd, path_ptr, path, &base);
+  if (rc < 0) {
+    return rc;
   }
 
-  return Vfs::ioctl(fd, request, arg);
+  struct stat st = {};
+  const int32_t stat_rc = Vfs::stat_at(base, path, &st);
+  if (stat_rc < 0) {
+    return stat_rc;
+  }
+  return copy_to_user(buf_ptr, &st, sizeof(st));
 }
 
 // SYS_STAT(path=ebx, buf=ecx)
 // Returns 0 on success, or negative errno on failure.
-static int32_t sys_stat(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
-  const uint32_t buf_ptr = regs->ecx;
+static int32_t sys_stat(TrapFrame* regs) { return do_fstatat(AT_FDCWD, regs->ebx, regs->ecx); }
 
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
-  if (rc < 0) {
-    return rc;
-  }
-
-  if (!validate_user_buffer(buf_ptr, sizeof(struct stat), /*writeable=*/true)) {
-    return -EFAULT;
+// SYS_FSTATAT(dirfd=ebx, path=ecx, buf=edx, flags=edi)
+// stat() relative to dirfd. There are no symlinks, so no flags are
+// accepted yet (-EINVAL).
+static int32_t sys_fstatat(TrapFrame* regs) {
+  if (regs->edi != 0) {
+    return -EINVAL;
   }
-  auto* buf = reinterpret_cast<struct stat*>(buf_ptr);
-  return Vfs::stat_path(abs_path, buf);
+  return do_fstatat(static_cast<int32_t>(regs->ebx), regs->ecx, regs->edx);
 }
 
 // SYS_FSTAT(fd=ebx, buf=ecx)
@@ -874,47 +992,65 @@ static int32_t sys_fstat(TrapFrame* regs) {
   const uint32_t fd_num = regs->ebx;
   const uint32_t buf_ptr = regs->ecx;
 
-  const Process* proc = Scheduler::current();
-  if (fd_num >= kMaxFds || proc->fds[fd_num] == nullptr) {
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
     return -EBADF;
   }
   const FileDescription* fd = proc->fds[fd_num];
   if (fd->type != FileType::VfsNode || fd->vfs == nullptr || fd->vfs->node == nullptr) {
     return -EBADF;
   }
-  if (!validate_user_buffer(buf_ptr, sizeof(struct stat), /*writeable=*/true)) {
-    return -EFAULT;
+  struct stat st = {};
+  const int32_t rc = Vfs::stat_node(fd->vfs->node, &st);
+  if (rc < 0) {
+    return rc;
   }
-  auto* buf = reinterpret_cast<struct stat*>(buf_ptr);
-  return Vfs::stat_node(fd->vfs->node, buf);
+  return copy_to_user(buf_ptr, &st, sizeof(st));
 }
 
-// SYS_MKDIR(path=ebx, mode=ecx)
-// Returns 0 on success, or negative errno on failure.
-static int32_t sys_mkdir(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
-
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
+static int32_t do_mkdirat(int32_t dirfd, uint32_t path_ptr) {
+  char path[kMaxPathLen];
+  VfsNode* base = nullptr;
+  const int32_t rc = user_path_at(dirfd, path_ptr, path, &base);
   if (rc < 0) {
     return rc;
   }
-
-  return Vfs::fs_mkdir(abs_path);
+  return Vfs::fs_mkdir_at(base, path);
 }
 
-// SYS_UNLINK(path=ebx)
+// SYS_MKDIR(path=ebx, mode=ecx)
 // Returns 0 on success, or negative errno on failure.
-static int32_t sys_unlink(TrapFrame* regs) {
-  const uint32_t path_ptr = regs->ebx;
+static int32_t sys_mkdir(TrapFrame* regs) { return do_mkdirat(AT_FDCWD, regs->ebx); }
 
-  char abs_path[128];
-  const int32_t rc = resolve_abs_path(path_ptr, abs_path, sizeof(abs_path));
+// SYS_MKDIRAT(dirfd=ebx, path=ecx, mode=edx)
+// mkdir() relative to dirfd.
+static int32_t sys_mkdirat(TrapFrame* regs) {
+  return do_mkdirat(static_cast<int32_t>(regs->ebx), regs->ecx);
+}
+
+static int32_t do_unlinkat(int32_t dirfd, uint32_t path_ptr, bool remove_dir) {
+  char path[kMaxPathLen];
+  VfsNode* base = nullptr;
+  const int32_t rc = user_path_at(dirfd, path_ptr, path, &base);
   if (rc < 0) {
     return rc;
   }
+  return Vfs::fs_unlink_at(base, path, remove_dir);
+}
 
-  return Vfs::fs_unlink(abs_path);
+// SYS_UNLINK(path=ebx)
+// Returns 0 on success, or negative errno on failure.
+static int32_t sys_unlink(TrapFrame* regs) { return do_unlinkat(AT_FDCWD, regs->ebx, false); }
+
+// SYS_UNLINKAT(dirfd=ebx, path=ecx, flags=edx)
+// unlink() relative to dirfd; with AT_REMOVEDIR it removes a directory
+// instead, if the filesystem supports that.
+static int32_t sys_unlinkat(TrapFrame* regs) {
+  const uint32_t flags = regs->edx;
+  if ((flags & ~static_cast<uint32_t>(AT_REMOVEDIR)) != 0) {
+    return -EINVAL;
+  }
+  return do_unlinkat(static_cast<int32_t>(regs->ebx), regs->ecx, flags != 0);
 }
 
 // SYS_RENAME(old=ebx, new=ecx)
@@ -944,26 +1080,28 @@ static int32_t sys_fcntl(TrapFrame* regs) {
   const auto cmd = static_cast<int32_t>(regs->ecx);
   const uint32_t arg = regs->edx;
 
-  Process* proc = Scheduler::current();
-  if (fd >= kMaxFds || proc->fds[fd] == nullptr) {
+  Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd] == nullptr) {
     return -EBADF;
   }
 
   switch (cmd) {
     case F_DUPFD: {
-      auto slot = fd_alloc_from(proc->fds, arg);
+      if (arg >= proc->fds.limit()) {
+        return -EINVAL;
+      }
+      auto slot = proc->fds.alloc(arg);
       if (!slot) {
         return -EMFILE;
       }
-      proc->fds[*slot] = proc->fds[fd];
-      proc->fds[*slot]->ref();
-      proc->fd_flags[*slot] = 0;
+      proc->fds[fd]->ref();
+      proc->fds.install(*slot, proc->fds[fd]);
       return static_cast<int32_t>(*slot);
     }
     case F_GETFD:
-      return static_cast<int32_t>(proc->fd_flags[fd]);
+      return static_cast<int32_t>(proc->fds.flags(fd));
     case F_SETFD:
-      proc->fd_flags[fd] = arg & FD_CLOEXEC;
+      proc->fds.set_flags(fd, arg & FD_CLOEXEC);
       return 0;
     case F_GETFL: {
       const FileDescription* desc = proc->fds[fd];
@@ -971,29 +1109,65 @@ static int32_t sys_fcntl(TrapFrame* regs) {
         return desc->vfs->open_flags;
       }
       if (desc->type == FileType::PipeRead) {
-        return O_RDONLY;
+        return O_RDONLY | desc->status_flags;
       }
       if (desc->type == FileType::PipeWrite) {
-        return O_WRONLY;
+        return O_WRONLY | desc->status_flags;
       }
-      return O_RDWR;
+      return O_RDWR | desc->status_flags;
     }
     case F_SETFL: {
-      // Only O_APPEND and O_NONBLOCK are modifiable via F_SETFL.
+      // Only O_APPEND and O_NONBLOCK are modifiable via F_SETFL. O_NONBLOCK
+      // applies to every type; O_APPEND only means something for VFS files.
       constexpr int32_t kModifiable = O_APPEND | O_NONBLOCK;
-      const FileDescription* desc = proc->fds[fd];
+      FileDescription* desc = proc->fds[fd];
+      desc->status_flags = static_cast<int32_t>(arg) & O_NONBLOCK;
       if (desc->type == FileType::VfsNode && desc->vfs != nullptr) {
         desc->vfs->open_flags =
             (desc->vfs->open_flags & ~kModifiable) | (static_cast<int32_t>(arg) & kModifiable);
-        return 0;
       }
-      return -EINVAL;
+      return 0;
     }
     default:
       return -EINVAL;
   }
 }
 
+// SYS_GETRLIMIT(resource=ebx, rlim=ecx)
+// Only RLIMIT_NOFILE exists. Returns 0, -EINVAL or -EFAULT.
+static int32_t sys_getrlimit(TrapFrame* regs) {
+  if (regs->ebx != RLIMIT_NOFILE) {
+    return -EINVAL;
+  }
+  const Process* proc = Scheduler::current()->group();
+  const rlimit lim = {.rlim_cur = proc->fds.limit(), .rlim_max = proc->fds.max_limit()};
+  return copy_to_user(regs->ecx, &lim, sizeof(lim));
+}
+
+// SYS_SETRLIMIT(resource=ebx, rlim=ecx)
+// Sets the fd limits of the calling process. Lowering either is always
+// allowed and leaves fds already open above the new limit alone; raising
+// rlim_max needs root and cannot pass kMaxFds (RLIM_INFINITY included).
+// Returns 0, -EINVAL, -EPERM or -EFAULT.
+static int32_t sys_setrlimit(TrapFrame* regs) {
+  if (regs->ebx != RLIMIT_NOFILE) {
+    return -EINVAL;
+  }
+  rlimit lim;
+  if (copy_from_user(&lim, regs->ecx, sizeof(lim)) < 0) {
+    return -EFAULT;
+  }
+  if (lim.rlim_cur > lim.rlim_max) {
+    return -EINVAL;
+  }
+  Process* proc = Scheduler::current()->group();
+  if (lim.rlim_max > kMaxFds || (lim.rlim_max > proc->fds.max_limit() && proc->uid != 0)) {
+    return -EPERM;
+  }
+  proc->fds.set_limits(lim.rlim_cur, lim.rlim_max);
+  return 0;
+}
+
 // SYS_MOUNT(target=ebx, fstype=ecx) -- stub
 // TODO: implement; the actual mount currently happens at boot via Fat::init_vfs().
 static int32_t sys_mount([[maybe_unused]] TrapFrame* regs) { return -ENOSYS; }
@@ -1011,6 +1185,333 @@ static int32_t sys_umount(TrapFrame* regs) {
   return Vfs::unmount(target);
 }
 
+// SYS_NANOSLEEP(req=ebx)
+// Sleeps for the duration in the user timespec at req. Unlike SYS_SLEEP the
+// wake-up is accurate to the one-shot timer, well below a millisecond.
+// Returns 0, -EFAULT for a bad pointer, or -EINVAL for a malformed timespec.
+static int32_t sys_nanosleep(TrapFrame* regs) {
+  const uint32_t req_ptr = regs->ebx;
+  timespec req;
+  if (copy_from_user(&req, req_ptr, sizeof(req)) < 0) {
+    return -EFAULT;
+  }
+  if (req.tv_sec < 0 || req.tv_nsec < 0 || req.tv_nsec >= 1'000'000'000) {
+    return -EINVAL;
+  }
+
+  const uint64_t ns = (static_cast<uint64_t>(req.tv_sec) * 1'000'000'000) +
+                      static_cast<uint64_t>(req.tv_nsec);
+  if (ns != 0) {
+    Scheduler::sleep_current(ns);
+  }
+  return 0;
+}
+
+// SYS_SCHEDSTAT(stat=ebx, procs=ecx, max_procs=edx)
+// Fills the user sched_stat at stat and up to max_procs proc_stat entries at
+// procs. Returns the number of proc_stat entries written, or -EFAULT.
+static int32_t sys_schedstat(TrapFrame* regs) {
+  const uint32_t stat_ptr = regs->ebx;
+  const uint32_t procs_ptr = regs->ecx;
+  const uint32_t max_procs = regs->edx;
+
+  if (!validate_user_buffer(stat_ptr, sizeof(sched_stat), /*writeable=*/true)) {
+    return -EFAULT;
+  }
+  if (max_procs > UINT32_MAX / sizeof(proc_stat) ||
+      !validate_user_buffer(procs_ptr, max_procs * sizeof(proc_stat), /*writeable=*/true)) {
+    return -EFAULT;
+  }
+
+  const std::span<proc_stat> procs{reinterpret_cast<proc_stat*>(procs_ptr), max_procs};
+  return static_cast<int32_t>(
+      Scheduler::get_stats(reinterpret_cast<sched_stat*>(stat_ptr), procs));
+}
+
+// SYS_FUTEX(uaddr=ebx, op=ecx, val=edx)
+// FUTEX_WAIT: sleep while the word at uaddr equals val; returns 0 when woken
+// or -EAGAIN if it already differs. FUTEX_WAKE: wake up to val waiters on
+// uaddr; returns the number woken.
+static int32_t sys_futex(TrapFrame* regs) {
+  const vaddr_t uaddr{regs->ebx};
+  const uint32_t op = regs->ecx;
+  const uint32_t val = regs->edx;
+
+  switch (op) {
+    case FUTEX_WAIT:
+      return Futex::wait(uaddr, val);
+    case FUTEX_WAKE:
+      return Futex::wake(uaddr, val);
+    default:
+      return -EINVAL;
+  }
+}
+
+// SYS_CLONE(stack=ebx, tls=ecx, clear_tid=edx)
+// Creates a thread sharing the caller's address space, fds and signal
+// handlers. It returns 0 from this syscall on the user stack `stack`, with
+// %gs based at `tls` if non-zero; the word at clear_tid (if non-zero) is
+// zeroed and FUTEX_WAKEd when it exits. Returns the thread's id.
+static int32_t sys_clone(TrapFrame* regs) {
+  const uint32_t stack = regs->ebx;
+  const vaddr_t tls{regs->ecx};
+  const vaddr_t clear_tid{regs->edx};
+
+  if (stack == 0 || stack > KERNEL_VMA || tls >= KERNEL_VMA) {
+    return -EINVAL;
+  }
+  if (clear_tid != 0 &&
+      ((clear_tid & (sizeof(uint32_t) - 1)) != 0 ||
+       !validate_user_buffer(clear_tid, sizeof(uint32_t), /*writeable=*/true))) {
+    return -EFAULT;
+  }
+  return Scheduler::clone_current(regs, stack, tls, clear_tid);
+}
+
+// SYS_EXIT_THREAD()
+// Terminates the calling thread only. The process exits with code 0 when
+// its last thread does.
+static int32_t sys_exit_thread([[maybe_unused]] TrapFrame* regs) {
+  Scheduler::exit_thread();
+  return 0;  // not reached by the exiting thread
+}
+
+// Copy the user iovec array at iov_ptr into bufs and validate every buffer
+// (writeable for readv). Returns the number of buffers, or negative errno.
+template <typename Buf>
+static int32_t copy_iovecs(uint32_t iov_ptr, uint32_t iovcnt, bool writeable,
+                           std::array<Buf, IOV_MAX>& bufs) {
+  if (iovcnt == 0 || iovcnt > IOV_MAX) {
+    return -EINVAL;
+  }
+  // Copy first: another thread could change the array after it is checked.
+  iovec iov[IOV_MAX];
+  if (copy_from_user(iov, iov_ptr, iovcnt * sizeof(iovec)) < 0) {
+    return -EFAULT;
+  }
+
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < iovcnt; ++i) {
+    const auto base = reinterpret_cast<uint32_t>(iov[i].iov_base);
+    const uint32_t len = iov[i].iov_len;
+    if (len > static_cast<uint32_t>(INT32_MAX) - total) {
+      return -EINVAL;
+    }
+    total += len;
+    if (!validate_user_buffer(base, len, writeable)) {
+      return -EFAULT;
+    }
+    bufs[i] = Buf(reinterpret_cast<typename Buf::pointer>(base), len);
+  }
+  return static_cast<int32_t>(iovcnt);
+}
+
+// SYS_READV(fd=ebx, iov=ecx, iovcnt=edx)
+// Returns total bytes read, or negative errno on error.
+static int32_t sys_readv(TrapFrame* regs) {
+  const uint32_t fd_num = regs->ebx;
+
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
+  }
+
+  std::array<std::span<uint8_t>, IOV_MAX> bufs;
+  const int32_t count = copy_iovecs(regs->ecx, regs->edx, /*writeable=*/true, bufs);
+  if (count < 0) {
+    return count;
+  }
+  return file_readv(proc->fds[fd_num], IoVec(bufs.data(), static_cast<size_t>(count)));
+}
+
+// SYS_WRITEV(fd=ebx, iov=ecx, iovcnt=edx)
+// Returns total bytes written, or negative errno on error.
+static int32_t sys_writev(TrapFrame* regs) {
+  const uint32_t fd_num = regs->ebx;
+
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
+  }
+
+  std::array<std::span<const uint8_t>, IOV_MAX> bufs;
+  const int32_t count = copy_iovecs(regs->ecx, regs->edx, /*writeable=*/false, bufs);
+  if (count < 0) {
+    return count;
+  }
+  return file_writev(proc->fds[fd_num], ConstIoVec(bufs.data(), static_cast<size_t>(count)));
+}
+
+// SYS_PREAD(fd=ebx, buf=ecx, count=edx, offset=edi)
+// Reads at offset without moving the file offset. Returns bytes read, or
+// negative errno on error (-ESPIPE for pipes and the terminal).
+static int32_t sys_pread(TrapFrame* regs) {
+  const uint32_t fd_num = regs->ebx;
+  const uint32_t buf = regs->ecx;
+  const uint32_t count = regs->edx;
+  const auto offset = static_cast<int32_t>(regs->edi);
+
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
+  }
+  if (offset < 0) {
+    return -EINVAL;
+  }
+  if (!validate_user_buffer(buf, count, /*writeable=*/true)) {
+    return -EFAULT;
+  }
+
+  return file_pread(proc->fds[fd_num],
+                    std::span<uint8_t>(reinterpret_cast<uint8_t*>(buf), count),
+                    static_cast<uint32_t>(offset));
+}
+
+// SYS_PWRITE(fd=ebx, buf=ecx, count=edx, offset=edi)
+// Writes at offset without moving the file offset. Returns bytes written,
+// or negative errno on error.
+static int32_t sys_pwrite(TrapFrame* regs) {
+  const uint32_t fd_num = regs->ebx;
+  const uint32_t buf = regs->ecx;
+  const uint32_t count = regs->edx;
+  const auto offset = static_cast<int32_t>(regs->edi);
+
+  const Process* proc = Scheduler::current()->group();
+  if (proc->fds[fd_num] == nullptr) {
+    return -EBADF;
+  }
+  if (offset < 0) {
+    return -EINVAL;
+  }
+  if (!validate_user_buffer(buf, count, /*writeable=*/false)) {
+    return -EFAULT;
+  }
+
+  return file_pwrite(proc->fds[fd_num],
+                     std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(buf), count),
+                     static_cast<uint32_t>(offset));
+}
+
+// SYS_POLL(fds=ebx, nfds=ecx, timeout_ms=edx)
+// Waits until one of fds is ready or timeout_ms passes (forever if
+// negative). Returns the number of entries with nonzero revents, 0 on
+// timeout, or negative errno on error.
+static int32_t sys_poll(TrapFrame* regs) {
+  const uint32_t fds_ptr = regs->ebx;
+  const uint32_t nfds = regs->ecx;
+  const auto timeout_ms = static_cast<int32_t>(regs->edx);
+
+  if (nfds > POLL_MAX) {
+    return -EINVAL;
+  }
+  // Work on a kernel copy so user memory is only written with the result.
+  std::array<pollfd, POLL_MAX> fds;
+  if (copy_from_user(fds.data(), fds_ptr, nfds * sizeof(pollfd)) < 0) {
+    return -EFAULT;
+  }
+  const int32_t ready = Poll::poll(std::span<pollfd>(fds.data(), nfds), timeout_ms);
+  if (ready >= 0 && copy_to_user(fds_ptr, fds.data(), nfds * sizeof(pollfd)) < 0) {
+    return -EFAULT;
+  }
+  return ready;
+}
+
+// SYS_TRACE(op=ebx, arg=ecx, len=edx)
+// TRACE_ON starts tracing pid `arg`; TRACE_OFF stops. TRACE_READ moves up to
+// len events into the trace_event array at arg and returns how many;
+// TRACE_STATS copies len histograms to arg and returns the dropped count.
+static int32_t sys_trace(TrapFrame* regs) {
+  const uint32_t op = regs->ebx;
+  const uint32_t arg = regs->ecx;
+  const uint32_t len = regs->edx;
+
+  switch (op) {
+    case TRACE_ON:
+      Trace::start(arg);
+      return 0;
+    case TRACE_OFF:
+      Trace::stop();
+      return 0;
+    case TRACE_READ: {
+      if (len > UINT32_MAX / sizeof(trace_event) ||
+          !user_range_ok(arg, len * sizeof(trace_event))) {
+        return -EFAULT;
+      }
+      // Events leave the kernel buffer in batches; a fault part way
+      // through loses at most one batch.
+      std::array<trace_event, 16> batch;
+      uint32_t total = 0;
+      while (total < len) {
+        const size_t want = len - total < batch.size() ? len - total : batch.size();
+        const size_t got = Trace::read(std::span<trace_event>(batch.data(), want));
+        if (got == 0) {
+          break;
+        }
+        if (copy_to_user(arg + (total * sizeof(trace_event)), batch.data(),
+                         got * sizeof(trace_event)) < 0) {
+          return -EFAULT;
+        }
+        total += got;
+      }
+      return static_cast<int32_t>(total);
+    }
+    case TRACE_STATS: {
+      const uint32_t count = len < SYS_MAX ? len : SYS_MAX;
+      std::array<trace_hist, SYS_MAX> hists;
+      const uint32_t dropped = Trace::stats(std::span<trace_hist>(hists.data(), count));
+      if (copy_to_user(arg, hists.data(), count * sizeof(trace_hist)) < 0) {
+        return -EFAULT;
+      }
+      return static_cast<int32_t>(dropped);
+    }
+    default:
+      return -EINVAL;
+  }
+}
+
+// SYS_RING_SETUP(ring=ebx, entries=ecx)
+// Registers a syscall ring (see <sys/ring.h>), or drops it if ring is 0.
+// Returns 0 on success, or negative errno on failure.
+static int32_t sys_ring_setup(TrapFrame* regs) {
+  const uint32_t ring_ptr = regs->ebx;
+  const uint32_t entries = regs->ecx;
+
+  Process* proc = Scheduler::current()->group();
+  if (ring_ptr == 0) {
+    Ring::release(proc);
+    return 0;
+  }
+  if ((ring_ptr & (alignof(ring) - 1)) != 0 || entries > RING_MAX_ENTRIES) {
+    return -EINVAL;
+  }
+  if (!validate_user_buffer(ring_ptr, RING_SIZE(entries), /*writeable=*/true)) {
+    return -EFAULT;
+  }
+  return Ring::setup(proc, reinterpret_cast<ring*>(ring_ptr), entries);
+}
+
+static int32_t run_ring_call(const ring_sqe& sqe);
+
+// SYS_RING_ENTER(to_submit=ebx, min_complete=ecx)
+// Runs queued ring submissions. Returns the number of unread completions,
+// kSyscallRestart if blocked (will be retried), or negative errno.
+static int32_t sys_ring_enter(TrapFrame* regs) {
+  const uint32_t to_submit = regs->ebx;
+  const uint32_t min_complete = regs->ecx;
+
+  Process* proc = Scheduler::current()->group();
+  if (proc->ring == nullptr) {
+    return -ENXIO;
+  }
+  // The program may have unmapped its ring since ring_setup(); one check
+  // here covers every entry the batch touches.
+  const auto ring_ptr = reinterpret_cast<uint32_t>(proc->ring->shared);
+  if (!validate_user_buffer(ring_ptr, RING_SIZE(proc->ring->mask + 1), /*writeable=*/true)) {
+    return -EFAULT;
+  }
+  return Ring::enter(proc, to_submit, min_complete, run_ring_call);
+}
+
 // ===========================================================================
 // Dispatch table
 // ===========================================================================
@@ -1052,6 +1553,26 @@ static constexpr std::array<syscall_fn, SYS_MAX> syscall_table = {
     sys_fcntl,          // 31 SYS_FCNTL
     sys_mount,          // 32 SYS_MOUNT
     sys_umount,         // 33 SYS_UMOUNT
+    sys_nanosleep,      // 34 SYS_NANOSLEEP
+    sys_schedstat,      // 35 SYS_SCHEDSTAT
+    sys_futex,          // 36 SYS_FUTEX
+    sys_clone,          // 37 SYS_CLONE
+    sys_exit_thread,    // 38 SYS_EXIT_THREAD
+    sys_ring_setup,     // 39 SYS_RING_SETUP
+    sys_ring_enter,     // 40 SYS_RING_ENTER
+    sys_readv,          // 41 SYS_READV
+    sys_writev,         // 42 SYS_WRITEV
+    sys_pread,          // 43 SYS_PREAD
+    sys_pwrite,         // 44 SYS_PWRITE
+    sys_poll,           // 45 SYS_POLL
+    sys_trace,          // 46 SYS_TRACE
+    sys_openat,         // 47 SYS_OPENAT
+    sys_mkdirat,        // 48 SYS_MKDIRAT
+    sys_fstatat,        // 49 SYS_FSTATAT
+    sys_unlinkat,       // 50 SYS_UNLINKAT
+    sys_getrlimit,      // 51 SYS_GETRLIMIT
+    sys_setrlimit,      // 52 SYS_SETRLIMIT
+    sys_fsync,          // 53 SYS_FSYNC
 };
 
 static_assert(syscall_table[SYS_EXIT] == sys_exit);
@@ -1088,12 +1609,89 @@ static_assert(syscall_table[SYS_RENAME] == sys_rename);
 static_assert(syscall_table[SYS_FCNTL] == sys_fcntl);
 static_assert(syscall_table[SYS_MOUNT] == sys_mount);
 static_assert(syscall_table[SYS_UMOUNT] == sys_umount);
+static_assert(syscall_table[SYS_NANOSLEEP] == sys_nanosleep);
+static_assert(syscall_table[SYS_SCHEDSTAT] == sys_schedstat);
+static_assert(syscall_table[SYS_FUTEX] == sys_futex);
+static_assert(syscall_table[SYS_CLONE] == sys_clone);
+static_assert(syscall_table[SYS_EXIT_THREAD] == sys_exit_thread);
+static_assert(syscall_table[SYS_RING_SETUP] == sys_ring_setup);
+static_assert(syscall_table[SYS_RING_ENTER] == sys_ring_enter);
+static_assert(syscall_table[SYS_READV] == sys_readv);
+static_assert(syscall_table[SYS_WRITEV] == sys_writev);
+static_assert(syscall_table[SYS_PREAD] == sys_pread);
+static_assert(syscall_table[SYS_PWRITE] == sys_pwrite);
+static_assert(syscall_table[SYS_POLL] == sys_poll);
+static_assert(syscall_table[SYS_TRACE] == sys_trace);
+static_assert(syscall_table[SYS_OPENAT] == sys_openat);
+static_assert(syscall_table[SYS_MKDIRAT] == sys_mkdirat);
+static_assert(syscall_table[SYS_FSTATAT] == sys_fstatat);
+static_assert(syscall_table[SYS_UNLINKAT] == sys_unlinkat);
+static_assert(syscall_table[SYS_GETRLIMIT] == sys_getrlimit);
+static_assert(syscall_table[SYS_SETRLIMIT] == sys_setrlimit);
+static_assert(syscall_table[SYS_FSYNC] == sys_fsync);
 static_assert(syscall_table.size() == SYS_MAX);
+static_assert(TRACE_RET_RESTART == kSyscallRestart);
+
+// Run syscall num and, if the caller is being traced, record it. Kept out
+// of line so the untraced path in syscall_dispatch stays a single branch.
+[[gnu::noinline]] static int32_t traced_call(TrapFrame* regs, uint32_t num) {
+  const Process* proc = Scheduler::current();
+  if (!Trace::traces(proc)) {
+    return syscall_table[num](regs);
+  }
+  // Handlers may rewrite the frame (exec, sigreturn), so capture it first.
+  const uint32_t pid = proc->pid;
+  const uint32_t args[3] = {regs->ebx, regs->ecx, regs->edx};
+
+  // An exiting caller never sees its result; log the call on the way in so
+  // it lands before the exit event.
+  if (num == SYS_EXIT || num == SYS_EXIT_THREAD) {
+    Trace::record(pid, num, args, 0, 0);
+    return syscall_table[num](regs);
+  }
+
+  const uint64_t start = rdtsc();
+  const int32_t ret = syscall_table[num](regs);
+  Trace::record(pid, num, args, ret, rdtsc() - start);
+  return ret;
+}
+
+// Run one ring submission through the syscall table. Only calls on files
+// and paths are allowed: they depend on nothing but their arguments and the
+// fd table, and restart cleanly when parked. Calls that replace the address
+// space, exit, sleep or touch signal state complete with -EINVAL.
+static int32_t run_ring_call(const ring_sqe& sqe) {
+  switch (sqe.nr) {
+    case SYS_READ:
+    case SYS_WRITE:
+    case SYS_OPEN:
+    case SYS_CLOSE:
+    case SYS_LSEEK:
+    case SYS_STAT:
+    case SYS_FSTAT:
+    case SYS_GETDENTS:
+    case SYS_MKDIR:
+    case SYS_UNLINK:
+    case SYS_RENAME:
+    case SYS_READV:
+    case SYS_WRITEV:
+      break;
+    default:
+      return -EINVAL;
+  }
+  TrapFrame frame = {};
+  frame.eax = sqe.nr;
+  frame.ebx = sqe.args[0];
+  frame.ecx = sqe.args[1];
+  frame.edx = sqe.args[2];
+  return syscall_table[sqe.nr](&frame);
+}
 
 __BEGIN_DECLS
 
-// Assembly entry point defined in syscall_entry.S.
+// Assembly entry points defined in trap_entry.S.
 void syscall_entry();
+void sysenter_entry();
 
 // Assembly entry point defined in trap_entry.S.
 void page_fault_entry();
@@ -1105,18 +1703,21 @@ uint32_t syscall_dispatch(uint32_t esp) {
   assert(regs != nullptr && "syscall_dispatch(): regs pointer is null");
   const uint32_t num = regs->eax;
 
+  Scheduler::account_syscall_entry();
+
   if (num >= SYS_MAX) {
     regs->eax = static_cast<uint32_t>(-ENOSYS);
     Scheduler::check_pending_signals(regs);
     return Scheduler::schedule(esp);
   }
 
-  const int32_t ret = syscall_table[num](regs);
+  const int32_t ret = Trace::enabled ? traced_call(regs, num) : syscall_table[num](regs);
 
   if (ret == kSyscallRestart) {
-    // Rewind EIP past the "int $0x80" instruction (opcode CD 80, 2 bytes)
-    // so it re-executes when the process is rescheduled. EAX still holds
-    // the syscall number (we do not overwrite it).
+    // Rewind EIP past the "int $0x80" (CD 80) or "sysenter" (0F 34)
+    // instruction, both 2 bytes, so it re-executes when the process is
+    // rescheduled. EAX still holds the syscall number (we do not overwrite
+    // it).
     regs->eip -= 2;
     Scheduler::block_current();
   } else {
@@ -1133,6 +1734,35 @@ uint32_t syscall_dispatch(uint32_t esp) {
 
 __END_DECLS
 
+namespace {
+
+bool sysenter_enabled = false;
+
+// SEP in CPUID, minus the early Pentium Pros that report it without
+// implementing it (family 6, model < 3, stepping < 3). libc applies the
+// same test when choosing its syscall stub.
+bool cpu_has_sysenter() {
+  const CpuidResult r = cpuid(1);
+  if ((r.edx & CPUID_FEAT_EDX_SEP) == 0U) {
+    return false;
+  }
+  const uint32_t family = (r.eax >> 8) & 0xF;
+  const uint32_t model = (r.eax >> 4) & 0xF;
+  const uint32_t stepping = r.eax & 0xF;
+  return !(family == 6 && model < 3 && stepping < 3);
+}
+
+// Point the calling CPU's SYSENTER MSRs at sysenter_entry. The stack MSR
+// holds the address of the CPU's TSS.esp0 rather than a stack, so it need
+// not change on context switches.
+void program_sysenter(uint32_t cpu) {
+  wrmsr(IA32_SYSENTER_CS, GDT::KERNEL_CODE_SELECTOR);
+  wrmsr(IA32_SYSENTER_ESP, reinterpret_cast<uint32_t>(&TSS::tss[cpu].esp0));
+  wrmsr(IA32_SYSENTER_EIP, reinterpret_cast<uint32_t>(sysenter_entry));
+}
+
+}  // namespace
+
 namespace Syscall {
 
 void init() {
@@ -1143,6 +1773,19 @@ void init() {
   // TRAP_ENTRY stub so we can deliver SIGSEGV and context-switch on page faults.
   IDT::set_entry(14, reinterpret_cast<uintptr_t>(page_fault_entry), IDT::Gate::Interrupt,
                  IDT::Ring::Kernel);
+
+  sysenter_enabled = cpu_has_sysenter();
+  if (sysenter_enabled) {
+    program_sysenter(0);
+  }
 }
 
+void init_ap(uint32_t cpu) {
+  if (sysenter_enabled) {
+    program_sysenter(cpu);
+  }
+}
+
+bool has_sysenter() { return sysenter_enabled; }
+
 }  // namespace Syscall
@@ -0,0 +1,123 @@
+#include "timer.h"
+
+#include <assert.h>
+
+#include "pit.h"
+
+namespace {
+
+// Root of the pairing heap: the pending timer with the earliest deadline.
+// Each timer's children are a list through sibling/prev, and every child's
+// deadline is at or after its parent's.
+Timer* root = nullptr;
+
+// Meld two detached heaps; the root with the later deadline becomes the
+// first child of the other.
+Timer* meld(Timer* a, Timer* b) {
+  if (a == nullptr) {
+    return b;
+  }
+  if (b == nullptr) {
+    return a;
+  }
+  if (b->deadline_ns < a->deadline_ns) {
+    Timer* tmp = a;
+    a = b;
+    b = tmp;
+  }
+  b->prev = a;
+  b->sibling = a->child;
+  if (a->child != nullptr) {
+    a->child->prev = b;
+  }
+  a->child = b;
+  a->sibling = nullptr;
+  a->prev = nullptr;
+  return a;
+}
+
+// Meld a list of sibling heaps into one: pairwise left to right, then the
+// pairs right to left. This keeps the amortised cost of removals O(log n).
+Timer* merge_pairs(Timer* first) {
+  Timer* pairs = nullptr;  // melded pairs, most recent first
+  while (first != nullptr) {
+    Timer* a = first;
+    Timer* b = a->sibling;
+    first = b != nullptr ? b->sibling : nullptr;
+    a->sibling = nullptr;
+    a->prev = nullptr;
+    if (b != nullptr) {
+      b->sibling = nullptr;
+      b->prev = nullptr;
+    }
+    Timer* pair = meld(a, b);
+    pair->sibling = pairs;
+    pairs = pair;
+  }
+
+  Timer* result = nullptr;
+  while (pairs != nullptr) {
+    Timer* next = pairs->sibling;
+    pairs->sibling = nullptr;
+    result = meld(result, pairs);
+    pairs = next;
+  }
+  return result;
+}
+
+// Take a pending timer out of the heap.
+void remove(Timer* t) {
+  if (t == root) {
+    root = merge_pairs(t->child);
+  } else {
+    if (t->prev->child == t) {
+      t->prev->child = t->sibling;
+    } else {
+      t->prev->sibling = t->sibling;
+    }
+    if (t->sibling != nullptr) {
+      t->sibling->prev = t->prev;
+    }
+    root = meld(root, merge_pairs(t->child));
+  }
+  t->child = nullptr;
+  t->sibling = nullptr;
+  t->prev = nullptr;
+  t->pending = false;
+}
+
+}  // namespace
+
+void add_timer(Timer* t, uint64_t deadline_ns, TimerCallback callback, void* arg) {
+  assert(t != nullptr && "add_timer(): null timer");
+  assert(callback != nullptr && "add_timer(): null callback");
+
+  if (timer_pending(t)) {
+    remove(t);
+  }
+  t->deadline_ns = deadline_ns;
+  t->callback = callback;
+  t->arg = arg;
+  t->pending = true;
+  root = meld(root, t);
+}
+
+bool cancel_timer(Timer* t) {
+  assert(t != nullptr && "cancel_timer(): null timer");
+  if (!timer_pending(t)) {
+    return false;
+  }
+  remove(t);
+  return true;
+}
+
+void run_timers(uint64_t now_ns) {
+  while (root != nullptr && root->deadline_ns <= now_ns) {
+    Timer* t = root;
+    remove(t);
+    // Removed before the call so the callback may re-add t.
+    t->callback(t->arg);
+  }
+}
+
+uint64_t next_timer_deadline() { return root != nullptr ? root->deadline_ns : PIT::kNoDeadline; }
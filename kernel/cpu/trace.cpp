@@ -0,0 +1,110 @@
+#include "trace.h"
+
+#include <array.h>
+#include <string.h>
+#include <sys/syscall.h>
+
+#include "process.h"
+#include "ring_buffer.h"
+
+namespace Trace {
+
+bool enabled = false;
+
+namespace {
+
+uint32_t traced_pid = 0;
+uint32_t next_seq = 0;
+uint32_t dropped = 0;
+RingBuffer<trace_event, kCapacity> events;
+std::array<trace_hist, SYS_MAX> hists;
+
+// Index of the highest set bit, i.e. floor(log2(cycles)); 0 for 0 and 1.
+uint32_t bucket_for(uint64_t cycles) {
+  const auto high = static_cast<uint32_t>(cycles >> 32);
+  if (high != 0) {
+    return 63 - static_cast<uint32_t>(__builtin_clz(high));
+  }
+  const auto low = static_cast<uint32_t>(cycles);
+  return low == 0 ? 0 : 31 - static_cast<uint32_t>(__builtin_clz(low));
+}
+
+// Syscall events leave the last slot free, so the exit event a reader
+// waits for is only lost if it has not drained even that one.
+void push(const trace_event& event, size_t limit) {
+  if (events.size() >= limit || !events.push(event)) {
+    ++dropped;
+  }
+}
+
+}  // namespace
+
+void start(uint32_t pid) {
+  trace_event discard;
+  while (events.pop(discard)) {
+  }
+  memset(hists.data(), 0, sizeof(hists));
+  next_seq = 0;
+  dropped = 0;
+  traced_pid = pid;
+  enabled = true;
+}
+
+void stop() { enabled = false; }
+
+bool traces(const Process* proc) {
+  return traced_pid == TRACE_ALL || proc->group()->pid == traced_pid;
+}
+
+void record(uint32_t pid, uint32_t nr, const uint32_t (&args)[3], int32_t ret, uint64_t cycles) {
+  push(trace_event{.seq = next_seq++,
+                   .pid = pid,
+                   .nr = nr,
+                   .args = {args[0], args[1], args[2]},
+                   .ret = ret,
+                   .reserved = 0,
+                   .cycles = cycles},
+       kCapacity - 1);
+
+  trace_hist& hist = hists[nr];
+  ++hist.count;
+  if (ret < 0 && ret != TRACE_RET_RESTART) {
+    ++hist.errors;
+  }
+  hist.total_cycles += cycles;
+  if (cycles > hist.max_cycles) {
+    hist.max_cycles = cycles;
+  }
+  const uint32_t bucket = bucket_for(cycles);
+  ++hist.buckets[bucket < TRACE_BUCKETS ? bucket : TRACE_BUCKETS - 1];
+}
+
+void process_exited(const Process* proc, int32_t exit_code) {
+  if (!enabled || !traces(proc)) {
+    return;
+  }
+  push(trace_event{.seq = next_seq++,
+                   .pid = proc->pid,
+                   .nr = TRACE_EXIT_NR,
+                   .args = {0, 0, 0},
+                   .ret = exit_code,
+                   .reserved = 0,
+                   .cycles = 0},
+       kCapacity);
+}
+
+size_t read(std::span<trace_event> out) {
+  size_t n = 0;
+  while (n < out.size() && events.pop(out[n])) {
+    ++n;
+  }
+  return n;
+}
+
+uint32_t stats(std::span<trace_hist> out) {
+  const size_t n = out.size() < hists.size() ? out.size() : hists.size();
+  memcpy(out.data(), hists.data(), n * sizeof(trace_hist));
+  return dropped;
+}
+
+}  // namespace Trace
@@ -0,0 +1,86 @@
+#include "vdso.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "address_space.h"
+#include "pit.h"
+#include "pmm.h"
+#include "x86.h"
+
+static constexpr uint32_t CPUID_FEAT_EDX_TSC = 1U << 4;
+
+namespace {
+
+paddr_t page_phys = 0;
+vdso_time* time_page = nullptr;
+bool has_tsc = false;
+
+// Calibration reference taken by init().
+uint64_t ref_ns = 0;
+uint64_t ref_tsc = 0;
+
+// Read the PIT clock and the TSC as close together as possible: the PIT
+// read is slow port I/O, so the TSC is sampled on both sides of it.
+void sample(uint64_t& ns, uint64_t& tsc) {
+  const uint64_t before = has_tsc ? rdtsc() : 0;
+  ns = PIT::now_ns();
+  const uint64_t after = has_tsc ? rdtsc() : 0;
+  tsc = before + ((after - before) / 2);
+}
+
+}  // namespace
+
+namespace Vdso {
+
+void init() {
+  assert(time_page == nullptr && "Vdso::init(): called more than once");
+
+  page_phys = kPmm.alloc();
+  assert(page_phys && "Vdso::init(): out of physical memory");
+  time_page = phys_to_virt(page_phys).ptr<vdso_time>();
+  memset(time_page, 0, PAGE_SIZE);
+
+  has_tsc = (cpuid(1).edx & CPUID_FEAT_EDX_TSC) != 0U;
+  sample(ref_ns, ref_tsc);
+  update();
+}
+
+void map(PageTable* pd) {
+  assert(time_page != nullptr && "Vdso::map(): called before init()");
+  AddressSpace::map_shared(pd, kTimePageVA, page_phys, /*writeable=*/false);
+}
+
+void update() {
+  if (time_page == nullptr) {
+    return;
+  }
+
+  uint64_t ns = 0;
+  uint64_t tsc = 0;
+  sample(ns, tsc);
+
+  uint32_t mult = time_page->tsc_mult;
+  const uint64_t elapsed_ns = ns - ref_ns;
+  if (has_tsc && elapsed_ns >= kCalibrateMinNs && elapsed_ns <= kCalibrateMaxNs &&
+      tsc > ref_tsc) {
+    const uint64_t m = (elapsed_ns << VDSO_TSC_SHIFT) / (tsc - ref_tsc);
+    mult = m > UINT32_MAX ? 0 : static_cast<uint32_t>(m);
+  }
+
+  // Seqlock write side. Stores are not reordered with other stores on x86,
+  // so compiler barriers are enough to order them for readers.
+  volatile vdso_time* vt = time_page;
+  vt->seq = vt->seq + 1;
+  __asm__ volatile("" ::: "memory");
+  vt->tsc_mult = mult;
+  vt->ns = ns;
+  vt->tsc = tsc;
+  vt->ticks = ns / PIT::kTickNs;
+  __asm__ volatile("" ::: "memory");
+  vt->seq = vt->seq + 1;
+}
+
+const vdso_time* page() { return time_page; }
+
+}  // namespace Vdso
@@ -0,0 +1,49 @@
+#include "wait_queue.h"
+
+#include <assert.h>
+
+#include "process.h"
+
+void WaitQueue::push(Process* p) {
+  assert(p != nullptr && "WaitQueue::push(): null process");
+  p->next = nullptr;
+  if (tail == nullptr) {
+    head = tail = p;
+  } else {
+    tail->next = p;
+    tail = p;
+  }
+}
+
+Process* WaitQueue::pop() {
+  Process* p = head;
+  if (p == nullptr) {
+    return nullptr;
+  }
+  head = p->next;
+  if (head == nullptr) {
+    tail = nullptr;
+  }
+  p->next = nullptr;
+  return p;
+}
+
+bool WaitQueue::remove(Process* p) {
+  Process* prev = nullptr;
+  for (Process* cur = head; cur != nullptr; prev = cur, cur = cur->next) {
+    if (cur != p) {
+      continue;
+    }
+    if (prev != nullptr) {
+      prev->next = cur->next;
+    } else {
+      head = cur->next;
+    }
+    if (tail == cur) {
+      tail = prev;
+    }
+    cur->next = nullptr;
+    return true;
+  }
+  return false;
+}
@@ -50,11 +50,12 @@ bool wait_bsy() {
   }
 }
 
-// Program the LBA28 registers and issue a single-sector command to the master drive.
-void issue_lba28(uint32_t lba, uint8_t cmd) {
+// Program the LBA28 registers and issue a command for `count` sectors
+// (256 encoded as 0) to the master drive.
+void issue_lba28(uint32_t lba, uint8_t cmd, uint32_t count = 1) {
   outb(kRegControl, 0x02);  // nIEN: disable interrupt delivery
   outb(kRegDrvHead, static_cast<uint8_t>(0xE0 | ((lba >> 24) & 0x0F)));
-  outb(kRegSecCnt, 1);
+  outb(kRegSecCnt, static_cast<uint8_t>(count));
   outb(kRegLbaLo, static_cast<uint8_t>(lba));
   outb(kRegLbaMid, static_cast<uint8_t>(lba >> 8));
   outb(kRegLbaHi, static_cast<uint8_t>(lba >> 16));
@@ -116,6 +117,27 @@ bool read_sector(uint32_t lba, uint8_t buf[512]) {
   return true;
 }
 
+bool read_sectors(uint32_t lba, uint32_t count, uint8_t* buf) {
+  if (!s_present || count == 0 || count > kAtaMaxSectorsPerCommand) {
+    return false;
+  }
+  wait_bsy();
+  issue_lba28(lba, kCmdReadSectors, count);
+
+  // The drive goes busy again after each sector and raises DRQ once the
+  // next one is ready.
+  auto* words = reinterpret_cast<uint16_t*>(buf);
+  for (uint32_t sec = 0; sec < count; ++sec) {
+    if (!wait_bsy() || !wait_drq()) {
+      return false;
+    }
+    for (int i = 0; i < 256; ++i) {
+      *words++ = inw(kRegData);
+    }
+  }
+  return true;
+}
+
 bool write_sector(uint32_t lba, const uint8_t buf[512]) {
   if (!s_present) {
     return false;
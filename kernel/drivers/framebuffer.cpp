@@ -19,6 +19,35 @@ size_t fb_size = 0;
 // 16 MiB should be enough for resolutions up to 2048x2048x4.
 constexpr vaddr_t kFbVirtBase{0xFD000000};
 
+// Placement of a src_w x src_h image scaled by blit_scaled().
+struct ScaledLayout {
+  uint32_t scale;  // integer magnification, at least 1
+  uint32_t dst_w;  // scaled size in pixels
+  uint32_t dst_h;
+  uint32_t off_x;  // letterbox margins in pixels
+  uint32_t off_y;
+};
+
+ScaledLayout scaled_layout(uint32_t src_w, uint32_t src_h) {
+  const uint32_t fb_w = fb_info.width;
+  const uint32_t fb_h = fb_info.height;
+
+  // Integer scale factor: largest multiplier that fits both dimensions.
+  const uint32_t scale_x = fb_w / src_w;
+  const uint32_t scale_y = fb_h / src_h;
+  const uint32_t scale = std::max<uint32_t>((scale_x < scale_y) ? scale_x : scale_y, 1);
+
+  const uint32_t dst_w = src_w * scale;
+  const uint32_t dst_h = src_h * scale;
+  return ScaledLayout{
+      .scale = scale,
+      .dst_w = dst_w,
+      .dst_h = dst_h,
+      .off_x = (fb_w > dst_w) ? (fb_w - dst_w) / 2 : 0,
+      .off_y = (fb_h > dst_h) ? (fb_h - dst_h) / 2 : 0,
+  };
+}
+
 }  // namespace
 
 namespace Framebuffer {
@@ -101,59 +130,51 @@ void blit_scaled(const uint32_t* src, uint32_t src_w, uint32_t src_h) {
   if (src_w == 0 || src_h == 0) {
     return;
   }
+  clear_letterbox(src_w, src_h);
+  for (uint32_t row = 0; row < src_h; ++row) {
+    blit_scaled_row(src + (row * src_w), src_w, src_h, row);
+  }
+}
 
-  const uint32_t fb_w = fb_info.width;
-  const uint32_t fb_h = fb_info.height;
-  const uint32_t bytes_per_pixel = fb_info.bpp / 8;
-
-  // Integer scale factor: largest multiplier that fits both dimensions.
-  const uint32_t scale_x = fb_w / src_w;
-  const uint32_t scale_y = fb_h / src_h;
-  uint32_t scale = (scale_x < scale_y) ? scale_x : scale_y;
-  scale = std::max<uint32_t>(scale, 1);
-
-  const uint32_t dst_w = src_w * scale;
-  const uint32_t dst_h = src_h * scale;
-  const uint32_t off_x = (fb_w > dst_w) ? (fb_w - dst_w) / 2 : 0;
-  const uint32_t off_y = (fb_h > dst_h) ? (fb_h - dst_h) / 2 : 0;
-
-  // If no letterboxing, skip clearing and just blit directly.
-  if (off_x == 0 && off_y == 0) {
-    for (uint32_t r = 0; r < dst_h; ++r) {
-      const uint32_t src_row = r / scale;
-      auto* dst_row = reinterpret_cast<uint32_t*>(fb_buffer + (r * fb_info.pitch));
-      for (uint32_t c = 0; c < dst_w; ++c) {
-        const uint32_t src_col = c / scale;
-        dst_row[c] = src[(src_row * src_w) + src_col];
-      }
-    }
+void clear_letterbox(uint32_t src_w, uint32_t src_h) {
+  const ScaledLayout layout = scaled_layout(src_w, src_h);
+  if (layout.off_x == 0 && layout.off_y == 0) {
     return;
   }
-
-  // Clear the letterbox regions: top, bottom, left, right bars.
+  const uint32_t bytes_per_pixel = fb_info.bpp / 8;
 
   // Top bar.
-  memset(fb_buffer, 0, off_y * fb_info.pitch);
+  memset(fb_buffer, 0, layout.off_y * fb_info.pitch);
 
   // Bottom bar.
-  memset(fb_buffer + ((off_y + dst_h) * fb_info.pitch), 0, off_y * fb_info.pitch);
+  memset(fb_buffer + ((layout.off_y + layout.dst_h) * fb_info.pitch), 0,
+         layout.off_y * fb_info.pitch);
+
+  // Left and right bars (within the middle region).
+  for (uint32_t r = 0; r < layout.dst_h; ++r) {
+    uint8_t* line = fb_buffer + ((layout.off_y + r) * fb_info.pitch);
+    memset(line, 0, layout.off_x * bytes_per_pixel);
+    memset(line + ((layout.off_x + layout.dst_w) * bytes_per_pixel), 0,
+           layout.off_x * bytes_per_pixel);
+  }
+}
 
-  // Left bar (within the middle region).
-  for (uint32_t r = 0; r < dst_h; ++r) {
-    memset(fb_buffer + ((off_y + r) * fb_info.pitch), 0, off_x * bytes_per_pixel);
-    memset(fb_buffer + ((off_y + r) * fb_info.pitch) + ((off_x + dst_w) * bytes_per_pixel), 0,
-           off_x * bytes_per_pixel);
+void blit_scaled_row(const uint32_t* row, uint32_t src_w, uint32_t src_h, uint32_t src_row) {
+  if (src_w == 0 || src_row >= src_h) {
+    return;
   }
+  const ScaledLayout layout = scaled_layout(src_w, src_h);
+  const uint32_t bytes_per_pixel = fb_info.bpp / 8;
 
-  for (uint32_t r = 0; r < dst_h; ++r) {
-    const uint32_t src_row = r / scale;
-    // Pointer to the start of the destination row in the framebuffer.
-    auto* dst_row = reinterpret_cast<uint32_t*>(fb_buffer + ((off_y + r) * fb_info.pitch) +
-                                                (off_x * bytes_per_pixel));
-    for (uint32_t c = 0; c < dst_w; ++c) {
-      const uint32_t src_col = c / scale;
-      dst_row[c] = src[(src_row * src_w) + src_col];
-    }
+  // Scale the row once, then repeat it for the remaining scale - 1 lines.
+  const uint32_t first = layout.off_y + (src_row * layout.scale);
+  uint8_t* first_line = fb_buffer + (first * fb_info.pitch) + (layout.off_x * bytes_per_pixel);
+  auto* dst = reinterpret_cast<uint32_t*>(first_line);
+  for (uint32_t c = 0; c < layout.dst_w; ++c) {
+    dst[c] = row[c / layout.scale];
+  }
+  for (uint32_t r = 1; r < layout.scale; ++r) {
+    memcpy(first_line + (r * fb_info.pitch), first_line, layout.dst_w * bytes_per_pixel);
   }
 }
 
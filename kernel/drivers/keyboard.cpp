@@ -5,7 +5,11 @@
 #include <stdio.h>
 #include <sys/io.h>
 
+#include "idt.h"
 #include "interrupt.h"
+#include "lock_stats.h"
+#include "pic.h"
+#include "poller.h"
 #include "qemu.h"
 #include "scheduler.h"
 #include "terminal.h"
@@ -152,12 +156,29 @@ bool Key::is_modifier() const {
 
 KeyboardDriver kKeyboard;
 
-static void keyboard_handler([[maybe_unused]] interrupt_frame* frame) {
+__BEGIN_DECLS
+
+// Assembly entry point defined in trap_entry.S.
+void keyboard_entry();
+
+// Keyboard IRQ dispatch. Called from keyboard_entry with the TrapFrame ESP.
+// Buffers the key, then switches straight to any reader the key woke if the
+// CPU was idling.
+uint32_t keyboard_dispatch(uint32_t esp) {
   const uint8_t scancode = inb(kDataPort);
   kKeyboard.process_scancode(scancode);
+  PIC::send_eoi(static_cast<uint8_t>(IRQ::Keyboard));
+  return Scheduler::preempt_idle(esp);
 }
 
-void KeyboardDriver::init() { Interrupt::register_handler(IRQ::Keyboard, keyboard_handler); }
+__END_DECLS
+
+void KeyboardDriver::init() {
+  IDT::set_entry(32 + static_cast<uint8_t>(IRQ::Keyboard),
+                 reinterpret_cast<uintptr_t>(keyboard_entry), IDT::Gate::Interrupt,
+                 IDT::Ring::Kernel);
+  PIC::unmask(static_cast<uint8_t>(IRQ::Keyboard));
+}
 
 void KeyboardDriver::process_scancode(uint8_t scancode) {
   // First, try to process as a command response.
@@ -174,6 +195,8 @@ void KeyboardDriver::process_scancode(uint8_t scancode) {
     ke.key = event.key.value();
     ke.pressed = event.pressed ? 1 : 0;
     static_cast<void>(event_buffer_.push(ke));
+    Scheduler::wake_all(event_waiters_);
+    Poll::notify();
   }
 
   // Shift+PageUp/PageDown: scroll the terminal without buffering the key.
@@ -204,6 +227,12 @@ void KeyboardDriver::process_scancode(uint8_t scancode) {
     return;
   }
 
+  // Ctrl+Alt+L: dump lock statistics to the debugcon port.
+  if (event.pressed && event.ctrl && event.alt && event.key == Key::L) {
+    lock_stats_dump();
+    return;
+  }
+
   // Buffer printable characters for sys_read.
   if (event.ascii != '\0') {
     buffer_char(event.ascii);
@@ -238,6 +267,8 @@ void KeyboardDriver::process_scancode(uint8_t scancode) {
 
 void KeyboardDriver::buffer_char(char c) {
   static_cast<void>(input_buffer_.push(c));  // Drop char if buffer full
+  Scheduler::wake_all(input_waiters_);
+  Poll::notify();
 }
 
 size_t KeyboardDriver::read(char* buf, size_t count) {
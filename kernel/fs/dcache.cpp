@@ -0,0 +1,107 @@
+#include "dcache.h"
+
+#include <array.h>
+#include <string.h>
+
+#include "spinlock.h"
+#include "vfs.h"
+
+namespace {
+
+struct Entry {
+  const VfsNode* parent;  // nullptr for an empty slot
+  VfsNode* node;          // nullptr for a negative entry
+  uint32_t generation;    // valid only while equal to `generation`
+  uint32_t hash;
+  char name[kMaxNameLen];
+};
+
+SpinLock dcache_lock{"vfs_dcache"};
+std::array<Entry, Dcache::kSlots> slots;
+Dcache::Stats counters;
+
+// Bumped by invalidate_all(); entries from older generations are empty.
+// Starts at 1 so the zero-initialised table holds no valid entries.
+uint32_t generation = 1;
+
+// FNV-1a over the name, seeded with the parent's address.
+uint32_t hash_of(const VfsNode* parent, const char* name) {
+  uint32_t h = 2166136261U ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(parent));
+  for (const char* p = name; *p != '\0'; ++p) {
+    h = (h ^ static_cast<uint8_t>(*p)) * 16777619U;
+  }
+  return h;
+}
+
+Entry& slot_for(uint32_t hash) { return slots[hash & (Dcache::kSlots - 1)]; }
+
+bool matches(const Entry& e, const VfsNode* parent, uint32_t hash, const char* name) {
+  return e.generation == generation && e.parent == parent && e.hash == hash &&
+         strcmp(e.name, name) == 0;
+}
+
+}  // namespace
+
+namespace Dcache {
+
+bool lookup(const VfsNode* parent, const char* name, VfsNode** node) {
+  const uint32_t hash = hash_of(parent, name);
+  const LockGuard guard(dcache_lock);
+  const Entry& e = slot_for(hash);
+  if (!matches(e, parent, hash, name)) {
+    ++counters.misses;
+    return false;
+  }
+  if (e.node != nullptr) {
+    ++counters.hits;
+  } else {
+    ++counters.negative_hits;
+  }
+  *node = e.node;
+  return true;
+}
+
+void insert(const VfsNode* parent, const char* name, VfsNode* node) {
+  const size_t len = strlen(name);
+  if (len >= kMaxNameLen) {
+    return;
+  }
+  const uint32_t hash = hash_of(parent, name);
+  const LockGuard guard(dcache_lock);
+  Entry& e = slot_for(hash);
+  e.parent = parent;
+  e.node = node;
+  e.generation = generation;
+  e.hash = hash;
+  memcpy(e.name, name, len + 1);
+}
+
+void forget(const VfsNode* parent, const char* name) {
+  const uint32_t hash = hash_of(parent, name);
+  const LockGuard guard(dcache_lock);
+  Entry& e = slot_for(hash);
+  if (matches(e, parent, hash, name)) {
+    e.parent = nullptr;
+  }
+}
+
+void invalidate_all() {
+  const LockGuard guard(dcache_lock);
+  if (++generation == 0) {
+    // Wrapped: entries from generation 0 would look valid again.
+    memset(slots.data(), 0, sizeof(slots));
+    generation = 1;
+  }
+}
+
+Stats stats() {
+  const LockGuard guard(dcache_lock);
+  return counters;
+}
+
+void reset_stats() {
+  const LockGuard guard(dcache_lock);
+  counters = {};
+}
+
+}  // namespace Dcache
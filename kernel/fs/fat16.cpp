@@ -9,7 +9,11 @@
 #include <string.h>
 
 #include "ata.h"
+#include "file.h"
 #include "heap.h"
+#include "mutex.h"
+#include "page_cache.h"
+#include "paging.h"
 #include "scheduler.h"
 #include "vfs.h"
 
@@ -117,6 +121,21 @@ struct FatState {
 
 FatState s;
 
+// Serialises the VfsOps callbacks below: they share the in-memory FAT and
+// read-modify-write whole sectors, so interleaved calls could corrupt both.
+Mutex fat_mutex{"fat"};
+
+// Take fat_mutex. A process that finds it held is parked and gets
+// kSyscallRestart; a kernel thread (the page cache's write-back) cannot
+// restart and gets -EBUSY instead.
+int32_t fat_lock() {
+  const Process* self = Scheduler::current();
+  if (self != nullptr && self->kernel_thread) {
+    return fat_mutex.try_lock() ? 0 : -EBUSY;
+  }
+  return fat_mutex.lock_or_wait() ? 0 : kSyscallRestart;
+}
+
 // ===========================================================================
 // FAT chain helpers
 // ===========================================================================
@@ -359,10 +378,22 @@ bool find_free_dir_slot(uint32_t dir_cluster, uint32_t* out_lba, uint32_t* out_o
 // VfsOps callbacks
 // ===========================================================================
 
-int32_t fat_read(VfsNode* node, std::span<uint8_t> buf, uint32_t offset) {
-  assert(s.mounted && "fat_read(): filesystem not mounted");
+// Sectors fat_readv() reads with one ATA command, at most (32 KiB, a
+// quarter of the page cache's largest read-ahead run). Its bounce buffer
+// is static: fat_mutex is held while it is in use.
+constexpr uint32_t kReadRunSectors = 64;
+static_assert(kReadRunSectors <= kAtaMaxSectorsPerCommand, "read run too long for one command");
+uint8_t read_run[kReadRunSectors * kAtaSectorSize];
+
+int32_t fat_readv(VfsNode* node, IoVec iov, uint32_t offset) {
+  assert(s.mounted && "fat_readv(): filesystem not mounted");
   auto* fi = static_cast<FatFileInfo*>(node->priv);
-  assert(fi != nullptr && "fat_read(): node missing FatFileInfo");
+  assert(fi != nullptr && "fat_readv(): node missing FatFileInfo");
+  const int32_t locked = fat_lock();
+  if (locked < 0) {
+    return locked;
+  }
+  const MutexGuard guard(fat_mutex);
 
   if (offset >= fi->file_size || fi->start_cluster == 0) {
     return 0;
@@ -372,9 +403,8 @@ int32_t fat_read(VfsNode* node, std::span<uint8_t> buf, uint32_t offset) {
   const uint32_t spc = s.sectors_per_cluster;
   const uint32_t bytes_per_cluster = bps * spc;
 
-  const auto buf_len = static_cast<uint32_t>(buf.size());
   const uint32_t available = fi->file_size - offset;
-  uint32_t remaining = std::min(buf_len, available);
+  uint32_t remaining = std::min(iov_length(iov), available);
   uint32_t out_pos = 0;
 
   const uint32_t cluster_idx = offset / bytes_per_cluster;
@@ -388,39 +418,61 @@ int32_t fat_read(VfsNode* node, std::span<uint8_t> buf, uint32_t offset) {
     }
   }
 
-  uint8_t sector_buf[512];
-
   while (remaining > 0 && cluster >= 2 && !fat_is_eoc(cluster)) {
-    const uint32_t clus_sector = cluster_to_sector(cluster);
-    uint32_t sector_idx = cluster_off / bps;
-    uint32_t byte_in_sec = cluster_off % bps;
-
-    while (remaining > 0 && sector_idx < spc) {
-      if (!Ata::read_sector(clus_sector + sector_idx, sector_buf)) {
-        return -1;
-      }
-      const uint32_t sec_avail = bps - byte_in_sec;
-      const uint32_t to_copy = std::min(remaining, sec_avail);
-      memcpy(buf.data() + out_pos, sector_buf + byte_in_sec, to_copy);
-      out_pos += to_copy;
-      remaining -= to_copy;
-      byte_in_sec = 0;
-      ++sector_idx;
+    // Every sector the request still needs, in one transfer up to the size
+    // of the bounce buffer: the rest of this cluster and of any clusters
+    // that follow it on disk.
+    const uint32_t sector_idx = cluster_off / bps;
+    const uint32_t byte_in_sec = cluster_off % bps;
+    const uint32_t wanted = std::min((byte_in_sec + remaining + bps - 1) / bps, kReadRunSectors);
+    uint32_t count = spc - sector_idx;
+    uint32_t last = cluster;
+    uint32_t next = fat_get(cluster);
+    while (count < wanted && next == last + 1) {
+      count += spc;
+      last = next;
+      next = fat_get(next);
+    }
+    count = std::min(count, wanted);
+    if (!Ata::read_sectors(cluster_to_sector(cluster) + sector_idx, count, read_run)) {
+      return -1;
+    }
+    const uint32_t to_copy = std::min(remaining, (count * bps) - byte_in_sec);
+    iov_scatter(iov, out_pos, read_run + byte_in_sec, to_copy);
+    out_pos += to_copy;
+    remaining -= to_copy;
+
+    // Continue after the last sector read: inside the run, or in the
+    // cluster the chain goes to next.
+    const uint32_t pos = (sector_idx + count) * bps;
+    if (pos >= (last - cluster + 1) * bytes_per_cluster) {
+      cluster = next;
+      cluster_off = 0;
+    } else {
+      cluster += pos / bytes_per_cluster;
+      cluster_off = pos % bytes_per_cluster;
     }
-
-    cluster_off = 0;
-    cluster = fat_get(cluster);
   }
 
   return static_cast<int32_t>(out_pos);
 }
 
-int32_t fat_write(VfsNode* node, std::span<const uint8_t> buf, uint32_t offset) {
-  assert(s.mounted && "fat_write(): filesystem not mounted");
+int32_t fat_read(VfsNode* node, std::span<uint8_t> buf, uint32_t offset) {
+  return fat_readv(node, IoVec(&buf, 1), offset);
+}
+
+int32_t fat_writev(VfsNode* node, ConstIoVec iov, uint32_t offset) {
+  assert(s.mounted && "fat_writev(): filesystem not mounted");
   auto* fi = static_cast<FatFileInfo*>(node->priv);
-  assert(fi != nullptr && "fat_write(): node missing FatFileInfo");
+  assert(fi != nullptr && "fat_writev(): node missing FatFileInfo");
+  const int32_t locked = fat_lock();
+  if (locked < 0) {
+    return locked;
+  }
+  const MutexGuard guard(fat_mutex);
 
-  if (buf.empty()) {
+  const uint32_t length = iov_length(iov);
+  if (length == 0) {
     return 0;
   }
 
@@ -428,7 +480,7 @@ int32_t fat_write(VfsNode* node, std::span<const uint8_t> buf, uint32_t offset)
   const uint32_t spc = s.sectors_per_cluster;
   const uint32_t bytes_per_cluster = bps * spc;
 
-  const uint32_t end = offset + static_cast<uint32_t>(buf.size());
+  const uint32_t end = offset + length;
 
   // Extend cluster chain if needed.
   uint32_t allocated = 0;
@@ -461,21 +513,22 @@ int32_t fat_write(VfsNode* node, std::span<const uint8_t> buf, uint32_t offset)
   uint32_t written = 0;
   uint32_t cur_off = offset % bytes_per_cluster;
 
-  while (written < static_cast<uint32_t>(buf.size()) && cluster >= 2 && !fat_is_eoc(cluster)) {
+  while (written < length && cluster >= 2 && !fat_is_eoc(cluster)) {
     const uint32_t clus_sector = cluster_to_sector(cluster);
     uint32_t sector_idx = cur_off / bps;
     uint32_t byte_in_sec = cur_off % bps;
 
-    while (written < static_cast<uint32_t>(buf.size()) && sector_idx < spc) {
+    while (written < length && sector_idx < spc) {
       const uint32_t sec_avail = bps - byte_in_sec;
-      const uint32_t to_write = std::min(static_cast<uint32_t>(buf.size()) - written, sec_avail);
+      const uint32_t to_write = std::min(length - written, sec_avail);
       const uint32_t lba = clus_sector + sector_idx;
 
+      // Only a partly overwritten sector needs its old contents.
       uint8_t sec[512];
-      if (!Ata::read_sector(lba, sec)) {
+      if (to_write < bps && !Ata::read_sector(lba, sec)) {
         return -EIO;
       }
-      memcpy(sec + byte_in_sec, buf.data() + written, to_write);
+      iov_gather(iov, written, sec + byte_in_sec, to_write);
       if (!Ata::write_sector(lba, sec)) {
         return -EIO;
       }
@@ -495,10 +548,28 @@ int32_t fat_write(VfsNode* node, std::span<const uint8_t> buf, uint32_t offset)
   return static_cast<int32_t>(written);
 }
 
+int32_t fat_write(VfsNode* node, std::span<const uint8_t> buf, uint32_t offset) {
+  return fat_writev(node, ConstIoVec(&buf, 1), offset);
+}
+
+// Page cache hooks: one page of the file at a time.
+int32_t fat_read_page(VfsNode* node, uint32_t index, std::span<uint8_t> page) {
+  return fat_readv(node, IoVec(&page, 1), index * PAGE_SIZE);
+}
+
+int32_t fat_write_page(VfsNode* node, uint32_t index, std::span<const uint8_t> data) {
+  return fat_writev(node, ConstIoVec(&data, 1), index * PAGE_SIZE);
+}
+
 int32_t fat_truncate(VfsNode* node) {
   assert(s.mounted && "fat_truncate(): filesystem not mounted");
   auto* fi = static_cast<FatFileInfo*>(node->priv);
   assert(fi != nullptr && "fat_truncate(): node missing FatFileInfo");
+  const int32_t locked = fat_lock();
+  if (locked < 0) {
+    return locked;
+  }
+  const MutexGuard guard(fat_mutex);
 
   if (fi->start_cluster != 0) {
     fat_free_chain(fi->start_cluster);
@@ -515,6 +586,11 @@ const VfsOps fat_ops = {
     .write = fat_write,
     .ioctl = nullptr,
     .truncate = fat_truncate,
+    .readv = fat_readv,
+    .writev = fat_writev,
+    .poll = nullptr,
+    .read_page = fat_read_page,
+    .write_page = fat_write_page,
 };
 
 // ===========================================================================
@@ -766,6 +842,8 @@ int32_t fat_unlink(const char* abs_path) {
     (void)Ata::write_sector(fi->dir_entry_sector, sec);
   }
 
+  // The file is gone: drop its cached pages rather than writing them back.
+  PageCache::invalidate(node);
   delete fi;
   node->priv = nullptr;
   Vfs::unregister_node(abs_path);
@@ -849,19 +927,8 @@ int32_t fat_rename(const char* old_path, const char* new_path) {
   fi->dir_entry_sector = new_lba;
   fi->dir_entry_offset = new_off;
 
-  // Move the node in the VFS tree: unregister from old location, re-register
-  // at new location, and transfer the metadata to the new node.
-  void* saved_priv = node->priv;
-  const size_t saved_size = node->size;
-  const VfsOps* saved_ops = node->ops;
-  Vfs::unregister_node(old_path);
-  VfsNode* new_node = Vfs::register_node(new_path, VfsNodeType::File, saved_ops);
-  if (new_node != nullptr) {
-    new_node->priv = saved_priv;
-    new_node->size = saved_size;
-  }
-
-  return 0;
+  // Move the node itself, so open files and cached pages follow the file.
+  return Vfs::move_node(old_path, new_path);
 }
 
 VfsNode* fat_create(const char* abs_path, [[maybe_unused]] int32_t flags,
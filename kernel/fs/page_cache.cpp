@@ -0,0 +1,486 @@
+#include "page_cache.h"
+
+#include <array.h>
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "paging.h"
+#include "pmm.h"
+#include "scheduler.h"
+#include "vfs.h"
+
+namespace {
+
+struct Page {
+  VfsNode* node;   // nullptr while the descriptor is free
+  uint32_t index;  // page index within the file
+  paddr_t frame;
+  bool dirty;
+  Page* hash_next;  // bucket chain; free list while unused
+  Page* newer;      // LRU neighbours (lru_head is the most recently used)
+  Page* older;
+};
+
+constexpr uint32_t kBucketBits = 8;
+constexpr uint32_t kBuckets = 1U << kBucketBits;
+
+std::array<Page, PageCache::kMaxPages> pages;
+std::array<Page*, kBuckets> buckets;
+Page* lru_head = nullptr;
+Page* lru_tail = nullptr;
+Page* free_pages = nullptr;  // released descriptors
+uint32_t unused = 0;         // pages[unused..] have never been handed out
+uint32_t resident = 0;
+PageCache::Stats counters;
+
+// Fibonacci hash of the node address mixed with the page index.
+uint32_t bucket_of(const VfsNode* node, uint32_t index) {
+  const auto key = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(node)) ^ (index * 0x9E37U);
+  return (key * 2654435761U) >> (32 - kBucketBits);
+}
+
+uint8_t* data(const Page* p) { return phys_to_virt(p->frame).ptr<uint8_t>(); }
+
+Page* find(const VfsNode* node, uint32_t index) {
+  for (Page* p = buckets[bucket_of(node, index)]; p != nullptr; p = p->hash_next) {
+    if (p->node == node && p->index == index) {
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+void lru_remove(Page* p) {
+  (p->newer != nullptr ? p->newer->older : lru_head) = p->older;
+  (p->older != nullptr ? p->older->newer : lru_tail) = p->newer;
+  p->newer = nullptr;
+  p->older = nullptr;
+}
+
+void lru_push(Page* p) {
+  p->newer = nullptr;
+  p->older = lru_head;
+  (lru_head != nullptr ? lru_head->newer : lru_tail) = p;
+  lru_head = p;
+}
+
+// Make a filled page visible to lookups, as the most recently used.
+void link(Page* p) {
+  Page*& bucket = buckets[bucket_of(p->node, p->index)];
+  p->hash_next = bucket;
+  bucket = p;
+  lru_push(p);
+  ++resident;
+}
+
+// Return an unlinked descriptor and its frame.
+void free_page(Page* p) {
+  kPmm.free(p->frame);
+  p->node = nullptr;
+  p->hash_next = free_pages;
+  free_pages = p;
+}
+
+// Unlink a page and free it, discarding its contents.
+void release(Page* p) {
+  Page** slot = &buckets[bucket_of(p->node, p->index)];
+  while (*slot != p) {
+    slot = &(*slot)->hash_next;
+  }
+  *slot = p->hash_next;
+  lru_remove(p);
+  free_page(p);
+  --resident;
+}
+
+// Bytes of the page that lie inside the file.
+uint32_t file_bytes(const Page* p) {
+  const size_t start = static_cast<size_t>(p->index) * PAGE_SIZE;
+  const size_t size = p->node->size;
+  if (size <= start) {
+    return 0;
+  }
+  return size - start < PAGE_SIZE ? static_cast<uint32_t>(size - start) : PAGE_SIZE;
+}
+
+int32_t write_back(Page* p) {
+  VfsNode* node = p->node;
+  const uint32_t len = file_bytes(p);
+  if (len > 0) {
+    // The backend may set node->size to the size it has on disk, which
+    // lags the cached size while higher pages are still dirty.
+    const size_t size = node->size;
+    const int32_t rc =
+        node->ops->write_page(node, p->index, std::span<const uint8_t>(data(p), len));
+    node->size = size;
+    if (rc < 0) {
+      return rc;
+    }
+    ++counters.writebacks;
+  }
+  p->dirty = false;
+  return 0;
+}
+
+// Evict the least recently used clean page, or write back and evict the
+// least recently used page if every page is dirty.
+int32_t evict_one() {
+  Page* victim = lru_tail;
+  for (Page* p = lru_tail; p != nullptr; p = p->newer) {
+    if (!p->dirty) {
+      victim = p;
+      break;
+    }
+  }
+  if (victim == nullptr) {
+    return -ENOMEM;
+  }
+  if (victim->dirty) {
+    const int32_t rc = write_back(victim);
+    if (rc < 0) {
+      return rc;
+    }
+  }
+  release(victim);
+  ++counters.evictions;
+  return 0;
+}
+
+// An unlinked page for (node, index) with a frame but no contents.
+int32_t alloc_page(VfsNode* node, uint32_t index, Page** out) {
+  if (resident == PageCache::kMaxPages ||
+      (resident > 0 && kPmm.get_free_count() <= PageCache::kMinFreeFrames)) {
+    const int32_t rc = evict_one();
+    if (rc < 0) {
+      return rc;
+    }
+  }
+
+  const paddr_t frame = kPmm.alloc();
+  if (frame.is_null()) {
+    return -ENOMEM;
+  }
+  Page* p = free_pages;
+  if (p != nullptr) {
+    free_pages = p->hash_next;
+  } else {
+    assert(unused < PageCache::kMaxPages && "alloc_page(): out of page descriptors");
+    p = &pages[unused++];
+  }
+  *p = Page{.node = node, .index = index, .frame = frame, .dirty = false, .hash_next = nullptr,
+            .newer = nullptr, .older = nullptr};
+  *out = p;
+  return 0;
+}
+
+// Read consecutive pages of one file from the backend: with one readv if
+// it has one, else a read_page per page until one comes up short. Returns
+// the bytes read or a negative errno.
+int32_t read_pages(VfsNode* node, std::span<Page* const> run) {
+  const uint32_t start = run[0]->index;
+  if (run.size() > 1 && node->ops->readv != nullptr) {
+    std::array<std::span<uint8_t>, PageCache::kReadAheadMaxPages> bufs;
+    for (size_t i = 0; i < run.size(); ++i) {
+      bufs[i] = std::span<uint8_t>(data(run[i]), PAGE_SIZE);
+    }
+    return node->ops->readv(node, IoVec(bufs.data(), run.size()), start * PAGE_SIZE);
+  }
+  int32_t total = 0;
+  for (Page* p : run) {
+    const int32_t n = node->ops->read_page(node, p->index, std::span<uint8_t>(data(p), PAGE_SIZE));
+    if (n < 0) {
+      return n;
+    }
+    total += n;
+    if (static_cast<uint32_t>(n) < PAGE_SIZE) {
+      break;
+    }
+  }
+  return total;
+}
+
+// Fill the missing page `index` and the missing pages after it, up to
+// `limit` (exclusive) or the first cached one, with one backend read.
+// Sets *out to the page at index and returns the number of pages filled,
+// or a negative errno.
+int32_t fill_run(VfsNode* node, uint32_t index, uint32_t limit, Page** out) {
+  std::array<Page*, PageCache::kReadAheadMaxPages> run{};
+  uint32_t count = 0;
+  while (count < run.size() && index + count < limit &&
+         (count == 0 || find(node, index + count) == nullptr)) {
+    const int32_t rc = alloc_page(node, index + count, &run[count]);
+    if (rc < 0) {
+      if (count == 0) {
+        return rc;
+      }
+      break;  // read what we have
+    }
+    ++count;
+  }
+
+  const int32_t n = read_pages(node, std::span<Page* const>(run.data(), count));
+  if (n < 0) {
+    for (uint32_t i = 0; i < count; ++i) {
+      free_page(run[i]);
+    }
+    return n;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t skip = i * PAGE_SIZE;
+    const uint32_t left = static_cast<uint32_t>(n) > skip ? static_cast<uint32_t>(n) - skip : 0;
+    const uint32_t filled = left < PAGE_SIZE ? left : PAGE_SIZE;
+    memset(data(run[i]) + filled, 0, PAGE_SIZE - filled);
+    link(run[i]);
+  }
+  *out = run[0];
+  return static_cast<int32_t>(count);
+}
+
+// The cached page (node, index). On a miss it is read from the backend if
+// `fill` is set, together with the missing pages up to `limit`, and
+// zero-filled otherwise.
+int32_t get_page(VfsNode* node, uint32_t index, bool fill, uint32_t limit, Page** out) {
+  Page* p = find(node, index);
+  if (p != nullptr) {
+    ++counters.hits;
+    lru_remove(p);
+    lru_push(p);
+    *out = p;
+    return 0;
+  }
+  ++counters.misses;
+
+  if (fill) {
+    const int32_t n = fill_run(node, index, limit > index ? limit : index + 1, out);
+    if (n < 0) {
+      return n;
+    }
+    counters.readahead += static_cast<uint32_t>(n) - 1;
+    return 0;
+  }
+  const int32_t rc = alloc_page(node, index, &p);
+  if (rc < 0) {
+    return rc;
+  }
+  memset(data(p), 0, PAGE_SIZE);
+  link(p);
+  *out = p;
+  return 0;
+}
+
+// Update ra for a read of [offset, offset + length) that ends before page
+// `end`, in a file of `file_pages` pages. Returns the page index (exclusive)
+// up to which the cache should be filled.
+uint32_t plan_read_ahead(PageCache::ReadAhead* ra, uint32_t offset, uint32_t length,
+                         uint32_t end, uint32_t file_pages) {
+  const bool sequential = offset == ra->next;
+  ra->next = offset + length;
+  if (!sequential) {
+    ra->window /= 2;
+    ra->end = 0;
+    return end;
+  }
+  // Enough is still buffered ahead of the reader.
+  if (ra->end > end + (ra->window / 2)) {
+    return end;
+  }
+  if (ra->window < PageCache::kReadAheadMinPages) {
+    ra->window = PageCache::kReadAheadMinPages;
+  } else if (ra->window < PageCache::kReadAheadMaxPages) {
+    ra->window *= 2;
+  }
+  ra->end = end + ra->window < file_pages ? end + ra->window : file_pages;
+  return ra->end > end ? ra->end : end;
+}
+
+// Fill the missing pages in [from, to). Read-ahead is best effort, so
+// errors are dropped; a later read of the page reports them.
+void prefetch(VfsNode* node, uint32_t from, uint32_t to) {
+  uint32_t index = from;
+  while (index < to) {
+    if (find(node, index) != nullptr) {
+      ++index;
+      continue;
+    }
+    Page* p = nullptr;
+    const int32_t n = fill_run(node, index, to, &p);
+    if (n < 0) {
+      if (n == kSyscallRestart) {
+        Scheduler::cancel_wait();
+      }
+      return;
+    }
+    counters.readahead += static_cast<uint32_t>(n);
+    index += static_cast<uint32_t>(n);
+  }
+}
+
+[[noreturn]] void writeback_thread([[maybe_unused]] void* arg) {
+  while (true) {
+    Scheduler::kthread_sleep(PageCache::kWritebackIntervalNs);
+    // A busy or failing backend leaves its pages dirty for the next round.
+    (void)PageCache::sync_all();
+  }
+}
+
+}  // namespace
+
+namespace PageCache {
+
+int32_t read(VfsNode* node, IoVec iov, uint32_t offset, ReadAhead* ra) {
+  const size_t size = node->size;
+  if (offset >= size) {
+    return 0;
+  }
+  const uint32_t wanted = iov_length(iov);
+  const uint32_t length = wanted < size - offset ? wanted : static_cast<uint32_t>(size - offset);
+
+  // Pages the read touches end before `end`; misses fill up to `limit`.
+  const uint32_t end = (offset + length + PAGE_SIZE - 1) / PAGE_SIZE;
+  const auto file_pages = static_cast<uint32_t>((size + PAGE_SIZE - 1) / PAGE_SIZE);
+  // The plan is worked out on a copy: a read that fails before copying
+  // anything (a kSyscallRestart above all) is retried at the same offset
+  // and must still look sequential then.
+  ReadAhead plan = ra != nullptr ? *ra : ReadAhead{};
+  const uint32_t limit =
+      ra != nullptr ? plan_read_ahead(&plan, offset, length, end, file_pages) : end;
+
+  uint32_t done = 0;
+  int32_t rc = 0;
+  while (done < length) {
+    const uint32_t pos = offset + done;
+    const uint32_t in_page = pos % PAGE_SIZE;
+    const uint32_t n = PAGE_SIZE - in_page < length - done ? PAGE_SIZE - in_page : length - done;
+    Page* p = nullptr;
+    rc = get_page(node, pos / PAGE_SIZE, /*fill=*/true, limit, &p);
+    if (rc < 0) {
+      break;
+    }
+    iov_scatter(iov, done, data(p) + in_page, n);
+    done += n;
+  }
+  if (ra != nullptr && done > 0) {
+    plan.next = offset + done;
+    *ra = plan;
+  }
+  if (rc < 0) {
+    return partial_result(done, rc);
+  }
+  prefetch(node, end, limit);
+  return static_cast<int32_t>(done);
+}
+
+int32_t write(VfsNode* node, ConstIoVec iov, uint32_t offset) {
+  const uint32_t length = iov_length(iov);
+
+  uint32_t done = 0;
+  while (done < length) {
+    const uint32_t pos = offset + done;
+    const uint32_t index = pos / PAGE_SIZE;
+    const uint32_t in_page = pos % PAGE_SIZE;
+    const uint32_t n = PAGE_SIZE - in_page < length - done ? PAGE_SIZE - in_page : length - done;
+    // Old contents matter only if the write leaves part of the page that
+    // lies inside the file.
+    const bool fill = n < PAGE_SIZE && static_cast<size_t>(index) * PAGE_SIZE < node->size;
+    Page* p = nullptr;
+    const int32_t rc = get_page(node, index, fill, index + 1, &p);
+    if (rc < 0) {
+      return partial_result(done, rc);
+    }
+    iov_gather(iov, done, data(p) + in_page, n);
+    p->dirty = true;
+    done += n;
+    if (pos + n > node->size) {
+      node->size = pos + n;
+    }
+  }
+  return static_cast<int32_t>(done);
+}
+
+int32_t fsync(VfsNode* node) {
+  while (true) {
+    Page* highest = nullptr;
+    for (Page* p = lru_head; p != nullptr; p = p->older) {
+      if (p->node == node && p->dirty && (highest == nullptr || p->index > highest->index)) {
+        highest = p;
+      }
+    }
+    if (highest == nullptr) {
+      return 0;
+    }
+    const int32_t rc = write_back(highest);
+    if (rc < 0) {
+      return rc;
+    }
+  }
+}
+
+int32_t sync_all() {
+  // Write-back neither frees nor reorders pages, so the walk stays valid.
+  for (Page* p = lru_head; p != nullptr; p = p->older) {
+    if (p->dirty) {
+      const int32_t rc = fsync(p->node);
+      if (rc < 0) {
+        return rc;
+      }
+    }
+  }
+  return 0;
+}
+
+void invalidate(const VfsNode* node) {
+  Page* p = lru_head;
+  while (p != nullptr) {
+    Page* next = p->older;
+    if (p->node == node) {
+      release(p);
+    }
+    p = next;
+  }
+}
+
+void evict(VfsNode* node) {
+  const int32_t rc = fsync(node);
+  if (rc == kSyscallRestart) {
+    Scheduler::cancel_wait();
+  }
+  invalidate(node);
+}
+
+size_t shrink(size_t count) {
+  size_t freed = 0;
+  Page* p = lru_tail;
+  while (p != nullptr && freed < count) {
+    Page* next = p->newer;
+    if (!p->dirty) {
+      release(p);
+      ++counters.evictions;
+      ++freed;
+    }
+    p = next;
+  }
+  return freed;
+}
+
+void init() {
+  kPmm.set_reclaim(shrink);
+  assert(Scheduler::kthread_create(writeback_thread, nullptr) != nullptr &&
+         "PageCache::init(): cannot start the write-back thread");
+}
+
+Stats stats() {
+  Stats result = counters;
+  result.resident = resident;
+  result.dirty = 0;
+  for (const Page* p = lru_head; p != nullptr; p = p->older) {
+    if (p->dirty) {
+      ++result.dirty;
+    }
+  }
+  return result;
+}
+
+void reset_stats() { counters = Stats{}; }
+
+}  // namespace PageCache
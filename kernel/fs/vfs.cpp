@@ -4,15 +4,19 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <sys/fb.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <termios.h>
 
+#include "dcache.h"
 #include "framebuffer.h"
 #include "keyboard.h"
 #include "modules.h"
+#include "page_cache.h"
+#include "rwlock.h"
 #include "scheduler.h"
 #include "terminal.h"
 #include "tty.h"
@@ -21,6 +25,12 @@ namespace {
 
 VfsNode* root_node = nullptr;
 
+// Guards the shape of the node tree (parent/child/sibling links). Lookups
+// and directory listings share it; register/unregister/unmount take it
+// exclusively. tree_lookup() and the child-list helpers below assume the
+// caller holds it.
+RwLock tree_lock{"vfs_tree"};
+
 // ===========================================================================
 // Tree-based mount support
 // ===========================================================================
@@ -39,29 +49,46 @@ const FsOps* find_mount_ops(const VfsNode* node) {
 // Tree helpers
 // ===========================================================================
 
-// Find a direct child of parent with the given name.
+// Find a direct child of parent with the given name, through the dentry
+// cache. Scans the child list on a miss and caches the answer, including
+// a negative one.
 VfsNode* find_child(VfsNode* parent, const char* name) {
+  VfsNode* cached;
+  if (Dcache::lookup(parent, name, &cached)) {
+    return cached;
+  }
+  VfsNode* found = nullptr;
   for (VfsNode* c = parent->first_child; c != nullptr; c = c->next_sibling) {
     if (strcmp(c->name, name) == 0) {
-      return c;
+      found = c;
+      break;
     }
   }
-  return nullptr;
+  Dcache::insert(parent, name, found);
+  return found;
 }
 
-// Add a child to a parent's child list (prepend).
+// Add a child to the end of a parent's child list, so a getdents() cursor
+// into the list (an index) stays valid while entries are created.
 void add_child(VfsNode* parent, VfsNode* child) {
   child->parent = parent;
-  child->next_sibling = parent->first_child;
-  parent->first_child = child;
+  child->next_sibling = nullptr;
+  VfsNode** link = &parent->first_child;
+  while (*link != nullptr) {
+    link = &(*link)->next_sibling;
+  }
+  *link = child;
+  Dcache::forget(parent, child->name);  // may be cached as missing
 }
 
-// Remove a child from its parent's child list.
+// Remove a child from its parent's child list. Callers free the child's
+// subtree next, so every cached entry goes with it (see dcache.h).
 void remove_child(VfsNode* child) {
   VfsNode* parent = child->parent;
   if (parent == nullptr) {
     return;
   }
+  Dcache::invalidate_all();
   if (parent->first_child == child) {
     parent->first_child = child->next_sibling;
   } else {
@@ -106,92 +133,160 @@ VfsNode* make_node(const char* name, VfsNodeType type, const VfsOps* ops, mode_t
   node->first_child = nullptr;
   node->next_sibling = nullptr;
   node->mount_ops = nullptr;
+  node->refs = 0;
   return node;
 }
 
-// Walk the tree from root following the given absolute path.
-// Returns the node at path, or nullptr if any component is missing.
-// TODO: tree_lookup and register_node share the same component-by-component
-// path walk. Extract a shared next_component() iterator to deduplicate.
-VfsNode* tree_lookup(const char* path) {
+// Walk the tree from base (the root for an absolute path or a null base)
+// one component at a time. "." stays put and ".." moves to the parent,
+// stopping at the root. Returns nullptr if any component is missing.
+VfsNode* walk(VfsNode* base, const char* path) {
   if (root_node == nullptr) {
     return nullptr;
   }
-  if (path[0] == '/' && path[1] == '\0') {
-    return root_node;
-  }
-
-  VfsNode* cur = root_node;
-  const char* p = path + 1;  // skip leading '/'
+  VfsNode* cur = (path[0] == '/' || base == nullptr) ? root_node : base;
+  const char* p = path;
 
   while (*p != '\0') {
-    const char* slash = strchr(p, '/');
-    char component[kMaxNameLen];
-    size_t clen;
-    if (slash != nullptr) {
-      clen = static_cast<size_t>(slash - p);
-    } else {
-      clen = strlen(p);
+    while (*p == '/') {
+      ++p;  // leading, double or trailing slash
     }
-    if (clen == 0) {
-      // double slash or trailing slash -- skip
+    if (*p == '\0') {
+      break;
+    }
+    const char* start = p;
+    while (*p != '\0' && *p != '/') {
       ++p;
+    }
+    const auto clen = static_cast<size_t>(p - start);
+
+    if (clen == 1 && start[0] == '.') {
+      continue;
+    }
+    if (clen == 2 && start[0] == '.' && start[1] == '.') {
+      if (cur->parent != nullptr) {
+        cur = cur->parent;
+      }
       continue;
     }
     if (clen >= kMaxNameLen) {
       return nullptr;
     }
-    memcpy(component, p, clen);
+    char component[kMaxNameLen];
+    memcpy(component, start, clen);
     component[clen] = '\0';
 
     cur = find_child(cur, component);
     if (cur == nullptr) {
       return nullptr;
     }
-
-    p += clen;
-    if (*p == '/') {
-      ++p;
-    }
   }
   return cur;
 }
 
-// Build the full absolute path of a node into buf. Returns the length written.
-[[maybe_unused]] uint32_t node_path(const VfsNode* node, char* buf, uint32_t buf_size) {
-  if (node == root_node || node->parent == nullptr) {
-    if (buf_size > 1) {
-      buf[0] = '/';
-      buf[1] = '\0';
-      return 1;
+// Walk the tree from root following the given absolute path.
+// Returns the node at path, or nullptr if any component is missing.
+VfsNode* tree_lookup(const char* path) { return walk(nullptr, path); }
+
+// True for a node that has been removed from the tree but is still
+// referenced (see delete_tree()).
+bool is_detached(const VfsNode* node) { return node != root_node && node->parent == nullptr; }
+
+// Build the full absolute path of a node into buf. Returns the length
+// written, -ENOENT for a detached node or -ERANGE if buf is too small.
+int32_t build_path(const VfsNode* node, char* buf, size_t size) {
+  if (size < 2) {
+    return -ERANGE;
+  }
+  // Fill from the end backwards, then move the result to the front.
+  size_t start = size - 1;
+  buf[start] = '\0';
+  const VfsNode* n = node;
+  for (; n != nullptr && n != root_node; n = n->parent) {
+    const size_t nlen = strlen(n->name);
+    if (nlen + 1 > start) {
+      return -ERANGE;
     }
-    buf[0] = '\0';
-    return 0;
+    start -= nlen;
+    memcpy(buf + start, n->name, nlen);
+    buf[--start] = '/';
+  }
+  if (node != nullptr && n == nullptr) {
+    return -ENOENT;
+  }
+  if (start == size - 1) {
+    buf[--start] = '/';  // the root itself
+  }
+  const size_t len = size - 1 - start;
+  memmove(buf, buf + start, len + 1);
+  return static_cast<int32_t>(len);
+}
+
+// Split path (relative to base) into its parent directory and last
+// component. On success stores the parent in *parent and the absolute
+// path of the last component in abs_path, for FsOps that take paths.
+// Returns 0, -ENOENT if the parent is missing, -ENOTDIR if it is not a
+// directory, -EINVAL if the last component is "." or "..", or
+// -ENAMETOOLONG. Caller holds tree_lock.
+int32_t resolve_parent(VfsNode* base, const char* path, char* abs_path, VfsNode** parent) {
+  size_t len = strlen(path);
+  while (len > 1 && path[len - 1] == '/') {
+    --len;
+  }
+  size_t name_start = len;
+  while (name_start > 0 && path[name_start - 1] != '/') {
+    --name_start;
+  }
+  const size_t name_len = len - name_start;
+  const char* name = path + name_start;
+  if (name_len == 0 || (name_len == 1 && name[0] == '.') ||
+      (name_len == 2 && name[0] == '.' && name[1] == '.')) {
+    return -EINVAL;
+  }
+  if (name_len >= kMaxNameLen) {
+    return -ENAMETOOLONG;
   }
 
-  // Build path by walking up to root, then reversing.
-  const VfsNode* ancestors[32];
-  uint32_t depth = 0;
-  for (const VfsNode* n = node; n != nullptr && n != root_node && depth < 32; n = n->parent) {
-    ancestors[depth++] = n;
+  char dir[kMaxPathLen];
+  if (name_start >= sizeof(dir)) {
+    return -ENAMETOOLONG;
+  }
+  memcpy(dir, path, name_start);
+  dir[name_start] = '\0';  // "" (base itself), "/" or "a/b/"
+  VfsNode* dir_node = walk(base, dir);
+  if (dir_node == nullptr) {
+    return -ENOENT;
+  }
+  if (dir_node->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
   }
 
-  uint32_t pos = 0;
-  for (uint32_t i = depth; i > 0; --i) {
-    if (pos + 1 < buf_size) {
-      buf[pos++] = '/';
-    }
-    const char* name = ancestors[i - 1]->name;
-    const size_t nlen = strlen(name);
-    for (size_t j = 0; j < nlen && pos + 1 < buf_size; ++j) {
-      buf[pos++] = name[j];
-    }
+  const int32_t dir_len = build_path(dir_node, abs_path, kMaxPathLen);
+  if (dir_len < 0) {
+    return dir_len == -ERANGE ? -ENAMETOOLONG : dir_len;
   }
-  buf[pos] = '\0';
-  return pos;
+  auto pos = static_cast<size_t>(dir_len);
+  if (pos + 1 + name_len + 1 > kMaxPathLen) {
+    return -ENAMETOOLONG;
+  }
+  if (pos > 1) {
+    abs_path[pos++] = '/';
+  }
+  memcpy(abs_path + pos, name, name_len);
+  abs_path[pos + name_len] = '\0';
+  *parent = dir_node;
+  return 0;
 }
 
-// Recursively delete a tree node and all its children.
+// True if node's file data goes through the page cache.
+bool is_cached(const VfsNode* node) {
+  return node->ops != nullptr && node->ops->read_page != nullptr;
+}
+
+// Recursively delete a tree node and all its children. Nodes that are
+// still referenced are only detached; node_put() frees them later. Cached
+// pages are written back and dropped; a backend that deletes the file
+// discards them first (see PageCache::evict()).
 // TODO: make iterative to avoid stack overflow on deep trees.
 // TODO: free node->priv (FAT metadata) before deleting -- currently leaks on unmount.
 void delete_tree(VfsNode* node) {
@@ -204,7 +299,15 @@ void delete_tree(VfsNode* node) {
     delete_tree(child);
     child = next;
   }
-  delete node;
+  node->first_child = nullptr;
+  node->parent = nullptr;
+  node->next_sibling = nullptr;
+  if (node->refs == 0) {
+    if (is_cached(node)) {
+      PageCache::evict(node);
+    }
+    delete node;
+  }
 }
 
 // ===========================================================================
@@ -216,6 +319,7 @@ struct TtyState {
   char line_buf[256];
   size_t line_len;
   size_t line_pos;  // bytes already handed to the caller
+  bool line_done;   // line_buf ends in '\n' and can be handed out
 };
 
 TtyState tty_state = {
@@ -227,36 +331,20 @@ TtyState tty_state = {
     .line_buf = {},
     .line_len = 0,
     .line_pos = 0,
+    .line_done = false,
 };
 
 // ===========================================================================
 // devfs operations
 // ===========================================================================
 
-int32_t tty_read([[maybe_unused]] VfsNode* node, std::span<uint8_t> buf,
-                 [[maybe_unused]] uint32_t offset) {
-  // Raw mode: return whatever is in the keyboard buffer immediately.
-  if ((tty_state.termios.c_lflag & ICANON) == 0U) {
-    char* cbuf = reinterpret_cast<char*>(buf.data());
-    const size_t n = kKeyboard.read(cbuf, buf.size());
-    return static_cast<int32_t>(n);
+// Canonical mode: move typed characters into line_buf, echoing and
+// applying backspace, until a newline completes the line. Returns true
+// once a complete line is waiting to be read.
+bool tty_fill_line() {
+  if (tty_state.line_done) {
+    return true;
   }
-
-  // Canonical mode: accumulate into line_buf until '\n', then serve line.
-  // If there is already buffered data from a previous '\n', hand it out.
-  if (tty_state.line_pos < tty_state.line_len) {
-    const size_t avail = tty_state.line_len - tty_state.line_pos;
-    const size_t to_copy = avail < buf.size() ? avail : buf.size();
-    memcpy(buf.data(), tty_state.line_buf + tty_state.line_pos, to_copy);
-    tty_state.line_pos += to_copy;
-    if (tty_state.line_pos >= tty_state.line_len) {
-      tty_state.line_len = 0;
-      tty_state.line_pos = 0;
-    }
-    return static_cast<int32_t>(to_copy);
-  }
-
-  // Read new characters from keyboard into the line buffer.
   char c;
   while (kKeyboard.read(&c, 1) == 1) {
     if (c == '\b' || c == 127) {
@@ -277,20 +365,48 @@ int32_t tty_read([[maybe_unused]] VfsNode* node, std::span<uint8_t> buf,
       tty_state.line_buf[tty_state.line_len++] = store;
     }
     if (store == '\n') {
-      // Line complete: serve it.
-      const size_t to_copy = tty_state.line_len < buf.size() ? tty_state.line_len : buf.size();
-      memcpy(buf.data(), tty_state.line_buf, to_copy);
-      tty_state.line_pos = to_copy;
-      if (tty_state.line_pos >= tty_state.line_len) {
-        tty_state.line_len = 0;
-        tty_state.line_pos = 0;
-      }
-      return static_cast<int32_t>(to_copy);
+      tty_state.line_done = true;
+      return true;
     }
   }
+  return false;
+}
 
-  // No newline yet; ask the scheduler to retry.
-  return 0;
+int32_t tty_read([[maybe_unused]] VfsNode* node, std::span<uint8_t> buf,
+                 [[maybe_unused]] uint32_t offset) {
+  // Raw mode: return whatever is in the keyboard buffer, or sleep until a
+  // key arrives.
+  if ((tty_state.termios.c_lflag & ICANON) == 0U) {
+    char* cbuf = reinterpret_cast<char*>(buf.data());
+    const size_t n = kKeyboard.read(cbuf, buf.size());
+    if (n == 0 && !buf.empty()) {
+      Scheduler::wait_on(kKeyboard.input_waiters());
+      return kSyscallRestart;
+    }
+    return static_cast<int32_t>(n);
+  }
+
+  // Canonical mode: hand out a completed line, sleeping until there is one.
+  if (!tty_fill_line()) {
+    Scheduler::wait_on(kKeyboard.input_waiters());
+    return kSyscallRestart;
+  }
+  const size_t avail = tty_state.line_len - tty_state.line_pos;
+  const size_t to_copy = avail < buf.size() ? avail : buf.size();
+  memcpy(buf.data(), tty_state.line_buf + tty_state.line_pos, to_copy);
+  tty_state.line_pos += to_copy;
+  if (tty_state.line_pos >= tty_state.line_len) {
+    tty_state.line_len = 0;
+    tty_state.line_pos = 0;
+    tty_state.line_done = false;
+  }
+  return static_cast<int32_t>(to_copy);
+}
+
+uint32_t tty_poll([[maybe_unused]] VfsNode* node) {
+  const bool readable =
+      (tty_state.termios.c_lflag & ICANON) == 0U ? kKeyboard.has_input() : tty_fill_line();
+  return readable ? (POLLIN | POLLOUT) : POLLOUT;
 }
 
 int32_t tty_ioctl([[maybe_unused]] VfsNode* node, uint32_t request, void* arg) {
@@ -314,6 +430,7 @@ int32_t tty_ioctl([[maybe_unused]] VfsNode* node, uint32_t request, void* arg) {
       // TCSAFLUSH semantics: discard pending input.
       tty_state.line_len = 0;
       tty_state.line_pos = 0;
+      tty_state.line_done = false;
       return 0;
     }
     default:
@@ -328,7 +445,17 @@ int32_t tty_write([[maybe_unused]] VfsNode* node, std::span<const uint8_t> buf,
 }
 
 const VfsOps tty_ops = {
-    .open = nullptr, .read = tty_read, .write = tty_write, .ioctl = tty_ioctl, .truncate = nullptr};
+    .open = nullptr,
+    .read = tty_read,
+    .write = tty_write,
+    .ioctl = tty_ioctl,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = tty_poll,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 int32_t null_read([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<uint8_t> buf,
                   [[maybe_unused]] uint32_t offset) {
@@ -341,7 +468,17 @@ int32_t null_write([[maybe_unused]] VfsNode* node, std::span<const uint8_t> buf,
 }
 
 const VfsOps null_ops = {
-    .open = nullptr, .read = null_read, .write = null_write, .ioctl = nullptr, .truncate = nullptr};
+    .open = nullptr,
+    .read = null_read,
+    .write = null_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 void kbd_open([[maybe_unused]] VfsNode* node) {
   // Discard any events queued before this open (e.g. keystrokes used to
@@ -357,6 +494,11 @@ int32_t kbd_read([[maybe_unused]] VfsNode* node, std::span<uint8_t> buf,
   }
   auto* events = reinterpret_cast<kbd_event*>(buf.data());
   const size_t n = kKeyboard.read_events(events, max_events);
+  if (n == 0) {
+    // Sleep until a key event arrives (-EAGAIN instead for O_NONBLOCK).
+    Scheduler::wait_on(kKeyboard.event_waiters());
+    return kSyscallRestart;
+  }
   return static_cast<int32_t>(n * sizeof(kbd_event));
 }
 
@@ -365,8 +507,22 @@ int32_t kbd_write([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<con
   return -1;  // not writable
 }
 
+uint32_t kbd_poll([[maybe_unused]] VfsNode* node) {
+  return kKeyboard.has_events() ? POLLIN : 0U;
+}
+
 const VfsOps kbd_ops = {
-    .open = kbd_open, .read = kbd_read, .write = kbd_write, .ioctl = nullptr, .truncate = nullptr};
+    .open = kbd_open,
+    .read = kbd_read,
+    .write = kbd_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = kbd_poll,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 // ===========================================================================
 // framebuffer device operations
@@ -446,7 +602,17 @@ int32_t fb_write([[maybe_unused]] VfsNode* node, std::span<const uint8_t> buf, u
 }
 
 const VfsOps fb_ops = {
-    .open = nullptr, .read = fb_read, .write = fb_write, .ioctl = nullptr, .truncate = nullptr};
+    .open = nullptr,
+    .read = fb_read,
+    .write = fb_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 // ===========================================================================
 // ramfs operations
@@ -469,13 +635,73 @@ int32_t ramfs_write([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<c
 }
 
 const VfsOps ramfs_ops = {
-    .open = nullptr, .read = ramfs_read, .write = ramfs_write, .ioctl = nullptr, .truncate = nullptr};
+    .open = nullptr,
+    .read = ramfs_read,
+    .write = ramfs_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
+
+// Read into iov at `offset`: from the page cache if the backend uses it,
+// in one call if the backend takes a list, otherwise a read per buffer
+// until one comes up short. `ra` is the file's read-ahead state. The
+// caller has checked that node has a read op.
+int32_t read_at(VfsNode* node, IoVec iov, uint32_t offset, PageCache::ReadAhead* ra) {
+  if (is_cached(node)) {
+    return PageCache::read(node, iov, offset, ra);
+  }
+  if (node->ops->readv != nullptr) {
+    return node->ops->readv(node, iov, offset);
+  }
+  return iov_each(iov, [node, offset](std::span<uint8_t> buf, uint32_t done) {
+    return node->ops->read(node, buf, offset + done);
+  });
+}
+
+// Write counterpart of read_at(). The caller has checked for a write op.
+int32_t write_at(VfsNode* node, ConstIoVec iov, uint32_t offset) {
+  if (is_cached(node)) {
+    return PageCache::write(node, iov, offset);
+  }
+  if (node->ops->writev != nullptr) {
+    return node->ops->writev(node, iov, offset);
+  }
+  return iov_each(iov, [node, offset](std::span<const uint8_t> buf, uint32_t done) {
+    return node->ops->write(node, buf, offset + done);
+  });
+}
+
+// The open-file state of fd if its node supports reading (or writing),
+// nullptr otherwise.
+VfsFileDescription* readable(FileDescription* fd) {
+  auto* vfs_fd = fd->vfs;
+  if ((vfs_fd == nullptr) || (vfs_fd->node == nullptr) || (vfs_fd->node->ops == nullptr) ||
+      (vfs_fd->node->ops->read == nullptr)) {
+    return nullptr;
+  }
+  return vfs_fd;
+}
+
+VfsFileDescription* writable(FileDescription* fd) {
+  auto* vfs_fd = fd->vfs;
+  if ((vfs_fd == nullptr) || (vfs_fd->node == nullptr) || (vfs_fd->node->ops == nullptr) ||
+      (vfs_fd->node->ops->write == nullptr)) {
+    return nullptr;
+  }
+  return vfs_fd;
+}
 
 }  // namespace
 
 namespace Vfs {
 
 void init() {
+  Dcache::invalidate_all();
   delete_tree(root_node);
   root_node = make_node("", VfsNodeType::Directory, nullptr);
 }
@@ -487,6 +713,8 @@ VfsNode* register_node(const char* path, VfsNodeType type, const VfsOps* ops, mo
     return nullptr;
   }
 
+  const WriteGuard guard(tree_lock);
+
   // Walk the tree, creating intermediate Directory nodes as needed.
   VfsNode* cur = root_node;
   const char* p = path + 1;  // skip leading '/'
@@ -547,6 +775,7 @@ VfsNode* register_node(const char* path, VfsNodeType type, const VfsOps* ops, mo
 
 void unregister_node(const char* path) {
   assert(path != nullptr && "unregister_node(): null path");
+  const WriteGuard guard(tree_lock);
   VfsNode* node = tree_lookup(path);
   if (node != nullptr && node != root_node) {
     remove_child(node);
@@ -554,52 +783,121 @@ void unregister_node(const char* path) {
   }
 }
 
+int32_t move_node(const char* old_path, const char* new_path) {
+  assert(old_path != nullptr && new_path != nullptr && new_path[0] == '/' &&
+         "move_node(): paths must be non-null and new_path absolute");
+  const char* last_slash = strrchr(new_path, '/');
+  const char* new_name = last_slash + 1;
+  const auto parent_len = static_cast<size_t>(last_slash - new_path);
+  if (parent_len >= kMaxPathLen || strlen(new_name) >= kMaxNameLen) {
+    return -ENAMETOOLONG;
+  }
+  if (new_name[0] == '\0') {
+    return -EINVAL;
+  }
+  char parent_path[kMaxPathLen];
+  memcpy(parent_path, new_path, parent_len);
+  parent_path[parent_len == 0 ? 1 : parent_len] = '\0';  // keep "/" for the root
+
+  const WriteGuard guard(tree_lock);
+  VfsNode* node = tree_lookup(old_path);
+  VfsNode* parent = tree_lookup(parent_path);
+  if (node == nullptr || node == root_node || parent == nullptr) {
+    return -ENOENT;
+  }
+  if (parent->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
+  }
+  VfsNode* existing = find_child(parent, new_name);
+  if (existing == node) {
+    return 0;
+  }
+  if (existing != nullptr) {
+    remove_child(existing);
+    delete_tree(existing);
+  }
+  remove_child(node);
+  strcpy(node->name, new_name);
+  add_child(parent, node);
+  return 0;
+}
+
 VfsNode* lookup(const char* path) {
   assert(path != nullptr && path[0] == '/' && "lookup(): path must be non-null and absolute");
+  const ReadGuard guard(tree_lock);
   return tree_lookup(path);
 }
 
+VfsNode* lookup_at(VfsNode* base, const char* path) {
+  assert(path != nullptr && "lookup_at(): null path");
+  const ReadGuard guard(tree_lock);
+  return walk(base, path);
+}
+
+int32_t node_path(const VfsNode* node, char* buf, size_t size) {
+  assert(buf != nullptr && "node_path(): null buffer");
+  const ReadGuard guard(tree_lock);
+  return build_path(node, buf, size);
+}
+
+void node_get(VfsNode* node) {
+  if (node != nullptr) {
+    __atomic_fetch_add(&node->refs, 1, __ATOMIC_RELAXED);
+  }
+}
+
+void node_put(VfsNode* node) {
+  if (node == nullptr) {
+    return;
+  }
+  assert(node->refs > 0 && "node_put(): reference count underflow");
+  const WriteGuard guard(tree_lock);
+  if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_RELAXED) == 0 && is_detached(node)) {
+    if (is_cached(node)) {
+      PageCache::evict(node);
+    }
+    delete node;
+  }
+}
+
 int32_t open(const char* path, int32_t flags, mode_t mode) {
   assert(path != nullptr && path[0] == '/' && "open(): path must be non-null and absolute");
+  return open_at(nullptr, path, flags, mode);
+}
 
-  VfsNode* node = lookup(path);
+int32_t open_at(VfsNode* base, const char* path, int32_t flags, mode_t mode) {
+  assert(path != nullptr && "open_at(): null path");
 
-  // O_CREAT: try to create the file via the mounted filesystem.
-  // TODO: the parent-path extraction (strrchr + memcpy) is duplicated in
-  // open(), fs_mkdir(), fat_mkdir(), and fat_create(). Extract a path_parent() helper.
+  VfsNode* node = lookup_at(base, path);
+
+  // O_CREAT: try to create the file via the filesystem mounted over its parent.
   if (node == nullptr && (flags & O_CREAT) != 0) {
-    // Find the parent directory to determine which mount to use.
-    const char* last_slash = strrchr(path, '/');
-    if (last_slash != nullptr) {
-      char parent_path[kMaxPathLen];
-      const auto parent_len = static_cast<size_t>(last_slash - path);
-      if (parent_len == 0) {
-        parent_path[0] = '/';
-        parent_path[1] = '\0';
-      } else if (parent_len < kMaxPathLen) {
-        memcpy(parent_path, path, parent_len);
-        parent_path[parent_len] = '\0';
-      } else {
-        parent_path[0] = '\0';
-      }
-      const VfsNode* parent_node = tree_lookup(parent_path);
-      if (parent_node != nullptr) {
-        const FsOps* fs = find_mount_ops(parent_node);
-        if (fs != nullptr && fs->create != nullptr) {
-          node = fs->create(path, flags, mode);
-        }
+    char abs_path[kMaxPathLen];
+    VfsNode* parent = nullptr;
+    const FsOps* fs = nullptr;
+    {
+      const ReadGuard guard(tree_lock);
+      if (resolve_parent(base, path, abs_path, &parent) == 0) {
+        fs = find_mount_ops(parent);
       }
     }
+    if (fs != nullptr && fs->create != nullptr) {
+      node = fs->create(abs_path, flags, mode);
+    }
   }
 
   if (node == nullptr) {
     return -ENOENT;
   }
+  if ((flags & O_DIRECTORY) != 0 && node->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
+  }
 
   Process* proc = Scheduler::current();
   if (proc == nullptr) {
     return -ESRCH;
   }
+  proc = proc->group();
 
   // Permission check (root bypasses).
   // TODO: use S_IRUSR/S_IWUSR/O_ACCMODE constants instead of magic numbers.
@@ -628,10 +926,16 @@ int32_t open(const char* path, int32_t flags, mode_t mode) {
   // O_TRUNC: truncate an existing writable file.
   if ((flags & O_TRUNC) != 0 && node->type == VfsNodeType::File && node->ops != nullptr &&
       node->ops->truncate != nullptr) {
-    node->ops->truncate(node);
+    const int32_t rc = node->ops->truncate(node);
+    if (rc == kSyscallRestart) {
+      return rc;
+    }
+    if (is_cached(node)) {
+      PageCache::invalidate(node);
+    }
   }
 
-  auto slot = fd_alloc(proc->fds);
+  auto slot = proc->fds.alloc();
   if (!slot) {
     return -EMFILE;
   }
@@ -642,14 +946,15 @@ int32_t open(const char* path, int32_t flags, mode_t mode) {
   }
 
   auto* desc = new FileDescription{
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = vfs_fd,
+      .status_flags = flags & O_NONBLOCK};
   if (desc == nullptr) {
     delete vfs_fd;
     return -ENOMEM;
   }
 
-  proc->fds[*slot] = desc;
-  proc->fd_flags[*slot] = ((flags & O_CLOEXEC) != 0) ? FD_CLOEXEC : 0;
+  node_get(node);
+  proc->fds.install(*slot, desc, ((flags & O_CLOEXEC) != 0) ? FD_CLOEXEC : 0);
 
   if (node->ops != nullptr && node->ops->open != nullptr) {
     node->ops->open(node);
@@ -666,7 +971,7 @@ int32_t read(FileDescription* fd, std::span<uint8_t> buf) {
     return -1;
   }
 
-  const int32_t n = vfs_fd->node->ops->read(vfs_fd->node, buf, vfs_fd->offset);
+  const int32_t n = read_at(vfs_fd->node, IoVec(&buf, 1), vfs_fd->offset, &vfs_fd->ra);
   if (n > 0) {
     vfs_fd->offset += static_cast<uint32_t>(n);
   }
@@ -686,16 +991,76 @@ int32_t write(FileDescription* fd, std::span<const uint8_t> buf) {
     vfs_fd->offset = static_cast<uint32_t>(vfs_fd->node->size);
   }
 
-  const int32_t n = vfs_fd->node->ops->write(vfs_fd->node, buf, vfs_fd->offset);
+  const int32_t n = write_at(vfs_fd->node, ConstIoVec(&buf, 1), vfs_fd->offset);
+  if (n > 0) {
+    vfs_fd->offset += static_cast<uint32_t>(n);
+  }
+  return n;
+}
+
+int32_t readv(FileDescription* fd, IoVec iov) {
+  assert(fd != nullptr && "readv(): null file description");
+  auto* vfs_fd = readable(fd);
+  if (vfs_fd == nullptr) {
+    return -1;
+  }
+
+  const int32_t n = read_at(vfs_fd->node, iov, vfs_fd->offset, &vfs_fd->ra);
   if (n > 0) {
     vfs_fd->offset += static_cast<uint32_t>(n);
   }
   return n;
 }
 
+int32_t writev(FileDescription* fd, ConstIoVec iov) {
+  assert(fd != nullptr && "writev(): null file description");
+  auto* vfs_fd = writable(fd);
+  if (vfs_fd == nullptr) {
+    return -1;
+  }
+
+  if ((vfs_fd->open_flags & O_APPEND) != 0) {
+    vfs_fd->offset = static_cast<uint32_t>(vfs_fd->node->size);
+  }
+
+  const int32_t n = write_at(vfs_fd->node, iov, vfs_fd->offset);
+  if (n > 0) {
+    vfs_fd->offset += static_cast<uint32_t>(n);
+  }
+  return n;
+}
+
+int32_t pread(FileDescription* fd, std::span<uint8_t> buf, uint32_t offset) {
+  assert(fd != nullptr && "pread(): null file description");
+  auto* vfs_fd = readable(fd);
+  if (vfs_fd == nullptr) {
+    return -1;
+  }
+  return read_at(vfs_fd->node, IoVec(&buf, 1), offset, &vfs_fd->ra);
+}
+
+int32_t pwrite(FileDescription* fd, std::span<const uint8_t> buf, uint32_t offset) {
+  assert(fd != nullptr && "pwrite(): null file description");
+  auto* vfs_fd = writable(fd);
+  if (vfs_fd == nullptr) {
+    return -1;
+  }
+  return write_at(vfs_fd->node, ConstIoVec(&buf, 1), offset);
+}
+
+int32_t fsync(FileDescription* fd) {
+  assert(fd != nullptr && "fsync(): null file description");
+  auto* vfs_fd = fd->vfs;
+  if (vfs_fd == nullptr || vfs_fd->node == nullptr || !is_cached(vfs_fd->node)) {
+    return 0;
+  }
+  return PageCache::fsync(vfs_fd->node);
+}
+
 void close(FileDescription* fd) {
   assert(fd != nullptr && "close(): null file description");
   if (fd->vfs != nullptr) {
+    node_put(fd->vfs->node);
     delete fd->vfs;
     fd->vfs = nullptr;
   }
@@ -713,6 +1078,7 @@ bool is_directory(const char* path) {
     norm[len - 1] = '\0';
   }
 
+  const ReadGuard guard(tree_lock);
   const VfsNode* node = tree_lookup(norm);
   if (node == nullptr) {
     return false;
@@ -720,46 +1086,52 @@ bool is_directory(const char* path) {
   return node->type == VfsNodeType::Directory;
 }
 
-uint32_t getdents(const char* path, dirent* entries, uint32_t max_entries) {
-  assert(path != nullptr && path[0] == '/' && "getdents(): path must be non-null and absolute");
-  assert(entries != nullptr && "getdents(): null entries buffer");
-  if (max_entries == 0) {
-    return 0;
+int32_t getdents(FileDescription* fd, std::span<dirent> entries, bool attrs) {
+  assert(fd != nullptr && "getdents(): null file description");
+  VfsFileDescription* vfs_fd = fd->vfs;
+  if (vfs_fd == nullptr || vfs_fd->node == nullptr) {
+    return -EBADF;
   }
 
-  // Strip trailing slash.
-  char norm[kMaxPathLen];
-  strncpy(norm, path, kMaxPathLen - 1);
-  norm[kMaxPathLen - 1] = '\0';
-  const size_t norm_len_raw = strlen(norm);
-  if (norm_len_raw > 1 && norm[norm_len_raw - 1] == '/') {
-    norm[norm_len_raw - 1] = '\0';
+  const ReadGuard guard(tree_lock);
+  const VfsNode* dir = vfs_fd->node;
+  if (dir->type != VfsNodeType::Directory) {
+    return -ENOTDIR;
   }
 
-  const VfsNode* dir = tree_lookup(norm);
-  if (dir == nullptr) {
-    return 0;
+  // The offset counts children from the start of the list. New children
+  // are appended, so they never shift the cursor; removing a child before
+  // the cursor shifts it by one, so one entry may be skipped.
+  uint32_t index = 0;
+  const VfsNode* child = dir->first_child;
+  for (; child != nullptr && index < vfs_fd->offset; child = child->next_sibling) {
+    ++index;
   }
 
   uint32_t count = 0;
-  for (VfsNode* child = dir->first_child; child != nullptr && count < max_entries;
-       child = child->next_sibling) {
-    strncpy(entries[count].d_name, child->name, sizeof(entries[count].d_name) - 1);
-    entries[count].d_name[sizeof(entries[count].d_name) - 1] = '\0';
+  for (; child != nullptr && count < entries.size(); child = child->next_sibling) {
+    ++index;
+    if (child->name[0] == '\0') {
+      continue;  // unregistered
+    }
+    dirent& entry = entries[count++];
+    memset(&entry, 0, sizeof(entry));
+    strncpy(entry.d_name, child->name, sizeof(entry.d_name) - 1);
     if (child->type == VfsNodeType::Directory) {
-      entries[count].d_type = DT_DIR;
-      entries[count].d_size = 0;
+      entry.d_type = DT_DIR;
     } else if (child->type == VfsNodeType::CharDev) {
-      entries[count].d_type = DT_CHR;
-      entries[count].d_size = static_cast<uint32_t>(child->size);
+      entry.d_type = DT_CHR;
     } else {
-      entries[count].d_type = DT_REG;
-      entries[count].d_size = static_cast<uint32_t>(child->size);
+      entry.d_type = DT_REG;
+    }
+    if (attrs) {
+      entry.d_size = child->type == VfsNodeType::Directory ? 0 : static_cast<uint32_t>(child->size);
+      entry.d_mode = child->mode;
     }
-    ++count;
   }
+  vfs_fd->offset = index;
 
-  return count;
+  return static_cast<int32_t>(count);
 }
 
 int32_t mount(const char* path, const FsOps* ops) {
@@ -797,12 +1169,19 @@ int32_t unmount(const char* path) {
     return -EINVAL;
   }
 
+  // Dirty pages must reach the filesystem while it is still mounted.
+  const int32_t rc = PageCache::sync_all();
+  if (rc < 0) {
+    return rc;
+  }
+
   // Call the filesystem's unmount callback if provided.
   if (node->mount_ops->unmount != nullptr) {
     node->mount_ops->unmount(node);
   }
 
   // Remove all children (the mounted filesystem's subtree).
+  const WriteGuard guard(tree_lock);
   while (node->first_child != nullptr) {
     VfsNode* child = node->first_child;
     remove_child(child);
@@ -813,40 +1192,50 @@ int32_t unmount(const char* path) {
   return 0;
 }
 
-int32_t fs_mkdir(const char* abs_path) {
-  // Walk the tree to find the nearest mount ancestor.
-  // First check if parent exists.
-  const VfsNode* node = tree_lookup(abs_path);
-  const VfsNode* start = (node != nullptr) ? node : root_node;
-  // If the path doesn't exist, find the parent.
-  if (node == nullptr) {
-    const char* last_slash = strrchr(abs_path, '/');
-    if (last_slash != nullptr) {
-      char parent_path[kMaxPathLen];
-      const auto plen = static_cast<size_t>(last_slash - abs_path);
-      if (plen == 0) {
-        parent_path[0] = '/';
-        parent_path[1] = '\0';
-      } else {
-        memcpy(parent_path, abs_path, plen);
-        parent_path[plen] = '\0';
-      }
-      const VfsNode* parent = tree_lookup(parent_path);
-      if (parent != nullptr) {
-        start = parent;
-      }
+int32_t fs_mkdir(const char* abs_path) { return fs_mkdir_at(nullptr, abs_path); }
+
+int32_t fs_unlink(const char* abs_path) { return fs_unlink_at(nullptr, abs_path, false); }
+
+int32_t fs_mkdir_at(VfsNode* base, const char* path) {
+  char abs_path[kMaxPathLen];
+  const FsOps* ops = nullptr;
+  {
+    const ReadGuard guard(tree_lock);
+    if (walk(base, path) != nullptr) {
+      return -EEXIST;
+    }
+    VfsNode* parent = nullptr;
+    const int32_t rc = resolve_parent(base, path, abs_path, &parent);
+    if (rc < 0) {
+      return rc;
     }
+    ops = find_mount_ops(parent);
   }
-  const FsOps* ops = find_mount_ops(start);
   if (ops == nullptr || ops->mkdir == nullptr) {
     return -ENOENT;
   }
   return ops->mkdir(abs_path);
 }
 
-int32_t fs_unlink(const char* abs_path) {
-  const VfsNode* node = tree_lookup(abs_path);
-  const FsOps* ops = find_mount_ops(node != nullptr ? node : root_node);
+int32_t fs_unlink_at(VfsNode* base, const char* path, bool remove_dir) {
+  char abs_path[kMaxPathLen];
+  const FsOps* ops = nullptr;
+  {
+    const ReadGuard guard(tree_lock);
+    const VfsNode* node = walk(base, path);
+    if (node == nullptr) {
+      return -ENOENT;
+    }
+    const bool is_dir = node->type == VfsNodeType::Directory;
+    if (remove_dir != is_dir) {
+      return remove_dir ? -ENOTDIR : -EISDIR;
+    }
+    const int32_t rc = build_path(node, abs_path, sizeof(abs_path));
+    if (rc < 0) {
+      return rc == -ERANGE ? -ENAMETOOLONG : rc;
+    }
+    ops = find_mount_ops(node);
+  }
   if (ops == nullptr || ops->unlink == nullptr) {
     return -ENOENT;
   }
@@ -854,7 +1243,7 @@ int32_t fs_unlink(const char* abs_path) {
 }
 
 int32_t fs_rename(const char* old_path, const char* new_path) {
-  const VfsNode* node = tree_lookup(old_path);
+  VfsNode* node = tree_lookup(old_path);
   const FsOps* ops = find_mount_ops(node != nullptr ? node : root_node);
   if (ops == nullptr || ops->rename == nullptr) {
     return -ENOENT;
@@ -879,9 +1268,11 @@ int32_t stat_node(const VfsNode* node, struct stat* buf) {
   return 0;
 }
 
-int32_t stat_path(const char* path, struct stat* buf) {
-  assert(path != nullptr && "stat_path(): null path");
-  const VfsNode* node = lookup(path);
+int32_t stat_path(const char* path, struct stat* buf) { return stat_at(nullptr, path, buf); }
+
+int32_t stat_at(VfsNode* base, const char* path, struct stat* buf) {
+  assert(path != nullptr && "stat_at(): null path");
+  const VfsNode* node = lookup_at(base, path);
   if (node == nullptr) {
     return -ENOENT;
   }
@@ -911,6 +1302,17 @@ int32_t ioctl(FileDescription* fd, uint32_t request, void* arg) {
   return vfs_fd->node->ops->ioctl(vfs_fd->node, request, arg);
 }
 
+uint32_t poll(FileDescription* fd) {
+  auto* vfs_fd = fd->vfs;
+  if ((vfs_fd == nullptr) || (vfs_fd->node == nullptr) || (vfs_fd->node->ops == nullptr)) {
+    return POLLNVAL;
+  }
+  if (vfs_fd->node->ops->poll != nullptr) {
+    return vfs_fd->node->ops->poll(vfs_fd->node);
+  }
+  return (readable(fd) != nullptr ? POLLIN : 0U) | (writable(fd) != nullptr ? POLLOUT : 0U);
+}
+
 int32_t tty_ioctl(uint32_t request, void* arg) { return ::tty_ioctl(nullptr, request, arg); }
 
 void init_ramfs() {
@@ -20,6 +20,9 @@ namespace AddressSpace {
 // Kernel PDE range: indices 768–1023 (0xC0000000 / 4 MiB per entry = 768).
 static constexpr uint32_t kKernelPdeStart = KERNEL_VMA >> 22;
 
+// PageEntry::available value of pages mapped with map_shared().
+static constexpr uint32_t kSharedPage = 1;
+
 // Allocate a new page directory with kernel mappings copied from
 // boot_page_directory and user entries zeroed.
 // Returns the physical and virtual addresses of the new page directory.
@@ -39,7 +42,14 @@ struct PageDir {
 // The page directory does not need to be the currently loaded one.
 void map(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable, bool user);
 
-// Unmap a single page from a page directory, freeing its physical frame.
+// Map a page whose frame the address space does not own (PageEntry's
+// available bits carry kSharedPage). copy() maps the same frame into the
+// new address space instead of duplicating it, and unmap() and destroy()
+// leave the frame allocated. Used for the vDSO time page.
+void map_shared(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable);
+
+// Unmap a single page from a page directory, freeing its physical frame
+// unless it was mapped with map_shared().
 // Invalidates the TLB entry for `virt` via invlpg. No-op if not mapped.
 void unmap(PageTable* pd, vaddr_t virt);
 
@@ -56,11 +66,15 @@ void sync_kernel_mappings(PageTable* pd);
 void load(paddr_t pd_phys);
 
 // Free all user-space pages and page tables owned by this page directory,
-// then free the page directory page itself.
+// then free the page directory page itself. Shared pages are left alone.
 void destroy(PageTable* pd, paddr_t pd_phys);
 
 // Returns true if the page containing va is present in pd and is
 // user-accessible. If writeable is true, also requires the PTE rw bit.
 [[nodiscard]] bool is_user_mapped(const PageTable* pd, vaddr_t va, bool writeable);
 
+// Translate a user virtual address in pd to its physical address, keeping
+// the page offset. Returns 0 unless the page is present and user-accessible.
+[[nodiscard]] paddr_t user_phys(const PageTable* pd, vaddr_t va);
+
 }  // namespace AddressSpace
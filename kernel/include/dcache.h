@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+struct VfsNode;
+
+/*
+ * Directory entry cache for VFS path lookup.
+ *
+ * Maps (parent node, component name) to the child node, so resolving a
+ * path costs one hash probe per component instead of a strcmp against
+ * every sibling. A failed lookup is cached too, as a negative entry with
+ * a null node, so repeated probes for missing files (PATH-style searches,
+ * O_CREAT checks) also stay off the sibling lists.
+ *
+ * The table is direct-mapped: a colliding insert simply replaces the old
+ * entry. Adding a child forgets the negative entry for its name. Removing
+ * one drops the whole cache, because the removed subtree is freed and
+ * entries keyed by those nodes must not match nodes later allocated at
+ * the same addresses; removals (unlink, rename, unmount) are rare.
+ *
+ * Callers hold the VFS tree lock (shared for lookups, exclusive for
+ * changes); the table has its own spinlock since shared holders insert.
+ */
+
+namespace Dcache {
+
+// Number of cache slots (power of two).
+static constexpr uint32_t kSlots = 512;
+
+struct Stats {
+  uint32_t hits;           // lookups answered with a node
+  uint32_t negative_hits;  // lookups answered "does not exist"
+  uint32_t misses;         // lookups that had to scan the sibling list
+};
+
+// Look up `name` under `parent`. Returns true on a hit and sets *node (to
+// nullptr for a negative entry); returns false on a miss.
+[[nodiscard]] bool lookup(const VfsNode* parent, const char* name, VfsNode** node);
+
+// Record the result of a sibling scan: node is the child of parent called
+// name, or nullptr if there is none.
+void insert(const VfsNode* parent, const char* name, VfsNode* node);
+
+// Drop the entry for `name` under `parent`, if any.
+void forget(const VfsNode* parent, const char* name);
+
+// Drop every entry.
+void invalidate_all();
+
+// Hit and miss counters since boot or the last reset_stats().
+[[nodiscard]] Stats stats();
+void reset_stats();
+
+}  // namespace Dcache
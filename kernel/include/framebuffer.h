@@ -63,4 +63,10 @@ void blit(const uint32_t* src, uint32_t dst_x, uint32_t dst_y, uint32_t w, uint3
 // If src is larger than the framebuffer, scale is clamped to 1.
 void blit_scaled(const uint32_t* src, uint32_t src_w, uint32_t src_h);
 
+// blit_scaled() in pieces, for callers that produce the image a row at a
+// time: clear_letterbox() blanks the margins around the scaled image, and
+// blit_scaled_row() draws source row src_row (src_w pixels) of it.
+void clear_letterbox(uint32_t src_w, uint32_t src_h);
+void blit_scaled_row(const uint32_t* row, uint32_t src_w, uint32_t src_h, uint32_t src_row);
+
 }  // namespace Framebuffer
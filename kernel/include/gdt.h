@@ -1,6 +1,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <sys/segment.h>
+
+#include "smp.h"
 
 /*
  * =======================================
@@ -64,9 +67,21 @@ namespace GDT {
 // Segment selectors (index * 8, plus RPL for user segments)
 static constexpr uint16_t KERNEL_CODE_SELECTOR = 0x08;  // index 1
 static constexpr uint16_t KERNEL_DATA_SELECTOR = 0x10;  // index 2
-static constexpr uint16_t TSS_SELECTOR = 0x18;          // index 3
-static constexpr uint16_t USER_CODE_SELECTOR = 0x23;    // index 4 | RPL 3
-static constexpr uint16_t USER_DATA_SELECTOR = 0x2B;    // index 5 | RPL 3
+static constexpr uint16_t USER_CODE_SELECTOR = __USER_CS;  // index 3 | RPL 3
+static constexpr uint16_t USER_DATA_SELECTOR = __USER_DS;  // index 4 | RPL 3
+static constexpr uint16_t TSS_SELECTOR = 0x28;          // index 5
+// TSS descriptors for CPUs 1.. follow the BSP's (index 6..).
+static constexpr uint16_t kApTssIndexBase = 6;
+// One user TLS data segment per CPU follows the TSSs. The scheduler points
+// the running thread's %gs at its CPU's entry and loads the thread's TLS
+// base into it on every switch (see set_tls()).
+static constexpr uint16_t kTlsIndexBase = kApTssIndexBase + Smp::kMaxCpus - 1;
+
+// SYSENTER/SYSEXIT derive every selector from IA32_SYSENTER_CS (the kernel
+// code selector), so the four flat segments must sit in this order.
+static_assert(KERNEL_DATA_SELECTOR == KERNEL_CODE_SELECTOR + 8, "SYSENTER SS = CS + 8");
+static_assert(USER_CODE_SELECTOR == ((KERNEL_CODE_SELECTOR + 16) | 3), "SYSEXIT CS = CS + 16");
+static_assert(USER_DATA_SELECTOR == ((KERNEL_CODE_SELECTOR + 24) | 3), "SYSEXIT SS = CS + 24");
 
 // Access byte values
 static constexpr uint8_t CODE_ACCESS = 0x9A;  // Present, DPL=0, Code, Readable
@@ -99,4 +114,21 @@ struct Descriptor {
 
 void init();
 bool is_initialized();
+
+// Load the GDT built by init() on the calling CPU and reload the segment
+// registers. Used by APs, whose GDTR still points at the trampoline's GDT.
+void load();
+
+// Selector of `cpu`'s TSS descriptor.
+[[nodiscard]] uint16_t tss_selector(uint32_t cpu);
+
+// User selector (RPL 3) of `cpu`'s TLS segment.
+[[nodiscard]] uint16_t tls_selector(uint32_t cpu);
+
+// True if `selector` names any CPU's TLS segment.
+[[nodiscard]] bool is_tls_selector(uint32_t selector);
+
+// Set the base of `cpu`'s TLS segment. The new base takes effect the next
+// time a segment register is loaded with tls_selector(cpu).
+void set_tls(uint32_t cpu, uint32_t base);
 }  // namespace GDT
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <sys/cdefs.h>
 
+#include "spinlock.h"
+
 struct BlockHeader;
 
 /*
@@ -12,6 +14,9 @@ struct BlockHeader;
  * Backed by physical pages allocated from the PMM and mapped on demand via
  * VMM::map(). The heap occupies a dedicated virtual region starting at
  * kHeapVirtBase and can grow up to kHeapMaxSize by mapping additional pages.
+ *
+ * alloc() and free() are serialised by a spinlock, so the heap may be used
+ * from any CPU and from IRQ handlers.
  */
 class Heap {
  public:
@@ -38,6 +43,9 @@ class Heap {
  private:
   BlockHeader* find_last_block() const;
   bool grow(size_t min_bytes);
+  void* alloc_locked(size_t size);
+
+  SpinLock lock_{"heap"};
 
   BlockHeader* base_ = nullptr;
   uint8_t* end_ = nullptr;  // one byte past the last mapped byte
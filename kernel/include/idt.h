@@ -65,5 +65,7 @@ struct Descriptor {
 } __attribute__((packed));
 
 void init();
+// Load the shared IDT on the calling CPU (APs; init() loads it on the BSP).
+void load();
 void set_entry(size_t index, uintptr_t handler, Gate gate, Ring ring);
 }  // namespace IDT
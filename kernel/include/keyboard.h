@@ -17,6 +17,7 @@ __END_DECLS
 
 #include "ps2_command_queue.h"
 #include "ring_buffer.h"
+#include "wait_queue.h"
 
 // Size of keyboard input buffer for sys_read system call
 static constexpr size_t kKeyboardInputBufferSize = 128;
@@ -111,7 +112,7 @@ class KeyboardDriver {
   KeyboardDriver() = default;
   ~KeyboardDriver() = default;
 
-  // Registers the keyboard IRQ handler.
+  // Installs the keyboard IRQ entry point and unmasks IRQ 1.
   static void init();
   KeyboardDriver(const KeyboardDriver&) = delete;
   KeyboardDriver& operator=(const KeyboardDriver&) = delete;
@@ -169,6 +170,28 @@ class KeyboardDriver {
    */
   void flush_events() { event_buffer_.clear(); }
 
+  /**
+   * Returns true if characters are buffered for read() (poll).
+   */
+  bool has_input() const { return input_buffer_.size() > 0; }
+
+  /**
+   * Returns true if key events are buffered for read_events() (poll).
+   */
+  bool has_events() const { return event_buffer_.size() > 0; }
+
+  /**
+   * Processes blocked reading terminal input. Woken whenever a character
+   * is buffered.
+   */
+  WaitQueue& input_waiters() { return input_waiters_; }
+
+  /**
+   * Processes blocked reading /dev/kbd. Woken whenever a key event is
+   * buffered.
+   */
+  WaitQueue& event_waiters() { return event_waiters_; }
+
  private:
   /**
    * Buffers printable character for sys_read.
@@ -188,6 +211,12 @@ class KeyboardDriver {
   // Raw key event buffer for /dev/kbd
   RingBuffer<kbd_event, kKeyEventBufferSize> event_buffer_;
 
+  // Readers parked until input_buffer_ becomes non-empty
+  WaitQueue input_waiters_{};
+
+  // Readers parked until event_buffer_ becomes non-empty
+  WaitQueue event_waiters_{};
+
   // PS/2 command protocol handler
   PS2CommandQueue cmd_queue_;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Per-lock usage statistics.
+ *
+ * Every SpinLock, Mutex and RwLock embeds a LockStats. It joins a global
+ * registry the first time the lock is acquired, so lock_stats_dump() can
+ * report every lock that has actually been used without a central table
+ * of lock definitions. A lock that goes away (one on the stack or in a
+ * freed object) leaves the registry in its destructor.
+ *
+ * Times are raw TSC cycles: cheap enough to read on every acquire and
+ * release, and only ever compared with each other.
+ */
+struct LockStats {
+  constexpr explicit LockStats(const char* lock_name) : name(lock_name) {}
+  ~LockStats();
+
+  LockStats(const LockStats&) = delete;
+  LockStats& operator=(const LockStats&) = delete;
+
+  const char* name;              // shown by lock_stats_dump()
+  uint32_t acquisitions = 0;     // successful acquisitions (shared and exclusive)
+  uint32_t contentions = 0;      // acquisitions that found the lock held
+  uint64_t wait_cycles = 0;      // total cycles spent spinning for the lock
+  uint64_t hold_cycles = 0;      // total cycles held exclusively
+  uint64_t max_hold_cycles = 0;  // longest single exclusive hold
+  LockStats* prev = nullptr;     // registry links
+  LockStats* next = nullptr;
+  bool registered = false;       // true while linked into the registry
+
+  // Count a successful acquisition; registers the lock on first use.
+  void record_acquire();
+
+  // Count an acquisition attempt that had to wait `waited` cycles (or, for
+  // sleeping locks, had to block).
+  void record_contention(uint64_t waited);
+
+  // Count the end of an exclusive hold lasting `held` cycles.
+  void record_release(uint64_t held);
+};
+
+// Write one line per registered lock to the debugcon port (0xE9).
+void lock_stats_dump();
+
+// Zero the counters of every registered lock.
+void lock_stats_reset();
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lock_stats.h"
+#include "wait_queue.h"
+
+struct Process;
+
+/*
+ * Sleeping mutex for long critical sections (e.g. disk I/O).
+ *
+ * A process that finds the mutex held is parked on the mutex's wait queue
+ * using the same prepare-to-wait protocol as pipes and the keyboard:
+ * lock_or_wait() calls Scheduler::wait_on() and returns false, the syscall
+ * returns kSyscallRestart, and it is re-executed once unlock() wakes the
+ * queue. The waiter costs no CPU time while the holder works.
+ *
+ * Owners are processes, so the mutex must be released before the syscall
+ * that took it returns. Not for IRQ context.
+ */
+class Mutex {
+ public:
+  constexpr explicit Mutex(const char* name) : stats_(name) {}
+
+  Mutex(const Mutex&) = delete;
+  Mutex& operator=(const Mutex&) = delete;
+
+  // Acquire for the current process and return true, or park the caller on
+  // the mutex's wait queue and return false. On false the caller must
+  // unwind and return kSyscallRestart.
+  [[nodiscard]] bool lock_or_wait();
+
+  // Acquire if free. Never parks the caller.
+  [[nodiscard]] bool try_lock();
+
+  // Release and wake every waiter so they retry.
+  void unlock();
+
+  [[nodiscard]] bool is_locked() const { return owner_ != nullptr; }
+  [[nodiscard]] const Process* owner() const { return owner_; }
+  [[nodiscard]] const LockStats& stats() const { return stats_; }
+
+ private:
+  Process* owner_ = nullptr;
+  WaitQueue waiters_{};
+  uint64_t acquired_at_ = 0;  // TSC at acquisition
+  LockStats stats_;
+};
+
+// Releases a Mutex already acquired by lock_or_wait() / try_lock() when it
+// goes out of scope.
+class MutexGuard {
+ public:
+  explicit MutexGuard(Mutex& mutex) : mutex_(mutex) {}
+  ~MutexGuard() { mutex_.unlock(); }
+
+  MutexGuard(const MutexGuard&) = delete;
+  MutexGuard& operator=(const MutexGuard&) = delete;
+
+ private:
+  Mutex& mutex_;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "file.h"
+
+struct VfsNode;
+
+/*
+ * Page cache shared by the VFS and the filesystem backends.
+ *
+ * File data is cached in whole pages keyed by (node, page index in the
+ * file). A backend opts in by providing the read_page/write_page VfsOps;
+ * Vfs::read/write and their vector and positional forms then go through
+ * the cache for its nodes and only call the backend to fill a missing
+ * page or to write a dirty one back. Each page's data lives in its own
+ * PMM frame, so a later file-backed mmap can map cached pages directly.
+ *
+ * Writes only dirty the cached pages and grow node->size. Dirty pages
+ * reach the backend when they are evicted, on fsync() / sync_all()
+ * (including before an unmount), when their node is freed, and from a
+ * write-back kernel thread every kWritebackIntervalNs. A backend error is returned by the
+ * call that triggered the write-back and leaves the page dirty.
+ *
+ * Pages sit on one LRU list. The cache takes a new frame only while the
+ * PMM has more than kMinFreeFrames free, and never holds more than
+ * kMaxPages; past either limit a miss recycles the least recently used
+ * page instead (a clean one if there is any). When the PMM itself runs
+ * dry it calls shrink() to take clean pages back.
+ *
+ * Reads through an open file keep ReadAhead state. While the reader goes
+ * through the file sequentially the cache stays up to `window` pages
+ * ahead of it, topping up whenever less than half a window is left, and
+ * doubles the window each time up to kReadAheadMaxPages. A read anywhere
+ * else halves the window. Missing pages are fetched in runs, one backend
+ * call per run, so a sequential reader issues few large transfers.
+ *
+ * All state is protected by the big kernel lock.
+ */
+
+namespace PageCache {
+
+// Upper bound on resident pages (4 MiB of file data).
+static constexpr uint32_t kMaxPages = 1024;
+
+// The cache stops growing once the PMM is down to this many free frames.
+static constexpr size_t kMinFreeFrames = 256;
+
+// Period of the write-back thread.
+static constexpr uint64_t kWritebackIntervalNs = 2'000'000'000;
+
+// Read-ahead window bounds, in pages (16 KiB to 128 KiB). The largest run
+// filled with one backend call is kReadAheadMaxPages.
+static constexpr uint32_t kReadAheadMinPages = 4;
+static constexpr uint32_t kReadAheadMaxPages = 32;
+
+// Per-open-file read-ahead state; zero-initialised for a new file.
+struct ReadAhead {
+  uint32_t next;    // offset at which a sequential read would continue
+  uint32_t window;  // pages to stay ahead of a sequential reader
+  uint32_t end;     // page index just past the pages read ahead so far
+};
+
+struct Stats {
+  uint32_t hits;        // page lookups served from the cache
+  uint32_t misses;      // page lookups that had to allocate a page
+  uint32_t readahead;   // pages filled ahead of the reader
+  uint32_t evictions;   // pages dropped to make room or under PMM pressure
+  uint32_t writebacks;  // dirty pages written to the backend
+  uint32_t resident;    // pages currently cached
+  uint32_t dirty;       // resident pages not yet written back
+};
+
+// Read into iov from `offset` of a cached node, bounded by node->size,
+// reading ahead per `ra` if it is non-null. Returns the bytes read or a
+// negative errno (kSyscallRestart included); a failure after some bytes
+// were copied returns the short count. `ra` is only updated by a read that
+// returns some bytes.
+[[nodiscard]] int32_t read(VfsNode* node, IoVec iov, uint32_t offset,
+                           ReadAhead* ra = nullptr);
+
+// Write iov at `offset` into the cache, growing node->size. Returns the
+// bytes written or a negative errno, like read().
+[[nodiscard]] int32_t write(VfsNode* node, ConstIoVec iov, uint32_t offset);
+
+// Write back every dirty page of node, highest index first so the
+// backend extends the file once. Returns 0 or the first error.
+[[nodiscard]] int32_t fsync(VfsNode* node);
+
+// Write back every dirty page. Returns 0 or the first error.
+[[nodiscard]] int32_t sync_all();
+
+// Drop every page of node without writing it back (truncate and unlink).
+void invalidate(const VfsNode* node);
+
+// Write back node's dirty pages, then drop all of them. Used when a node
+// is freed while its file still exists; pages the backend fails to take
+// are lost.
+void evict(VfsNode* node);
+
+// Free up to `count` clean pages, least recently used first. Returns the
+// number of frames given back to the PMM.
+size_t shrink(size_t count);
+
+// Register the PMM reclaim hook and start the write-back thread.
+void init();
+
+// Counters since boot or the last reset_stats(); resident and dirty are
+// current values and are not reset.
+[[nodiscard]] Stats stats();
+void reset_stats();
+
+}  // namespace PageCache
@@ -102,6 +102,11 @@ class PhysicalMemoryManager {
   // Releases a previously allocated page frame.
   void free(paddr_t addr);
 
+  // Called by alloc() when no frame is free: frees up to `count` frames
+  // held by a cache and returns how many it freed.
+  using ReclaimFn = size_t (*)(size_t count);
+  void set_reclaim(ReclaimFn fn) { reclaim_ = fn; }
+
   [[nodiscard]] size_t get_free_count() const { return free_count_; }
 
   [[nodiscard]] size_t get_total_frames() const { return total_frames_; }
@@ -126,6 +131,7 @@ class PhysicalMemoryManager {
   Bitmap<MAX_FRAMES> bitmap_;
   size_t total_frames_ = 0;
   size_t free_count_ = 0;
+  ReclaimFn reclaim_ = nullptr;
 };
 
 extern PhysicalMemoryManager kPmm;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <poll.h>
+#include <span.h>
+#include <stdint.h>
+
+#include "wait_queue.h"
+
+/*
+ * poll(): wait for any of several file descriptors (see <poll.h>).
+ *
+ * A process can only sleep on one wait queue, so pollers all share one,
+ * and every pollable resource (pipes, keyboard input) calls notify() along
+ * with waking its own queue. A woken poller re-executes SYS_POLL and
+ * re-checks its descriptors through file_poll(); the timeout deadline is
+ * kept in Process::poll_deadline_ns across those restarts and enforced
+ * with Scheduler::wait_on_until().
+ */
+
+namespace Poll {
+
+// Queue that processes sleeping in poll() wait on.
+[[nodiscard]] WaitQueue& waiters();
+
+// Wake every poll() caller to re-check its descriptors. Safe from IRQ
+// context.
+void notify();
+
+// Fill in revents for fds (a kernel copy) from the current process's fd
+// table. If none is ready and timeout_ms allows, sleep and return
+// kSyscallRestart. Returns the number of ready entries, 0 on timeout.
+[[nodiscard]] int32_t poll(std::span<pollfd> fds, int32_t timeout_ms);
+
+}  // namespace Poll
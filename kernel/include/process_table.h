@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+struct Process;
+
+/*
+ * Process table.
+ *
+ * PCBs are allocated from the kernel heap on demand and recycled through a
+ * free list, so the number of live processes is bounded only by memory and
+ * the PID space. PIDs come from a bitmap: allocation scans forward from the
+ * last PID handed out and wraps at kMaxPid, so a PID is reused only once
+ * the space has cycled. PID 0 is the first allocation (the BSP's idle
+ * process) and is never freed.
+ *
+ * Live processes are reachable three ways:
+ *   - by PID, through a hash table chained via Process::hash_next (O(1)),
+ *   - all together, through the list starting at head() and linked via
+ *     Process::table_next (for broadcast scans),
+ *   - per parent, through Process::first_child / next_sibling (waitpid).
+ */
+
+namespace ProcessTable {
+
+// Exclusive upper bound on PIDs.
+static constexpr uint32_t kMaxPid = 32768;
+
+// Number of pid hash buckets (power of two).
+static constexpr uint32_t kHashBuckets = 256;
+
+// Allocate a zeroed PCB with a fresh PID, in state Ready with cwd at the root.
+// Returns nullptr when the PID space or the heap is exhausted.
+[[nodiscard]] Process* alloc();
+
+// Return p's PID to the bitmap and its PCB to the free list. p must have
+// no children left and must already be unlinked from its parent.
+void free(Process* p);
+
+// Live process with the given PID, or nullptr.
+[[nodiscard]] Process* find(uint32_t pid);
+
+// First live process; follow Process::table_next for the rest.
+[[nodiscard]] Process* head();
+
+// Number of live processes.
+[[nodiscard]] uint32_t count();
+
+// Make child a child of parent (pushes onto parent's child list).
+void add_child(Process* parent, Process* child);
+
+// Unlink child from its parent's child list and clear child->parent.
+// No-op for processes without a parent.
+void remove_child(Process* child);
+
+}  // namespace ProcessTable
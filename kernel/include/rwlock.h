@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lock_stats.h"
+
+/*
+ * Spinning reader-writer lock.
+ *
+ * Any number of readers may hold the lock together; a writer holds it
+ * alone. Writers take priority: once a writer is waiting, new readers spin
+ * until it has been served, so a steady stream of lookups cannot starve
+ * tree updates.
+ *
+ * Interrupt state is left alone, so an RwLock must not be taken from IRQ
+ * context. Hold times are recorded for writers only.
+ */
+class RwLock {
+ public:
+  constexpr explicit RwLock(const char* name) : stats_(name) {}
+
+  RwLock(const RwLock&) = delete;
+  RwLock& operator=(const RwLock&) = delete;
+
+  void read_lock();
+  void read_unlock();
+  void write_lock();
+  void write_unlock();
+
+  [[nodiscard]] uint32_t readers() const;
+  [[nodiscard]] bool is_write_locked() const;
+  [[nodiscard]] const LockStats& stats() const { return stats_; }
+
+ private:
+  static constexpr uint32_t kWriter = 1U << 31;
+
+  uint32_t state_ = 0;            // kWriter, or the number of readers
+  uint32_t writers_waiting_ = 0;  // readers back off while non-zero
+  uint64_t acquired_at_ = 0;      // TSC at write acquisition
+  LockStats stats_;
+};
+
+// Holds an RwLock shared for the lifetime of the guard.
+class ReadGuard {
+ public:
+  explicit ReadGuard(RwLock& lock) : lock_(lock) { lock_.read_lock(); }
+  ~ReadGuard() { lock_.read_unlock(); }
+
+  ReadGuard(const ReadGuard&) = delete;
+  ReadGuard& operator=(const ReadGuard&) = delete;
+
+ private:
+  RwLock& lock_;
+};
+
+// Holds an RwLock exclusively for the lifetime of the guard.
+class WriteGuard {
+ public:
+  explicit WriteGuard(RwLock& lock) : lock_(lock) { lock_.write_lock(); }
+  ~WriteGuard() { lock_.write_unlock(); }
+
+  WriteGuard(const WriteGuard&) = delete;
+  WriteGuard& operator=(const WriteGuard&) = delete;
+
+ private:
+  RwLock& lock_;
+};
@@ -9,26 +9,78 @@
 // Forward declaration for is_vfs_node_open.
 struct VfsNode;
 
+// Forward declarations for get_stats (see <sys/schedstat.h>).
+struct sched_stat;
+struct proc_stat;
+
 /*
  * Round-robin preemptive scheduler.
  *
- * The timer IRQ (100 Hz) triggers schedule() on every tick. Processes in
- * the ready queue are run in FIFO order. An idle process (PID 0) runs when
- * no user processes are ready.
+ * Each CPU has its own ready queue, run in FIFO order with a kTimeSliceNs
+ * slice, and its own idle process (PID 0) that runs when nothing is ready.
+ * A woken process goes to an idle CPU if there is one (kicked with a
+ * reschedule IPI), otherwise back to the CPU it last ran on. A CPU whose
+ * queue runs dry steals from the longest other queue.
+ *
+ * The timer is tickless: after every scheduling decision the PIT is armed
+ * as a one-shot for the earliest of the current slice end (only if another
+ * process is waiting for the CPU) and the next sleeper's wake time. With
+ * nothing runnable and nobody sleeping, the only interrupts left are the
+ * PIT's longest countdowns (~55 ms) that keep the clock running. The PIT
+ * drives the BSP and the kernel timer heap; APs time their slices with
+ * their local APIC timers.
  *
  * Context switching works by returning a (possibly different) kernel ESP
  * from schedule(). The assembly stubs (timer_entry.S, syscall_entry.S) use
  * the returned ESP to restore the next process's TrapFrame and iret into it.
+ *
+ * Kernel threads (kthread_create) are ring-0 processes on the shared
+ * boot_page_directory. They run like syscall code: interrupts disabled and
+ * the big kernel lock held, so they are never preempted and must give up
+ * the CPU themselves through kthread_yield/wait/sleep/exit. Those raise
+ * kKthreadYieldVector, which saves a TrapFrame like any other trap, so
+ * kernel threads are switched by the same schedule() path. Kernel threads
+ * ignore signals and must not call code that blocks through
+ * kSyscallRestart; they sleep on wait queues with kthread_wait() instead.
+ *
+ * User threads (clone_current) are scheduled like any other process. They
+ * share their group leader's page directory, so switching between threads
+ * of one process reloads CR3 with the same value; only the TLS segment
+ * changes.
+ *
+ * CPU time is accounted in nanoseconds at every kernel entry that can
+ * change what a CPU runs: the interval since the CPU's last accounting
+ * point is charged to the process that ran it, as user time if it was
+ * interrupted in ring 3 and as system time if it was in a syscall or is a
+ * kernel thread. Time a process spends Ready in a run queue is its wait
+ * time. Load averages are sampled every kLoadSampleNs from a kernel timer.
  */
 
 namespace Scheduler {
 
+// Length of a time slice when other processes are waiting to run.
+static constexpr uint64_t kTimeSliceNs = 10'000'000;
+
+// Software interrupt a kernel thread raises to switch away. Kernel-only
+// gate: int from ring 3 faults.
+static constexpr uint8_t kKthreadYieldVector = 0x81;
+
+// Interval between load average samples.
+static constexpr uint64_t kLoadSampleNs = 5'000'000'000;
+
+// Entry point of a kernel thread.
+using KthreadFn = void (*)(void* arg);
+
 // Create the idle process (PID 0), install timer_entry as the sole
 // IRQ 0 handler, and unmask the timer IRQ for PIT tick counting.
 // Must be called after heap, PMM, and PIT are initialised.
 // Context switching is disabled until start() is called.
 void init();
 
+// Set up `cpu`'s run queue with an idle process running on `kernel_stack`
+// (the stack the AP booted on). Called by each AP before it goes online.
+void init_ap(uint32_t cpu, uint8_t* kernel_stack);
+
 // Enable preemptive context switching. Must be called after init().
 void start();
 
@@ -58,48 +110,128 @@ void init_trap_frame(TrapFrame* frame, vaddr_t entry, uint32_t user_esp);
 // Called from timer_entry.S and syscall_entry.S.
 // `esp` is the current kernel stack pointer (pointing to a TrapFrame).
 // Returns the kernel ESP to restore (may be a different process's stack).
+// Re-arms the one-shot timer for the next deadline before returning.
 [[nodiscard]] uint32_t schedule(uint32_t esp);
 
-// Mark the current process as Zombie and free its address space.
+// Create a kernel thread that runs fn(arg) once the scheduler picks it.
+// Returning from fn is the same as calling kthread_exit(). Returns nullptr
+// if the process table is full or the kernel stack cannot be allocated.
+[[nodiscard]] Process* kthread_create(KthreadFn fn, void* arg);
+
+// Kernel-thread only. Let other ready processes run, then continue.
+void kthread_yield();
+
+// Kernel-thread only. Sleep on `wq` until wake_all() is called on it. The
+// caller checks its wait condition before calling and again afterwards:
+// both happen under the kernel lock, so no wakeup can be missed.
+void kthread_wait(WaitQueue& wq);
+
+// Kernel-thread only. Sleep for `ns` nanoseconds.
+void kthread_sleep(uint64_t ns);
+
+// Kernel-thread only. Terminate the calling thread. Its kernel stack is
+// freed the next time its CPU schedules.
+[[noreturn]] void kthread_exit();
+
+// Terminate the current process: every thread in its group. The calling
+// thread becomes a Zombie at once and the others are sent SIGKILL. When the
+// last one is gone, the group's fds and address space are freed and the
+// parent is woken if it is blocked in waitpid.
 // The actual context switch happens when schedule() is called by the
 // assembly return path (syscall_entry.S / timer_entry.S).
 void exit_current(uint32_t exit_code);
 
-// Block the current process until `ms` milliseconds have elapsed,
-// then switch to the next ready process.
-void sleep_current(uint32_t ms);
+// Terminate only the calling thread (pthread_exit). The last thread of a
+// group to go releases the group as exit_current() does, with exit code 0.
+void exit_thread();
 
-// Block the current process with wake_tick=0, so it wakes on the next
-// scheduler tick. Used by the syscall restart mechanism to retry a
-// blocked syscall (e.g. pipe read on empty buffer).
+// Block the current process until `ns` nanoseconds have elapsed,
+// then switch to the next ready process.
+void sleep_current(uint64_t ns);
+
+// Record that the current process should sleep on `wq` if the syscall in
+// progress returns kSyscallRestart. Resource code calls this just before
+// returning kSyscallRestart (e.g. pipe read on an empty buffer). No-op for
+// the idle process, so kernel-context callers such as ktests never block.
+void wait_on(WaitQueue& wq);
+
+// wait_on(), but the process is also woken at deadline_ns (a PIT::now_ns()
+// time) if nothing wakes `wq` first. Used for timeouts such as poll()'s.
+void wait_on_until(WaitQueue& wq, uint64_t deadline_ns);
+
+// Forget the wait_on() or wait_on_until() of a call whose kSyscallRestart
+// the caller does not pass on (e.g. a vectored read that already
+// transferred some bytes).
+void cancel_wait();
+
+// Park the current process on the queue recorded by wait_on(). Called by
+// syscall_dispatch after rewinding EIP for a kSyscallRestart result. The
+// process costs no CPU until wake_all() is called on that queue or a signal
+// arrives. If a signal is already pending, the process stays runnable so
+// the signal is delivered and the syscall retried afterwards.
 void block_current();
 
+// Move every process sleeping on `wq` to the ready queue. Safe to call from
+// IRQ context and on an empty queue. Woken processes re-execute their
+// syscall and re-check the resource.
+void wake_all(WaitQueue& wq);
+
+// Called from IRQ entry paths that may have woken a process (e.g. the
+// keyboard IRQ). If the idle process is running and something is ready,
+// switch to it now instead of waiting for the next timer tick.
+// Returns the kernel ESP to restore.
+[[nodiscard]] uint32_t preempt_idle(uint32_t esp);
+
 // Create a child process as an exact copy of the current process.
 // The child gets a deep copy of the parent's address space.
 // Returns the child PID to the parent, or (uint32_t)-1 on failure.
 // The child's TrapFrame has eax=0 so fork() returns 0 in the child.
 [[nodiscard]] uint32_t fork_current(const TrapFrame* parent_regs);
 
+// Create a thread in the current process's group. It shares the address
+// space and everything else reached through Process::group(), and starts
+// as a copy of `regs` returning 0, on the user stack `user_esp`. A non-zero
+// `tls` becomes its %gs segment base. If `clear_tid` is non-zero, the word
+// there is zeroed and FUTEX_WAKEd when the thread exits. Returns the new
+// thread's pid, or -EAGAIN if the process table is full.
+[[nodiscard]] int32_t clone_current(const TrapFrame* regs, uint32_t user_esp, vaddr_t tls,
+                                    vaddr_t clear_tid);
+
 // Block until a child process exits and collect its exit code.
 // If pid > 0, wait for that specific child.
 // If pid == -1, wait for any child.
 // exit_code_ptr, if non-null, receives the child's exit code.
-// Returns child PID on success, 0 if blocked (will be restarted by
-// scheduler), or -1 if no matching child found.
+// Returns child PID on success, kSyscallRestart if the caller was parked on
+// its child_exit_waiters queue (woken by exit_current), or -ECHILD if no
+// matching child exists.
 [[nodiscard]] int32_t waitpid_current(int32_t pid, int32_t* exit_code_ptr);
 
+// Set p's command name from `path`: its last component, truncated to
+// kProcessNameLen - 1 characters.
+void set_name(Process* p, const char* path);
+
+// Charge the time since this CPU's last accounting point to the current
+// process as user time. Called by syscall_dispatch on entry, so that the
+// rest of the syscall is charged as system time by schedule().
+void account_syscall_entry();
+
+// Fill `stat` with system-wide statistics and `procs` with per-process
+// ones, in process table order. Returns the number of entries written.
+[[nodiscard]] uint32_t get_stats(sched_stat* stat, std::span<proc_stat> procs);
+
 // Get the currently running process (nullptr before init).
 [[nodiscard]] Process* current();
 
 // Send signal `signum` to the process with the given pid.
-// Sets the pending bit; if the target is blocked, moves it to the ready queue.
+// Sets the pending bit; if the target is blocked (sleeping or on a wait
+// queue), moves it to the ready queue.
 void send_signal(uint32_t pid, uint32_t signum);
 
 // Send signal `signum` to all non-idle, non-zombie processes.
 // Used for Ctrl+C (SIGINT) where there is no process group tracking yet.
 void broadcast_signal(uint32_t signum);
 
-// Returns true if at least one non-idle, non-zombie process exists.
+// Returns true if at least one non-idle, non-zombie user process exists.
 [[nodiscard]] bool has_user_processes();
 
 // Check and deliver pending signals for the current process.
@@ -109,6 +241,11 @@ void broadcast_signal(uint32_t signum);
 // frame is the TrapFrame about to be restored; only acts for user-mode frames.
 void check_pending_signals(TrapFrame* frame);
 
+// Returns true if a thread of `leader`'s group is running on a CPU other
+// than the caller's. Only such CPUs can hold TLB entries for the group's
+// user mappings: every switch reloads CR3.
+[[nodiscard]] bool group_running_elsewhere(const Process* leader);
+
 // Returns true if any non-zombie process currently has the given VFS node open.
 // Used by fat_unlink to refuse deletion of open files.
 [[nodiscard]] bool is_vfs_node_open(const VfsNode* node);
@@ -8,15 +8,22 @@
 
 namespace Syscall {
 
-// Register IDT entry 0x80 as a user-callable interrupt gate.
-// Must be called after Interrupt::init().
+// Register IDT entry 0x80 as a user-callable interrupt gate, and enable
+// the sysenter fast path on the BSP if the CPU supports it.
+// Must be called after Interrupt::init() and TSS::init().
 void init();
 
+// Enable the sysenter fast path on the calling AP (if the BSP enabled it).
+void init_ap(uint32_t cpu);
+
+// Returns true if sysenter_entry is installed as the SYSENTER target.
+[[nodiscard]] bool has_sysenter();
+
 }  // namespace Syscall
 
 __BEGIN_DECLS
 
-// Called from syscall_entry.S. Dispatches the syscall identified by
+// Called from syscall_entry and sysenter_entry (trap_entry.S). Dispatches the syscall identified by
 // regs->eax and returns the kernel ESP to restore (which may be a different
 // process after a blocking syscall triggers a context switch).
 uint32_t syscall_dispatch(uint32_t esp);
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array.h>
 #include <stdint.h>
 
+#include "smp.h"
+
 /*
  * =======================================
  *      Task State Segment (TSS)
@@ -59,15 +62,19 @@ struct Entry {
 
 static_assert(sizeof(Entry) == 104, "TSS must be 104 bytes");
 
-// The single kernel TSS instance. Its address is installed in the GDT by
-// GDT::init(); TSS::init() configures the fields and loads the selector.
-extern Entry tss;
+// One TSS per CPU, indexed by Smp::current_cpu(). Their addresses are
+// installed in the GDT by GDT::init(); init() / init_ap() configure the
+// fields and load the selector.
+extern std::array<Entry, Smp::kMaxCpus> tss;
 
-// Configure the TSS (ss0, iomap_base) and load the task register.
+// Configure the BSP's TSS (ss0, iomap_base) and load the task register.
 // Must be called after GDT::init().
 void init();
 
-// Update the ring-0 stack pointer stored in the TSS.
+// Configure `cpu`'s TSS and load it on the calling AP.
+void init_ap(uint32_t cpu);
+
+// Update the ring-0 stack pointer stored in the calling CPU's TSS.
 // Call on every context switch to ensure ring-3 interrupts land on the
 // correct kernel stack.
 void set_kernel_stack(uint32_t esp0);
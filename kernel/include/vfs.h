@@ -8,6 +8,7 @@
 #include <sys/types.h>
 
 #include "file.h"
+#include "page_cache.h"
 
 // Maximum path length (including null terminator).
 static constexpr uint32_t kMaxPathLen = 128;
@@ -27,14 +28,31 @@ struct VfsOps {
   int32_t (*write)(struct VfsNode* node, std::span<const uint8_t> buf, uint32_t offset);
   int32_t (*ioctl)(struct VfsNode* node, uint32_t request, void* arg);
   int32_t (*truncate)(struct VfsNode* node);
+  // Optional scatter/gather variants of read/write, for backends that can
+  // fill several buffers from one device transfer. Without them the VFS
+  // calls read/write once per buffer.
+  int32_t (*readv)(struct VfsNode* node, IoVec iov, uint32_t offset);
+  int32_t (*writev)(struct VfsNode* node, ConstIoVec iov, uint32_t offset);
+  // Optional readiness check for poll(), returning POLL* bits. Without it
+  // a node is always ready for whichever of read/write it supports.
+  uint32_t (*poll)(struct VfsNode* node);
+  // Optional page cache hooks, provided together (see page_cache.h). With
+  // them, reads and writes go through the cache. read_page fills `page`
+  // with page `index` of the file and returns the bytes it holds of the
+  // file; write_page stores `data` at index * PAGE_SIZE. If the backend
+  // also has readv, the cache fills runs of pages with one readv call.
+  int32_t (*read_page)(struct VfsNode* node, uint32_t index, std::span<uint8_t> page);
+  int32_t (*write_page)(struct VfsNode* node, uint32_t index, std::span<const uint8_t> data);
 };
 
 // An open-file description backed by a VFS node. Tracks the per-fd
-// read/write offset for regular files.
+// read/write offset for regular files, and the read-ahead state of reads
+// through it.
 struct VfsFileDescription {
   struct VfsNode* node;
   uint32_t offset;
   int32_t open_flags;
+  PageCache::ReadAhead ra{};
 };
 
 // Maximum component name length (filename or directory name, not full path).
@@ -65,6 +83,10 @@ struct VfsNode {
 
   // Mount point: non-null if a filesystem is mounted on this node.
   const struct FsOps* mount_ops;
+
+  // Open descriptions and working directories using this node. A removed
+  // node stays allocated, detached from the tree, until this drops to 0.
+  uint32_t refs;
 };
 
 // Filesystem-level operations for a mounted volume.
@@ -93,21 +115,64 @@ void init();
 // Soft-delete a node by path (clears its name so it is skipped by lookup).
 void unregister_node(const char* path);
 
+// Move the node at old_path to new_path, replacing any node already there.
+// The node keeps its identity, so open files, cached pages and size follow
+// it. The parent of new_path must exist. Returns 0 or a negative errno.
+[[nodiscard]] int32_t move_node(const char* old_path, const char* new_path);
+
 // Look up a node by its full path. Returns nullptr if not found.
 [[nodiscard]] VfsNode* lookup(const char* path);
 
+// Look up path starting at directory `base` (nullptr for the root); an
+// absolute path ignores base. "." and ".." are followed through the tree,
+// so a relative path never needs to be joined to base's path or walked
+// from the root. Returns nullptr if any component is missing.
+[[nodiscard]] VfsNode* lookup_at(VfsNode* base, const char* path);
+
+// Write node's absolute path (nullptr for the root) into buf. Returns its
+// length, -ENOENT if the node has been removed from the tree, or -ERANGE
+// if buf is too small.
+[[nodiscard]] int32_t node_path(const VfsNode* node, char* buf, size_t size);
+
+// Take and drop a reference that keeps node allocated (see VfsNode::refs).
+// Dropping the last reference to a removed node frees it. Both ignore
+// nullptr.
+void node_get(VfsNode* node);
+void node_put(VfsNode* node);
+
 // Open a VFS node and install it into the process's fd table.
 // flags uses the same O_* constants as open(2). If O_CREAT is set and the
 // node does not exist, a filesystem create is attempted.
 // Returns the fd number, or negative errno on failure.
 [[nodiscard]] int32_t open(const char* path, int32_t flags, mode_t mode = 0);
 
+// open() with path relative to directory base (see lookup_at()). With
+// O_DIRECTORY the node must be a directory (-ENOTDIR otherwise).
+[[nodiscard]] int32_t open_at(VfsNode* base, const char* path, int32_t flags, mode_t mode = 0);
+
 // Read from a VFS-backed file description.
 [[nodiscard]] int32_t read(FileDescription* fd, std::span<uint8_t> buf);
 
 // Write to a VFS-backed file description.
 [[nodiscard]] int32_t write(FileDescription* fd, std::span<const uint8_t> buf);
 
+// Scatter/gather read and write at the description's offset, which they
+// advance like read() and write().
+[[nodiscard]] int32_t readv(FileDescription* fd, IoVec iov);
+[[nodiscard]] int32_t writev(FileDescription* fd, ConstIoVec iov);
+
+// Read or write at `offset`, leaving the description's offset alone.
+// pwrite() ignores O_APPEND.
+[[nodiscard]] int32_t pread(FileDescription* fd, std::span<uint8_t> buf, uint32_t offset);
+[[nodiscard]] int32_t pwrite(FileDescription* fd, std::span<const uint8_t> buf, uint32_t offset);
+
+// Write the file's cached dirty pages back to its filesystem. Returns 0
+// (also for nodes that are not cached) or a negative errno.
+[[nodiscard]] int32_t fsync(FileDescription* fd);
+
+// Readiness of a VFS-backed file description for poll() (see VfsOps::poll).
+[[nodiscard]] uint32_t poll(FileDescription* fd);
+
 // Perform a device-specific control operation on a VFS-backed file description.
 [[nodiscard]] int32_t ioctl(FileDescription* fd, uint32_t request, void* arg);
 
@@ -121,14 +186,17 @@ void close(FileDescription* fd);
 // Returns true if path names a valid virtual directory.
 [[nodiscard]] bool is_directory(const char* path);
 
-// Fill entries with the direct children of path. Returns the number of
-// entries written, or 0 if path is not a directory or is empty.
-uint32_t getdents(const char* path, dirent* entries, uint32_t max_entries);
+// Fill entries with the next children of the directory open on fd,
+// starting from its offset, and advance the offset past them. d_name and
+// d_type are always set; d_size and d_mode only if attrs. Returns the
+// number of entries written (0 at the end), -ENOTDIR or -EBADF.
+[[nodiscard]] int32_t getdents(FileDescription* fd, std::span<dirent> entries, bool attrs);
 
 // Mount a filesystem at the given path. Calls ops->mount() if provided.
 int32_t mount(const char* path, const FsOps* ops);
 
-// Unmount the filesystem at the given path.
+// Unmount the filesystem at the given path, after writing back every
+// dirty cached page.
 int32_t unmount(const char* path);
 
 // Filesystem-level operations -- dispatched to the nearest mount ancestor.
@@ -136,10 +204,19 @@ int32_t fs_mkdir(const char* abs_path);
 int32_t fs_unlink(const char* abs_path);
 int32_t fs_rename(const char* old_path, const char* new_path);
 
+// fs_mkdir() and fs_unlink() with path relative to directory base. With
+// remove_dir, unlink only accepts a directory; without it, only a
+// non-directory.
+int32_t fs_mkdir_at(VfsNode* base, const char* path);
+int32_t fs_unlink_at(VfsNode* base, const char* path, bool remove_dir);
+
 // Fill buf with stat information for the given path.
 // Returns 0 on success, or negative errno on failure.
 int32_t stat_path(const char* path, struct stat* buf);
 
+// stat_path() with path relative to directory base (see lookup_at()).
+int32_t stat_at(VfsNode* base, const char* path, struct stat* buf);
+
 // Fill buf with stat information for a VfsNode directly.
 int32_t stat_node(const VfsNode* node, struct stat* buf);
 
@@ -0,0 +1,31 @@
+#pragma once
+
+struct Process;
+
+/*
+ * Intrusive FIFO of processes sleeping on a resource (pipe buffer, keyboard
+ * input, child exit, ...). Links through Process::next, which is free while a
+ * process is blocked since it is then not on the ready queue.
+ *
+ * WaitQueue only manages list membership. Process state transitions go
+ * through Scheduler::wait_on() and Scheduler::wake_all().
+ *
+ * Zero-initialisation yields an empty queue, so a WaitQueue can be embedded
+ * in memset/value-initialised structs such as Process.
+ */
+struct WaitQueue {
+  Process* head;
+  Process* tail;
+
+  // Returns true if no process is waiting.
+  [[nodiscard]] bool empty() const { return head == nullptr; }
+
+  // Append p to the back of the queue.
+  void push(Process* p);
+
+  // Remove and return the front process, or nullptr if empty.
+  [[nodiscard]] Process* pop();
+
+  // Unlink p from anywhere in the queue. Returns false if p was not queued.
+  bool remove(Process* p);
+};
@@ -15,3 +15,43 @@ extern uint32_t kernel_start;
 extern uint32_t kernel_end;
 
 __END_DECLS
+
+// Execute CPUID for `leaf` (subleaf 0) and return the four result registers.
+struct CpuidResult {
+  uint32_t eax;
+  uint32_t ebx;
+  uint32_t ecx;
+  uint32_t edx;
+};
+
+static inline CpuidResult cpuid(uint32_t leaf) {
+  CpuidResult r;
+  __asm__ volatile("cpuid"
+                   : "=a"(r.eax), "=b"(r.ebx), "=c"(r.ecx), "=d"(r.edx)
+                   : "a"(leaf), "c"(0));
+  return r;
+}
+
+// Read a model-specific register.
+static inline uint64_t rdmsr(uint32_t msr) {
+  uint32_t lo;
+  uint32_t hi;
+  __asm__ volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+// Write a model-specific register.
+static inline void wrmsr(uint32_t msr, uint64_t value) {
+  __asm__ volatile("wrmsr"
+                   :
+                   : "c"(msr), "a"(static_cast<uint32_t>(value)),
+                     "d"(static_cast<uint32_t>(value >> 32)));
+}
+
+// Read the time-stamp counter.
+static inline uint64_t rdtsc() {
+  uint32_t lo;
+  uint32_t hi;
+  __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
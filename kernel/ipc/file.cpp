@@ -1,33 +1,36 @@
 #include "file.h"
 
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <sys/io.h>
+#include <unique_ptr.h>
 
 #include "keyboard.h"
 #include "pipe.h"
+#include "scheduler.h"
 #include "tty.h"
 #include "vfs.h"
 
 static constexpr uint16_t kDebugconPort = 0xE9;
 
-// ===========================================================================
-// Terminal singletons
-// ===========================================================================
-
-static FileDescription g_terminal_read = {
-    .type = FileType::TerminalRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr};
-static FileDescription g_terminal_write = {
-    .type = FileType::TerminalWrite, .ref_count = 1, .pipe = nullptr, .vfs = nullptr};
-
 // ===========================================================================
 // File operations dispatch
 // ===========================================================================
 
-int32_t file_read(FileDescription* fd, std::span<uint8_t> buf) {
+namespace {
+
+int32_t read_backend(FileDescription* fd, std::span<uint8_t> buf) {
   switch (fd->type) {
     case FileType::TerminalRead: {
       char* cbuf = reinterpret_cast<char*>(buf.data());
       const size_t n = kKeyboard.read(cbuf, buf.size());
+      if (n == 0 && !buf.empty()) {
+        Scheduler::wait_on(kKeyboard.input_waiters());
+        return kSyscallRestart;
+      }
       return static_cast<int32_t>(n);
     }
     case FileType::PipeRead:
@@ -39,7 +42,7 @@ int32_t file_read(FileDescription* fd, std::span<uint8_t> buf) {
   }
 }
 
-int32_t file_write(FileDescription* fd, std::span<const uint8_t> buf) {
+int32_t write_backend(FileDescription* fd, std::span<const uint8_t> buf) {
   switch (fd->type) {
     case FileType::TerminalWrite:
       terminal_write({reinterpret_cast<const char*>(buf.data()), buf.size()});
@@ -56,21 +59,115 @@ int32_t file_write(FileDescription* fd, std::span<const uint8_t> buf) {
   }
 }
 
-void file_close(FileDescription* fd) {
-  // Terminal singletons are never freed; just decrement their ref count.
-  if (fd->type == FileType::TerminalRead || fd->type == FileType::TerminalWrite) {
-    if (fd->ref_count > 0) {
-      --fd->ref_count;
-    }
-    return;
+// O_NONBLOCK applies to pipes, terminals and character devices. Regular
+// file I/O still waits out a busy backend, as POSIX leaves it unaffected.
+bool is_nonblocking(const FileDescription* fd) {
+  if ((fd->status_flags & O_NONBLOCK) == 0) {
+    return false;
+  }
+  return fd->type != FileType::VfsNode || fd->vfs == nullptr || fd->vfs->node == nullptr ||
+         fd->vfs->node->type == VfsNodeType::CharDev;
+}
+
+// An O_NONBLOCK description never sleeps: a backend result that would park
+// the caller becomes -EAGAIN, and the wait it set up is dropped.
+int32_t nonblocking_result(const FileDescription* fd, int32_t rc) {
+  if (rc == kSyscallRestart && is_nonblocking(fd)) {
+    Scheduler::cancel_wait();
+    return -EAGAIN;
   }
+  return rc;
+}
+
+}  // namespace
+
+int32_t file_read(FileDescription* fd, std::span<uint8_t> buf) {
+  return nonblocking_result(fd, read_backend(fd, buf));
+}
+
+int32_t file_write(FileDescription* fd, std::span<const uint8_t> buf) {
+  return nonblocking_result(fd, write_backend(fd, buf));
+}
 
+int32_t file_readv(FileDescription* fd, IoVec iov) {
+  if (fd->type == FileType::VfsNode) {
+    return nonblocking_result(fd, Vfs::readv(fd, iov));
+  }
+  return iov_each(iov, [fd](std::span<uint8_t> buf, uint32_t) { return file_read(fd, buf); });
+}
+
+int32_t file_writev(FileDescription* fd, ConstIoVec iov) {
+  if (fd->type == FileType::VfsNode) {
+    return nonblocking_result(fd, Vfs::writev(fd, iov));
+  }
+  return iov_each(iov,
+                  [fd](std::span<const uint8_t> buf, uint32_t) { return file_write(fd, buf); });
+}
+
+int32_t file_pread(FileDescription* fd, std::span<uint8_t> buf, uint32_t offset) {
+  if (fd->type != FileType::VfsNode) {
+    return -ESPIPE;
+  }
+  return nonblocking_result(fd, Vfs::pread(fd, buf, offset));
+}
+
+int32_t file_pwrite(FileDescription* fd, std::span<const uint8_t> buf, uint32_t offset) {
+  if (fd->type != FileType::VfsNode) {
+    return -ESPIPE;
+  }
+  return nonblocking_result(fd, Vfs::pwrite(fd, buf, offset));
+}
+
+uint32_t file_poll(FileDescription* fd) {
+  switch (fd->type) {
+    case FileType::TerminalRead:
+      return kKeyboard.has_input() ? POLLIN : 0;
+    case FileType::TerminalWrite:
+      return POLLOUT;
+    case FileType::PipeRead:
+      return pipe_poll_read(fd->pipe);
+    case FileType::PipeWrite:
+      return pipe_poll_write(fd->pipe);
+    case FileType::VfsNode:
+      return Vfs::poll(fd);
+    default:
+      return 0;
+  }
+}
+
+int32_t partial_result(uint32_t done, int32_t rc) {
+  if (done == 0) {
+    return rc;
+  }
+  Scheduler::cancel_wait();
+  return static_cast<int32_t>(done);
+}
+
+void iov_scatter(IoVec iov, uint32_t pos, const uint8_t* src, uint32_t n) {
+  iov_for_range(iov, pos, n, [&src](std::span<uint8_t> chunk) {
+    memcpy(chunk.data(), src, chunk.size());
+    src += chunk.size();
+  });
+}
+
+void iov_gather(ConstIoVec iov, uint32_t pos, uint8_t* dst, uint32_t n) {
+  iov_for_range(iov, pos, n, [&dst](std::span<const uint8_t> chunk) {
+    memcpy(dst, chunk.data(), chunk.size());
+    dst += chunk.size();
+  });
+}
+
+void file_close(FileDescription* fd) {
   if (fd->ref_count > 1) {
     --fd->ref_count;
     return;
   }
 
   switch (fd->type) {
+    case FileType::TerminalRead:
+    case FileType::TerminalWrite:
+      delete fd;
+      return;
     case FileType::PipeRead:
       pipe_close_read(fd->pipe);
       delete fd;
@@ -91,28 +188,168 @@ void file_close(FileDescription* fd) {
 // FD table helpers
 // ===========================================================================
 
-void fd_init_stdio(std::span<FileDescription*> fds) {
-  fds[0] = &g_terminal_read;
-  fds[1] = &g_terminal_write;
-  fds[2] = &g_terminal_write;
+bool FdTable::init_stdio() {
+  assert(capacity_ == 0 && "FdTable::init_stdio(): table in use");
+  set_limits(kDefaultFdLimit, kMaxFds);
+  if (!reserve(2)) {
+    return false;
+  }
+  // Each table gets its own descriptions (shared across fork like any
+  // other), so status flags set through F_SETFL stay per process tree.
+  auto rd = std::make_unique<FileDescription>(FileDescription{
+      .type = FileType::TerminalRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr,
+      .status_flags = 0});
+  auto wr = std::make_unique<FileDescription>(FileDescription{
+      .type = FileType::TerminalWrite, .ref_count = 2, .pipe = nullptr, .vfs = nullptr,
+      .status_flags = 0});
+  if (!rd || !wr) {
+    return false;
+  }
+  install(0, rd.release());
+  install(1, wr.get());
+  install(2, wr.release());
+  return true;
+}
 
-  // Increment ref counts for the new references (fd 0 adds 1 to read,
-  // fds 1 and 2 each add 1 to write).
-  ++g_terminal_read.ref_count;
-  g_terminal_write.ref_count += 2;
+std::optional<uint32_t> FdTable::alloc(uint32_t min_fd) {
+  if (min_fd >= limit_) {
+    return std::nullopt;
+  }
+  // Free fds in min_fd's word, then the first word after it with any.
+  uint32_t word = min_fd / 32;
+  uint32_t free_bits = ~open_[word] & (~0U << (min_fd % 32));
+  if (free_bits == 0) {
+    const uint32_t later = word + 1 < kWords ? ~full_ & (~0U << (word + 1)) : 0;
+    if (later == 0) {
+      return std::nullopt;
+    }
+    word = static_cast<uint32_t>(__builtin_ctz(later));
+    free_bits = ~open_[word];
+  }
+  const uint32_t fd = word * 32 + static_cast<uint32_t>(__builtin_ctz(free_bits));
+  if (!reserve(fd)) {
+    return std::nullopt;
+  }
+  return fd;
+}
 
-  for (size_t i = 3; i < fds.size(); ++i) {
-    fds[i] = nullptr;
+bool FdTable::reserve(uint32_t fd) { return fd < limit_ && grow(fd); }
+
+bool FdTable::grow(uint32_t fd) {
+  if (fd < capacity_) {
+    return true;
+  }
+  uint32_t cap = capacity_ != 0 ? capacity_ : kInitialSlots;
+  while (cap <= fd) {
+    cap *= 2;
+  }
+  auto* grown = new Slot[cap];
+  if (grown == nullptr) {
+    return false;
   }
+  if (capacity_ != 0) {
+    memcpy(grown, slots_, capacity_ * sizeof(Slot));
+  }
+  memset(grown + capacity_, 0, (cap - capacity_) * sizeof(Slot));
+  delete[] slots_;
+  slots_ = grown;
+  capacity_ = cap;
+  return true;
+}
+
+void FdTable::install(uint32_t fd, FileDescription* desc, uint32_t fd_flags) {
+  assert(fd < capacity_ && "FdTable::install(): fd has no slot");
+  assert(slots_[fd].file == nullptr && "FdTable::install(): fd already open");
+  assert(desc != nullptr && "FdTable::install(): null description");
+  slots_[fd] = Slot{.file = desc, .flags = fd_flags};
+  mark_open(fd);
 }
 
-std::optional<uint32_t> fd_alloc(std::span<FileDescription*> fds) { return fd_alloc_from(fds, 0); }
+FileDescription* FdTable::remove(uint32_t fd) {
+  if (fd >= capacity_ || slots_[fd].file == nullptr) {
+    return nullptr;
+  }
+  FileDescription* desc = slots_[fd].file;
+  slots_[fd] = Slot{.file = nullptr, .flags = 0};
+  mark_closed(fd);
+  return desc;
+}
 
-std::optional<uint32_t> fd_alloc_from(std::span<FileDescription*> fds, uint32_t min_fd) {
-  for (uint32_t i = min_fd; i < static_cast<uint32_t>(fds.size()); ++i) {
-    if (fds[i] == nullptr) {
-      return i;
+std::optional<uint32_t> FdTable::next_open(uint32_t from) const {
+  if (from >= capacity_) {
+    return std::nullopt;
+  }
+  for (uint32_t word = from / 32; word * 32 < capacity_; ++word) {
+    uint32_t bits = open_[word];
+    if (word == from / 32) {
+      bits &= ~0U << (from % 32);
+    }
+    if (bits != 0) {
+      return word * 32 + static_cast<uint32_t>(__builtin_ctz(bits));
     }
   }
   return std::nullopt;
 }
+
+bool FdTable::copy_from(const FdTable& other) {
+  assert(capacity_ == 0 && "FdTable::copy_from(): table in use");
+  set_limits(other.limit_, other.max_limit_);
+  if (other.capacity_ == 0) {
+    return true;
+  }
+  // Only as many slots as the highest open fd needs, not other's capacity.
+  // That fd may be above a limit lowered after it was opened.
+  uint32_t highest = 0;
+  for (uint32_t word = kWords; word-- > 0;) {
+    if (other.open_[word] != 0) {
+      highest = word * 32 + 31 - static_cast<uint32_t>(__builtin_clz(other.open_[word]));
+      break;
+    }
+  }
+  if (!grow(highest)) {
+    return false;
+  }
+  for (auto fd = other.next_open(0); fd; fd = other.next_open(*fd + 1)) {
+    FileDescription* desc = other.slots_[*fd].file;
+    desc->ref();
+    install(*fd, desc, other.slots_[*fd].flags);
+  }
+  return true;
+}
+
+void FdTable::close_on_exec() {
+  for (auto fd = next_open(0); fd; fd = next_open(*fd + 1)) {
+    if ((slots_[*fd].flags & FD_CLOEXEC) != 0) {
+      file_close(remove(*fd));
+    }
+  }
+}
+
+void FdTable::close_all() {
+  for (auto fd = next_open(0); fd; fd = next_open(*fd + 1)) {
+    file_close(remove(*fd));
+  }
+  delete[] slots_;
+  slots_ = nullptr;
+  capacity_ = 0;
+}
+
+void FdTable::set_limits(uint32_t soft, uint32_t hard) {
+  assert(soft <= hard && hard <= kMaxFds && "FdTable::set_limits(): bad limits");
+  limit_ = soft;
+  max_limit_ = hard;
+}
+
+void FdTable::mark_open(uint32_t fd) {
+  const uint32_t word = fd / 32;
+  open_[word] |= 1U << (fd % 32);
+  if (open_[word] == ~0U) {
+    full_ |= 1U << word;
+  }
+}
+
+void FdTable::mark_closed(uint32_t fd) {
+  const uint32_t word = fd / 32;
+  open_[word] &= ~(1U << (fd % 32));
+  full_ &= ~(1U << word);
+}
@@ -0,0 +1,90 @@
+#include "futex.h"
+
+#include <array.h>
+#include <errno.h>
+
+#include "address_space.h"
+#include "file.h"
+#include "process.h"
+#include "scheduler.h"
+
+namespace {
+
+std::array<WaitQueue, Futex::kHashBuckets> buckets;
+
+// Translate uaddr to its futex key in the current address space.
+// Returns 0 and sets *error if the address is unusable.
+paddr_t key_for(vaddr_t uaddr, int32_t* error) {
+  if ((uaddr & (sizeof(uint32_t) - 1)) != 0) {
+    *error = -EINVAL;
+    return 0;
+  }
+  const paddr_t key = AddressSpace::user_phys(Scheduler::current()->page_directory, uaddr);
+  if (key == 0) {
+    *error = -EFAULT;
+  }
+  return key;
+}
+
+}  // namespace
+
+namespace Futex {
+
+int32_t wait(vaddr_t uaddr, uint32_t expected) {
+  Process* proc = Scheduler::current();
+  if (proc->futex_woken) {
+    proc->futex_woken = false;
+    return 0;
+  }
+
+  int32_t error = 0;
+  const paddr_t key = key_for(uaddr, &error);
+  if (key == 0) {
+    return error;
+  }
+
+  // Read through the physical mapping: the word may belong to an address
+  // space that is not loaded (ktests), and this cannot fault.
+  const uint32_t value = *phys_to_virt(key).ptr<volatile const uint32_t>();
+  if (value != expected) {
+    return -EAGAIN;
+  }
+
+  proc->futex_key = key;
+  Scheduler::wait_on(bucket(key));
+  return kSyscallRestart;
+}
+
+int32_t wake(vaddr_t uaddr, uint32_t count) {
+  int32_t error = 0;
+  const paddr_t key = key_for(uaddr, &error);
+  if (key == 0) {
+    return error;
+  }
+
+  // Other keys may share the bucket: move only matching waiters to a
+  // private queue, then wake that.
+  WaitQueue& wq = bucket(key);
+  WaitQueue woken{};
+  uint32_t n = 0;
+  for (Process* p = wq.head; p != nullptr && n < count;) {
+    Process* next = p->next;
+    if (p->futex_key == key) {
+      wq.remove(p);
+      p->futex_woken = true;
+      woken.push(p);
+      ++n;
+    }
+    p = next;
+  }
+  Scheduler::wake_all(woken);
+  return static_cast<int32_t>(n);
+}
+
+WaitQueue& bucket(paddr_t key) {
+  // Words in one page differ in the low bits, pages in the frame number.
+  const uint32_t hash = (key >> 2) ^ (key >> PAGE_OFFSET_BITS);
+  return buckets[hash % kHashBuckets];
+}
+
+}  // namespace Futex
@@ -1,6 +1,10 @@
 #include "pipe.h"
 
+#include <poll.h>
+
 #include "file.h"
+#include "poller.h"
+#include "scheduler.h"
 
 int32_t pipe_read(Pipe* pipe, std::span<uint8_t> buf) {
   uint32_t bytes_read = 0;
@@ -14,11 +18,14 @@ int32_t pipe_read(Pipe* pipe, std::span<uint8_t> buf) {
   }
 
   if (bytes_read > 0) {
+    Scheduler::wake_all(pipe->write_waiters);
+    Poll::notify();
     return static_cast<int32_t>(bytes_read);
   }
 
   // Buffer empty. If writers still exist, block the caller.
   if (pipe->writers > 0) {
+    Scheduler::wait_on(pipe->read_waiters);
     return kSyscallRestart;
   }
 
@@ -41,13 +48,34 @@ int32_t pipe_write(Pipe* pipe, std::span<const uint8_t> buf) {
   }
 
   if (bytes_written > 0) {
+    Scheduler::wake_all(pipe->read_waiters);
+    Poll::notify();
     return static_cast<int32_t>(bytes_written);
   }
 
   // Buffer full and readers exist: block the caller.
+  Scheduler::wait_on(pipe->write_waiters);
   return kSyscallRestart;
 }
 
+uint32_t pipe_poll_read(const Pipe* pipe) {
+  uint32_t revents = 0;
+  if (pipe->buffer.size() > 0) {
+    revents |= POLLIN;
+  }
+  if (pipe->writers == 0) {
+    revents |= POLLHUP;
+  }
+  return revents;
+}
+
+uint32_t pipe_poll_write(const Pipe* pipe) {
+  if (pipe->readers == 0) {
+    return POLLERR;
+  }
+  return pipe->buffer.size() < kPipeBufferSize ? POLLOUT : 0;
+}
+
 static void pipe_maybe_free(Pipe* pipe) {
   if (pipe->readers == 0 && pipe->writers == 0) {
     delete pipe;
@@ -61,6 +89,10 @@ void pipe_close_read(Pipe* pipe) {
   if (pipe->readers > 0) {
     --pipe->readers;
   }
+  if (pipe->readers == 0) {
+    Scheduler::wake_all(pipe->write_waiters);
+    Poll::notify();
+  }
   pipe_maybe_free(pipe);
 }
 
@@ -71,5 +103,9 @@ void pipe_close_write(Pipe* pipe) {
   if (pipe->writers > 0) {
     --pipe->writers;
   }
+  if (pipe->writers == 0) {
+    Scheduler::wake_all(pipe->read_waiters);
+    Poll::notify();
+  }
   pipe_maybe_free(pipe);
 }
@@ -0,0 +1,71 @@
+#include "poller.h"
+
+#include "file.h"
+#include "pit.h"
+#include "process.h"
+#include "scheduler.h"
+
+namespace {
+
+WaitQueue poll_waiters;
+
+constexpr uint64_t kNsPerMs = 1'000'000;
+
+// Conditions reported whether or not they were asked for.
+constexpr uint32_t kAlwaysReported = POLLERR | POLLHUP | POLLNVAL;
+
+}  // namespace
+
+namespace Poll {
+
+WaitQueue& waiters() { return poll_waiters; }
+
+void notify() { Scheduler::wake_all(poll_waiters); }
+
+int32_t poll(std::span<pollfd> fds, int32_t timeout_ms) {
+  Process* self = Scheduler::current();
+  const Process* group = self->group();
+
+  int32_t ready = 0;
+  for (pollfd& p : fds) {
+    p.revents = 0;
+    if (p.fd < 0) {
+      continue;
+    }
+    const auto fd_num = static_cast<uint32_t>(p.fd);
+    if (group->fds[fd_num] == nullptr) {
+      p.revents = POLLNVAL;
+    } else {
+      const uint32_t wanted = static_cast<uint16_t>(p.events) | kAlwaysReported;
+      p.revents = static_cast<int16_t>(file_poll(group->fds[fd_num]) & wanted);
+    }
+    if (p.revents != 0) {
+      ++ready;
+    }
+  }
+
+  if (ready > 0 || timeout_ms == 0) {
+    self->poll_deadline_ns = 0;
+    Scheduler::cancel_wait();
+    return ready;
+  }
+  if (timeout_ms < 0) {
+    Scheduler::wait_on(poll_waiters);
+    return kSyscallRestart;
+  }
+
+  // The first pass fixes the deadline; restarted passes keep it.
+  const uint64_t now = PIT::now_ns();
+  if (self->poll_deadline_ns == 0) {
+    self->poll_deadline_ns = now + (static_cast<uint64_t>(timeout_ms) * kNsPerMs);
+  }
+  if (now >= self->poll_deadline_ns) {
+    self->poll_deadline_ns = 0;
+    Scheduler::cancel_wait();
+    return 0;
+  }
+  Scheduler::wait_on_until(poll_waiters, self->poll_deadline_ns);
+  return kSyscallRestart;
+}
+
+}  // namespace Poll
@@ -0,0 +1,139 @@
+#include "ring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "file.h"
+#include "pit.h"
+#include "poller.h"
+#include "process.h"
+#include "scheduler.h"
+
+namespace {
+
+// Slot arrays following the ring header. Sized from the kernel's own copy
+// of the entry count: the one in the header is writable by the program.
+ring_sqe* sq_slots(const Ring::State* st) { return reinterpret_cast<ring_sqe*>(st->shared + 1); }
+ring_cqe* cq_slots(const Ring::State* st) {
+  return reinterpret_cast<ring_cqe*>(sq_slots(st) + st->mask + 1);
+}
+
+// Completions not yet read by the program.
+uint32_t unread(const ring* r) { return r->cq_tail - r->cq_head; }
+
+void post(Ring::State* st, uint32_t user_data, int32_t res) {
+  ring* r = st->shared;
+  ring_cqe& cqe = cq_slots(st)[r->cq_tail & st->mask];
+  cqe.user_data = user_data;
+  cqe.res = res;
+  // Publish the entry before the tail that makes it visible.
+  __atomic_store_n(&r->cq_tail, r->cq_tail + 1, __ATOMIC_RELEASE);
+}
+
+// Run `sqe`, posting its completion or parking it. Returns the wait queue
+// the call asked to sleep on if it was parked, nullptr otherwise.
+WaitQueue* run(Ring::State* st, const ring_sqe& sqe, Ring::CallFn call) {
+  const int32_t rc = call(sqe);
+  if (rc != kSyscallRestart) {
+    post(st, sqe.user_data, rc);
+    return nullptr;
+  }
+  // The call is retried by a later enter(), not by rewinding this syscall,
+  // so take back the wait_on() it made.
+  Process* self = Scheduler::current();
+  WaitQueue* wq = self->wait_queue;
+  self->wait_queue = nullptr;
+  st->calls[st->parked++] = sqe;
+  return wq;
+}
+
+}  // namespace
+
+namespace Ring {
+
+int32_t setup(Process* proc, ring* shared, uint32_t entries) {
+  if (entries == 0 || entries > RING_MAX_ENTRIES || (entries & (entries - 1)) != 0) {
+    return -EINVAL;
+  }
+  if (proc->ring == nullptr) {
+    proc->ring = new State{};
+    if (proc->ring == nullptr) {
+      return -ENOMEM;
+    }
+  }
+  State* st = proc->ring;
+  st->shared = shared;
+  st->mask = entries - 1;
+  st->parked = 0;
+  st->submitted = 0;
+  memset(shared, 0, sizeof(*shared));
+  shared->entries = entries;
+  return 0;
+}
+
+void release(Process* proc) {
+  delete proc->ring;
+  proc->ring = nullptr;
+}
+
+int32_t enter(Process* proc, uint32_t to_submit, uint32_t min_complete, CallFn call) {
+  State* st = proc->ring;
+  if (st == nullptr) {
+    return -ENXIO;
+  }
+  ring* r = st->shared;
+  const uint32_t entries = st->mask + 1;
+  WaitQueue* wait = nullptr;
+  bool one_queue = true;
+  const auto note = [&](WaitQueue* wq) {
+    if (wait == nullptr) {
+      wait = wq;
+    } else if (wq != nullptr && wq != wait) {
+      one_queue = false;
+    }
+  };
+
+  // Parked calls first, in submission order. Each one either completes or
+  // parks again (possibly on a different queue).
+  const uint32_t parked = st->parked;
+  std::array<ring_sqe, kMaxParked> retry;
+  memcpy(retry.data(), st->calls.data(), parked * sizeof(ring_sqe));
+  st->parked = 0;
+  for (uint32_t i = 0; i < parked; ++i) {
+    note(run(st, retry[i], call));
+  }
+
+  // New submissions, while there is a CQ slot and a parking place for each.
+  // A restarted enter() re-runs with the same to_submit, so the count taken
+  // so far lives in `st` rather than here.
+  while (st->submitted < to_submit) {
+    const uint32_t head = r->sq_head;
+    if (head == __atomic_load_n(&r->sq_tail, __ATOMIC_ACQUIRE) ||
+        unread(r) + st->parked >= entries || st->parked == kMaxParked) {
+      break;
+    }
+    // Copy the entry out first: the program may rewrite the slot as soon as
+    // sq_head moves past it.
+    const ring_sqe sqe = sq_slots(st)[head & st->mask];
+    __atomic_store_n(&r->sq_head, head + 1, __ATOMIC_RELEASE);
+    ++st->submitted;
+    note(run(st, sqe, call));
+  }
+
+  if (unread(r) < min_complete && st->parked > 0) {
+    // Any parked call may be the one that becomes ready. If they all wait on
+    // one queue, sleep on it. Otherwise sleep on the poll queue, which pipes
+    // and the keyboard notify, and recheck each tick for queues that do not
+    // (the FAT lock).
+    if (one_queue && wait != nullptr) {
+      Scheduler::wait_on(*wait);
+    } else {
+      Scheduler::wait_on_until(Poll::waiters(), PIT::now_ns() + PIT::kTickNs);
+    }
+    return kSyscallRestart;
+  }
+  st->submitted = 0;
+  return static_cast<int32_t>(unread(r));
+}
+
+}  // namespace Ring
@@ -7,12 +7,26 @@
 #include "pmm.h"
 #include "process.h"
 #include "scheduler.h"
+#include "smp.h"
 
 namespace {
 
 std::array<ShmRegion, kMaxShmRegions> regions;
 uint32_t next_id = 0;
 
+// Unmap a mapping's pages from the group's page directory without freeing
+// the frames. Threads of the group running on other CPUs may still cache
+// the translations, so flush them there too before the frames can be
+// freed: one page, or the whole TLB for a larger range.
+void unmap_pages(Process* group, vaddr_t vaddr, uint32_t num_pages) {
+  for (uint32_t p = 0; p < num_pages; ++p) {
+    AddressSpace::unmap_nofree(group->page_directory, vaddr + p * PAGE_SIZE);
+  }
+  if (Scheduler::group_running_elsewhere(group)) {
+    Smp::tlb_shootdown(num_pages == 1 ? vaddr : vaddr_t{Smp::kFlushAll});
+  }
+}
+
 }  // namespace
 
 namespace Shm {
@@ -76,7 +90,7 @@ int32_t attach(uint32_t shmid, vaddr_t vaddr) {
     return -1;
   }
 
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
   // Check for room in the per-process mapping table.
   if (proc->shm_mapping_count >= kMaxShmMappings) {
@@ -100,7 +114,7 @@ int32_t attach(uint32_t shmid, vaddr_t vaddr) {
 }
 
 int32_t detach(vaddr_t vaddr, uint32_t size) {
-  Process* proc = Scheduler::current();
+  Process* proc = Scheduler::current()->group();
 
   // Find the mapping by vaddr.
   for (uint32_t i = 0; i < proc->shm_mapping_count; ++i) {
@@ -114,10 +128,7 @@ int32_t detach(vaddr_t vaddr, uint32_t size) {
       return -1;
     }
 
-    // Unmap pages without freeing the physical frames.
-    for (uint32_t p = 0; p < m.num_pages; ++p) {
-      AddressSpace::unmap_nofree(proc->page_directory, vaddr + p * PAGE_SIZE);
-    }
+    unmap_pages(proc, vaddr, m.num_pages);
 
     ShmRegion* region = find_region(m.shm_id);
 
@@ -145,10 +156,7 @@ void detach_all(Process* proc) {
   while (proc->shm_mapping_count > 0) {
     const ShmMapping& m = proc->shm_mappings[0];
 
-    // Unmap without freeing physical frames.
-    for (uint32_t p = 0; p < m.num_pages; ++p) {
-      AddressSpace::unmap_nofree(proc->page_directory, m.vaddr + p * PAGE_SIZE);
-    }
+    unmap_pages(proc, m.vaddr, m.num_pages);
 
     ShmRegion* region = find_region(m.shm_id);
 
@@ -6,6 +6,7 @@
 #include "../tests/kernel/ktest.h"
 #include "ata.h"
 #include "fat16.h"
+#include "fpu.h"
 #include "framebuffer.h"
 #include "gdt.h"
 #include "heap.h"
@@ -13,13 +14,16 @@
 #include "keyboard.h"
 #include "modules.h"
 #include "multiboot.h"
+#include "page_cache.h"
 #include "paging.h"
 #include "pit.h"
 #include "pmm.h"
 #include "scheduler.h"
+#include "smp.h"
 #include "syscall.h"
 #include "terminal.h"
 #include "tss.h"
+#include "vdso.h"
 #include "vfs.h"
 #include "vmm.h"
 #include "x86.h"
@@ -44,7 +48,9 @@ void kernel_init() {
   Interrupt::init();
   KeyboardDriver::init();
   Syscall::init();
+  Fpu::init();
   PIT::init();
+  Vdso::init();
   kHeap.init();
   Scheduler::init();
 }
@@ -84,12 +90,27 @@ __attribute__((noreturn)) void kernel_main() {
   // Mount FAT filesystem from ATA drive (registers /fat/ nodes).
   Fat::init_vfs();
 
+  // Cache file pages in memory; a kernel thread writes dirty ones back.
+  interrupt_disable();
+  kernel_lock();
+  PageCache::init();
+  kernel_unlock();
+  interrupt_enable();
+
+  // Start the application processors. They idle until work is queued.
+  Smp::init();
+
   VfsNode* shell = Vfs::lookup("/bin/sh");
   if ((shell != nullptr) && (shell->data != nullptr)) {
     printf("Loading shell \"%s\" (%u bytes)...\n", shell->name, static_cast<unsigned>(shell->size));
+    // The APs are live now, so run queue updates need the kernel lock.
+    interrupt_disable();
+    kernel_lock();
     assert(Scheduler::create_process(std::span<const uint8_t>{shell->data, shell->size},
                                      shell->name) &&
            "kernel_main(): failed to create shell process");
+    kernel_unlock();
+    interrupt_enable();
   } else {
     printf("No shell found at /bin/sh\n");
   }
@@ -63,6 +63,13 @@ void map(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable, bool user) {
   pt->entry[pt_index(virt)] = PageEntry(phys, writeable, user);
 }
 
+void map_shared(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable) {
+  map(pd, virt, phys, writeable, /*user=*/true);
+  const PageEntry& pde = pd->entry[pd_index(virt)];
+  auto* pt = phys_to_virt(frame_to_phys(pde.frame)).ptr<PageTable>();
+  pt->entry[pt_index(virt)].available = kSharedPage;
+}
+
 void unmap(PageTable* pd, vaddr_t virt) {
   const uint32_t pdi = pd_index(virt);
   const PageEntry& pde = pd->entry[pdi];
@@ -77,7 +84,9 @@ void unmap(PageTable* pd, vaddr_t virt) {
     return;
   }
 
-  kPmm.free(frame_to_phys(pte.frame));
+  if (pte.available != kSharedPage) {
+    kPmm.free(frame_to_phys(pte.frame));
+  }
   memset(&pte, 0, sizeof(pte));
   __asm__ volatile("invlpg (%0)" ::"r"(virt) : "memory");
 }
@@ -123,6 +132,15 @@ bool is_user_mapped(const PageTable* pd, vaddr_t va, bool writeable) {
   return true;
 }
 
+paddr_t user_phys(const PageTable* pd, vaddr_t va) {
+  if (!is_user_mapped(pd, va, /*writeable=*/false)) {
+    return 0;
+  }
+  const PageEntry& pde = pd->entry[pd_index(va)];
+  const auto* pt = phys_to_virt(frame_to_phys(pde.frame)).ptr<const PageTable>();
+  return frame_to_phys(pt->entry[pt_index(va)].frame) | (va & (PAGE_SIZE - 1));
+}
+
 PageDir copy(const PageTable* src_pd) {
   auto [new_phys, new_pd] = create();
 
@@ -140,6 +158,12 @@ PageDir copy(const PageTable* src_pd) {
         continue;
       }
 
+      const vaddr_t va{(pdi << 22U) | (pti << PAGE_OFFSET_BITS)};
+      if (pte.available == kSharedPage) {
+        map_shared(new_pd, va, frame_to_phys(pte.frame), pte.rw != 0);
+        continue;
+      }
+
       const paddr_t new_page = kPmm.alloc();
       assert(new_page && "AddressSpace::copy(): out of physical memory\n");
 
@@ -147,7 +171,6 @@ PageDir copy(const PageTable* src_pd) {
       auto* dst = phys_to_virt(new_page).ptr<uint8_t>();
       memcpy(dst, src, PAGE_SIZE);
 
-      const vaddr_t va{(pdi << 22U) | (pti << PAGE_OFFSET_BITS)};
       map(new_pd, va, new_page, pte.rw != 0, pte.user != 0);
     }
   }
@@ -167,7 +190,7 @@ void destroy(PageTable* pd, paddr_t pd_phys) {
     auto* pt = phys_to_virt(pt_phys).ptr<PageTable>();
 
     for (auto& pte : pt->entry) {
-      if (pte.present) {
+      if (pte.present && pte.available != kSharedPage) {
         kPmm.free(frame_to_phys(pte.frame));
       }
     }
@@ -160,11 +160,16 @@ void Heap::dump() const {
          static_cast<unsigned>(total_used), static_cast<unsigned>(total_free));
 }
 
-void* Heap::alloc(size_t size) {  // NOLINT(misc-no-recursion)
+void* Heap::alloc(size_t size) {
   assert(base_ && "kmalloc: heap not initialised\n");
   if (size == 0) {
     return nullptr;
   }
+  const LockGuard guard(lock_);
+  return alloc_locked(size);
+}
+
+void* Heap::alloc_locked(size_t size) {  // NOLINT(misc-no-recursion)
 
   const size_t need = align16(size);
 
@@ -189,7 +194,7 @@ void* Heap::alloc(size_t size) {  // NOLINT(misc-no-recursion)
   if (!grow(need + sizeof(BlockHeader))) {
     return nullptr;
   }
-  return alloc(size);
+  return alloc_locked(size);
 }
 
 void Heap::free(void* ptr) {
@@ -198,6 +203,7 @@ void Heap::free(void* ptr) {
   }
 
   auto* hdr = reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(ptr) - sizeof(BlockHeader));
+  const LockGuard guard(lock_);
 
   if (reinterpret_cast<uint8_t*>(hdr) < reinterpret_cast<uint8_t*>(base_) ||
       reinterpret_cast<uint8_t*>(ptr) >= end_) {
@@ -120,7 +120,10 @@ void PhysicalMemoryManager::mark_used_range(paddr_t start, size_t length) {
 }
 
 paddr_t PhysicalMemoryManager::alloc() {
-  const size_t frame = bitmap_.find_first_clear();
+  size_t frame = bitmap_.find_first_clear();
+  if (frame >= total_frames_ && reclaim_ != nullptr && reclaim_(1) > 0) {
+    frame = bitmap_.find_first_clear();
+  }
   if (frame >= total_frames_) {
     return 0;  // Out of memory.
   }
@@ -0,0 +1,111 @@
+#include "uaccess.h"
+
+#include <errno.h>
+#include <sys/cdefs.h>
+
+#include "paging.h"
+#include "process.h"
+
+// One __ex_table entry: if `insn` faults, resume at `fixup`.
+struct ExTableEntry {
+  uint32_t insn;
+  uint32_t fixup;
+};
+
+__BEGIN_DECLS
+
+/* Defined in arch/linker.ld */
+extern const ExTableEntry ex_table_start[];
+extern const ExTableEntry ex_table_end[];
+
+__END_DECLS
+
+namespace {
+
+// rep movsb between the two sides; a fault stops the copy with ecx still
+// holding the bytes not yet moved. Returns that count (0 on success).
+size_t copy_user_bytes(void* dst, const void* src, size_t len) {
+  __asm__ volatile(
+      "1: rep movsb\n"
+      "2:\n"
+      ".pushsection __ex_table, \"a\"\n"
+      "  .long 1b, 2b\n"
+      ".popsection\n"
+      : "+D"(dst), "+S"(src), "+c"(len)
+      :
+      : "memory");
+  return len;
+}
+
+}  // namespace
+
+bool user_range_ok(uint32_t ptr, size_t len) {
+  return len == 0 || (ptr + len > ptr && ptr + len <= KERNEL_VMA);
+}
+
+int32_t copy_from_user(void* dst, uint32_t src, size_t len) {
+  if (!user_range_ok(src, len)) {
+    return -EFAULT;
+  }
+  return copy_user_bytes(dst, reinterpret_cast<const void*>(src), len) == 0 ? 0 : -EFAULT;
+}
+
+int32_t copy_to_user(uint32_t dst, const void* src, size_t len) {
+  if (!user_range_ok(dst, len)) {
+    return -EFAULT;
+  }
+  return copy_user_bytes(reinterpret_cast<void*>(dst), src, len) == 0 ? 0 : -EFAULT;
+}
+
+int32_t strncpy_from_user(char* dst, uint32_t src, size_t size) {
+  if (size == 0) {
+    return -ENAMETOOLONG;
+  }
+  if (src >= KERNEL_VMA) {
+    return -EFAULT;
+  }
+  // Never read past the end of user space, even for an unterminated string.
+  const size_t limit = size < KERNEL_VMA - src ? size : KERNEL_VMA - src;
+
+  size_t left = limit;
+  uint32_t faulted = 0;
+  uint32_t scratch;
+  char* out = dst;
+  uint32_t in = src;
+  __asm__ volatile(
+      "1: lodsb\n"
+      "   stosb\n"
+      "   testb %%al, %%al\n"
+      "   jz 3f\n"
+      "   decl %%ecx\n"
+      "   jnz 1b\n"
+      "   jmp 3f\n"
+      "2: movl $1, %[faulted]\n"
+      "3:\n"
+      ".pushsection __ex_table, \"a\"\n"
+      "  .long 1b, 2b\n"
+      ".popsection\n"
+      : "+D"(out), "+S"(in), "+c"(left), "=&a"(scratch), [faulted] "+r"(faulted)
+      :
+      : "memory", "cc");
+
+  if (faulted != 0) {
+    return -EFAULT;
+  }
+  if (left == 0) {
+    // No terminator within limit bytes: too long, or it runs into the kernel.
+    dst[size - 1] = '\0';
+    return limit == size ? -ENAMETOOLONG : -EFAULT;
+  }
+  return static_cast<int32_t>(limit - left);
+}
+
+bool fixup_exception(TrapFrame* regs) {
+  for (const ExTableEntry* entry = ex_table_start; entry != ex_table_end; ++entry) {
+    if (entry->insn == regs->eip) {
+      regs->eip = entry->fixup;
+      return true;
+    }
+  }
+  return false;
+}
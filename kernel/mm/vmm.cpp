@@ -7,6 +7,7 @@
 #include "paging.h"
 #include "panic.h"
 #include "pmm.h"
+#include "smp.h"
 
 namespace {
 
@@ -83,6 +84,8 @@ void unmap(vaddr_t virt) {
   pte = PageEntry{};
 
   __asm__ volatile("invlpg (%0)" ::"r"(virt) : "memory");
+  // Kernel mappings are shared by every CPU.
+  Smp::tlb_shootdown(virt);
 }
 
 paddr_t get_phys(vaddr_t virt) {
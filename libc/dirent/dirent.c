@@ -1,38 +1,72 @@
 #include <dirent.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <unistd.h>
+
+/* Refill the buffer with the next batch. Returns the number of entries
+ * read, 0 at the end of the directory, or -1 on failure. */
+static int fill(DIR* dirp) {
+  const int n = getdents(dirp->fd, dirp->entries, DIR_BUF_SIZE, GETDENTS_ATTRS);
+  dirp->count = n < 0 ? 0 : n;
+  dirp->index = 0;
+  return n;
+}
 
 DIR* opendir(const char* path) {
   if (path == NULL) {
     return NULL;
   }
 
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  DIR* dirp = fdopendir(fd);
+  if (dirp == NULL) {
+    close(fd);
+  }
+  return dirp;
+}
+
+DIR* fdopendir(int fd) {
   DIR* dirp = (DIR*)malloc(sizeof(DIR));
   if (dirp == NULL) {
     return NULL;
   }
 
-  int n = getdents(path, dirp->entries, DIR_BUF_SIZE);
-  if (n < 0) {
+  /* Read the first batch now so a non-directory fails here, not in readdir. */
+  dirp->fd = fd;
+  if (fill(dirp) < 0) {
     free(dirp);
     return NULL;
   }
-
-  dirp->count = n;
-  dirp->index = 0;
   return dirp;
 }
 
 struct dirent* readdir(DIR* dirp) {
-  if (dirp == NULL || dirp->index >= dirp->count) {
+  if (dirp == NULL) {
+    return NULL;
+  }
+  /* A short batch is not the end: keep asking until getdents returns 0. */
+  if (dirp->index >= dirp->count && (dirp->count == 0 || fill(dirp) <= 0)) {
     return NULL;
   }
   return &dirp->entries[dirp->index++];
 }
 
+void rewinddir(DIR* dirp) {
+  if (dirp == NULL) {
+    return;
+  }
+  lseek(dirp->fd, 0, SEEK_SET);
+  fill(dirp);
+}
+
 int closedir(DIR* dirp) {
   if (dirp == NULL) {
     return -1;
   }
+  close(dirp->fd);
   free(dirp);
   return 0;
 }
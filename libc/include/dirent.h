@@ -11,27 +11,36 @@ __BEGIN_DECLS
 #define DT_DIR 4
 #define DT_REG 8
 
+/* getdents() flags. */
+#define GETDENTS_ATTRS 1 /* also fill d_size and d_mode */
+
 struct dirent {
   char d_name[128]; /* entry name (not the full path) */
   uint8_t d_type;   /* DT_REG, DT_DIR, DT_CHR, or DT_UNKNOWN */
-  uint32_t d_size;  /* file size in bytes (0 for directories and devices) */
+  uint32_t d_size;  /* file size in bytes (0 for directories); needs GETDENTS_ATTRS */
+  uint32_t d_mode;  /* type and permission bits, as st_mode; needs GETDENTS_ATTRS */
 };
 
-/* Maximum entries buffered by opendir. */
+/* Maximum entries buffered by a DIR; readdir refills it as it drains. */
 #define DIR_BUF_SIZE 64
 
 typedef struct {
+  int fd;                              /* the open directory */
   struct dirent entries[DIR_BUF_SIZE]; /* buffered entries from getdents */
-  int count;                           /* total entries returned */
+  int count;                           /* valid entries in the buffer */
   int index;                           /* current read position */
 } DIR;
 
-/* Low-level syscall wrapper. */
-int getdents(const char* path, struct dirent* buf, unsigned int count);
+/* Low-level syscall wrapper: read up to count entries of the directory open
+ * on fd, continuing where the previous call stopped. Returns the number
+ * read, 0 at the end of the directory, or -1 on failure. */
+int getdents(int fd, struct dirent* buf, unsigned int count, unsigned int flags);
 
-/* POSIX-like directory stream API. */
+/* POSIX-like directory stream API. Entries carry GETDENTS_ATTRS fields. */
 DIR* opendir(const char* path);
+DIR* fdopendir(int fd);
 struct dirent* readdir(DIR* dirp);
+void rewinddir(DIR* dirp);
 int closedir(DIR* dirp);
 
 __END_DECLS
@@ -10,8 +10,14 @@
 #define O_TRUNC 01000
 #define O_APPEND 02000
 #define O_NONBLOCK 04000
+#define O_DIRECTORY 0200000
 #define O_CLOEXEC 02000000
 
+/* dirfd of the *at() calls meaning the current working directory. */
+#define AT_FDCWD (-100)
+/* unlinkat() flag: remove a directory instead of a file. */
+#define AT_REMOVEDIR 0x200
+
 #define F_DUPFD 0
 #define F_GETFD 1
 #define F_SETFD 2
@@ -23,6 +29,7 @@
 __BEGIN_DECLS
 
 int open(const char* path, int flags, ...);
+int openat(int dirfd, const char* path, int flags, ...);
 int fcntl(int fd, int cmd, ...);
 
 __END_DECLS
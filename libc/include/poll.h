@@ -0,0 +1,42 @@
+#ifndef _POLL_H
+#define _POLL_H
+
+#include <sys/cdefs.h>
+
+/*
+ * Wait for any of several file descriptors to become ready.
+ *
+ * Pipes, the terminal, /dev/tty, /dev/kbd and regular files can be polled.
+ * Files and devices without a readiness notion are always ready for
+ * whatever they support. POLLERR, POLLHUP and POLLNVAL are reported
+ * whether requested or not.
+ */
+
+#define POLLIN 0x001   /* data to read (or EOF) */
+#define POLLPRI 0x002  /* never reported */
+#define POLLOUT 0x004  /* writing will not block */
+#define POLLERR 0x008  /* write end of a pipe with no readers */
+#define POLLHUP 0x010  /* read end of a pipe with no writers */
+#define POLLNVAL 0x020 /* fd is not open */
+
+#define POLL_MAX 64 /* most entries one poll() takes */
+
+typedef unsigned int nfds_t;
+
+struct pollfd {
+  int fd;        /* ignored if negative */
+  short events;  /* requested POLL* bits */
+  short revents; /* returned POLL* bits */
+};
+
+__BEGIN_DECLS
+
+// Sleep until an entry of fds is ready or timeout_ms milliseconds pass
+// (negative: no timeout, 0: do not sleep). Returns the number of entries
+// with non-zero revents, 0 on timeout, or -1 with errno EINVAL (nfds over
+// POLL_MAX) or EFAULT.
+int poll(struct pollfd* fds, nfds_t nfds, int timeout_ms);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _PTHREAD_H
+#define _PTHREAD_H
+
+#include <stddef.h>
+#include <sys/cdefs.h>
+#include <sys/futex.h>
+
+/*
+ * Minimal POSIX threads on top of the clone, exit_thread and futex
+ * syscalls.
+ *
+ * Every thread but the initial one runs on a malloc'd stack, with %gs based
+ * at its thread descriptor (so %gs:0 holds pthread_self(), as in the i386
+ * TLS ABI). pthread_join() sleeps on the descriptor's tid word, which the
+ * kernel clears when the thread exits. Threads must be joined to free their
+ * stacks; the initial thread cannot be joined.
+ *
+ * malloc() and free() take a lock once a program links pthread_create().
+ * stdio is not thread-safe.
+ */
+
+#define PTHREAD_STACK_MIN 4096
+#define PTHREAD_STACK_DEFAULT (64 * 1024)
+
+typedef struct __pthread* pthread_t;
+
+typedef struct {
+  size_t stack_size;
+} pthread_attr_t;
+
+typedef struct {
+  struct futex_mutex m;
+} pthread_mutex_t;
+
+typedef struct {
+  struct futex_cond c;
+} pthread_cond_t;
+
+typedef int pthread_mutexattr_t; /* no attributes are supported */
+typedef int pthread_condattr_t;  /* no attributes are supported */
+
+#define PTHREAD_MUTEX_INITIALIZER {FUTEX_MUTEX_INITIALIZER}
+#define PTHREAD_COND_INITIALIZER {FUTEX_COND_INITIALIZER}
+
+__BEGIN_DECLS
+
+int pthread_attr_init(pthread_attr_t* attr);
+int pthread_attr_setstacksize(pthread_attr_t* attr, size_t stack_size);
+
+// Start start(arg) in a new thread. attr may be NULL for the defaults.
+// Returns 0, or EAGAIN if the stack or the thread cannot be allocated.
+int pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*start)(void*),
+                   void* arg);
+
+// Wait for thread to exit, store its result in *result if non-NULL, and
+// free it. Returns 0, or EINVAL for the initial thread.
+int pthread_join(pthread_t thread, void** result);
+
+// Terminate the calling thread. Returning from the start routine is the
+// same as calling this with its return value. The process exits (with code
+// 0) when its last thread does.
+__attribute__((noreturn)) void pthread_exit(void* result);
+
+pthread_t pthread_self(void);
+int pthread_equal(pthread_t a, pthread_t b);
+
+int pthread_mutex_init(pthread_mutex_t* mutex, const pthread_mutexattr_t* attr);
+int pthread_mutex_destroy(pthread_mutex_t* mutex);
+int pthread_mutex_lock(pthread_mutex_t* mutex);
+int pthread_mutex_trylock(pthread_mutex_t* mutex); /* EBUSY if locked */
+int pthread_mutex_unlock(pthread_mutex_t* mutex);
+
+int pthread_cond_init(pthread_cond_t* cond, const pthread_condattr_t* attr);
+int pthread_cond_destroy(pthread_cond_t* cond);
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex);
+int pthread_cond_signal(pthread_cond_t* cond);
+int pthread_cond_broadcast(pthread_cond_t* cond);
+
+__END_DECLS
+
+#endif
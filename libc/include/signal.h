@@ -7,6 +7,7 @@
 #define SIGILL 4
 #define SIGABRT 6
 #define SIGFPE 8
+#define SIGKILL 9 /* cannot be caught or ignored */
 #define SIGSEGV 11
 #define SIGTERM 15
 #define NSIG 32
@@ -0,0 +1,59 @@
+#ifndef _SYS_FUTEX_H
+#define _SYS_FUTEX_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * Futexes: block on a 32-bit word in memory.
+ *
+ * FUTEX_WAIT sleeps only if the word still holds the expected value, so a
+ * wakeup between reading the word and calling futex() is never lost. The
+ * kernel keys waiters by the word's physical address, so a futex in shmat()
+ * memory works across processes that map it at different addresses.
+ *
+ * futex_mutex and futex_cond are built on it: uncontended lock and unlock
+ * are a single atomic instruction and never enter the kernel. Both are
+ * ready for use when zero-initialised.
+ */
+
+#define FUTEX_WAIT 0 /* sleep while *uaddr == val */
+#define FUTEX_WAKE 1 /* wake up to val waiters */
+
+struct futex_mutex {
+  volatile uint32_t state; /* 0 unlocked, 1 locked, 2 locked with waiters */
+};
+
+struct futex_cond {
+  volatile uint32_t seq; /* bumped by every signal and broadcast */
+};
+
+#define FUTEX_MUTEX_INITIALIZER {0}
+#define FUTEX_COND_INITIALIZER {0}
+
+__BEGIN_DECLS
+
+// FUTEX_WAIT returns 0 when woken (possibly spuriously) or -1 with errno
+// EAGAIN if *uaddr != val. FUTEX_WAKE returns the number of waiters woken.
+int futex(volatile uint32_t* uaddr, int op, uint32_t val);
+
+void futex_mutex_lock(struct futex_mutex* m);
+
+// Returns 0 if the mutex was acquired, -1 if it is already locked.
+int futex_mutex_trylock(struct futex_mutex* m);
+
+void futex_mutex_unlock(struct futex_mutex* m);
+
+// Atomically unlock m and sleep until signalled, then relock m. Callers
+// must re-check their condition: wakeups may be spurious.
+void futex_cond_wait(struct futex_cond* c, struct futex_mutex* m);
+
+// Wake one waiter of c.
+void futex_cond_signal(struct futex_cond* c);
+
+// Wake every waiter of c.
+void futex_cond_broadcast(struct futex_cond* c);
+
+__END_DECLS
+
+#endif
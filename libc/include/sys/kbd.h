@@ -91,7 +91,8 @@ enum kbd_key {
 
 /*
  * Keyboard event returned by reading /dev/kbd.
- * Non-blocking: read returns 0 when no events are pending.
+ * read blocks until an event is pending; with O_NONBLOCK it fails with
+ * EAGAIN instead.
  */
 struct kbd_event {
   uint8_t key;     /* enum kbd_key value */
@@ -0,0 +1,62 @@
+#ifndef _SYS_SCHEDSTAT_H
+#define _SYS_SCHEDSTAT_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * Scheduler statistics, as returned by schedstat().
+ *
+ * All times are in nanoseconds of the monotonic clock. Load averages are
+ * fixed point with LOAD_FSHIFT fractional bits (LOAD_FIXED_1 == 1.0) and
+ * count processes that are running or waiting for a CPU, sampled every
+ * LOAD_SAMPLE_SEC seconds and decayed over 1, 5 and 15 minutes.
+ */
+
+#define LOAD_FSHIFT 11
+#define LOAD_FIXED_1 (1 << LOAD_FSHIFT)
+#define LOAD_SAMPLE_SEC 5
+
+#define SCHEDSTAT_MAX_CPUS 8
+#define SCHEDSTAT_NAME_LEN 16
+
+/* Values of proc_stat.state. */
+#define PROC_STATE_RUNNING 'R' /* on a CPU */
+#define PROC_STATE_READY 'W'   /* waiting in a run queue */
+#define PROC_STATE_BLOCKED 'S' /* sleeping or on a wait queue */
+#define PROC_STATE_ZOMBIE 'Z'  /* exited, not yet reaped */
+
+struct sched_stat {
+  uint64_t uptime_ns;                   /* time since boot */
+  uint64_t idle_ns[SCHEDSTAT_MAX_CPUS]; /* per-CPU time spent in the idle process */
+  uint32_t loadavg[3];                  /* 1, 5 and 15 minute load averages */
+  uint32_t cpu_count;                   /* CPUs online (valid idle_ns entries) */
+  uint32_t nr_running;                  /* processes running or ready right now */
+  uint32_t nr_procs;                    /* processes, not counting idle */
+};
+
+struct proc_stat {
+  uint32_t pid;
+  uint32_t ppid;                 /* 0 for orphans */
+  char name[SCHEDSTAT_NAME_LEN]; /* argv[0] basename, or "kthread" */
+  char state;                    /* PROC_STATE_* */
+  uint8_t kernel_thread;         /* 1 for kernel threads */
+  uint16_t reserved;
+  uint32_t cpu;                  /* CPU it runs on, or last ran on */
+  uint64_t user_ns;              /* time spent in user mode */
+  uint64_t system_ns;            /* time spent in the kernel on its behalf */
+  uint64_t wait_ns;              /* time spent ready but waiting for a CPU */
+  uint32_t voluntary_switches;   /* gave up the CPU (blocked, slept, exited) */
+  uint32_t involuntary_switches; /* preempted at the end of a time slice */
+};
+
+__BEGIN_DECLS
+
+// Fill *stat with system-wide scheduler statistics and up to max_procs
+// entries of procs with per-process ones. Returns the number of entries
+// written to procs (at most max_procs), or -1 on failure.
+int schedstat(struct sched_stat* stat, struct proc_stat* procs, unsigned int max_procs);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _SYS_SELECT_H
+#define _SYS_SELECT_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * select(), implemented in libc on top of poll(). Descriptors that poll()
+ * reports as POLLHUP or POLLERR count as readable or writable, so the
+ * following read() or write() sees the EOF or the error.
+ */
+
+#define FD_SETSIZE 64
+
+typedef struct {
+  uint32_t bits[FD_SETSIZE / 32];
+} fd_set;
+
+struct timeval {
+  long tv_sec;
+  long tv_usec;
+};
+
+#define FD_ZERO(set)                                       \
+  do {                                                     \
+    for (unsigned __i = 0; __i < FD_SETSIZE / 32; ++__i) { \
+      (set)->bits[__i] = 0;                                \
+    }                                                      \
+  } while (0)
+#define FD_SET(fd, set) ((set)->bits[(fd) / 32] |= (1U << ((fd) % 32)))
+#define FD_CLR(fd, set) ((set)->bits[(fd) / 32] &= ~(1U << ((fd) % 32)))
+#define FD_ISSET(fd, set) (((set)->bits[(fd) / 32] & (1U << ((fd) % 32))) != 0)
+
+__BEGIN_DECLS
+
+// Wait until a descriptor in readfds is readable or one in writefds is
+// writable, or timeout passes (NULL: no timeout). exceptfds is cleared:
+// no exceptional conditions exist. Rewrites the sets to the ready
+// descriptors and returns how many there are, 0 on timeout, or -1 with
+// errno set (EINVAL if nfds exceeds FD_SETSIZE, EBADF for a closed fd).
+int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+           struct timeval* timeout);
+
+__END_DECLS
+
+#endif
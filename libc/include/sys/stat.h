@@ -32,6 +32,11 @@ int stat(const char* path, struct stat* buf);
 int fstat(int fd, struct stat* buf);
 int mkdir(const char* path, mode_t mode);
 
+/* Relative paths are resolved from the directory open on dirfd, or from
+ * the working directory for AT_FDCWD. fstatat() takes no flags yet. */
+int fstatat(int dirfd, const char* path, struct stat* buf, int flags);
+int mkdirat(int dirfd, const char* path, mode_t mode);
+
 __END_DECLS
 
 #endif /* _SYS_STAT_H */
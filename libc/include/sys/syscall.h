@@ -42,7 +42,27 @@
 #define SYS_FCNTL 31         /* custom */
 #define SYS_MOUNT 32         /* custom */
 #define SYS_UMOUNT 33        /* custom */
-#define SYS_MAX 34
+#define SYS_NANOSLEEP 34     /* Linux: 162 */
+#define SYS_SCHEDSTAT 35     /* custom */
+#define SYS_FUTEX 36         /* Linux: 240 */
+#define SYS_CLONE 37         /* Linux: 120 */
+#define SYS_EXIT_THREAD 38   /* Linux:   1 (exit) */
+#define SYS_RING_SETUP 39    /* Linux: 425 (io_uring_setup) */
+#define SYS_RING_ENTER 40    /* Linux: 426 (io_uring_enter) */
+#define SYS_READV 41         /* Linux: 145 */
+#define SYS_WRITEV 42        /* Linux: 146 */
+#define SYS_PREAD 43         /* Linux: 180 (pread64) */
+#define SYS_PWRITE 44        /* Linux: 181 (pwrite64) */
+#define SYS_POLL 45          /* Linux: 168 */
+#define SYS_TRACE 46         /* custom */
+#define SYS_OPENAT 47        /* Linux: 295 */
+#define SYS_MKDIRAT 48       /* Linux: 296 */
+#define SYS_FSTATAT 49       /* Linux: 300 (fstatat64) */
+#define SYS_UNLINKAT 50      /* Linux: 301 */
+#define SYS_GETRLIMIT 51     /* Linux: 76 */
+#define SYS_SETRLIMIT 52     /* Linux: 75 */
+#define SYS_FSYNC 53         /* Linux: 118 */
+#define SYS_MAX 54
 
 #include <stdint.h>
 
@@ -63,4 +83,17 @@ static inline int32_t __syscall_ret(int32_t r) {
 static inline int32_t __syscall_ret(int32_t r) { return r; }
 #endif
 
+// Instruction the wrappers use to enter the kernel. In libc it calls
+// through __syscall_entry: eax = number, ebx/ecx/edx = arguments, result in
+// eax, every other register preserved, exactly like int $0x80. It points
+// at an int $0x80 stub until __syscall_init() (called from crt0) switches
+// it to the sysenter stub on CPUs that support it.
+#ifdef __is_libc
+extern void (*__syscall_entry)(void);
+void __syscall_init(void);
+#define __SYSCALL "call *__syscall_entry"
+#else
+#define __SYSCALL "int $0x80"
+#endif
+
 #endif
@@ -0,0 +1,70 @@
+#ifndef _SYS_TRACE_H
+#define _SYS_TRACE_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * Syscall tracing, as controlled by the trace_*() calls below.
+ *
+ * While tracing is on, every syscall made by the traced pid (or by any
+ * process, for TRACE_ALL) is appended to a kernel ring buffer as one
+ * trace_event, and its duration in TSC cycles is added to the histogram
+ * for its syscall number. Events that do not fit in the buffer are
+ * dropped and counted; trace_read() drains it.
+ *
+ * Durations are raw cycles from entry to return of the handler. A call
+ * that blocks is recorded once per attempt: each restart is its own event
+ * with ret == TRACE_RET_RESTART.
+ */
+
+/* Operations of SYS_TRACE. */
+#define TRACE_ON 0    /* arg: pid or TRACE_ALL */
+#define TRACE_OFF 1
+#define TRACE_READ 2  /* arg: trace_event array, len: entries */
+#define TRACE_STATS 3 /* arg: trace_hist array, len: entries */
+
+#define TRACE_ALL 0xFFFFFFFFU           /* trace_on() pid: every process */
+#define TRACE_BUCKETS 32                /* histogram bucket i: 2^i <= cycles < 2^(i+1) */
+#define TRACE_EXIT_NR 0xFFFFFFFFU       /* trace_event.nr of a process exit */
+#define TRACE_RET_RESTART (-0x7FFFFFFE) /* trace_event.ret of a call that blocked */
+
+struct trace_event {
+  uint32_t seq;     /* position in the trace; gaps mean dropped events */
+  uint32_t pid;
+  uint32_t nr;      /* SYS_*, or TRACE_EXIT_NR with the exit code in ret */
+  uint32_t args[3]; /* ebx, ecx, edx */
+  int32_t ret;      /* raw return value, negative errno on failure */
+  uint32_t reserved;
+  uint64_t cycles;  /* handler duration */
+};
+
+struct trace_hist {
+  uint32_t count;                  /* calls recorded */
+  uint32_t errors;                 /* calls that returned negative errno */
+  uint64_t total_cycles;
+  uint64_t max_cycles;
+  uint32_t buckets[TRACE_BUCKETS]; /* calls by log2(cycles) */
+};
+
+__BEGIN_DECLS
+
+// Start tracing pid (TRACE_ALL for every process), discarding any events
+// and statistics left from an earlier trace. Returns 0, or -1 on failure.
+int trace_on(uint32_t pid);
+
+// Stop tracing. Buffered events and statistics stay readable.
+int trace_off(void);
+
+// Move up to max buffered events into events, oldest first. Returns the
+// number moved, or -1 on failure.
+int trace_read(struct trace_event* events, unsigned int max);
+
+// Copy the histograms of the first max syscall numbers into hists
+// (hists[i] is SYS_ number i). Returns the number of events dropped
+// because the buffer was full, or -1 on failure.
+int trace_stats(struct trace_hist* hists, unsigned int max);
+
+__END_DECLS
+
+#endif
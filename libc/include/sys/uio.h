@@ -0,0 +1,32 @@
+#ifndef _SYS_UIO_H
+#define _SYS_UIO_H
+
+#include <stddef.h>
+#include <sys/cdefs.h>
+
+/*
+ * Scatter/gather I/O: one read or write across several buffers.
+ *
+ * readv() fills the buffers in array order and writev() drains them in
+ * array order, exactly as one read() or write() of their concatenation
+ * would. The kernel checks the whole list once per call.
+ */
+
+#define IOV_MAX 16 /* most buffers one call takes */
+
+struct iovec {
+  void* iov_base;
+  size_t iov_len;
+};
+
+__BEGIN_DECLS
+
+// Returns the total number of bytes transferred, or -1 with errno set
+// (EINVAL if iovcnt is not 1..IOV_MAX or the lengths add up to more than
+// INT_MAX, EFAULT for a bad buffer).
+int readv(int fd, const struct iovec* iov, int iovcnt);
+int writev(int fd, const struct iovec* iov, int iovcnt);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _SYS_VDSO_H
+#define _SYS_VDSO_H
+
+#include <stdint.h>
+
+/*
+ * Time page shared read-only with every process.
+ *
+ * The kernel maps one page at VDSO_TIME_ADDR in each user address space and
+ * rewrites it on every PIT interrupt with the monotonic time and the TSC
+ * value read at the same moment. Readers extrapolate from there with the
+ * TSC, so clock_gettime(CLOCK_MONOTONIC) needs no system call:
+ *
+ *   ns = vt->ns + (((rdtsc() - vt->tsc) * vt->tsc_mult) >> VDSO_TSC_SHIFT)
+ *
+ * Updates are published with a sequence counter: seq is odd while the kernel
+ * is writing, and a reader retries if seq was odd or changed across its
+ * reads. tsc_mult is 0 until the TSC has been calibrated against the PIT
+ * (or if the CPU has no TSC), in which case readers use SYS_CLOCK_GETTIME.
+ */
+
+#define VDSO_TIME_ADDR 0xBFFFF000U
+#define VDSO_TSC_SHIFT 24
+
+struct vdso_time {
+  uint32_t seq;      /* odd while an update is in progress */
+  uint32_t tsc_mult; /* ns per TSC cycle << VDSO_TSC_SHIFT, or 0 */
+  uint64_t ns;       /* monotonic time of the last update */
+  uint64_t tsc;      /* TSC at the last update */
+  uint64_t ticks;    /* ns / PIT tick length at the last update */
+};
+
+#endif
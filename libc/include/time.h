@@ -17,6 +17,7 @@ struct timespec {
 __BEGIN_DECLS
 
 int clock_gettime(clockid_t clk_id, struct timespec* tp);
+int nanosleep(const struct timespec* req, struct timespec* rem);
 
 __END_DECLS
 
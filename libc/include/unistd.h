@@ -25,9 +25,13 @@ int open(const char* path, int flags, ...);
 int exec(const char* path, char* const argv[], char* const envp[]);
 int write(int fd, const void* buf, size_t count);
 int read(int fd, void* buf, size_t count);
+int pread(int fd, void* buf, size_t count, int offset);
+int pwrite(int fd, const void* buf, size_t count, int offset);
 int close(int fd);
+int fsync(int fd);
 int dup2(int oldfd, int newfd);
 int pipe(int pipefd[2]);
+int pipe2(int pipefd[2], int flags);
 unsigned int sleep(unsigned int seconds);
 void msleep(unsigned int ms);
 void* sbrk(int increment);
@@ -35,6 +39,7 @@ int lseek(int fd, int offset, int whence);
 int chdir(const char* path);
 char* getcwd(char* buf, unsigned int size);
 int unlink(const char* path);
+int unlinkat(int dirfd, const char* path, int flags);
 int fcntl(int fd, int cmd, ...);
 
 __END_DECLS
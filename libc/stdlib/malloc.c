@@ -19,6 +19,7 @@ void* realloc(void* ptr, size_t size) { return krealloc(ptr, size); }
 
 #else /* __is_libc */
 
+#include <sys/futex.h>
 #include <unistd.h>
 
 /*
@@ -39,6 +40,28 @@ struct BlockHeader {
 
 static struct BlockHeader* heap_base = NULL;
 
+/*
+ * The heap lock. The futex functions are referenced weakly, so they are
+ * only linked in (and the lock only taken) by programs that also use
+ * pthreads; everything else keeps lock-free malloc.
+ */
+static struct futex_mutex heap_lock = FUTEX_MUTEX_INITIALIZER;
+
+#pragma weak futex_mutex_lock
+#pragma weak futex_mutex_unlock
+
+static void lock_heap(void) {
+  if (futex_mutex_lock) {
+    futex_mutex_lock(&heap_lock);
+  }
+}
+
+static void unlock_heap(void) {
+  if (futex_mutex_unlock) {
+    futex_mutex_unlock(&heap_lock);
+  }
+}
+
 /* Round up to nearest multiple of ALIGN, minimum ALIGN. */
 static size_t align_up(size_t sz) {
   if (sz == 0) {
@@ -52,7 +75,7 @@ static struct BlockHeader* block_after(struct BlockHeader* hdr) {
   return (struct BlockHeader*)((char*)hdr + HEADER_SIZE + hdr->size);
 }
 
-void* malloc(size_t size) {
+static void* malloc_unlocked(size_t size) {
   if (size == 0) {
     return NULL;
   }
@@ -101,11 +124,7 @@ void* malloc(size_t size) {
   return (char*)hdr + HEADER_SIZE;
 }
 
-void free(void* ptr) {
-  if (!ptr) {
-    return;
-  }
-
+static void free_unlocked(void* ptr) {
   struct BlockHeader* hdr = (struct BlockHeader*)((char*)ptr - HEADER_SIZE);
   hdr->free = 1;
 
@@ -134,6 +153,22 @@ void free(void* ptr) {
   }
 }
 
+void* malloc(size_t size) {
+  lock_heap();
+  void* ptr = malloc_unlocked(size);
+  unlock_heap();
+  return ptr;
+}
+
+void free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  lock_heap();
+  free_unlocked(ptr);
+  unlock_heap();
+}
+
 void* calloc(size_t nmemb, size_t size) {
   if (nmemb != 0 && size > (size_t)-1 / nmemb) {
     return NULL;
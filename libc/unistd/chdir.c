@@ -4,13 +4,13 @@
 
 int chdir(const char* path) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_CHDIR), "b"(path));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_CHDIR), "b"(path));
   return __syscall_ret(ret);
 }
 
 int getcwd_impl(char* buf, unsigned int size) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_GETCWD), "b"(buf), "c"(size));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_GETCWD), "b"(buf), "c"(size));
   return __syscall_ret(ret);
 }
 
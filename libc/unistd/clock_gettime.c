@@ -1,9 +1,70 @@
+#include <stddef.h>
 #include <stdint.h>
 #include <sys/syscall.h>
 #include <time.h>
 
+#ifdef __is_libc
+
+#include <sys/vdso.h>
+
+#define NS_PER_SEC 1000000000ULL
+
+// Read CLOCK_MONOTONIC from the kernel's time page (see <sys/vdso.h>).
+// Returns 0 if the TSC is not calibrated yet and the caller must ask the
+// kernel instead.
+static int vdso_monotonic(struct timespec* tp) {
+  const volatile struct vdso_time* vt = (const volatile struct vdso_time*)VDSO_TIME_ADDR;
+  static uint64_t last_ns;
+
+  uint32_t seq;
+  uint32_t mult;
+  uint64_t ns;
+  uint64_t base_tsc;
+  uint32_t lo;
+  uint32_t hi;
+  do {
+    seq = vt->seq;
+    __asm__ volatile("" ::: "memory");
+    mult = vt->tsc_mult;
+    ns = vt->ns;
+    base_tsc = vt->tsc;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    __asm__ volatile("" ::: "memory");
+  } while ((seq & 1) != 0 || vt->seq != seq);
+
+  if (mult == 0) {
+    return 0;
+  }
+
+  const uint64_t tsc = ((uint64_t)hi << 32) | lo;
+  if (tsc > base_tsc) {
+    ns += ((tsc - base_tsc) * mult) >> VDSO_TSC_SHIFT;
+  }
+  // Extrapolation may run slightly ahead of the next update; never let
+  // this process see time go backwards. Its threads share last_ns, so it
+  // only ever moves forward, by compare-and-swap.
+  uint64_t last = __atomic_load_n(&last_ns, __ATOMIC_RELAXED);
+  while (ns > last && !__atomic_compare_exchange_n(&last_ns, &last, ns, /*weak=*/1,
+                                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+  if (ns < last) {
+    ns = last;
+  }
+
+  tp->tv_sec = (int32_t)(ns / NS_PER_SEC);
+  tp->tv_nsec = (int32_t)(ns % NS_PER_SEC);
+  return 1;
+}
+
+#endif
+
 int clock_gettime(clockid_t clk_id, struct timespec* tp) {
+#ifdef __is_libc
+  if (clk_id == CLOCK_MONOTONIC && tp != NULL && vdso_monotonic(tp)) {
+    return 0;
+  }
+#endif
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_CLOCK_GETTIME), "b"(clk_id), "c"(tp));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_CLOCK_GETTIME), "b"(clk_id), "c"(tp));
   return __syscall_ret(ret);
 }
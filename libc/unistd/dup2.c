@@ -15,7 +15,7 @@ int dup2(int oldfd, int newfd) {
 
 int dup2(int oldfd, int newfd) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_DUP2), "b"(oldfd), "c"(newfd));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_DUP2), "b"(oldfd), "c"(newfd));
   return __syscall_ret(ret);
 }
 
@@ -16,7 +16,7 @@ int exec(const char* path, char* const argv[], char* const envp[]) {
 
 int exec(const char* path, char* const argv[], char* const envp[]) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_EXEC), "b"(path), "c"(argv), "d"(envp));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_EXEC), "b"(path), "c"(argv), "d"(envp));
   return __syscall_ret(ret);
 }
 
@@ -12,7 +12,7 @@ int fb_flip(const void* src, unsigned int w, unsigned int h) {
 #else /* __is_libc */
 int fb_flip(const void* src, unsigned int w, unsigned int h) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_FB_FLIP), "b"(src), "c"(w), "d"(h));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_FB_FLIP), "b"(src), "c"(w), "d"(h));
   return __syscall_ret(ret);
 }
 #endif
@@ -11,6 +11,6 @@ int fcntl(int fd, int cmd, ...) {
   va_end(ap);
 
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_FCNTL), "b"(fd), "c"(cmd), "d"(arg));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_FCNTL), "b"(fd), "c"(cmd), "d"(arg));
   return __syscall_ret(ret);
 }
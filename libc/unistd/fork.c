@@ -11,7 +11,7 @@ int fork(void) { return -1; }
 
 int fork(void) {
   int32_t pid;
-  __asm__ volatile("int $0x80" : "=a"(pid) : "a"(SYS_FORK));
+  __asm__ volatile(__SYSCALL : "=a"(pid) : "a"(SYS_FORK));
   return __syscall_ret(pid);
 }
 
@@ -0,0 +1,21 @@
+#include <unistd.h>
+
+#ifdef __is_libk
+
+int fsync(int fd) {
+  (void)fd;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+int fsync(int fd) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_FSYNC), "b"(fd) : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
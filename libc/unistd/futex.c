@@ -0,0 +1,85 @@
+#include <sys/futex.h>
+
+#ifdef __is_libk
+
+int futex(volatile uint32_t* uaddr, int op, uint32_t val) {
+  (void)uaddr;
+  (void)op;
+  (void)val;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+int futex(volatile uint32_t* uaddr, int op, uint32_t val) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_FUTEX), "b"(uaddr), "c"(op), "d"(val)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+/*
+ * Mutex states: 0 unlocked, 1 locked, 2 locked and possibly contended.
+ * Only an unlock that finds state 2 has to make the FUTEX_WAKE syscall.
+ */
+
+void futex_mutex_lock(struct futex_mutex* m) {
+  uint32_t c = 0;
+  if (__atomic_compare_exchange_n(&m->state, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    return;
+  }
+  // Contended: mark it so the holder wakes us, then sleep until we are the
+  // one that swaps a 0 out.
+  if (c != 2) {
+    c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+  }
+  while (c != 0) {
+    futex(&m->state, FUTEX_WAIT, 2);
+    c = __atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE);
+  }
+}
+
+int futex_mutex_trylock(struct futex_mutex* m) {
+  uint32_t c = 0;
+  return __atomic_compare_exchange_n(&m->state, &c, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+             ? 0
+             : -1;
+}
+
+void futex_mutex_unlock(struct futex_mutex* m) {
+  if (__atomic_fetch_sub(&m->state, 1, __ATOMIC_RELEASE) != 1) {
+    __atomic_store_n(&m->state, 0, __ATOMIC_RELEASE);
+    futex(&m->state, FUTEX_WAKE, 1);
+  }
+}
+
+void futex_cond_wait(struct futex_cond* c, struct futex_mutex* m) {
+  // A signal after this load changes seq, so the FUTEX_WAIT below returns
+  // at once instead of missing it.
+  const uint32_t seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+  futex_mutex_unlock(m);
+  futex(&c->seq, FUTEX_WAIT, seq);
+
+  // Relock as contended: a broadcast may have woken other waiters that
+  // now queue on the mutex behind us.
+  while (__atomic_exchange_n(&m->state, 2, __ATOMIC_ACQUIRE) != 0) {
+    futex(&m->state, FUTEX_WAIT, 2);
+  }
+}
+
+void futex_cond_signal(struct futex_cond* c) {
+  __atomic_fetch_add(&c->seq, 1, __ATOMIC_RELEASE);
+  futex(&c->seq, FUTEX_WAKE, 1);
+}
+
+void futex_cond_broadcast(struct futex_cond* c) {
+  __atomic_fetch_add(&c->seq, 1, __ATOMIC_RELEASE);
+  futex(&c->seq, FUTEX_WAKE, INT32_MAX);
+}
+
+#endif
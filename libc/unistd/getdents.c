@@ -2,8 +2,12 @@
 #include <stdint.h>
 #include <sys/syscall.h>
 
-int getdents(const char* path, struct dirent* buf, unsigned int count) {
+// flags goes in edi: esi and ebp carry the sysenter return state.
+int getdents(int fd, struct dirent* buf, unsigned int count, unsigned int flags) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_GETDENTS), "b"(path), "c"(buf), "d"(count));
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_GETDENTS), "b"(fd), "c"(buf), "d"(count), "D"(flags)
+                   : "memory");
   return __syscall_ret(ret);
 }
@@ -13,7 +13,7 @@ int ioctl(int fd, unsigned long request, ...) {
   void* arg = va_arg(ap, void*);
   va_end(ap);
   int32_t ret;
-  __asm__ volatile("int $0x80"
+  __asm__ volatile(__SYSCALL
                    : "=a"(ret)
                    : "a"(SYS_IOCTL), "b"(fd), "c"(request), "d"(arg)
                    : "memory");
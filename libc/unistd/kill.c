@@ -15,7 +15,7 @@ int kill(int pid, int sig) {
 
 int kill(int pid, int sig) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_KILL), "b"(pid), "c"(sig));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_KILL), "b"(pid), "c"(sig));
   return __syscall_ret(ret);
 }
 
@@ -4,6 +4,6 @@
 
 int lseek(int fd, int offset, int whence) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_LSEEK), "b"(fd), "c"(offset), "d"(whence));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_LSEEK), "b"(fd), "c"(offset), "d"(whence));
   return __syscall_ret(ret);
 }
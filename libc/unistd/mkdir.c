@@ -5,6 +5,13 @@
 int mkdir(const char* path, mode_t mode) {
   (void)mode;
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_MKDIR), "b"(path));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_MKDIR), "b"(path));
+  return __syscall_ret(ret);
+}
+
+int mkdirat(int dirfd, const char* path, mode_t mode) {
+  (void)mode;
+  int32_t ret;
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_MKDIRAT), "b"(dirfd), "c"(path));
   return __syscall_ret(ret);
 }
@@ -0,0 +1,15 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <time.h>
+
+int nanosleep(const struct timespec* req, struct timespec* rem) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_NANOSLEEP), "b"(req));
+  /* Sleeps are not interrupted early, so there is never time remaining. */
+  if (ret == 0 && rem != NULL) {
+    rem->tv_sec = 0;
+    rem->tv_nsec = 0;
+  }
+  return __syscall_ret(ret);
+}
@@ -13,6 +13,22 @@ int open(const char* path, int flags, ...) {
     va_end(ap);
   }
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_OPEN), "b"(path), "c"(flags), "d"(mode));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_OPEN), "b"(path), "c"(flags), "d"(mode));
+  return __syscall_ret(ret);
+}
+
+// The mode goes in edi: esi and ebp carry the sysenter return state.
+int openat(int dirfd, const char* path, int flags, ...) {
+  int mode = 0;
+  if ((flags & O_CREAT) != 0) {
+    va_list ap;
+    va_start(ap, flags);
+    mode = va_arg(ap, int);
+    va_end(ap);
+  }
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_OPENAT), "b"(dirfd), "c"(path), "d"(flags), "D"(mode));
   return __syscall_ret(ret);
 }
@@ -7,14 +7,23 @@ int pipe(int pipefd[2]) {
   return -1;
 }
 
+int pipe2(int pipefd[2], int flags) {
+  (void)pipefd;
+  (void)flags;
+  return -1;
+}
+
 #else /* __is_libc */
 
 #include <stdint.h>
 #include <sys/syscall.h>
 
-int pipe(int pipefd[2]) {
+int pipe(int pipefd[2]) { return pipe2(pipefd, 0); }
+
+/* flags: O_NONBLOCK and/or O_CLOEXEC, applied to both ends. */
+int pipe2(int pipefd[2], int flags) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_PIPE), "b"(pipefd));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_PIPE), "b"(pipefd), "c"(flags));
   return __syscall_ret(ret);
 }
 
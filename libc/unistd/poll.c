@@ -0,0 +1,26 @@
+#include <poll.h>
+
+#ifdef __is_libk
+
+int poll(struct pollfd* fds, nfds_t nfds, int timeout_ms) {
+  (void)fds;
+  (void)nfds;
+  (void)timeout_ms;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+int poll(struct pollfd* fds, nfds_t nfds, int timeout_ms) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_POLL), "b"(fds), "c"(nfds), "d"(timeout_ms)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
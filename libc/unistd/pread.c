@@ -0,0 +1,29 @@
+#include <stddef.h>
+#include <unistd.h>
+
+#ifdef __is_libk
+
+int pread(int fd, void* buf, size_t count, int offset) {
+  (void)fd;
+  (void)buf;
+  (void)count;
+  (void)offset;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+// The offset goes in edi: esi and ebp carry the sysenter return state.
+int pread(int fd, void* buf, size_t count, int offset) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_PREAD), "b"(fd), "c"(buf), "d"(count), "D"(offset)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include <pthread.h>
+
+#ifndef __is_libk
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/segment.h>
+#include <sys/syscall.h>
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+struct __pthread {
+  struct __pthread* self; /* %gs:0 */
+  void* (*start)(void*);
+  void* arg;
+  void* result;
+  volatile uint32_t tid; /* non-zero until the kernel clears it at exit */
+  void* stack;           /* malloc'd, freed by pthread_join */
+};
+
+static struct __pthread main_thread = {.self = &main_thread};
+
+/*
+ * int __clone(int (*fn)(void*), void* stack_top, void* arg, void* tls,
+ *             volatile uint32_t* clear_tid)
+ *
+ * Runs fn(arg) in a new thread on stack_top and ends the thread with
+ * SYS_EXIT_THREAD when fn returns. Returns the thread id or a negative
+ * errno in the caller. fn and arg are stored on the new stack before the
+ * syscall, so the child finds them without touching the caller's frame,
+ * and its call to fn sees a 16-byte aligned stack. Uses int $0x80 rather
+ * than __syscall_entry: the child must return on its own stack.
+ */
+__asm__(
+    ".text\n"
+    ".type __clone, @function\n"
+    "__clone:\n"
+    "    push %ebx\n"
+    "    mov 12(%esp), %ebx\n" /* stack_top */
+    "    mov 16(%esp), %eax\n" /* arg */
+    "    mov %eax, -16(%ebx)\n"
+    "    mov 8(%esp), %eax\n" /* fn */
+    "    mov %eax, -20(%ebx)\n"
+    "    sub $20, %ebx\n"
+    "    mov 20(%esp), %ecx\n" /* tls */
+    "    mov 24(%esp), %edx\n" /* clear_tid */
+    "    mov $" STR(SYS_CLONE) ", %eax\n"
+    "    int $0x80\n"
+    "    test %eax, %eax\n"
+    "    jz 1f\n"
+    "    pop %ebx\n"
+    "    ret\n"
+    "1:  pop %eax\n"
+    "    call *%eax\n"
+    "    mov $" STR(SYS_EXIT_THREAD) ", %eax\n"
+    "    int $0x80\n"
+    "    ud2\n");
+
+int __clone(int (*fn)(void*), void* stack_top, void* arg, void* tls, volatile uint32_t* clear_tid);
+
+static int thread_start(void* arg) {
+  struct __pthread* self = arg;
+  pthread_exit(self->start(self->arg));
+}
+
+int pthread_attr_init(pthread_attr_t* attr) {
+  attr->stack_size = PTHREAD_STACK_DEFAULT;
+  return 0;
+}
+
+int pthread_attr_setstacksize(pthread_attr_t* attr, size_t stack_size) {
+  if (stack_size < PTHREAD_STACK_MIN) {
+    return EINVAL;
+  }
+  attr->stack_size = stack_size;
+  return 0;
+}
+
+int pthread_create(pthread_t* thread, const pthread_attr_t* attr, void* (*start)(void*),
+                   void* arg) {
+  const size_t stack_size = attr != NULL ? attr->stack_size : PTHREAD_STACK_DEFAULT;
+  struct __pthread* t = calloc(1, sizeof(*t));
+  char* stack = malloc(stack_size);
+  if (t == NULL || stack == NULL) {
+    free(t);
+    free(stack);
+    return EAGAIN;
+  }
+
+  t->self = t;
+  t->start = start;
+  t->arg = arg;
+  t->stack = stack;
+  /* Set before the thread exists: it may exit before __clone returns. */
+  t->tid = UINT32_MAX;
+
+  const size_t top = ((uintptr_t)stack + stack_size) & ~(uintptr_t)15;
+  if (__clone(thread_start, (void*)top, t, t, &t->tid) < 0) {
+    free(stack);
+    free(t);
+    return EAGAIN;
+  }
+  *thread = t;
+  return 0;
+}
+
+int pthread_join(pthread_t thread, void** result) {
+  if (thread == &main_thread) {
+    return EINVAL;
+  }
+  uint32_t tid;
+  while ((tid = thread->tid) != 0) {
+    futex(&thread->tid, FUTEX_WAIT, tid);
+  }
+  if (result != NULL) {
+    *result = thread->result;
+  }
+  free(thread->stack);
+  free(thread);
+  return 0;
+}
+
+void pthread_exit(void* result) {
+  pthread_self()->result = result;
+  __asm__ volatile("int $0x80" ::"a"(SYS_EXIT_THREAD));
+  __builtin_unreachable();
+}
+
+pthread_t pthread_self(void) {
+  uint32_t gs;
+  __asm__("mov %%gs, %0" : "=r"(gs));
+  /* Only the main thread runs without a TLS segment. */
+  if ((gs & 0xFFFF) == __USER_DS) {
+    return &main_thread;
+  }
+  struct __pthread* self;
+  __asm__("mov %%gs:0, %0" : "=r"(self));
+  return self;
+}
+
+int pthread_equal(pthread_t a, pthread_t b) { return a == b; }
+
+int pthread_mutex_init(pthread_mutex_t* mutex, const pthread_mutexattr_t* attr) {
+  (void)attr;
+  mutex->m.state = 0;
+  return 0;
+}
+
+int pthread_mutex_destroy(pthread_mutex_t* mutex) {
+  return mutex->m.state != 0 ? EBUSY : 0;
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+  futex_mutex_lock(&mutex->m);
+  return 0;
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* mutex) {
+  return futex_mutex_trylock(&mutex->m) == 0 ? 0 : EBUSY;
+}
+
+int pthread_mutex_unlock(pthread_mutex_t* mutex) {
+  futex_mutex_unlock(&mutex->m);
+  return 0;
+}
+
+int pthread_cond_init(pthread_cond_t* cond, const pthread_condattr_t* attr) {
+  (void)attr;
+  cond->c.seq = 0;
+  return 0;
+}
+
+int pthread_cond_destroy(pthread_cond_t* cond) {
+  (void)cond;
+  return 0;
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+  futex_cond_wait(&cond->c, &mutex->m);
+  return 0;
+}
+
+int pthread_cond_signal(pthread_cond_t* cond) {
+  futex_cond_signal(&cond->c);
+  return 0;
+}
+
+int pthread_cond_broadcast(pthread_cond_t* cond) {
+  futex_cond_broadcast(&cond->c);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include <sys/ring.h>
+
+#ifdef __is_libk
+
+int ring_setup(struct ring* r, unsigned int entries) {
+  (void)r;
+  (void)entries;
+  return -1;
+}
+
+int ring_enter(unsigned int to_submit, unsigned int min_complete) {
+  (void)to_submit;
+  (void)min_complete;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <sys/syscall.h>
+
+int ring_setup(struct ring* r, unsigned int entries) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_RING_SETUP), "b"(r), "c"(entries) : "memory");
+  return __syscall_ret(ret);
+}
+
+int ring_enter(unsigned int to_submit, unsigned int min_complete) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_RING_ENTER), "b"(to_submit), "c"(min_complete)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include <sys/resource.h>
+
+#ifdef __is_libk
+
+int getrlimit(int resource, struct rlimit* rlim) {
+  (void)resource;
+  (void)rlim;
+  return -1;
+}
+
+int setrlimit(int resource, const struct rlimit* rlim) {
+  (void)resource;
+  (void)rlim;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <sys/syscall.h>
+
+int getrlimit(int resource, struct rlimit* rlim) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_GETRLIMIT), "b"(resource), "c"(rlim)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+int setrlimit(int resource, const struct rlimit* rlim) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_SETRLIMIT), "b"(resource), "c"(rlim)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
@@ -15,7 +15,7 @@ void* sbrk(int increment) {
 
 void* sbrk(int increment) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_SBRK), "b"(increment));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_SBRK), "b"(increment));
   if (ret < 0) {
     errno = -ret;
     return (void*)-1;
@@ -0,0 +1,26 @@
+#include <sys/schedstat.h>
+
+#ifdef __is_libk
+
+int schedstat(struct sched_stat* stat, struct proc_stat* procs, unsigned int max_procs) {
+  (void)stat;
+  (void)procs;
+  (void)max_procs;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+int schedstat(struct sched_stat* stat, struct proc_stat* procs, unsigned int max_procs) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_SCHEDSTAT), "b"(stat), "c"(procs), "d"(max_procs)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <sys/select.h>
+
+#ifdef __is_libk
+
+int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+           struct timeval* timeout) {
+  (void)nfds;
+  (void)readfds;
+  (void)writefds;
+  (void)exceptfds;
+  (void)timeout;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <errno.h>
+#include <poll.h>
+#include <stddef.h>
+
+int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+           struct timeval* timeout) {
+  if (nfds < 0 || nfds > FD_SETSIZE) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  /* One pollfd per descriptor in either set. */
+  struct pollfd fds[FD_SETSIZE];
+  nfds_t count = 0;
+  for (int fd = 0; fd < nfds; ++fd) {
+    short events = 0;
+    if (readfds != NULL && FD_ISSET(fd, readfds)) {
+      events |= POLLIN;
+    }
+    if (writefds != NULL && FD_ISSET(fd, writefds)) {
+      events |= POLLOUT;
+    }
+    if (events != 0) {
+      fds[count].fd = fd;
+      fds[count].events = events;
+      fds[count].revents = 0;
+      ++count;
+    }
+  }
+
+  int timeout_ms = -1;
+  if (timeout != NULL) {
+    timeout_ms = (int)(timeout->tv_sec * 1000 + timeout->tv_usec / 1000);
+  }
+  if (poll(fds, count, timeout_ms) < 0) {
+    return -1;
+  }
+
+  if (readfds != NULL) {
+    FD_ZERO(readfds);
+  }
+  if (writefds != NULL) {
+    FD_ZERO(writefds);
+  }
+  if (exceptfds != NULL) {
+    FD_ZERO(exceptfds);
+  }
+
+  int ready = 0;
+  for (nfds_t i = 0; i < count; ++i) {
+    const short revents = fds[i].revents;
+    if ((revents & POLLNVAL) != 0) {
+      errno = EBADF;
+      return -1;
+    }
+    if ((fds[i].events & POLLIN) != 0 && (revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+      FD_SET(fds[i].fd, readfds);
+      ++ready;
+    }
+    if ((fds[i].events & POLLOUT) != 0 && (revents & (POLLOUT | POLLERR)) != 0) {
+      FD_SET(fds[i].fd, writefds);
+      ++ready;
+    }
+  }
+  return ready;
+}
+
+#endif
@@ -15,7 +15,7 @@ int shmat(int shmid, void* vaddr) {
 
 int shmat(int shmid, void* vaddr) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_SHMAT), "b"(shmid), "c"(vaddr));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_SHMAT), "b"(shmid), "c"(vaddr));
   return __syscall_ret(ret);
 }
 
@@ -15,7 +15,7 @@ int shmdt(void* vaddr, unsigned int size) {
 
 int shmdt(void* vaddr, unsigned int size) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_SHMDT), "b"(vaddr), "c"(size));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_SHMDT), "b"(vaddr), "c"(size));
   return __syscall_ret(ret);
 }
 
@@ -14,7 +14,7 @@ int shmget(unsigned int size) {
 
 int shmget(unsigned int size) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_SHMGET), "b"(size));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_SHMGET), "b"(size));
   return __syscall_ret(ret);
 }
 
@@ -22,7 +22,7 @@ int raise(int sig) {
 sighandler_t signal(int signum, sighandler_t handler) {
   uint32_t old = 0;
   int32_t ret;
-  __asm__ volatile("int $0x80"
+  __asm__ volatile(__SYSCALL
                    : "=a"(ret)
                    : "a"(SYS_SIGACTION), "b"(signum), "c"((uint32_t)handler), "d"(&old));
   if (ret < 0) {
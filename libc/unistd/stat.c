@@ -4,12 +4,22 @@
 
 int stat(const char* path, struct stat* buf) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_STAT), "b"(path), "c"(buf));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_STAT), "b"(path), "c"(buf));
   return __syscall_ret(ret);
 }
 
 int fstat(int fd, struct stat* buf) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_FSTAT), "b"(fd), "c"(buf));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_FSTAT), "b"(fd), "c"(buf));
+  return __syscall_ret(ret);
+}
+
+// flags goes in edi: esi and ebp carry the sysenter return state.
+int fstatat(int dirfd, const char* path, struct stat* buf, int flags) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_FSTATAT), "b"(dirfd), "c"(path), "d"(buf), "D"(flags)
+                   : "memory");
   return __syscall_ret(ret);
 }
@@ -0,0 +1,64 @@
+#include <sys/syscall.h>
+
+#ifndef __is_libk
+
+#include <stdint.h>
+
+/*
+ * System call entry stubs. Both take the syscall number and arguments in
+ * eax/ebx/ecx/edx and return the result in eax, preserving everything else.
+ *
+ * The sysenter stub hands the kernel its return address in esi and its
+ * stack pointer in ebp (see sysenter_entry in the kernel's trap_entry.S).
+ * sysexit returns through edx/ecx, so those are saved on the stack along
+ * with the registers the stub repurposes.
+ */
+__asm__(
+    ".text\n"
+    ".type __syscall_int80, @function\n"
+    "__syscall_int80:\n"
+    "    int $0x80\n"
+    "    ret\n"
+    ".type __syscall_sysenter, @function\n"
+    "__syscall_sysenter:\n"
+    "    push %ebp\n"
+    "    push %esi\n"
+    "    push %edx\n"
+    "    push %ecx\n"
+    "    mov %esp, %ebp\n"
+    "    mov $1f, %esi\n"
+    "    sysenter\n"
+    "1:  pop %ecx\n"
+    "    pop %edx\n"
+    "    pop %esi\n"
+    "    pop %ebp\n"
+    "    ret\n");
+
+void __syscall_int80(void);
+void __syscall_sysenter(void);
+
+void (*__syscall_entry)(void) = __syscall_int80;
+
+#define CPUID_FEAT_EDX_SEP (1U << 11)
+
+// Same test the kernel applies before programming the SYSENTER MSRs: SEP
+// in CPUID, except on early Pentium Pros that report it without support.
+static int has_sysenter(void) {
+  uint32_t eax, ebx, ecx, edx;
+  __asm__ volatile("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+  if ((edx & CPUID_FEAT_EDX_SEP) == 0) {
+    return 0;
+  }
+  const uint32_t family = (eax >> 8) & 0xF;
+  const uint32_t model = (eax >> 4) & 0xF;
+  const uint32_t stepping = eax & 0xF;
+  return !(family == 6 && model < 3 && stepping < 3);
+}
+
+void __syscall_init(void) {
+  if (has_sysenter()) {
+    __syscall_entry = __syscall_sysenter;
+  }
+}
+
+#endif
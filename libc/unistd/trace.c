@@ -0,0 +1,49 @@
+#include <sys/trace.h>
+
+#ifdef __is_libk
+
+int trace_on(uint32_t pid) {
+  (void)pid;
+  return -1;
+}
+
+int trace_off(void) { return -1; }
+
+int trace_read(struct trace_event* events, unsigned int max) {
+  (void)events;
+  (void)max;
+  return -1;
+}
+
+int trace_stats(struct trace_hist* hists, unsigned int max) {
+  (void)hists;
+  (void)max;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <sys/syscall.h>
+
+static int trace_call(uint32_t op, uint32_t arg, uint32_t len) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_TRACE), "b"(op), "c"(arg), "d"(len)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+int trace_on(uint32_t pid) { return trace_call(TRACE_ON, pid, 0); }
+
+int trace_off(void) { return trace_call(TRACE_OFF, 0, 0); }
+
+int trace_read(struct trace_event* events, unsigned int max) {
+  return trace_call(TRACE_READ, (uint32_t)events, max);
+}
+
+int trace_stats(struct trace_hist* hists, unsigned int max) {
+  return trace_call(TRACE_STATS, (uint32_t)hists, max);
+}
+
+#endif
@@ -4,6 +4,14 @@
 
 int unlink(const char* path) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_UNLINK), "b"(path));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_UNLINK), "b"(path));
+  return __syscall_ret(ret);
+}
+
+int unlinkat(int dirfd, const char* path, int flags) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_UNLINKAT), "b"(dirfd), "c"(path), "d"(flags));
   return __syscall_ret(ret);
 }
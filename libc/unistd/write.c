@@ -17,7 +17,7 @@ int write(int fd, const void* buf, size_t count) {
 
 int write(int fd, const void* buf, size_t count) {
   int32_t ret;
-  __asm__ volatile("int $0x80" : "=a"(ret) : "a"(SYS_WRITE), "b"(fd), "c"(buf), "d"(count));
+  __asm__ volatile(__SYSCALL : "=a"(ret) : "a"(SYS_WRITE), "b"(fd), "c"(buf), "d"(count));
   return __syscall_ret(ret);
 }
 
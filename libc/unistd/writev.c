@@ -0,0 +1,26 @@
+#include <sys/uio.h>
+
+#ifdef __is_libk
+
+int writev(int fd, const struct iovec* iov, int iovcnt) {
+  (void)fd;
+  (void)iov;
+  (void)iovcnt;
+  return -1;
+}
+
+#else /* __is_libc */
+
+#include <stdint.h>
+#include <sys/syscall.h>
+
+int writev(int fd, const struct iovec* iov, int iovcnt) {
+  int32_t ret;
+  __asm__ volatile(__SYSCALL
+                   : "=a"(ret)
+                   : "a"(SYS_WRITEV), "b"(fd), "c"(iov), "d"(iovcnt)
+                   : "memory");
+  return __syscall_ret(ret);
+}
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "paging.h"
+
+/*
+ * Per-process address space management.
+ *
+ * Each process has its own page directory. Kernel mappings (PDE indices
+ * 768–1023, covering 0xC0000000–0xFFFFFFFF) are shared across all processes
+ * by copying the PDE entries from boot_page_directory. User mappings (PDE
+ * indices 0–767) are per-process.
+ *
+ * Page directories and page tables must reside in the first 8 MiB of
+ * physical memory so they can be accessed via phys_to_virt(). The PMM
+ * allocates lowest frames first, satisfying this constraint.
+ */
+
+namespace AddressSpace {
+
+// Kernel PDE range: indices 768–1023 (0xC0000000 / 4 MiB per entry = 768).
+static constexpr uint32_t kKernelPdeStart = KERNEL_VMA >> 22;
+
+// PageEntry::available value of pages mapped with map_shared().
+static constexpr uint32_t kSharedPage = 1;
+
+// Allocate a new page directory with kernel mappings copied from
+// boot_page_directory and user entries zeroed.
+// Returns the physical and virtual addresses of the new page directory.
+struct PageDir {
+  paddr_t phys;
+  PageTable* virt;
+};
+[[nodiscard]] PageDir create();
+
+// Duplicate src_pd into a fresh address space by eagerly copying every
+// user-space physical page (PDE indices 0..kKernelPdeStart-1).
+// Kernel PDEs are shared, as with create().
+// Panics if physical memory is exhausted.
+[[nodiscard]] PageDir copy(const PageTable* src_pd);
+
+// Map a single page in a specific page directory.
+// The page directory does not need to be the currently loaded one.
+void map(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable, bool user);
+
+// Map a page whose frame the address space does not own (PageEntry's
+// available bits carry kSharedPage). copy() maps the same frame into the
+// new address space instead of duplicating it, and unmap() and destroy()
+// leave the frame allocated. Used for the vDSO time page.
+void map_shared(PageTable* pd, vaddr_t virt, paddr_t phys, bool writeable);
+
+// Unmap a single page from a page directory, freeing its physical frame
+// unless it was mapped with map_shared().
+// Invalidates the TLB entry for `virt` via invlpg. No-op if not mapped.
+void unmap(PageTable* pd, vaddr_t virt);
+
+// Unmap a single page without freeing the backing physical frame.
+// Used for shared memory where the physical page is owned by the shm region.
+void unmap_nofree(PageTable* pd, vaddr_t virt);
+
+// Copy current kernel PDE entries (768–1023) from boot_page_directory
+// into the given page directory. Call before switching to this address
+// space to pick up any new kernel mappings (e.g. heap growth).
+void sync_kernel_mappings(PageTable* pd);
+
+// Load a page directory into CR3, switching the active address space.
+void load(paddr_t pd_phys);
+
+// Free all user-space pages and page tables owned by this page directory,
+// then free the page directory page itself. Shared pages are left alone.
+void destroy(PageTable* pd, paddr_t pd_phys);
+
+// Returns true if the page containing va is present in pd and is
+// user-accessible. If writeable is true, also requires the PTE rw bit.
+[[nodiscard]] bool is_user_mapped(const PageTable* pd, vaddr_t va, bool writeable);
+
+// Translate a user virtual address in pd to its physical address, keeping
+// the page offset. Returns 0 unless the page is present and user-accessible.
+[[nodiscard]] paddr_t user_phys(const PageTable* pd, vaddr_t va);
+
+}  // namespace AddressSpace
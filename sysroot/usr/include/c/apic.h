@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Local APIC driver.
+ *
+ * Every CPU has a local APIC at the same physical address (normally
+ * 0xFEE00000, reported by the IA32_APIC_BASE MSR). It is memory-mapped at
+ * kLapicVirtBase in the kernel half, so the mapping is shared by every
+ * address space and each CPU's accesses reach its own APIC.
+ *
+ * The 8259 PIC keeps delivering legacy IRQs (PIT, keyboard) to the BSP
+ * through LINT0 in virtual-wire mode; the local APIC is used for:
+ *   - AP startup (INIT / STARTUP IPIs),
+ *   - inter-processor interrupts (reschedule, TLB shootdown),
+ *   - a per-CPU one-shot timer on the APs, calibrated against the PIT.
+ */
+
+namespace LAPIC {
+
+// Vectors owned by the local APIC. The legacy PIC occupies 32-47.
+static constexpr uint8_t kTimerVector = 0x40;
+static constexpr uint8_t kRescheduleVector = 0x41;
+static constexpr uint8_t kTlbShootdownVector = 0x42;
+static constexpr uint8_t kSpuriousVector = 0xFF;
+
+// Detect and enable the BSP's local APIC, map its registers, and calibrate
+// the APIC timer against the PIT. Returns false (leaving the system on the
+// PIC alone) if the CPU has no APIC.
+// Must be called after VMM and PIT initialisation, with interrupts enabled.
+[[nodiscard]] bool init();
+
+// Enable the calling AP's local APIC. The register mapping is shared, so
+// this only programs per-CPU state. LINT0/LINT1 are masked so legacy IRQs
+// stay on the BSP.
+void init_ap();
+
+// True once init() has succeeded.
+[[nodiscard]] bool is_enabled();
+
+// APIC ID of the calling CPU.
+[[nodiscard]] uint8_t id();
+
+// Signal end-of-interrupt for an APIC-delivered vector.
+void eoi();
+
+// Send a fixed-delivery IPI with `vector` to the CPU with `apic_id`.
+void send_ipi(uint8_t apic_id, uint8_t vector);
+
+// Send an INIT IPI (assert) to `apic_id`, the first step of AP startup.
+void send_init(uint8_t apic_id);
+
+// Send a STARTUP IPI telling `apic_id` to begin real-mode execution at
+// physical address page * 4 KiB.
+void send_startup(uint8_t apic_id, uint8_t page);
+
+// Arm this CPU's APIC timer to fire kTimerVector once, delta_ns from now.
+// Deltas longer than the 32-bit counter allows are clamped.
+void set_oneshot(uint64_t delta_ns);
+
+// Stop this CPU's APIC timer.
+void stop_timer();
+
+}  // namespace LAPIC
@@ -0,0 +1,28 @@
+#ifndef _CTYPE_H
+#define _CTYPE_H
+
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+static inline int isdigit(int c) { return c >= '0' && c <= '9'; }
+static inline int isalpha(int c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+static inline int isalnum(int c) { return isalpha(c) || isdigit(c); }
+static inline int isspace(int c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+static inline int isupper(int c) { return c >= 'A' && c <= 'Z'; }
+static inline int islower(int c) { return c >= 'a' && c <= 'z'; }
+static inline int isprint(int c) { return c >= ' ' && c <= '~'; }
+static inline int isgraph(int c) { return c > ' ' && c <= '~'; }
+static inline int iscntrl(int c) { return (c >= 0 && c < ' ') || c == 0x7F; }
+static inline int ispunct(int c) { return isgraph(c) && !isalnum(c); }
+static inline int isxdigit(int c) {
+  return isdigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+static inline int toupper(int c) { return (c >= 'a' && c <= 'z') ? c - 32 : c; }
+static inline int tolower(int c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+
+__END_DECLS
+
+#endif /* _CTYPE_H */
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array.h>
+#include <optional.h>
+#include <span.h>
+#include <stdint.h>
+
+// Hard ceiling on file descriptors per process: no fd table grows past
+// this, and RLIMIT_NOFILE cannot be raised above it.
+static constexpr uint32_t kMaxFds = 1024;
+
+// RLIMIT_NOFILE a new process starts with.
+static constexpr uint32_t kDefaultFdLimit = 256;
+
+// Sentinel value returned by file_read / file_write when the caller should
+// block and retry. The callee must first park the caller with
+// Scheduler::wait_on(); syscall_dispatch then blocks it on that queue and
+// re-executes the syscall once the queue is woken.
+static constexpr int32_t kSyscallRestart = -0x7FFFFFFE;
+
+// Scatter/gather lists: the buffers of one readv/writev, filled or drained
+// in order as if they were a single buffer.
+using IoVec = std::span<const std::span<uint8_t>>;
+using ConstIoVec = std::span<const std::span<const uint8_t>>;
+
+// Forward declaration for pipe endpoints.
+struct Pipe;
+
+// Forward declaration for VFS open-file state.
+struct VfsFileDescription;
+
+// Types of open file descriptions.
+enum class FileType : uint8_t {
+  TerminalRead,   // stdin: reads from keyboard
+  TerminalWrite,  // stdout/stderr: writes to VGA terminal
+  PipeRead,       // read end of a pipe
+  PipeWrite,      // write end of a pipe
+  VfsNode,        // file/device opened through the VFS
+};
+
+// Reference-counted open file description.
+//
+// Multiple fds (across processes via fork, or via dup2 within a process)
+// can point to the same FileDescription. When ref_count drops to zero
+// the description is cleaned up via file_close().
+struct FileDescription {
+  FileType type;
+  uint32_t ref_count;
+  Pipe* pipe;               // non-null for PipeRead / PipeWrite only
+  VfsFileDescription* vfs;  // non-null for VfsNode only
+  int32_t status_flags;     // O_NONBLOCK (ignored for regular files); set by open/pipe/F_SETFL
+
+  void ref() { ++ref_count; }
+};
+
+// Read up to buf.size() bytes. Returns bytes read, 0 for EOF, or kSyscallRestart
+// to block (-EAGAIN instead if fd is O_NONBLOCK). Returns -1 on error (e.g. not
+// a readable fd).
+[[nodiscard]] int32_t file_read(FileDescription* fd, std::span<uint8_t> buf);
+
+// Write up to buf.size() bytes. Returns bytes written, kSyscallRestart to block
+// (-EAGAIN if O_NONBLOCK), or -1 on error.
+[[nodiscard]] int32_t file_write(FileDescription* fd, std::span<const uint8_t> buf);
+
+// Read into each buffer of iov in turn, stopping at the first short read.
+// Returns total bytes read, kSyscallRestart if the first buffer would block,
+// or a negative error if nothing was read.
+[[nodiscard]] int32_t file_readv(FileDescription* fd, IoVec iov);
+
+// Write each buffer of iov in turn, stopping at the first short write.
+// Returns as file_readv().
+[[nodiscard]] int32_t file_writev(FileDescription* fd, ConstIoVec iov);
+
+// Read or write at `offset` without using or moving the file offset.
+// Only VFS-backed descriptions are seekable; others return -ESPIPE.
+[[nodiscard]] int32_t file_pread(FileDescription* fd, std::span<uint8_t> buf, uint32_t offset);
+[[nodiscard]] int32_t file_pwrite(FileDescription* fd, std::span<const uint8_t> buf,
+                                  uint32_t offset);
+
+// Readiness of fd as POLLIN / POLLOUT / POLLHUP / POLLERR bits (<poll.h>).
+// Never blocks.
+[[nodiscard]] uint32_t file_poll(FileDescription* fd);
+
+// Result of a transfer that failed with `rc` after `done` bytes: rc if
+// nothing moved, otherwise the short count, dropping any wait the failing
+// step set up.
+[[nodiscard]] int32_t partial_result(uint32_t done, int32_t rc);
+
+// The helpers below take either list type; Byte is uint8_t or const uint8_t.
+
+// Total bytes in a scatter/gather list.
+template <typename Byte>
+[[nodiscard]] uint32_t iov_length(std::span<const std::span<Byte>> iov) {
+  uint32_t total = 0;
+  for (const auto& buf : iov) {
+    total += static_cast<uint32_t>(buf.size());
+  }
+  return total;
+}
+
+// Call fn(chunk) for each piece of the n bytes that start `pos` bytes into
+// iov, in order. Stops early if the list is shorter.
+template <typename Byte, typename Fn>
+void iov_for_range(std::span<const std::span<Byte>> iov, uint32_t pos, uint32_t n, Fn fn) {
+  for (const auto& buf : iov) {
+    if (n == 0) {
+      return;
+    }
+    if (pos >= buf.size()) {
+      pos -= static_cast<uint32_t>(buf.size());
+      continue;
+    }
+    const uint32_t avail = static_cast<uint32_t>(buf.size()) - pos;
+    const uint32_t chunk = n < avail ? n : avail;
+    fn(buf.subspan(pos, chunk));
+    n -= chunk;
+    pos = 0;
+  }
+}
+
+// Run op(buf, done) on each buffer of iov in turn, where done is the byte
+// count so far, stopping at the first short or failed transfer. Returns
+// the total, or as partial_result() for a failure.
+template <typename Byte, typename Op>
+[[nodiscard]] int32_t iov_each(std::span<const std::span<Byte>> iov, Op op) {
+  uint32_t total = 0;
+  for (const auto& buf : iov) {
+    const int32_t n = op(buf, total);
+    if (n < 0) {
+      return partial_result(total, n);
+    }
+    total += static_cast<uint32_t>(n);
+    if (static_cast<uint32_t>(n) < buf.size()) {
+      break;
+    }
+  }
+  return static_cast<int32_t>(total);
+}
+
+// Copy n bytes from src into iov, starting `pos` bytes into the list.
+void iov_scatter(IoVec iov, uint32_t pos, const uint8_t* src, uint32_t n);
+
+// Copy n bytes out of iov, starting `pos` bytes into the list, to dst.
+void iov_gather(ConstIoVec iov, uint32_t pos, uint8_t* dst, uint32_t n);
+
+// Decrement ref_count and perform type-specific cleanup when it reaches 0.
+void file_close(FileDescription* fd);
+
+// Per-process file descriptor table, shared by the threads of a group
+// (see Process::group()).
+//
+// Slots are allocated on demand and the array doubles as fds are needed,
+// up to the RLIMIT_NOFILE soft limit. Open fds are tracked in a bitmap
+// with one summary bit per full 32-bit word, so finding the lowest free fd
+// is two bit scans regardless of how many are open. Iteration (fork, exec,
+// exit) also walks the bitmap rather than every slot.
+//
+// A zero-filled table is valid and empty with a limit of 0; processes get
+// their limit from init_stdio() or copy_from().
+class FdTable {
+ public:
+  // Description at fd, or nullptr if fd is not open.
+  [[nodiscard]] FileDescription* operator[](uint32_t fd) const {
+    return fd < capacity_ ? slots_[fd].file : nullptr;
+  }
+
+  // Install new terminal descriptions as fds 0..2 of an empty table (1 and
+  // 2 share one) and set the default limit. Returns false if out of memory.
+  [[nodiscard]] bool init_stdio();
+
+  // Lowest closed fd >= min_fd, with a slot ready for install(). Returns
+  // nullopt if every fd from min_fd up to the limit is open, or the table
+  // cannot grow.
+  [[nodiscard]] std::optional<uint32_t> alloc(uint32_t min_fd = 0);
+
+  // Grow the table so fd has a slot. Returns false if fd is at or above
+  // the limit or out of memory.
+  [[nodiscard]] bool reserve(uint32_t fd);
+
+  // Put desc at a closed fd that has a slot (see alloc() and reserve()).
+  // The table takes over the caller's reference.
+  void install(uint32_t fd, FileDescription* desc, uint32_t fd_flags = 0);
+
+  // Remove the description at fd and return it (nullptr if fd was not
+  // open). The caller owns the reference, usually for file_close().
+  [[nodiscard]] FileDescription* remove(uint32_t fd);
+
+  // Per-fd flags (FD_CLOEXEC) of an open fd.
+  [[nodiscard]] uint32_t flags(uint32_t fd) const { return slots_[fd].flags; }
+  void set_flags(uint32_t fd, uint32_t fd_flags) { slots_[fd].flags = fd_flags; }
+
+  // Lowest open fd >= from, or nullopt if there is none.
+  [[nodiscard]] std::optional<uint32_t> next_open(uint32_t from) const;
+
+  // Make this (empty) table a copy of other for fork(): the same fds,
+  // flags and limits, each description with one more reference. Returns
+  // false if out of memory, leaving this table empty.
+  [[nodiscard]] bool copy_from(const FdTable& other);
+
+  // file_close() every open fd whose flags include FD_CLOEXEC.
+  void close_on_exec();
+
+  // file_close() every open fd and free the table.
+  void close_all();
+
+  // RLIMIT_NOFILE: fds at or above the soft limit are never allocated; the
+  // soft limit can be raised up to the hard one, itself at most kMaxFds.
+  [[nodiscard]] uint32_t limit() const { return limit_; }
+  [[nodiscard]] uint32_t max_limit() const { return max_limit_; }
+  void set_limits(uint32_t soft, uint32_t hard);
+
+  // Number of slots currently allocated.
+  [[nodiscard]] uint32_t capacity() const { return capacity_; }
+
+ private:
+  static constexpr uint32_t kInitialSlots = 16;
+  static constexpr uint32_t kWords = kMaxFds / 32;
+  static_assert(kMaxFds % 32 == 0 && kWords <= 32, "FdTable: summary must fit one word");
+
+  struct Slot {
+    FileDescription* file;
+    uint32_t flags;
+  };
+
+  // reserve() without the limit check.
+  [[nodiscard]] bool grow(uint32_t fd);
+  void mark_open(uint32_t fd);
+  void mark_closed(uint32_t fd);
+
+  Slot* slots_;
+  uint32_t capacity_;
+  uint32_t limit_;
+  uint32_t max_limit_;
+  std::array<uint32_t, kWords> open_;  // bit set: fd open
+  uint32_t full_;                      // bit w set: open_[w] has every fd open
+};
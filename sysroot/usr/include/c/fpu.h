@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+
+struct Process;
+
+/*
+ * Lazy x87/SSE state management.
+ *
+ * The kernel itself never touches FP registers (-mgeneral-regs-only), so
+ * only user processes have FPU state. Each process keeps a 512-byte
+ * FXSAVE image in its PCB, and each CPU remembers which process's state
+ * its FP registers currently hold (the owner).
+ *
+ * On every context switch CR0.TS is set unless the incoming process is
+ * this CPU's owner. The first FP/SSE instruction after that raises #NM
+ * (vector 7), whose handler saves the old owner's registers, loads the
+ * current process's (or a clean state on first use) and clears TS. A
+ * process that never uses the FPU never pays for a save or restore.
+ *
+ * With more than one CPU online a process may be resumed elsewhere, so
+ * the outgoing owner's registers are also saved at switch-out if it may
+ * have used them during its slice; a CPU that loads a process's state
+ * drops any stale ownership other CPUs still hold for it.
+ */
+
+namespace Fpu {
+
+// Size of an FXSAVE/FXRSTOR image.
+static constexpr uint32_t kStateSize = 512;
+
+// FXSAVE image; the instruction requires 16-byte alignment.
+struct alignas(16) State {
+  uint8_t bytes[kStateSize];
+};
+
+// Enable the FPU and SSE on the BSP and install the #NM handler.
+// Must be called after Interrupt::init().
+void init();
+
+// Enable the FPU and SSE on the calling AP. Called from ap_main().
+void init_ap();
+
+// True if the CPU supports FXSAVE/FXRSTOR (and CR4.OSFXSR was set).
+[[nodiscard]] bool has_fxsr();
+
+// Set CR0.TS for the switch from `prev` to `next` on the calling CPU (see
+// above). Called by the scheduler before it loads `next`.
+void switch_to(Process* prev, Process* next);
+
+// Give `child` a copy of `parent`'s FPU state (fork). `parent` must be the
+// process running on the calling CPU.
+void copy_state(Process* parent, Process* child);
+
+// Discard `p`'s FPU state: on exit, and on exec so the new program starts
+// with a clean FPU.
+void release(Process* p);
+
+}  // namespace Fpu
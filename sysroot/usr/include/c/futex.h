@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "paging.h"
+#include "wait_queue.h"
+
+/*
+ * Fast userspace mutexes (see <sys/futex.h>).
+ *
+ * A futex is any aligned 32-bit word in user memory. Waiters are keyed by
+ * the word's physical address, so processes that map the same frame at
+ * different addresses (shmat) share a futex. Waiters sleep on one of
+ * kHashBuckets wait queues selected by hashing the key; the key itself is
+ * recorded in Process::futex_key so wake() only takes matching waiters off
+ * a shared bucket.
+ *
+ * wait() uses the kSyscallRestart protocol: a woken process re-executes
+ * FUTEX_WAIT, sees Process::futex_woken and returns 0 without re-checking
+ * the word. A signal makes the restarted wait compare the word again.
+ */
+
+namespace Futex {
+
+// Number of hashed wait queues.
+static constexpr uint32_t kHashBuckets = 64;
+
+// If the word at `uaddr` in the current address space still holds
+// `expected`, park the caller on its bucket and return kSyscallRestart.
+// Returns 0 once woken, -EAGAIN if the word differs, -EINVAL if uaddr is not
+// 4-byte aligned, or -EFAULT if it is not mapped user-accessible.
+[[nodiscard]] int32_t wait(vaddr_t uaddr, uint32_t expected);
+
+// Wake up to `count` processes waiting on the word at `uaddr`, oldest first.
+// Returns the number woken, -EINVAL or -EFAULT.
+[[nodiscard]] int32_t wake(vaddr_t uaddr, uint32_t count);
+
+// Wait queue for the futex at physical address `key`. Exposed for tests.
+[[nodiscard]] WaitQueue& bucket(paddr_t key);
+
+}  // namespace Futex
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/segment.h>
+
+#include "smp.h"
+
+/*
+ * =======================================
+ *      Global Descriptor Table (GDT)
+ * =======================================
+ *
+ * A GDT entry is an 8-byte structure defining memory segments.
+ *
+ * Bit Layout:
+ * 63 56 | 55 52 | 51 48 | 47  40 | 39 32 | 31 16 | 15  0
+ * Base  | Flags | Limit | Access | Base  | Base  | Limit
+ * 31-24 | 3-0   | 19-16 | 7-0    | 23-16 | 15-0  | 15-0
+ *
+ * Base (63–56, 39–32, 41–16): 32-bit base address of the segment.
+ *
+ * Limit (51-48, 15–0): 20-bit value describing maximum addressable unit
+ * (scaled by page granularity).
+ *
+ * Access Byte (47-40):
+ *   - P (bit 47): Present bit (must be 1 for valid selectors)
+ *   - DPL (bits 46-45): Descriptor Privilege Level
+ *      00: Ring 0 (Kernel)
+ *      01: Ring 1
+ *      10: Ring 2
+ *      11: Ring 3 (User)
+ *   - S (bit 44): System Descriptor
+ *      0: System Segment (TSS, LDT)
+ *      1: Code or Data Segment
+ *   - E (bit 43): Executable bit
+ *      0: Data Segment
+ *      1: Code Segment
+ *   - DC (bit 42): Direction/Conforming
+ *      Data (E=0):
+ *        0: Segment grows up
+ *        1: Segment grows down
+ *      Code (E=1):
+ *        0: Can only be executed from ring set in DPL
+ *        1: Can be executed from rings ≥ DPL
+ *   - RW (bit 41): Read/Write
+ *      Data (E=0): Writable bit
+ *        0: Read-only
+ *        1: Read/write
+ *      Code (E=1): Readable bit
+ *        0: Execute-only
+ *        1: Execute/read
+ *   - A (bit 40): Accessed (set by CPU)
+ *
+ * Flags (55-52):
+ *   - G (bit 55): Granularity
+ *      0: Limit is in 1 byte blocks
+ *      1: Limit is in 4KiB blocks
+ *   - DB (bit 54): Size flag
+ *      0: 16-bit protected mode segment
+ *      1: 32-bit protected mode segment
+ *   - L (bit 53): Long-mode code flag
+ *      0: Protected mode or compatibility mode segment
+ *      1: 64-bit mode segment
+ *   - Reserved (bit 52): Must be 0
+ */
+namespace GDT {
+// Segment selectors (index * 8, plus RPL for user segments)
+static constexpr uint16_t KERNEL_CODE_SELECTOR = 0x08;  // index 1
+static constexpr uint16_t KERNEL_DATA_SELECTOR = 0x10;  // index 2
+static constexpr uint16_t USER_CODE_SELECTOR = __USER_CS;  // index 3 | RPL 3
+static constexpr uint16_t USER_DATA_SELECTOR = __USER_DS;  // index 4 | RPL 3
+static constexpr uint16_t TSS_SELECTOR = 0x28;          // index 5
+// TSS descriptors for CPUs 1.. follow the BSP's (index 6..).
+static constexpr uint16_t kApTssIndexBase = 6;
+// One user TLS data segment per CPU follows the TSSs. The scheduler points
+// the running thread's %gs at its CPU's entry and loads the thread's TLS
+// base into it on every switch (see set_tls()).
+static constexpr uint16_t kTlsIndexBase = kApTssIndexBase + Smp::kMaxCpus - 1;
+
+// SYSENTER/SYSEXIT derive every selector from IA32_SYSENTER_CS (the kernel
+// code selector), so the four flat segments must sit in this order.
+static_assert(KERNEL_DATA_SELECTOR == KERNEL_CODE_SELECTOR + 8, "SYSENTER SS = CS + 8");
+static_assert(USER_CODE_SELECTOR == ((KERNEL_CODE_SELECTOR + 16) | 3), "SYSEXIT CS = CS + 16");
+static_assert(USER_DATA_SELECTOR == ((KERNEL_CODE_SELECTOR + 24) | 3), "SYSEXIT SS = CS + 24");
+
+// Access byte values
+static constexpr uint8_t CODE_ACCESS = 0x9A;  // Present, DPL=0, Code, Readable
+static constexpr uint8_t DATA_ACCESS = 0x92;  // Present, DPL=0, Data, Writable
+// TSS: Present, DPL=0, S=0 (system), type=0x9 (32-bit TSS available)
+static constexpr uint8_t TSS_ACCESS = 0x89;
+// User: Present, DPL=3, S=1, Code/Data
+static constexpr uint8_t USER_CODE_ACCESS = 0xFA;  // Present, DPL=3, Code, Readable
+static constexpr uint8_t USER_DATA_ACCESS = 0xF2;  // Present, DPL=3, Data, Writable
+
+// Flags: 4KiB granularity, 32-bit protected mode
+static constexpr uint8_t FLAGS_4K_32BIT = 0xCF;
+
+// Maximum segment limit (20-bit, scaled by granularity)
+static constexpr uint32_t SEGMENT_LIMIT = 0xFFFFF;
+
+struct Entry {
+  uint16_t limit_low;
+  uint16_t base_low;
+  uint8_t base_mid;
+  uint8_t access;
+  uint8_t granularity;
+  uint8_t base_high;
+} __attribute__((packed));
+
+struct Descriptor {
+  uint16_t size;     // Size of GDT in bytes - 1: (8 * entry) - 1
+  uintptr_t offset;  // GDT linear address
+} __attribute__((packed));
+
+void init();
+bool is_initialized();
+
+// Load the GDT built by init() on the calling CPU and reload the segment
+// registers. Used by APs, whose GDTR still points at the trampoline's GDT.
+void load();
+
+// Selector of `cpu`'s TSS descriptor.
+[[nodiscard]] uint16_t tss_selector(uint32_t cpu);
+
+// User selector (RPL 3) of `cpu`'s TLS segment.
+[[nodiscard]] uint16_t tls_selector(uint32_t cpu);
+
+// True if `selector` names any CPU's TLS segment.
+[[nodiscard]] bool is_tls_selector(uint32_t selector);
+
+// Set the base of `cpu`'s TLS segment. The new base takes effect the next
+// time a segment register is loaded with tls_selector(cpu).
+void set_tls(uint32_t cpu, uint32_t base);
+}  // namespace GDT
@@ -0,0 +1,20 @@
+#ifndef _MATH_H
+#define _MATH_H
+
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+double fabs(double x);
+double sqrt(double x);
+double sin(double x);
+double cos(double x);
+double atan2(double y, double x);
+double floor(double x);
+double ceil(double x);
+double log(double x);
+double pow(double x, double y);
+
+__END_DECLS
+
+#endif /* _MATH_H */
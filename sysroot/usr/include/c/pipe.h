@@ -0,0 +1,47 @@
+#pragma once
+
+#include <span.h>
+#include <stdint.h>
+
+#include "ring_buffer.h"
+#include "wait_queue.h"
+
+static constexpr uint32_t kPipeBufferSize = 4096;
+
+struct Pipe {
+  RingBuffer<char, kPipeBufferSize> buffer;
+  uint32_t readers;  // number of open read-end FileDescriptions
+  uint32_t writers;  // number of open write-end FileDescriptions
+  WaitQueue read_waiters;   // readers parked on an empty buffer
+  WaitQueue write_waiters;  // writers parked on a full buffer
+
+  Pipe() : readers(0), writers(0), read_waiters{}, write_waiters{} {}
+};
+
+// Read up to buf.size() bytes from the pipe buffer into buf.
+// Returns bytes read, 0 for EOF (no writers), or kSyscallRestart after parking
+// the caller on read_waiters. Wakes blocked writers once space is freed.
+[[nodiscard]] int32_t pipe_read(Pipe* pipe, std::span<uint8_t> buf);
+
+// Write up to buf.size() bytes from buf into the pipe buffer.
+// Returns bytes written, -1 for broken pipe (no readers), or kSyscallRestart
+// after parking the caller on write_waiters. Wakes blocked readers on success.
+[[nodiscard]] int32_t pipe_write(Pipe* pipe, std::span<const uint8_t> buf);
+
+// Readiness of the read end: POLLIN if data is buffered, POLLHUP once there
+// are no writers left.
+[[nodiscard]] uint32_t pipe_poll_read(const Pipe* pipe);
+
+// Readiness of the write end: POLLOUT if there is buffer space, POLLERR
+// once there are no readers left.
+[[nodiscard]] uint32_t pipe_poll_write(const Pipe* pipe);
+
+// Called when a read-end FileDescription is freed. Decrements readers, wakes
+// blocked writers so they observe a broken pipe, and frees the Pipe if both
+// readers and writers are zero.
+void pipe_close_read(Pipe* pipe);
+
+// Called when a write-end FileDescription is freed. Decrements writers, wakes
+// blocked readers so they observe EOF, and frees the Pipe if both readers
+// and writers are zero.
+void pipe_close_write(Pipe* pipe);
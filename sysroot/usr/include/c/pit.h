@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * 8253/8254 Programmable Interval Timer (PIT) driver.
+ *
+ * Runs PIT channel 0 in one-shot mode (mode 0, interrupt on terminal count).
+ * Each countdown is programmed for the next deadline the kernel cares about,
+ * so IRQ 0 fires exactly when a sleeper is due or a time slice ends rather
+ * than at a fixed rate. The input clock is 1.193182 MHz (~838 ns per cycle);
+ * a single countdown is at most 0xFFFE cycles (~55 ms).
+ *
+ * Time is tracked as the running sum of completed countdowns plus the
+ * progress of the current one (read by latching the counter), giving a
+ * monotonic clock with sub-microsecond resolution.
+ *
+ * Until something calls set_deadline(), every expiry re-arms a countdown to
+ * the next kTickNs boundary, so code that hlt-waits on get_ticks() keeps
+ * working before the scheduler takes over (early boot, ktests).
+ */
+
+namespace PIT {
+
+// Nominal tick length used for get_ticks() and the default countdown (10 ms).
+static constexpr uint64_t kTickNs = 10'000'000;
+
+// Deadline value meaning "no event pending": arms the longest countdown the
+// hardware supports, which is only needed to keep the clock running.
+static constexpr uint64_t kNoDeadline = UINT64_MAX;
+
+// Program channel 0 for the first countdown.
+// Does not install an IRQ handler; see Scheduler::init().
+void init();
+
+// Account for an expired countdown, arm a default countdown to the next
+// kTickNs boundary, and refresh the shared time page (Vdso::update()).
+// Called from timer_entry.S dispatch.
+void tick();
+
+// Nanoseconds since init(). Monotonic.
+uint64_t now_ns();
+
+// Return now_ns() in units of kTickNs.
+uint64_t get_ticks();
+
+// Fire IRQ 0 at deadline_ns (absolute, in now_ns() time). Deadlines in the
+// past fire almost immediately; deadlines beyond the hardware range are
+// clamped and the caller re-arms from the resulting interrupt.
+void set_deadline(uint64_t deadline_ns);
+
+// Sleep for approximately n ticks.
+// Requires interrupts to be enabled.
+void sleep_ticks(uint64_t n);
+
+// Sleep for approximately the specified number of milliseconds.
+// Requires interrupts to be enabled.
+void sleep_ms(uint32_t ms);
+}  // namespace PIT
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "file.h"
+#include "fpu.h"
+#include "paging.h"
+#include "shm.h"
+#include "timer.h"
+#include "wait_queue.h"
+
+namespace Ring {
+struct State;
+}  // namespace Ring
+
+struct VfsNode;
+
+/*
+ * Trap frame: full register state saved on the kernel stack when a process
+ * is interrupted (by a hardware IRQ or int 0x80 syscall). The layout matches
+ * the push order in timer_entry.S and syscall_entry.S:
+ *
+ *   [low addr]  pushal regs → segment regs → CPU-pushed iret frame  [high addr]
+ *
+ * Fields are ordered from LOW address (ESP after all pushes) to HIGH address,
+ * which is the reverse of the push order.
+ */
+struct TrapFrame {
+  // Pushed last by pushal (EDI at lowest address, EAX at highest).
+  uint32_t edi, esi, ebp, esp_dummy, ebx, edx, ecx, eax;
+  // Pushed before pushal: ds pushed last (lowest), gs pushed first (highest).
+  uint32_t ds, es, fs, gs;
+  // Pushed by CPU on privilege-level change (EIP lowest, SS highest).
+  uint32_t eip, cs, eflags, user_esp, user_ss;
+} __attribute__((packed));
+
+static_assert(sizeof(TrapFrame) == 17 * 4, "TrapFrame must be 17 dwords (68 bytes)");
+static_assert(offsetof(TrapFrame, edi) == 0, "edi at offset 0");
+static_assert(offsetof(TrapFrame, eax) == 28, "eax at offset 28");
+static_assert(offsetof(TrapFrame, ds) == 32, "ds at offset 32");
+static_assert(offsetof(TrapFrame, eip) == 48, "eip at offset 48");
+static_assert(offsetof(TrapFrame, user_ss) == 64, "user_ss at offset 64");
+
+// Process states for the scheduler.
+enum class ProcessState : uint8_t {
+  Empty = 0,  // slot is unused or has been reaped
+  Ready,
+  Running,
+  Blocked,
+  Zombie,
+};
+
+// Length of Process::name, including the terminator.
+static constexpr uint32_t kProcessNameLen = 16;
+
+// Per-process kernel stack size (4 pages = 16 KiB).
+static constexpr uint32_t kKernelStackSize = 16384;
+
+// User-space stack layout for newly created processes.
+static constexpr vaddr_t kUserStackVA = 0x00BFC000;
+static constexpr uint32_t kUserStackPages = 4;
+static constexpr vaddr_t kUserStackTop = kUserStackVA + kUserStackPages * PAGE_SIZE;
+
+// Signal handler disposition: 0 = SIG_DFL, 1 = SIG_IGN, else user-space VA.
+static constexpr uint32_t kSigDfl = 0;
+static constexpr uint32_t kSigIgn = 1;
+
+/*
+ * Signal frame pushed onto the user stack when a user-installed signal handler
+ * is invoked. Layout (from low to high user-space address):
+ *
+ *   [trampoline: 7 bytes]   -- mov $SYS_SIGRETURN,%eax; int $0x80
+ *   [SignalFrame]
+ *     return_addr           -- points to start of trampoline above
+ *     signum                -- first argument to handler (C cdecl)
+ *     saved_eax .. saved_esp  -- register state to restore on sigreturn
+ *
+ * After the handler executes ret, execution jumps to the trampoline which
+ * issues sys_sigreturn to restore the saved context.
+ */
+struct SignalFrame {
+  uint32_t return_addr;  // points to inline trampoline (7 bytes below this frame)
+  uint32_t signum;       // argument to handler
+  // Saved user context:
+  uint32_t saved_eax;
+  uint32_t saved_ecx;
+  uint32_t saved_edx;
+  uint32_t saved_eip;
+  uint32_t saved_eflags;
+  uint32_t saved_esp;
+} __attribute__((packed));
+
+/*
+ * Process Control Block (PCB).
+ *
+ * Each process has its own kernel stack, address space (page directory),
+ * and saved register state. Kernel threads have a kernel stack only and
+ * run on boot_page_directory. The scheduler maintains intrusive linked lists
+ * of processes via the `next` pointer.
+ *
+ * A user thread created by clone() is a Process of its own (own pid, kernel
+ * stack, registers, FPU state, pending signals and TLS) whose page_directory
+ * is its group leader's. Everything else the threads share is only read
+ * and written through group(); the copies in a non-leader stay unused.
+ */
+struct Process {
+  uint32_t pid;
+  ProcessState state;
+  char name[kProcessNameLen];                 // command name (argv[0] basename), for schedstat
+  uint32_t cpu;                               // CPU the process last ran on
+  uint32_t kernel_esp;                        // saved kernel stack pointer (into kernel_stack)
+  paddr_t page_directory_phys;                // CR3 value for this process
+  PageTable* page_directory;                  // virtual pointer to page directory
+  uint8_t* kernel_stack;                      // base of allocated kernel stack (for cleanup)
+  vaddr_t heap_break;                         // current program break for sbrk
+  Timer sleep_timer;                          // wakes the process from sleep_current()
+  WaitQueue* wait_queue;                      // queue this process sleeps on (nullptr if none)
+  paddr_t futex_key;                          // physical address waited on in Futex::wait()
+  bool futex_woken;                           // set by Futex::wake(), consumed by the retry
+  uint64_t poll_deadline_ns;                  // timeout of the poll() in progress, 0 if none
+  WaitQueue child_exit_waiters;               // waitpid callers parked until a child exits
+  int32_t exit_code;                          // exit code stored when process becomes zombie
+  FdTable fds;                                // file descriptor table (file.h)
+  std::array<ShmMapping, kMaxShmMappings> shm_mappings;  // shared memory attachments
+  uint32_t shm_mapping_count;                            // number of active shm mappings
+  Ring::State* ring;                                     // syscall ring (ring.h), or nullptr
+  // Kernel threads (Scheduler::kthread_create):
+  bool kernel_thread;             // ring-0 thread on boot_page_directory
+  void (*kthread_fn)(void* arg);  // entry point, called once with kthread_arg
+  void* kthread_arg;              // argument passed to kthread_fn
+  // Threads (Scheduler::clone_current):
+  Process* group_leader;  // initial thread, which owns the shared state (nullptr on itself)
+  uint32_t thread_count;  // on a leader: live clone()d threads, not counting itself
+  bool group_exiting;     // on a leader: exit() or a fatal signal is ending every thread
+  vaddr_t clear_tid;      // user word zeroed and FUTEX_WAKEd when this thread exits
+  vaddr_t tls_base;       // base of the %gs TLS segment (GDT::set_tls), 0 if unused
+  // FPU state (see fpu.h):
+  Fpu::State fpu_state;  // FXSAVE image, valid if fpu_saved
+  bool fpu_saved;        // false until the first save: start from a clean FPU
+  // Scheduler statistics (see Scheduler::get_stats()):
+  uint64_t user_ns;               // time spent in user mode
+  uint64_t system_ns;             // time spent in the kernel on its behalf
+  uint64_t wait_ns;               // time spent Ready, waiting for a CPU
+  uint64_t ready_since_ns;        // when it last entered a run queue
+  uint32_t voluntary_switches;    // switched away while Blocked or Zombie
+  uint32_t involuntary_switches;  // switched away while still runnable
+  // Signal state:
+  uint32_t pending_signals;      // bitmask: bit N set means signal N is pending
+  uint32_t signal_handlers[32];  // per-signal handler: kSigDfl / kSigIgn / user VA
+  VfsNode* cwd;                  // current working directory, referenced; nullptr for the root
+  uint32_t uid;                  // user id (0 = root)
+  uint32_t gid;                  // group id (0 = root)
+  Process* next;                 // intrusive list pointer (ready/blocked queues)
+  // Process table links (see process_table.h):
+  Process* parent;        // nullptr for root processes and orphans
+  Process* first_child;   // most recently created child
+  Process* next_sibling;  // next child of the same parent
+  Process* hash_next;     // pid hash chain
+  Process* table_next;    // live process list, or free list once freed
+  Process* table_prev;    // live process list
+
+  // The thread that owns what a thread group shares: address space, heap
+  // break, fd table, shared memory, signal handlers, cwd, credentials and
+  // children. A process's initial thread is its own leader.
+  [[nodiscard]] Process* group() { return group_leader != nullptr ? group_leader : this; }
+  [[nodiscard]] const Process* group() const {
+    return group_leader != nullptr ? group_leader : this;
+  }
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array.h>
+#include <stdint.h>
+#include <sys/ring.h>
+
+struct Process;
+
+/*
+ * Syscall rings (see <sys/ring.h>).
+ *
+ * The ring itself lives in user memory; the kernel keeps only a pointer to
+ * it and the calls that returned kSyscallRestart ("parked" calls), which
+ * enter() retries before taking new submissions. A parked call still owns
+ * a CQ slot: submissions are only taken while unread completions plus
+ * parked calls leave room in the CQ.
+ *
+ * The calls themselves are run by a callback, so this module knows nothing
+ * about the syscall table; SYS_RING_ENTER passes one that only accepts the
+ * calls <sys/ring.h> lists.
+ */
+
+namespace Ring {
+
+// Calls that may be parked at once. A full park stops new submissions.
+static constexpr uint32_t kMaxParked = 16;
+
+// Per-process (thread group leader) ring registration.
+struct State {
+  ring* shared;        // the user's ring header, in the owner's address space
+  uint32_t mask;       // entries - 1
+  uint32_t parked;     // valid entries of `calls`
+  uint32_t submitted;  // SQEs taken by the enter() in progress, kept across restarts
+  std::array<ring_sqe, kMaxParked> calls;
+};
+
+// Run one submission in the current process and return its result, or
+// kSyscallRestart (after Scheduler::wait_on()) if it would block.
+using CallFn = int32_t (*)(const ring_sqe& sqe);
+
+// Register `shared` (entries slots, already checked to be RING_SIZE(entries)
+// bytes of writable memory) as `proc`'s ring, replacing any previous one,
+// and reset both queues. Returns 0, -EINVAL or -ENOMEM.
+[[nodiscard]] int32_t setup(Process* proc, ring* shared, uint32_t entries);
+
+// Drop `proc`'s ring and its parked calls. Safe if it has none.
+void release(Process* proc);
+
+// SYS_RING_ENTER for `proc`, the current thread group leader. Retries
+// parked calls, then runs up to `to_submit` new submissions through `call`.
+// If fewer than `min_complete` completions are unread and a call is parked,
+// parks the caller until any parked call may be ready and returns
+// kSyscallRestart; the restarted enter() takes only the rest of `to_submit`.
+// Returns the number of unread completions, or -ENXIO with no ring.
+[[nodiscard]] int32_t enter(Process* proc, uint32_t to_submit, uint32_t min_complete, CallFn call);
+
+}  // namespace Ring
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+#include "paging.h"
+
+/*
+ * Symmetric multiprocessing support.
+ *
+ * Application processors (APs) are discovered through the Intel MP
+ * floating pointer structure and started with the INIT-SIPI-SIPI sequence.
+ * Each AP runs a 16-bit trampoline (ap_trampoline.S) copied to
+ * kTrampolinePhys, which switches to protected mode, enables paging on
+ * boot_page_directory and jumps to ap_main() on a kmalloc'd stack.
+ *
+ * Every CPU has its own TSS, idle process and run queue (see scheduler.cpp).
+ * CPUs are numbered 0..cpu_count()-1 in boot order; CPU 0 is the BSP.
+ *
+ * Kernel entry is serialised by a big kernel lock taken on every trap
+ * entry (trap_entry.S, IRQWrapper) and released after the stack switch on
+ * the way out, so the rest of the kernel runs as if on a uniprocessor.
+ * TLB shootdown IPIs are the one exception: they are handled without the
+ * lock, and a CPU spinning for the lock services them so a lock holder
+ * waiting for acknowledgements cannot deadlock.
+ */
+
+namespace Smp {
+
+// Maximum number of CPUs brought online.
+static constexpr uint32_t kMaxCpus = 8;
+
+// Physical page the AP trampoline is copied to (SIPI vector 0x08). Lies in
+// the low 1 MiB, which the PMM never hands out.
+static constexpr uint32_t kTrampolinePhys = 0x8000;
+
+// Passed to tlb_shootdown() to flush the whole TLB instead of one page.
+static constexpr uint32_t kFlushAll = UINT32_MAX;
+
+// Enable the BSP's local APIC, install the IPI vectors, and start every AP
+// listed in the MP table. Returns once each AP is online or has timed out.
+// Falls back to a single CPU if there is no APIC or MP table.
+// Must be called after Scheduler::init(), with interrupts enabled.
+void init();
+
+// Index (0-based, boot order) of the calling CPU. 0 before init().
+[[nodiscard]] uint32_t current_cpu();
+
+// Number of CPUs online (1 before init()).
+[[nodiscard]] uint32_t cpu_count();
+
+// Send a reschedule IPI to `cpu`. No-op for the calling CPU.
+void send_reschedule(uint32_t cpu);
+
+// Invalidate `virt` (or everything, for kFlushAll) in every other online
+// CPU's TLB and wait until they have all done so. The caller flushes its
+// own TLB. Must be called with the big kernel lock held.
+void tlb_shootdown(vaddr_t virt);
+
+}  // namespace Smp
+
+__BEGIN_DECLS
+
+// Acquire / release the big kernel lock. Recursive on the owning CPU.
+// Called from the trap entry stubs; interrupts must be disabled.
+void kernel_lock();
+void kernel_unlock();
+
+__END_DECLS
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lock_stats.h"
+
+/*
+ * Ticket spinlock.
+ *
+ * Waiters take a ticket and spin until it is served, so the lock is handed
+ * out in FIFO order and no CPU can starve. lock() disables interrupts on
+ * the calling CPU for the duration of the hold and unlock() restores the
+ * previous state, so a SpinLock may also be taken from IRQ handlers.
+ *
+ * Holds must be short and must not sleep: a holder that returned
+ * kSyscallRestart would keep every other CPU spinning until it ran again.
+ */
+class SpinLock {
+ public:
+  constexpr explicit SpinLock(const char* name) : stats_(name) {}
+
+  SpinLock(const SpinLock&) = delete;
+  SpinLock& operator=(const SpinLock&) = delete;
+
+  // Disable interrupts and spin until the lock is held.
+  void lock();
+
+  // Acquire only if free. Returns false (interrupts unchanged) otherwise.
+  [[nodiscard]] bool try_lock();
+
+  // Release the lock and restore the interrupt state saved by lock().
+  void unlock();
+
+  [[nodiscard]] bool is_locked() const;
+  [[nodiscard]] const LockStats& stats() const { return stats_; }
+
+ private:
+  uint32_t next_ticket_ = 0;
+  uint32_t now_serving_ = 0;
+  uint32_t saved_eflags_ = 0;  // holder's EFLAGS before lock()
+  uint64_t acquired_at_ = 0;   // TSC at acquisition
+  LockStats stats_;
+};
+
+// Holds a lock for the lifetime of the guard.
+template <typename Lock>
+class LockGuard {
+ public:
+  explicit LockGuard(Lock& lock) : lock_(lock) { lock_.lock(); }
+  ~LockGuard() { lock_.unlock(); }
+
+  LockGuard(const LockGuard&) = delete;
+  LockGuard& operator=(const LockGuard&) = delete;
+
+ private:
+  Lock& lock_;
+};
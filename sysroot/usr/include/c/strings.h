@@ -0,0 +1,14 @@
+#ifndef _STRINGS_H
+#define _STRINGS_H
+
+#include <stddef.h>
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+int strcasecmp(const char* s1, const char* s2);
+int strncasecmp(const char* s1, const char* s2, size_t n);
+
+__END_DECLS
+
+#endif /* _STRINGS_H */
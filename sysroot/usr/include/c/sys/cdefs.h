@@ -0,0 +1,12 @@
+#ifndef _SYS_CDEFS_H
+#define _SYS_CDEFS_H
+
+#if defined(__cplusplus)
+#define __BEGIN_DECLS extern "C" {
+#define __END_DECLS }
+#else
+#define __BEGIN_DECLS
+#define __END_DECLS
+#endif
+
+#endif
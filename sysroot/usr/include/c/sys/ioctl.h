@@ -0,0 +1,19 @@
+#ifndef _SYS_IOCTL_H
+#define _SYS_IOCTL_H
+
+#include <stdint.h>
+
+struct winsize {
+  uint16_t ws_row;
+  uint16_t ws_col;
+  uint16_t ws_xpixel;
+  uint16_t ws_ypixel;
+};
+
+#define TIOCGWINSZ 0x5413
+#define TCGETS 0x5401
+#define TCSETS 0x5402
+
+int ioctl(int fd, unsigned long request, ...);
+
+#endif
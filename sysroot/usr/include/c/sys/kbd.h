@@ -0,0 +1,102 @@
+#ifndef _SYS_KBD_H
+#define _SYS_KBD_H
+
+#include <stdint.h>
+
+/* Key codes -- match Key::Value in kernel/include/keyboard.h */
+enum kbd_key {
+  KEY_UNKNOWN = 0,
+  KEY_A = 1,
+  KEY_B,
+  KEY_C,
+  KEY_D,
+  KEY_E,
+  KEY_F,
+  KEY_G,
+  KEY_H,
+  KEY_I,
+  KEY_J,
+  KEY_K,
+  KEY_L,
+  KEY_M,
+  KEY_N,
+  KEY_O,
+  KEY_P,
+  KEY_Q,
+  KEY_R,
+  KEY_S,
+  KEY_T,
+  KEY_U,
+  KEY_V,
+  KEY_W,
+  KEY_X,
+  KEY_Y,
+  KEY_Z,
+  KEY_0 = 27,
+  KEY_1,
+  KEY_2,
+  KEY_3,
+  KEY_4,
+  KEY_5,
+  KEY_6,
+  KEY_7,
+  KEY_8,
+  KEY_9,
+  KEY_SPACE = 37,
+  KEY_ENTER,
+  KEY_BACKSPACE,
+  KEY_TAB,
+  KEY_ESC,
+  KEY_MINUS,
+  KEY_EQUALS,
+  KEY_LBRACKET,
+  KEY_RBRACKET,
+  KEY_BACKSLASH,
+  KEY_SEMICOLON,
+  KEY_APOSTROPHE,
+  KEY_GRAVE,
+  KEY_COMMA,
+  KEY_PERIOD,
+  KEY_SLASH,
+  KEY_LSHIFT,
+  KEY_RSHIFT,
+  KEY_LCTRL,
+  KEY_RCTRL,
+  KEY_LALT,
+  KEY_RALT,
+  KEY_CAPSLOCK,
+  KEY_F1 = 60,
+  KEY_F2,
+  KEY_F3,
+  KEY_F4,
+  KEY_F5,
+  KEY_F6,
+  KEY_F7,
+  KEY_F8,
+  KEY_F9,
+  KEY_F10,
+  KEY_F11,
+  KEY_F12,
+  KEY_INSERT = 72,
+  KEY_DELETE,
+  KEY_HOME,
+  KEY_END,
+  KEY_PAGEUP,
+  KEY_PAGEDOWN,
+  KEY_UP,
+  KEY_DOWN,
+  KEY_LEFT,
+  KEY_RIGHT,
+};
+
+/*
+ * Keyboard event returned by reading /dev/kbd.
+ * read blocks until an event is pending; with O_NONBLOCK it fails with
+ * EAGAIN instead.
+ */
+struct kbd_event {
+  uint8_t key;     /* enum kbd_key value */
+  uint8_t pressed; /* 1 = press, 0 = release */
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef _SYS_MOUNT_H
+#define _SYS_MOUNT_H
+
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+int mount(const char* target, const char* fstype);
+int umount(const char* target);
+
+__END_DECLS
+
+#endif /* _SYS_MOUNT_H */
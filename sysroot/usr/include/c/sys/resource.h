@@ -0,0 +1,32 @@
+#ifndef _SYS_RESOURCE_H
+#define _SYS_RESOURCE_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * Per-process resource limits. Only RLIMIT_NOFILE is implemented: fds at
+ * or above rlim_cur are never handed out. rlim_cur can be raised up to
+ * rlim_max; only root can raise rlim_max, and never past the kernel's
+ * ceiling of 1024.
+ */
+
+typedef uint32_t rlim_t;
+
+#define RLIM_INFINITY ((rlim_t)-1)
+
+#define RLIMIT_NOFILE 7 /* one more than the highest fd that may be opened */
+
+struct rlimit {
+  rlim_t rlim_cur; /* soft limit, enforced */
+  rlim_t rlim_max; /* hard limit, ceiling for rlim_cur */
+};
+
+__BEGIN_DECLS
+
+int getrlimit(int resource, struct rlimit* rlim);
+int setrlimit(int resource, const struct rlimit* rlim);
+
+__END_DECLS
+
+#endif /* _SYS_RESOURCE_H */
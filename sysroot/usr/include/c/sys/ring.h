@@ -0,0 +1,84 @@
+#ifndef _SYS_RING_H
+#define _SYS_RING_H
+
+#include <stdint.h>
+#include <sys/cdefs.h>
+
+/*
+ * Syscall rings: batch many system calls into one kernel entry.
+ *
+ * A ring is a block of the process's own memory holding a submission
+ * queue (SQ) and a completion queue (CQ) of `entries` slots each. The
+ * program fills submission entries and advances sq_tail; ring_enter()
+ * then runs them in order, advancing sq_head, and posts one completion
+ * per submission at cq_tail, carrying the submission's user_data and what
+ * the system call would have returned (negative errno on failure). The
+ * program consumes completions by advancing cq_head.
+ *
+ * A submission names a system call and up to three arguments exactly as
+ * they would be passed in ebx, ecx and edx. Only calls that act on files
+ * are accepted (read, write, readv, writev, open, close, lseek, stat,
+ * fstat, getdents, mkdir, unlink, rename); anything else completes with
+ * -EINVAL.
+ *
+ * A call that would block (a read from an empty pipe, say) does not hold
+ * up the rest of the batch: it is parked in the kernel and completes
+ * during a later ring_enter(). Completions can therefore arrive out of
+ * submission order. The kernel never takes a submission it could not post
+ * a completion for, so the CQ cannot overflow.
+ *
+ * Each process has at most one ring; it is not inherited across fork()
+ * and is dropped by exec().
+ */
+
+#define RING_MAX_ENTRIES 256 /* entries must be a power of two up to this */
+
+struct ring_sqe {
+  uint32_t nr;        /* SYS_* number */
+  uint32_t args[3];   /* ebx, ecx, edx */
+  uint32_t user_data; /* copied to the completion */
+};
+
+struct ring_cqe {
+  uint32_t user_data;
+  int32_t res; /* the call's return value */
+};
+
+struct ring {
+  volatile uint32_t sq_head; /* next submission the kernel takes */
+  volatile uint32_t sq_tail; /* one past the last submission queued */
+  volatile uint32_t cq_head; /* next completion the program reads */
+  volatile uint32_t cq_tail; /* one past the last completion posted */
+  uint32_t entries;          /* slots in each queue, set by ring_setup() */
+  uint32_t reserved[3];
+  /* Followed by struct ring_sqe[entries], then struct ring_cqe[entries]. */
+};
+
+/* Bytes of memory a ring with `entries` slots needs. */
+#define RING_SIZE(entries) \
+  (sizeof(struct ring) + (entries) * (sizeof(struct ring_sqe) + sizeof(struct ring_cqe)))
+
+/* Slot arrays of ring `r`. Indices are taken modulo r->entries. */
+static inline struct ring_sqe* ring_sqes(struct ring* r) { return (struct ring_sqe*)(r + 1); }
+static inline struct ring_cqe* ring_cqes(struct ring* r) {
+  return (struct ring_cqe*)(ring_sqes(r) + r->entries);
+}
+
+__BEGIN_DECLS
+
+// Register the RING_SIZE(entries) bytes at r as the calling process's
+// ring, replacing any previous one, with empty queues. A NULL r
+// unregisters the ring and drops parked calls. Returns 0, or -1 with
+// errno EINVAL (bad entries or misaligned r) or EFAULT.
+int ring_setup(struct ring* r, unsigned int entries);
+
+// Retry parked calls, then run up to to_submit queued submissions. If
+// fewer than min_complete completions are then unread and some call is
+// parked, sleep until it can make progress and try again. Returns the
+// number of unread completions, or -1 with errno ENXIO if no ring is set
+// up.
+int ring_enter(unsigned int to_submit, unsigned int min_complete);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef _SYS_SEGMENT_H
+#define _SYS_SEGMENT_H
+
+/*
+ * Flat user segment selectors (GDT index << 3 | RPL 3), as laid out by the
+ * kernel's GDT (kernel/include/gdt.h). A thread without TLS runs with %gs
+ * set to __USER_DS.
+ */
+
+#define __USER_CS 0x1B
+#define __USER_DS 0x23
+
+#endif /* _SYS_SEGMENT_H */
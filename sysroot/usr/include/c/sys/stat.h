@@ -0,0 +1,42 @@
+#ifndef _SYS_STAT_H
+#define _SYS_STAT_H
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+
+#define S_IFMT 0170000
+#define S_IFREG 0100000
+#define S_IFDIR 0040000
+#define S_IFCHR 0020000
+
+#define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
+#define S_ISDIR(m) (((m) & S_IFMT) == S_IFDIR)
+#define S_ISCHR(m) (((m) & S_IFMT) == S_IFCHR)
+
+struct stat {
+  dev_t st_dev;
+  ino_t st_ino;
+  mode_t st_mode;
+  nlink_t st_nlink;
+  uid_t st_uid;
+  gid_t st_gid;
+  dev_t st_rdev;
+  off_t st_size;
+  blksize_t st_blksize;
+  blkcnt_t st_blocks;
+};
+
+__BEGIN_DECLS
+
+int stat(const char* path, struct stat* buf);
+int fstat(int fd, struct stat* buf);
+int mkdir(const char* path, mode_t mode);
+
+/* Relative paths are resolved from the directory open on dirfd, or from
+ * the working directory for AT_FDCWD. fstatat() takes no flags yet. */
+int fstatat(int dirfd, const char* path, struct stat* buf, int flags);
+int mkdirat(int dirfd, const char* path, mode_t mode);
+
+__END_DECLS
+
+#endif /* _SYS_STAT_H */
@@ -0,0 +1,99 @@
+#ifndef _SYS_SYSCALL_H
+#define _SYS_SYSCALL_H
+
+/*
+ * System call numbers shared between kernel and userspace.
+ *
+ * These values are indices into the kernel's syscall dispatch table.
+ * Keep in sync with the handlers in kernel/cpu/syscall.cpp.
+ */
+
+#define SYS_EXIT 0           /* Linux:  1 */
+#define SYS_FORK 1           /* Linux:  2 */
+#define SYS_READ 2           /* Linux:  3 */
+#define SYS_WRITE 3          /* Linux:  4 */
+#define SYS_OPEN 4           /* Linux:  5 */
+#define SYS_CLOSE 5          /* Linux:  6 */
+#define SYS_WAITPID 6        /* Linux:  7 */
+#define SYS_EXEC 7           /* Linux: 11 (execve) */
+#define SYS_LSEEK 8          /* Linux: 19 */
+#define SYS_GETPID 9         /* Linux: 20 */
+#define SYS_PIPE 10          /* Linux: 42 */
+#define SYS_SBRK 11          /* Linux: 45 (brk) */
+#define SYS_DUP2 12          /* Linux: 63 */
+#define SYS_CLOCK_GETTIME 13 /* Linux: 265 */
+#define SYS_SLEEP 14         /* custom */
+#define SYS_SHMGET 15        /* custom */
+#define SYS_SHMAT 16         /* custom */
+#define SYS_SHMDT 17         /* custom */
+#define SYS_FB_FLIP 18       /* custom */
+#define SYS_KILL 19          /* custom */
+#define SYS_SIGACTION 20     /* custom */
+#define SYS_SIGRETURN 21     /* custom */
+#define SYS_CHDIR 22         /* custom */
+#define SYS_GETCWD 23        /* custom */
+#define SYS_GETDENTS 24      /* custom */
+#define SYS_IOCTL 25         /* custom */
+#define SYS_STAT 26          /* custom */
+#define SYS_FSTAT 27         /* custom */
+#define SYS_MKDIR 28         /* custom */
+#define SYS_UNLINK 29        /* custom */
+#define SYS_RENAME 30        /* custom */
+#define SYS_FCNTL 31         /* custom */
+#define SYS_MOUNT 32         /* custom */
+#define SYS_UMOUNT 33        /* custom */
+#define SYS_NANOSLEEP 34     /* Linux: 162 */
+#define SYS_SCHEDSTAT 35     /* custom */
+#define SYS_FUTEX 36         /* Linux: 240 */
+#define SYS_CLONE 37         /* Linux: 120 */
+#define SYS_EXIT_THREAD 38   /* Linux:   1 (exit) */
+#define SYS_RING_SETUP 39    /* Linux: 425 (io_uring_setup) */
+#define SYS_RING_ENTER 40    /* Linux: 426 (io_uring_enter) */
+#define SYS_READV 41         /* Linux: 145 */
+#define SYS_WRITEV 42        /* Linux: 146 */
+#define SYS_PREAD 43         /* Linux: 180 (pread64) */
+#define SYS_PWRITE 44        /* Linux: 181 (pwrite64) */
+#define SYS_POLL 45          /* Linux: 168 */
+#define SYS_TRACE 46         /* custom */
+#define SYS_OPENAT 47        /* Linux: 295 */
+#define SYS_MKDIRAT 48       /* Linux: 296 */
+#define SYS_FSTATAT 49       /* Linux: 300 (fstatat64) */
+#define SYS_UNLINKAT 50      /* Linux: 301 */
+#define SYS_GETRLIMIT 51     /* Linux: 76 */
+#define SYS_SETRLIMIT 52     /* Linux: 75 */
+#define SYS_FSYNC 53         /* Linux: 118 */
+#define SYS_MAX 54
+
+#include <stdint.h>
+
+// Translates a raw kernel return value to the POSIX convention:
+// returns r on success (r >= 0), sets errno and returns -1 on failure (r < 0).
+// In libk (kernel) context no errno is available, so the raw value is returned.
+#ifdef __is_libc
+#include <errno.h>
+static inline int32_t __syscall_ret(int32_t r) {
+  if (r < 0) {
+    errno = -r;
+    return -1;
+  }
+  return r;
+}
+#else
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+static inline int32_t __syscall_ret(int32_t r) { return r; }
+#endif
+
+// Instruction the wrappers use to enter the kernel. In libc it calls
+// through __syscall_entry: eax = number, ebx/ecx/edx = arguments, result in
+// eax, every other register preserved, exactly like int $0x80. It points
+// at an int $0x80 stub until __syscall_init() (called from crt0) switches
+// it to the sysenter stub on CPUs that support it.
+#ifdef __is_libc
+extern void (*__syscall_entry)(void);
+void __syscall_init(void);
+#define __SYSCALL "call *__syscall_entry"
+#else
+#define __SYSCALL "int $0x80"
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Kernel timers: one-shot callbacks keyed by an absolute PIT::now_ns()
+ * deadline.
+ *
+ * Pending timers live in a pairing heap ordered by deadline. The heap links
+ * are embedded in each Timer, so there is no limit on how many can be
+ * pending and arming one never fails. Finding the next deadline and adding
+ * a timer are O(1); firing or cancelling one is O(log n) amortised.
+ *
+ * Timers are intrusive: the caller owns the storage (typically embedded in
+ * a longer-lived object such as Process) and it must stay valid while the
+ * timer is pending. A zero-initialised Timer is idle.
+ *
+ * Expired timers are run by the scheduler via run_timers(), with interrupts
+ * disabled. Callbacks may re-add their own timer or add/cancel others.
+ */
+
+using TimerCallback = void (*)(void* arg);
+
+struct Timer {
+  uint64_t deadline_ns;    // absolute PIT::now_ns() time at which to fire
+  TimerCallback callback;  // invoked once when the deadline passes
+  void* arg;               // passed to callback
+  bool pending;            // in the heap, waiting to fire
+  Timer* child;            // first child in the heap
+  Timer* sibling;          // next sibling
+  Timer* prev;             // previous sibling, or the parent for a first child
+};
+
+// Returns true if t is waiting to fire.
+[[nodiscard]] inline bool timer_pending(const Timer* t) { return t->pending; }
+
+// Arm t to call callback(arg) at deadline_ns. If t is already pending it is
+// moved to the new deadline.
+void add_timer(Timer* t, uint64_t deadline_ns, TimerCallback callback, void* arg);
+
+// Disarm t. Returns true if it was pending, false if it had already fired
+// or was never added.
+bool cancel_timer(Timer* t);
+
+// Fire every timer whose deadline is at or before now_ns, earliest first.
+void run_timers(uint64_t now_ns);
+
+// Deadline of the earliest pending timer, or PIT::kNoDeadline if none.
+[[nodiscard]] uint64_t next_timer_deadline();
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <span.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/trace.h>
+
+struct Process;
+
+/*
+ * Syscall tracing (see <sys/trace.h>).
+ *
+ * Compiled in unconditionally: while no trace is running, syscall_dispatch
+ * pays for one load and one not-taken branch on `enabled`. Events go to a
+ * fixed ring buffer that the reader drains; when it is full new events are
+ * dropped rather than overwriting unread ones, so a reader always sees a
+ * prefix of what happened plus a count of what it missed. Histograms are
+ * kept per syscall number and are not affected by drops.
+ *
+ * All state is protected by the big kernel lock.
+ */
+
+namespace Trace {
+
+// Events the buffer holds before it starts dropping.
+static constexpr size_t kCapacity = 256;
+
+// True while a trace is running.
+extern bool enabled;
+
+// Start a trace of `pid` (a thread group leader's pid, or TRACE_ALL),
+// discarding all buffered events and statistics.
+void start(uint32_t pid);
+
+// Stop tracing. Buffered events and statistics are kept.
+void stop();
+
+// True if syscalls made by proc should be recorded.
+[[nodiscard]] bool traces(const Process* proc);
+
+// Append one finished syscall and add it to the histogram for nr.
+void record(uint32_t pid, uint32_t nr, const uint32_t (&args)[3], int32_t ret, uint64_t cycles);
+
+// Append a TRACE_EXIT_NR event if proc is being traced.
+void process_exited(const Process* proc, int32_t exit_code);
+
+// Move buffered events into out, oldest first. Returns the number moved.
+[[nodiscard]] size_t read(std::span<trace_event> out);
+
+// Copy the histograms of syscalls 0..out.size()-1 into out. Returns the
+// number of events dropped since the trace started.
+[[nodiscard]] uint32_t stats(std::span<trace_hist> out);
+
+}  // namespace Trace
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct TrapFrame;
+
+/*
+ * Fault-tolerant access to user memory from syscall handlers.
+ *
+ * Instead of walking the page tables up front, the copy routines only
+ * check that the range lies below KERNEL_VMA and then touch it directly.
+ * Each instruction that may fault on a user address is listed in the
+ * exception table (section __ex_table, see arch/linker.ld) together with a
+ * fixup address. A kernel-mode page fault whose eip is in the table
+ * resumes at the fixup, and the routine returns -EFAULT instead of
+ * panicking. This also stays correct if the mapping goes away between a
+ * check and the access, which a page walk cannot promise.
+ *
+ * CR0.WP is set at boot so that writes to read-only user pages fault in
+ * ring 0 as well.
+ */
+
+// True if [ptr, ptr + len) lies entirely in user space. Says nothing about
+// whether the pages are mapped.
+[[nodiscard]] bool user_range_ok(uint32_t ptr, size_t len);
+
+// Copy len bytes between kernel memory and user address `src` / `dst`.
+// Returns 0, or -EFAULT if the range is not user space or any byte of it
+// could not be accessed (the kernel side may then be partially written).
+[[nodiscard]] int32_t copy_from_user(void* dst, uint32_t src, size_t len);
+[[nodiscard]] int32_t copy_to_user(uint32_t dst, const void* src, size_t len);
+
+// Copy a NUL-terminated user string into dst (size bytes, including the
+// terminator). Returns the string length, -ENAMETOOLONG if it does not fit,
+// or -EFAULT.
+[[nodiscard]] int32_t strncpy_from_user(char* dst, uint32_t src, size_t size);
+
+// Called for a kernel-mode page fault. If the faulting eip has an
+// exception table entry, redirects regs to its fixup and returns true.
+[[nodiscard]] bool fixup_exception(TrapFrame* regs);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/vdso.h>
+
+#include "paging.h"
+
+/*
+ * Shared time page (see <sys/vdso.h> for the layout and reader protocol).
+ *
+ * One physical page, owned by the kernel, mapped read-only at
+ * VDSO_TIME_ADDR into every user address space with
+ * AddressSpace::map_shared(), so fork() shares it and exit never frees it.
+ *
+ * PIT::tick() calls update() on every timer interrupt. The TSC rate is not
+ * measured with a busy wait: each update divides the time elapsed since
+ * init() by the TSC cycles elapsed, so the calibration becomes available
+ * once kCalibrateMinNs have passed and keeps sharpening until
+ * kCalibrateMaxNs, after which it is frozen.
+ */
+
+namespace Vdso {
+
+static constexpr vaddr_t kTimePageVA = VDSO_TIME_ADDR;
+
+// Shortest baseline the TSC rate is derived from.
+static constexpr uint64_t kCalibrateMinNs = 50'000'000;
+
+// Longest baseline: keeps (ns << VDSO_TSC_SHIFT) within 64 bits.
+static constexpr uint64_t kCalibrateMaxNs = 60'000'000'000;
+
+// Allocate and zero the time page and take the calibration reference.
+// Must be called after PMM and PIT initialisation.
+void init();
+
+// Map the time page read-only into `pd` at kTimePageVA.
+void map(PageTable* pd);
+
+// Publish the current time and TSC. Called from PIT::tick(). No-op before
+// init().
+void update();
+
+// Kernel view of the page (nullptr before init()).
+[[nodiscard]] const vdso_time* page();
+
+}  // namespace Vdso
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <dirent.h>
+#include <optional.h>
+#include <span.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "file.h"
+#include "page_cache.h"
+
+// Maximum path length (including null terminator).
+static constexpr uint32_t kMaxPathLen = 128;
+
+// VFS node types.
+enum class VfsNodeType : uint8_t {
+  File,       // regular file (ramfs data or FAT file)
+  CharDev,    // character device (e.g. /dev/tty, /dev/null)
+  Directory,  // directory node
+};
+
+// Operations that a VFS node can support. Each backend (ramfs, devfs, fat)
+// provides its own implementations. Null pointers mean "not supported".
+struct VfsOps {
+  void (*open)(struct VfsNode* node);
+  int32_t (*read)(struct VfsNode* node, std::span<uint8_t> buf, uint32_t offset);
+  int32_t (*write)(struct VfsNode* node, std::span<const uint8_t> buf, uint32_t offset);
+  int32_t (*ioctl)(struct VfsNode* node, uint32_t request, void* arg);
+  int32_t (*truncate)(struct VfsNode* node);
+  // Optional scatter/gather variants of read/write, for backends that can
+  // fill several buffers from one device transfer. Without them the VFS
+  // calls read/write once per buffer.
+  int32_t (*readv)(struct VfsNode* node, IoVec iov, uint32_t offset);
+  int32_t (*writev)(struct VfsNode* node, ConstIoVec iov, uint32_t offset);
+  // Optional readiness check for poll(), returning POLL* bits. Without it
+  // a node is always ready for whichever of read/write it supports.
+  uint32_t (*poll)(struct VfsNode* node);
+  // Optional page cache hooks, provided together (see page_cache.h). With
+  // them, reads and writes go through the cache. read_page fills `page`
+  // with page `index` of the file and returns the bytes it holds of the
+  // file; write_page stores `data` at index * PAGE_SIZE. If the backend
+  // also has readv, the cache fills runs of pages with one readv call.
+  int32_t (*read_page)(struct VfsNode* node, uint32_t index, std::span<uint8_t> page);
+  int32_t (*write_page)(struct VfsNode* node, uint32_t index, std::span<const uint8_t> data);
+};
+
+// An open-file description backed by a VFS node. Tracks the per-fd
+// read/write offset for regular files, and the read-ahead state of reads
+// through it.
+struct VfsFileDescription {
+  struct VfsNode* node;
+  uint32_t offset;
+  int32_t open_flags;
+  PageCache::ReadAhead ra{};
+};
+
+// Maximum component name length (filename or directory name, not full path).
+static constexpr uint32_t kMaxNameLen = 64;
+
+// A single node in the VFS tree. Represents a file, device, or directory.
+struct VfsNode {
+  char name[kMaxNameLen];  // component name (e.g. "tty", "sh"); root is ""
+  VfsNodeType type;
+  const VfsOps* ops;
+
+  // For ramfs File nodes: pointer to immutable data and length.
+  const uint8_t* data;
+  size_t size;
+
+  // For mutable FAT nodes: per-file mutable metadata (FatFileInfo* or FatDirInfo*).
+  void* priv;
+
+  // Permissions and ownership.
+  mode_t mode;
+  uint32_t uid;
+  uint32_t gid;
+
+  // Tree structure (child-sibling representation).
+  VfsNode* parent;
+  VfsNode* first_child;
+  VfsNode* next_sibling;
+
+  // Mount point: non-null if a filesystem is mounted on this node.
+  const struct FsOps* mount_ops;
+
+  // Open descriptions and working directories using this node. A removed
+  // node stays allocated, detached from the tree, until this drops to 0.
+  uint32_t refs;
+};
+
+// Filesystem-level operations for a mounted volume.
+struct FsOps {
+  int32_t (*mount)(VfsNode* mount_point);
+  void (*unmount)(VfsNode* mount_point);
+  int32_t (*mkdir)(const char* abs_path);
+  int32_t (*unlink)(const char* abs_path);
+  int32_t (*rename)(const char* old_path, const char* new_path);
+  VfsNode* (*create)(const char* abs_path, int32_t flags, mode_t mode);
+};
+
+// Forward declaration for stat_path.
+struct stat;
+
+namespace Vfs {
+
+// Initialise the VFS. Must be called before any other VFS function.
+void init();
+
+// Register a new node. Returns a pointer to the node, or nullptr if
+// the name is too long. If mode is 0, a default is assigned based on type.
+[[nodiscard]] VfsNode* register_node(const char* path, VfsNodeType type, const VfsOps* ops,
+                                     mode_t mode = 0);
+
+// Soft-delete a node by path (clears its name so it is skipped by lookup).
+void unregister_node(const char* path);
+
+// Move the node at old_path to new_path, replacing any node already there.
+// The node keeps its identity, so open files, cached pages and size follow
+// it. The parent of new_path must exist. Returns 0 or a negative errno.
+[[nodiscard]] int32_t move_node(const char* old_path, const char* new_path);
+
+// Look up a node by its full path. Returns nullptr if not found.
+[[nodiscard]] VfsNode* lookup(const char* path);
+
+// Look up path starting at directory `base` (nullptr for the root); an
+// absolute path ignores base. "." and ".." are followed through the tree,
+// so a relative path never needs to be joined to base's path or walked
+// from the root. Returns nullptr if any component is missing.
+[[nodiscard]] VfsNode* lookup_at(VfsNode* base, const char* path);
+
+// Write node's absolute path (nullptr for the root) into buf. Returns its
+// length, -ENOENT if the node has been removed from the tree, or -ERANGE
+// if buf is too small.
+[[nodiscard]] int32_t node_path(const VfsNode* node, char* buf, size_t size);
+
+// Take and drop a reference that keeps node allocated (see VfsNode::refs).
+// Dropping the last reference to a removed node frees it. Both ignore
+// nullptr.
+void node_get(VfsNode* node);
+void node_put(VfsNode* node);
+
+// Open a VFS node and install it into the process's fd table.
+// flags uses the same O_* constants as open(2). If O_CREAT is set and the
+// node does not exist, a filesystem create is attempted.
+// Returns the fd number, or negative errno on failure.
+[[nodiscard]] int32_t open(const char* path, int32_t flags, mode_t mode = 0);
+
+// open() with path relative to directory base (see lookup_at()). With
+// O_DIRECTORY the node must be a directory (-ENOTDIR otherwise).
+[[nodiscard]] int32_t open_at(VfsNode* base, const char* path, int32_t flags, mode_t mode = 0);
+
+// Read from a VFS-backed file description.
+[[nodiscard]] int32_t read(FileDescription* fd, std::span<uint8_t> buf);
+
+// Write to a VFS-backed file description.
+[[nodiscard]] int32_t write(FileDescription* fd, std::span<const uint8_t> buf);
+
+// Scatter/gather read and write at the description's offset, which they
+// advance like read() and write().
+[[nodiscard]] int32_t readv(FileDescription* fd, IoVec iov);
+[[nodiscard]] int32_t writev(FileDescription* fd, ConstIoVec iov);
+
+// Read or write at `offset`, leaving the description's offset alone.
+// pwrite() ignores O_APPEND.
+[[nodiscard]] int32_t pread(FileDescription* fd, std::span<uint8_t> buf, uint32_t offset);
+[[nodiscard]] int32_t pwrite(FileDescription* fd, std::span<const uint8_t> buf, uint32_t offset);
+
+// Write the file's cached dirty pages back to its filesystem. Returns 0
+// (also for nodes that are not cached) or a negative errno.
+[[nodiscard]] int32_t fsync(FileDescription* fd);
+
+// Readiness of a VFS-backed file description for poll() (see VfsOps::poll).
+[[nodiscard]] uint32_t poll(FileDescription* fd);
+
+// Perform a device-specific control operation on a VFS-backed file description.
+[[nodiscard]] int32_t ioctl(FileDescription* fd, uint32_t request, void* arg);
+
+// Perform a tty ioctl (TIOCGWINSZ, TCGETS, TCSETS) on the console terminal.
+// Used for terminal fds that are not backed by VFS nodes.
+[[nodiscard]] int32_t tty_ioctl(uint32_t request, void* arg);
+
+// Close a VFS-backed file description. Frees the VfsFileDescription.
+void close(FileDescription* fd);
+
+// Returns true if path names a valid virtual directory.
+[[nodiscard]] bool is_directory(const char* path);
+
+// Fill entries with the next children of the directory open on fd,
+// starting from its offset, and advance the offset past them. d_name and
+// d_type are always set; d_size and d_mode only if attrs. Returns the
+// number of entries written (0 at the end), -ENOTDIR or -EBADF.
+[[nodiscard]] int32_t getdents(FileDescription* fd, std::span<dirent> entries, bool attrs);
+
+// Mount a filesystem at the given path. Calls ops->mount() if provided.
+int32_t mount(const char* path, const FsOps* ops);
+
+// Unmount the filesystem at the given path, after writing back every
+// dirty cached page.
+int32_t unmount(const char* path);
+
+// Filesystem-level operations -- dispatched to the nearest mount ancestor.
+int32_t fs_mkdir(const char* abs_path);
+int32_t fs_unlink(const char* abs_path);
+int32_t fs_rename(const char* old_path, const char* new_path);
+
+// fs_mkdir() and fs_unlink() with path relative to directory base. With
+// remove_dir, unlink only accepts a directory; without it, only a
+// non-directory.
+int32_t fs_mkdir_at(VfsNode* base, const char* path);
+int32_t fs_unlink_at(VfsNode* base, const char* path, bool remove_dir);
+
+// Fill buf with stat information for the given path.
+// Returns 0 on success, or negative errno on failure.
+int32_t stat_path(const char* path, struct stat* buf);
+
+// stat_path() with path relative to directory base (see lookup_at()).
+int32_t stat_at(VfsNode* base, const char* path, struct stat* buf);
+
+// Fill buf with stat information for a VfsNode directly.
+int32_t stat_node(const VfsNode* node, struct stat* buf);
+
+// Populate ramfs nodes from multiboot modules. Each module becomes
+// a file at "/bin/<basename>".
+void init_ramfs();
+
+// Initialise devfs device nodes (/dev/tty, /dev/null, /dev/kbd, /dev/fb).
+void init_devfs();
+
+}  // namespace Vfs
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "paging.h"
+
+/*
+ * Virtual Memory Mapper
+ *
+ * Provides page-granularity mapping and unmapping of virtual addresses to
+ * physical frames. Operates on the single kernel page directory
+ * (boot_page_directory) that is set up by boot.S and extended on demand.
+ *
+ * All virtual addresses must be 4 KiB-aligned. Physical addresses returned
+ * by kPmm.alloc() are always 4 KiB-aligned, so they satisfy this requirement.
+ *
+ * Newly required page tables are allocated from the PMM. Their physical
+ * addresses must fall within the first 8 MiB so that they can be reached via
+ * phys_to_virt(). The PMM allocates from the lowest available frames first,
+ * so this holds in practice; a panic fires if it is ever violated.
+ */
+
+namespace VMM {
+
+// Map the virtual page at `virt` to the physical page at `phys`.
+// - Both addresses must be PAGE_SIZE-aligned.
+// - writeable: if true the page is writable from ring-0 (and ring-3 when
+// user).
+// - user: if true the page is also accessible from ring-3.
+// Remapping an already-mapped virtual page is allowed.
+void map(vaddr_t virt, paddr_t phys, bool writeable = true, bool user = false);
+
+// Remove the mapping for the virtual page at `virt`.
+// No-op if the address is not currently mapped.
+// The caller is responsible for freeing the backing physical frame.
+void unmap(vaddr_t virt);
+
+// Translate `virt` to its backing physical address.
+// Returns 0 if `virt` is not mapped.
+// The low 12 bits of `virt` (the page offset) are preserved in the result.
+[[nodiscard]] paddr_t get_phys(vaddr_t virt);
+
+// Map every physical frame from 8 MiB up to kPmm.get_total_frames()*PAGE_SIZE
+// into the kernel higher-half at phys_to_virt(pa). Must be called once, early
+// in kernel_init(), before any subsystem allocates frames above 8 MiB.
+// Page tables for the new mappings are allocated from the PMM and must land in
+// the already-mapped first 8 MiB (PMM allocates lowest-first; asserted).
+void map_all_physical_ram();
+
+// Flush the entire TLB by reloading CR3 with its current value.
+// Use when switching address spaces (loading a new page directory).
+// For single-page invalidation prefer the cheaper `invlpg` instruction,
+// as used internally by map() and unmap().
+void flush_tlb();
+
+}  // namespace VMM
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdarg.h>
+
+namespace std {
+
+using va_list = ::va_list;
+
+}  // namespace std
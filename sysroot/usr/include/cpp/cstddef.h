@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stddef.h>
+
+namespace std {
+
+using nullptr_t = decltype(nullptr);
+using ptrdiff_t = ::ptrdiff_t;
+using size_t = ::size_t;
+
+}  // namespace std
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdio.h>
+
+namespace std {
+
+using ::getchar;
+using ::printf;
+using ::putchar;
+using ::puts;
+using ::vprintf;
+
+}  // namespace std
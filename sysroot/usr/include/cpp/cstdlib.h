@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdlib.h>
+
+namespace std {
+
+using ::abort;
+using ::abs;
+using ::calloc;
+using ::free;
+using ::malloc;
+using ::rand;
+using ::realloc;
+using ::srand;
+
+using ::size_t;
+
+}  // namespace std
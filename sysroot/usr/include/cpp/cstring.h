@@ -0,0 +1,27 @@
+#pragma once
+
+#include_next <string.h>
+
+namespace std {
+
+using ::memcmp;
+using ::memcpy;
+using ::memmove;
+using ::memset;
+using ::strcat;
+using ::strchr;
+using ::strcmp;
+using ::strcpy;
+using ::strcspn;
+using ::strlen;
+using ::strncat;
+using ::strncmp;
+using ::strncpy;
+using ::strnlen;
+using ::strrchr;
+using ::strspn;
+using ::strstr;
+using ::strtok;
+using ::strtok_r;
+
+}  // namespace std
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace std {
+namespace numbers {
+
+inline constexpr double e = 2.718281828459045235360287471352662498;
+inline constexpr double pi = 3.141592653589793238462643383279502884;
+inline constexpr double sqrt2 = 1.414213562373095048801688724209698079;
+inline constexpr double sqrt3 = 1.732050807568877293527446341505872366;
+inline constexpr double ln2 = 0.693147180559945309417232121458176568;
+inline constexpr double ln10 = 2.302585092994045684017991454684364208;
+inline constexpr double log2e = 1.442695040888963407359924681001892137;
+inline constexpr double log10e = 0.434294481903251827651128918916605082;
+inline constexpr double phi = 1.618033988749894848204586834365638118;
+
+}  // namespace numbers
+}  // namespace std
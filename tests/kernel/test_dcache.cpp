@@ -0,0 +1,99 @@
+#include "dcache.h"
+#include "ktest.h"
+#include "vfs.h"
+
+namespace {
+
+const VfsOps null_ops = {
+    .open = nullptr,
+    .read = nullptr,
+    .write = nullptr,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
+
+}  // namespace
+
+// ===========================================================================
+// Dcache
+// ===========================================================================
+
+TEST(dcache, insert_lookup_forget) {
+  Dcache::invalidate_all();
+  VfsNode parent = {};
+  VfsNode child = {};
+
+  VfsNode* found = nullptr;
+  ASSERT_FALSE(Dcache::lookup(&parent, "x", &found));
+  Dcache::insert(&parent, "x", &child);
+  ASSERT_TRUE(Dcache::lookup(&parent, "x", &found));
+  ASSERT_EQ(found, &child);
+
+  // Same name under another parent is a different key.
+  VfsNode other = {};
+  ASSERT_FALSE(Dcache::lookup(&other, "x", &found));
+
+  Dcache::forget(&parent, "x");
+  ASSERT_FALSE(Dcache::lookup(&parent, "x", &found));
+}
+
+TEST(dcache, invalidate_all_drops_entries) {
+  Dcache::invalidate_all();
+  VfsNode parent = {};
+  Dcache::insert(&parent, "gone", nullptr);
+
+  VfsNode* found = &parent;
+  ASSERT_TRUE(Dcache::lookup(&parent, "gone", &found));
+  ASSERT_NULL(found);
+  Dcache::invalidate_all();
+  ASSERT_FALSE(Dcache::lookup(&parent, "gone", &found));
+}
+
+// ===========================================================================
+// Path lookup through the cache
+// ===========================================================================
+
+TEST(dcache, repeated_lookup_hits_every_component) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/a/b/c", VfsNodeType::File, &null_ops));
+
+  ASSERT_NOT_NULL(Vfs::lookup("/a/b/c"));
+  Dcache::reset_stats();
+  ASSERT_NOT_NULL(Vfs::lookup("/a/b/c"));
+  const Dcache::Stats stats = Dcache::stats();
+  ASSERT_EQ(stats.hits, 3U);
+  ASSERT_EQ(stats.misses, 0U);
+}
+
+TEST(dcache, negative_entry_cleared_by_register) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/a/b", VfsNodeType::File, &null_ops));
+
+  ASSERT_NULL(Vfs::lookup("/a/x"));
+  Dcache::reset_stats();
+  ASSERT_NULL(Vfs::lookup("/a/x"));
+  ASSERT_EQ(Dcache::stats().negative_hits, 1U);
+
+  VfsNode* node = Vfs::register_node("/a/x", VfsNodeType::File, &null_ops);
+  ASSERT_NOT_NULL(node);
+  ASSERT_EQ(Vfs::lookup("/a/x"), node);
+}
+
+TEST(dcache, unregister_drops_cached_node) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/a/b/c", VfsNodeType::File, &null_ops));
+  ASSERT_NOT_NULL(Vfs::lookup("/a/b/c"));
+
+  Vfs::unregister_node("/a/b");
+  ASSERT_NULL(Vfs::lookup("/a/b"));
+  ASSERT_NULL(Vfs::lookup("/a/b/c"));
+
+  VfsNode* node = Vfs::register_node("/a/b/c", VfsNodeType::File, &null_ops);
+  ASSERT_NOT_NULL(node);
+  ASSERT_EQ(Vfs::lookup("/a/b/c"), node);
+}
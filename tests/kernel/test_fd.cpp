@@ -1,4 +1,5 @@
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <sys/syscall.h>
 
@@ -8,74 +9,174 @@
 #include "scheduler.h"
 #include "syscall.h"
 
+namespace {
+
+FileDescription dummy = {
+    .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr,
+    .status_flags = 0};
+
+// Open every fd from 3 up to (not including) end on the dummy description.
+void fill_to(FdTable& table, uint32_t end) {
+  for (uint32_t fd = 3; fd < end; ++fd) {
+    ASSERT_TRUE(table.reserve(fd));
+    table.install(fd, &dummy);
+  }
+}
+
+// Close the dummy fds again, then everything else.
+void drop(FdTable& table) {
+  for (auto fd = table.next_open(3); fd; fd = table.next_open(*fd + 1)) {
+    if (table[*fd] == &dummy) {
+      ASSERT(table.remove(*fd) == &dummy);
+    }
+  }
+  table.close_all();
+}
+
+}  // namespace
+
 // ===========================================================================
-// fd_init_stdio
+// FdTable::init_stdio
 // ===========================================================================
 
 TEST(fd, init_sets_stdio) {
-  FileDescription* fds[kMaxFds];
-  fd_init_stdio(fds);
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
 
-  ASSERT_NOT_NULL(fds[0]);
-  ASSERT_NOT_NULL(fds[1]);
-  ASSERT_NOT_NULL(fds[2]);
-  ASSERT_EQ(fds[0]->type, FileType::TerminalRead);
-  ASSERT_EQ(fds[1]->type, FileType::TerminalWrite);
-  ASSERT_EQ(fds[2]->type, FileType::TerminalWrite);
+  ASSERT_NOT_NULL(table[0]);
+  ASSERT_NOT_NULL(table[1]);
+  ASSERT_NOT_NULL(table[2]);
+  ASSERT_EQ(table[0]->type, FileType::TerminalRead);
+  ASSERT_EQ(table[1]->type, FileType::TerminalWrite);
+  ASSERT_EQ(table[2]->type, FileType::TerminalWrite);
 
   // fds 1 and 2 share the same terminal write description.
-  ASSERT(fds[1] == fds[2]);
+  ASSERT(table[1] == table[2]);
+  ASSERT_EQ(table[1]->ref_count, 2U);
 
-  for (uint32_t i = 3; i < kMaxFds; ++i) {
-    ASSERT_NULL(fds[i]);
+  for (uint32_t i = 3; i < table.capacity(); ++i) {
+    ASSERT_NULL(table[i]);
   }
+  ASSERT_EQ(table.limit(), kDefaultFdLimit);
+  table.close_all();
+}
+
+TEST(fd, stdio_descriptions_are_per_table) {
+  FdTable a{};
+  FdTable b{};
+  ASSERT_TRUE(a.init_stdio());
+  ASSERT_TRUE(b.init_stdio());
+
+  // O_NONBLOCK set on one table's stdin must not leak into another's.
+  ASSERT(a[0] != b[0]);
+  a[0]->status_flags = O_NONBLOCK;
+  ASSERT_EQ(b[0]->status_flags, 0);
+  a.close_all();
+  b.close_all();
 }
 
 // ===========================================================================
-// fd_alloc
+// FdTable::alloc
 // ===========================================================================
 
 TEST(fd, alloc_returns_lowest_free) {
-  FileDescription* fds[kMaxFds];
-  fd_init_stdio(fds);
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
 
-  auto slot = fd_alloc(fds);
+  auto slot = table.alloc();
   ASSERT(slot.has_value());
   ASSERT_EQ(*slot, 3U);
+  table.close_all();
 }
 
 TEST(fd, alloc_after_close_reuses_slot) {
-  FileDescription* fds[kMaxFds];
-  fd_init_stdio(fds);
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
 
-  // "Close" fd 1 by nulling it.
-  fds[1] = nullptr;
+  file_close(table.remove(1));
 
-  auto slot = fd_alloc(fds);
+  auto slot = table.alloc();
   ASSERT(slot.has_value());
   ASSERT_EQ(*slot, 1U);
+  table.close_all();
 }
 
 TEST(fd, alloc_full_returns_nullopt) {
-  FileDescription* fds[kMaxFds];
-  FileDescription dummy = {
-      .type = FileType::TerminalRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr};
-
-  for (auto& fd : fds) {
-    fd = &dummy;
-  }
-
-  auto slot = fd_alloc(fds);
-  ASSERT_FALSE(slot.has_value());
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
+  table.set_limits(8, kMaxFds);
+  fill_to(table, 8);
+
+  ASSERT_FALSE(table.alloc().has_value());
+  ASSERT_FALSE(table.reserve(8));
+  drop(table);
 }
 
 TEST(fd, alloc_from_skips_lower) {
-  FileDescription* fds[kMaxFds];
-  fd_init_stdio(fds);
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
 
-  auto slot = fd_alloc_from(fds, 5);
+  auto slot = table.alloc(5);
   ASSERT(slot.has_value());
   ASSERT_EQ(*slot, 5U);
+  table.close_all();
+}
+
+TEST(fd, alloc_grows_past_full_words) {
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
+  table.set_limits(kMaxFds, kMaxFds);
+  fill_to(table, 70);
+
+  // fds 0..63 fill two bitmap words; the lowest free fd is in the third.
+  auto slot = table.alloc();
+  ASSERT(slot.has_value());
+  ASSERT_EQ(*slot, 70U);
+  ASSERT_TRUE(table.capacity() > 70);
+
+  ASSERT(table.remove(40) == &dummy);
+  ASSERT_EQ(*table.alloc(), 40U);
+  ASSERT_EQ(*table.alloc(41), 70U);
+  drop(table);
+}
+
+// ===========================================================================
+// FdTable fork and exec
+// ===========================================================================
+
+TEST(fd, copy_takes_references_and_flags) {
+  FdTable parent{};
+  ASSERT_TRUE(parent.init_stdio());
+  parent.set_limits(40, 50);
+  fill_to(parent, 4);
+  parent.set_flags(3, FD_CLOEXEC);
+  const uint32_t refs = dummy.ref_count;
+
+  FdTable child{};
+  ASSERT_TRUE(child.copy_from(parent));
+  ASSERT(child[3] == &dummy);
+  ASSERT_EQ(dummy.ref_count, refs + 1);
+  ASSERT_EQ(child.flags(3), static_cast<uint32_t>(FD_CLOEXEC));
+  ASSERT_EQ(child.limit(), 40U);
+  ASSERT_EQ(child.max_limit(), 50U);
+
+  ASSERT(child.remove(3) == &dummy);
+  --dummy.ref_count;
+  child.close_all();
+  drop(parent);
+}
+
+TEST(fd, close_on_exec_keeps_other_fds) {
+  FdTable table{};
+  ASSERT_TRUE(table.init_stdio());
+  table.set_flags(1, FD_CLOEXEC);
+
+  table.close_on_exec();
+  ASSERT_NOT_NULL(table[0]);
+  ASSERT_NULL(table[1]);
+  ASSERT_NOT_NULL(table[2]);
+  ASSERT_EQ(*table.alloc(), 1U);
+  table.close_all();
 }
 
 // ===========================================================================
@@ -92,8 +193,8 @@ TEST(fd, write_bad_fd) {
 
 TEST(fd, write_null_fd_slot) {
   Process* proc = Scheduler::current();
-  FileDescription* saved = proc->fds[5];
-  proc->fds[5] = nullptr;
+  const uint32_t saved_flags = proc->fds[5] != nullptr ? proc->fds.flags(5) : 0;
+  FileDescription* saved = proc->fds.remove(5);
 
   TrapFrame frame = {};
   frame.eax = SYS_WRITE;
@@ -103,7 +204,9 @@ TEST(fd, write_null_fd_slot) {
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, static_cast<uint32_t>(-EBADF));
 
-  proc->fds[5] = saved;
+  if (saved != nullptr) {
+    proc->fds.install(5, saved, saved_flags);
+  }
 }
 
 // ===========================================================================
@@ -114,11 +217,12 @@ TEST(fd, close_valid_fd) {
   Process* proc = Scheduler::current();
 
   auto* desc = new FileDescription{
-      .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr};
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr,
+      .status_flags = 0};
 
-  auto slot = fd_alloc(proc->fds);
+  auto slot = proc->fds.alloc();
   ASSERT(slot.has_value());
-  proc->fds[*slot] = desc;
+  proc->fds.install(*slot, desc);
 
   TrapFrame frame = {};
   frame.eax = SYS_CLOSE;
@@ -145,11 +249,12 @@ TEST(fd, dup2_copies_fd) {
   Process* proc = Scheduler::current();
 
   auto* desc = new FileDescription{
-      .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr};
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr,
+      .status_flags = 0};
 
-  auto slot = fd_alloc(proc->fds);
+  auto slot = proc->fds.alloc();
   ASSERT(slot.has_value());
-  proc->fds[*slot] = desc;
+  proc->fds.install(*slot, desc);
 
   TrapFrame frame = {};
   frame.eax = SYS_DUP2;
@@ -163,8 +268,8 @@ TEST(fd, dup2_copies_fd) {
   ASSERT_EQ(desc->ref_count, 2U);
 
   // Cleanup: close both fds.
-  proc->fds[*slot] = nullptr;
-  proc->fds[newfd] = nullptr;
+  ASSERT(proc->fds.remove(*slot) == desc);
+  ASSERT(proc->fds.remove(newfd) == desc);
   delete desc;
 }
 
@@ -189,3 +294,28 @@ TEST(fd, dup2_invalid_oldfd) {
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, static_cast<uint32_t>(-EBADF));
 }
+
+TEST(fd, dup2_grows_table) {
+  Process* proc = Scheduler::current();
+  const uint32_t newfd = proc->fds.capacity() + 40;
+  ASSERT_TRUE(newfd < proc->fds.limit());
+
+  TrapFrame frame = {};
+  frame.eax = SYS_DUP2;
+  frame.ebx = 1;  // stdout
+  frame.ecx = newfd;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+
+  ASSERT_EQ(frame.eax, newfd);
+  ASSERT(proc->fds[newfd] == proc->fds[1]);
+  file_close(proc->fds.remove(newfd));
+}
+
+TEST(fd, dup2_at_limit_is_ebadf) {
+  TrapFrame frame = {};
+  frame.eax = SYS_DUP2;
+  frame.ebx = 1;  // stdout
+  frame.ecx = Scheduler::current()->fds.limit();
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+  ASSERT_EQ(frame.eax, static_cast<uint32_t>(-EBADF));
+}
@@ -0,0 +1,39 @@
+#include <string.h>
+
+#include "fpu.h"
+#include "ktest.h"
+#include "process.h"
+
+// ===========================================================================
+// FXSAVE area layout
+// ===========================================================================
+
+TEST(fpu, state_is_fxsave_sized_and_aligned) {
+  ASSERT_EQ(sizeof(Fpu::State), 512U);
+  ASSERT_EQ(alignof(Fpu::State), 16U);
+  ASSERT_EQ(offsetof(Process, fpu_state) % 16, 0U);
+}
+
+TEST(fpu, qemu_cpu_has_fxsr) { ASSERT_TRUE(Fpu::has_fxsr()); }
+
+// ===========================================================================
+// Per-process state
+// ===========================================================================
+
+TEST(fpu, copy_state_duplicates_saved_image) {
+  Process parent{};
+  Process child{};
+  memset(parent.fpu_state.bytes, 0xAB, sizeof(parent.fpu_state.bytes));
+  parent.fpu_saved = true;
+
+  Fpu::copy_state(&parent, &child);
+  ASSERT_TRUE(child.fpu_saved);
+  ASSERT_EQ(memcmp(child.fpu_state.bytes, parent.fpu_state.bytes, Fpu::kStateSize), 0);
+}
+
+TEST(fpu, release_discards_saved_state) {
+  Process p{};
+  p.fpu_saved = true;
+  Fpu::release(&p);
+  ASSERT_FALSE(p.fpu_saved);
+}
@@ -0,0 +1,133 @@
+#include <errno.h>
+
+#include "address_space.h"
+#include "file.h"
+#include "futex.h"
+#include "ktest.h"
+#include "paging.h"
+#include "pmm.h"
+#include "process.h"
+#include "scheduler.h"
+
+// ktests run as the idle process, which Scheduler::wait_on() never parks,
+// so FUTEX_WAIT returns kSyscallRestart without queueing anything. Waiters
+// are simulated by pushing non-Blocked processes onto a bucket directly.
+
+namespace {
+
+constexpr vaddr_t kWordVA{0x00400000};
+constexpr vaddr_t kAliasVA{0x00800000};
+
+// Runs a test body with a fresh address space holding one user page at
+// kWordVA, installed as the current process's page directory.
+struct FutexSpace {
+  PageTable* orig_pd;
+  paddr_t orig_pd_phys;
+  AddressSpace::PageDir space;
+  paddr_t page;
+
+  FutexSpace() : space(AddressSpace::create()), page(kPmm.alloc()) {
+    Process* proc = Scheduler::current();
+    orig_pd = proc->page_directory;
+    orig_pd_phys = proc->page_directory_phys;
+    proc->page_directory = space.virt;
+    proc->page_directory_phys = space.phys;
+    AddressSpace::map(space.virt, kWordVA, page, /*writeable=*/true, /*user=*/true);
+    *word() = 0;
+  }
+
+  ~FutexSpace() {
+    Process* proc = Scheduler::current();
+    proc->page_directory = orig_pd;
+    proc->page_directory_phys = orig_pd_phys;
+    AddressSpace::destroy(space.virt, space.phys);
+  }
+
+  uint32_t* word() { return phys_to_virt(page).ptr<uint32_t>(); }
+};
+
+}  // namespace
+
+// ===========================================================================
+// Futex::wait
+// ===========================================================================
+
+TEST(futex, wait_on_changed_word_returns_eagain) {
+  FutexSpace fs;
+  *fs.word() = 1;
+  ASSERT_EQ(Futex::wait(kWordVA, 0), -EAGAIN);
+}
+
+TEST(futex, wait_on_expected_word_restarts) {
+  FutexSpace fs;
+  ASSERT_EQ(Futex::wait(kWordVA, 0), kSyscallRestart);
+  ASSERT_EQ(Scheduler::current()->futex_key, fs.page);
+  Scheduler::current()->futex_key = 0;
+}
+
+TEST(futex, wait_rejects_bad_addresses) {
+  FutexSpace fs;
+  ASSERT_EQ(Futex::wait(kWordVA + 2, 0), -EINVAL);
+  ASSERT_EQ(Futex::wait(kAliasVA, 0), -EFAULT);
+  ASSERT_EQ(Futex::wake(kAliasVA, 1), -EFAULT);
+}
+
+TEST(futex, restarted_wait_after_wake_returns_zero) {
+  FutexSpace fs;
+  Scheduler::current()->futex_woken = true;
+  *fs.word() = 1;  // the word is not re-checked once woken
+  ASSERT_EQ(Futex::wait(kWordVA, 0), 0);
+  ASSERT_FALSE(Scheduler::current()->futex_woken);
+}
+
+// ===========================================================================
+// Futex::wake
+// ===========================================================================
+
+TEST(futex, wake_without_waiters_returns_zero) {
+  FutexSpace fs;
+  ASSERT_EQ(Futex::wake(kWordVA, 1), 0);
+}
+
+TEST(futex, wake_takes_only_matching_waiters_in_order) {
+  FutexSpace fs;
+  WaitQueue& wq = Futex::bucket(fs.page);
+  Process a{};
+  Process other{};
+  Process b{};
+  a.state = other.state = b.state = ProcessState::Zombie;
+  a.futex_key = b.futex_key = fs.page;
+  // A different word that hashes to the same bucket.
+  other.futex_key = fs.page + PAGE_SIZE * Futex::kHashBuckets;
+  ASSERT_EQ(&Futex::bucket(other.futex_key), &wq);
+  for (Process* p : {&a, &other, &b}) {
+    p->wait_queue = &wq;
+    wq.push(p);
+  }
+
+  ASSERT_EQ(Futex::wake(kWordVA, 1), 1);
+  ASSERT_TRUE(a.futex_woken);
+  ASSERT_NULL(a.wait_queue);
+  ASSERT_FALSE(b.futex_woken);
+
+  ASSERT_EQ(Futex::wake(kWordVA, 8), 1);
+  ASSERT_TRUE(b.futex_woken);
+  ASSERT_FALSE(other.futex_woken);
+  ASSERT_TRUE(wq.remove(&other));
+  ASSERT_TRUE(wq.empty());
+}
+
+TEST(futex, aliased_mappings_share_a_key) {
+  FutexSpace fs;
+  AddressSpace::map(fs.space.virt, kAliasVA, fs.page, /*writeable=*/true, /*user=*/true);
+  WaitQueue& wq = Futex::bucket(fs.page + 4U);
+  Process waiter{};
+  waiter.state = ProcessState::Zombie;
+  waiter.futex_key = fs.page + 4U;
+  waiter.wait_queue = &wq;
+  wq.push(&waiter);
+
+  ASSERT_EQ(Futex::wake(kAliasVA + 4, 1), 1);
+  ASSERT_TRUE(waiter.futex_woken);
+  AddressSpace::unmap_nofree(fs.space.virt, kAliasVA);
+}
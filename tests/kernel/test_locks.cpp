@@ -0,0 +1,133 @@
+#include "ktest.h"
+#include "mutex.h"
+#include "rwlock.h"
+#include "scheduler.h"
+#include "spinlock.h"
+
+// ===========================================================================
+// SpinLock
+// ===========================================================================
+
+TEST(locks, spinlock_lock_unlock) {
+  SpinLock lock{"test_spin"};
+  ASSERT_FALSE(lock.is_locked());
+  lock.lock();
+  ASSERT_TRUE(lock.is_locked());
+  lock.unlock();
+  ASSERT_FALSE(lock.is_locked());
+}
+
+TEST(locks, spinlock_try_lock_fails_when_held) {
+  SpinLock lock{"test_spin"};
+  ASSERT_TRUE(lock.try_lock());
+  ASSERT_FALSE(lock.try_lock());
+  lock.unlock();
+  ASSERT_TRUE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST(locks, spinlock_restores_interrupt_state) {
+  SpinLock lock{"test_spin"};
+  uint32_t before;
+  __asm__ volatile("pushfl; popl %0" : "=r"(before));
+  lock.lock();
+  uint32_t held;
+  __asm__ volatile("pushfl; popl %0" : "=r"(held));
+  ASSERT_EQ(held & 0x200U, 0U);
+  lock.unlock();
+  uint32_t after;
+  __asm__ volatile("pushfl; popl %0" : "=r"(after));
+  ASSERT_EQ(after & 0x200U, before & 0x200U);
+}
+
+TEST(locks, spinlock_counts_acquisitions) {
+  SpinLock lock{"test_spin"};
+  for (int i = 0; i < 3; ++i) {
+    const LockGuard guard(lock);
+    ASSERT_TRUE(lock.is_locked());
+  }
+  ASSERT_FALSE(lock.is_locked());
+  ASSERT_EQ(lock.stats().acquisitions, 3U);
+  ASSERT_EQ(lock.stats().contentions, 0U);
+  ASSERT_TRUE(lock.stats().max_hold_cycles <= lock.stats().hold_cycles);
+}
+
+// ===========================================================================
+// RwLock
+// ===========================================================================
+
+TEST(locks, rwlock_readers_share) {
+  RwLock lock{"test_rw"};
+  lock.read_lock();
+  lock.read_lock();
+  ASSERT_EQ(lock.readers(), 2U);
+  ASSERT_FALSE(lock.is_write_locked());
+  lock.read_unlock();
+  lock.read_unlock();
+  ASSERT_EQ(lock.readers(), 0U);
+  ASSERT_EQ(lock.stats().acquisitions, 2U);
+}
+
+TEST(locks, rwlock_writer_is_exclusive) {
+  RwLock lock{"test_rw"};
+  {
+    const WriteGuard guard(lock);
+    ASSERT_TRUE(lock.is_write_locked());
+    ASSERT_EQ(lock.readers(), 0U);
+  }
+  ASSERT_FALSE(lock.is_write_locked());
+  {
+    const ReadGuard guard(lock);
+    ASSERT_EQ(lock.readers(), 1U);
+  }
+  ASSERT_EQ(lock.stats().acquisitions, 2U);
+}
+
+// ===========================================================================
+// Mutex
+// ===========================================================================
+
+TEST(locks, mutex_owner_is_current_process) {
+  Mutex mutex{"test_mutex"};
+  ASSERT_FALSE(mutex.is_locked());
+  ASSERT_TRUE(mutex.lock_or_wait());
+  ASSERT_TRUE(mutex.is_locked());
+  ASSERT_EQ(mutex.owner(), Scheduler::current());
+  mutex.unlock();
+  ASSERT_FALSE(mutex.is_locked());
+  ASSERT_NULL(mutex.owner());
+}
+
+TEST(locks, mutex_try_lock_fails_when_held) {
+  Mutex mutex{"test_mutex"};
+  ASSERT_TRUE(mutex.try_lock());
+  ASSERT_FALSE(mutex.try_lock());
+  { const MutexGuard guard(mutex); }
+  ASSERT_FALSE(mutex.is_locked());
+  ASSERT_EQ(mutex.stats().acquisitions, 1U);
+}
+
+// ===========================================================================
+// LockStats registry
+// ===========================================================================
+
+TEST(locks, destroyed_locks_leave_registry) {
+  // Each lock reuses the previous one's stack slot. A registry that kept
+  // destroyed locks would link the slot to itself and the walk below
+  // would never end.
+  for (int i = 0; i < 3; ++i) {
+    SpinLock lock{"test_scoped"};
+    const LockGuard guard(lock);
+    ASSERT_TRUE(lock.stats().registered);
+  }
+  {
+    SpinLock outer{"test_outer"};
+    { const LockGuard guard(outer); }
+    {
+      SpinLock inner{"test_inner"};
+      { const LockGuard guard(inner); }
+    }
+    ASSERT_TRUE(outer.stats().registered);
+  }
+  lock_stats_reset();
+}
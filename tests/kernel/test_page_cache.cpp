@@ -0,0 +1,455 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+
+#include "file.h"
+#include "ktest.h"
+#include "page_cache.h"
+#include "paging.h"
+#include "process.h"
+#include "scheduler.h"
+#include "vfs.h"
+
+namespace {
+
+// A "disk" behind the fake backend below.
+constexpr uint32_t kStorePages = 48;
+uint8_t store[kStorePages * PAGE_SIZE];
+size_t store_size = 0;
+uint32_t page_reads = 0;
+uint32_t run_reads = 0;
+uint32_t page_writes = 0;
+uint32_t last_written = 0;
+// Backend reads that fail with kSyscallRestart, as FAT's do while another
+// process holds its lock.
+uint32_t busy_reads = 0;
+
+void reset_store(size_t size) {
+  for (uint32_t i = 0; i < sizeof(store); ++i) {
+    store[i] = static_cast<uint8_t>(i * 7);
+  }
+  store_size = size;
+  page_reads = 0;
+  run_reads = 0;
+  page_writes = 0;
+  busy_reads = 0;
+  PageCache::reset_stats();
+}
+
+int32_t store_read_page([[maybe_unused]] VfsNode* node, uint32_t index,
+                        std::span<uint8_t> page) {
+  ++page_reads;
+  if (busy_reads > 0) {
+    --busy_reads;
+    return kSyscallRestart;
+  }
+  const size_t start = static_cast<size_t>(index) * PAGE_SIZE;
+  if (start >= store_size) {
+    return 0;
+  }
+  const size_t n = store_size - start < page.size() ? store_size - start : page.size();
+  memcpy(page.data(), store + start, n);
+  return static_cast<int32_t>(n);
+}
+
+int32_t store_readv([[maybe_unused]] VfsNode* node, IoVec iov, uint32_t offset) {
+  ++run_reads;
+  if (busy_reads > 0) {
+    --busy_reads;
+    return kSyscallRestart;
+  }
+  if (offset >= store_size) {
+    return 0;
+  }
+  const uint32_t n = iov_length(iov) < store_size - offset
+                         ? iov_length(iov)
+                         : static_cast<uint32_t>(store_size - offset);
+  iov_scatter(iov, 0, store + offset, n);
+  return static_cast<int32_t>(n);
+}
+
+// Like FAT, resets node->size to the size the store has.
+int32_t store_write_page(VfsNode* node, uint32_t index, std::span<const uint8_t> data) {
+  ++page_writes;
+  last_written = index;
+  const size_t start = static_cast<size_t>(index) * PAGE_SIZE;
+  memcpy(store + start, data.data(), data.size());
+  if (start + data.size() > store_size) {
+    store_size = start + data.size();
+  }
+  node->size = store_size;
+  return static_cast<int32_t>(data.size());
+}
+
+int32_t unused_read([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<uint8_t> buf,
+                    [[maybe_unused]] uint32_t offset) {
+  return -EIO;
+}
+
+int32_t unused_write([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<const uint8_t> buf,
+                     [[maybe_unused]] uint32_t offset) {
+  return -EIO;
+}
+
+const VfsOps store_ops = {
+    .open = nullptr,
+    .read = unused_read,
+    .write = unused_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = store_read_page,
+    .write_page = store_write_page,
+};
+
+// The same backend, able to fill a run of pages with one call.
+const VfsOps store_run_ops = {
+    .open = nullptr,
+    .read = unused_read,
+    .write = unused_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = store_readv,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = store_read_page,
+    .write_page = store_write_page,
+};
+
+// A node backed by the store, holding `size` bytes of it.
+VfsNode make_node(size_t size, const VfsOps* ops = &store_ops) {
+  reset_store(size);
+  VfsNode node = {};
+  node.type = VfsNodeType::File;
+  node.ops = ops;
+  node.size = size;
+  return node;
+}
+
+int32_t cache_read(VfsNode* node, uint8_t* buf, uint32_t len, uint32_t offset,
+                   PageCache::ReadAhead* ra = nullptr) {
+  std::span<uint8_t> span(buf, len);
+  return PageCache::read(node, IoVec(&span, 1), offset, ra);
+}
+
+int32_t cache_write(VfsNode* node, const uint8_t* buf, uint32_t len, uint32_t offset) {
+  std::span<const uint8_t> span(buf, len);
+  return PageCache::write(node, ConstIoVec(&span, 1), offset);
+}
+
+}  // namespace
+
+// ===========================================================================
+// Reads
+// ===========================================================================
+
+TEST(page_cache, read_miss_then_hit) {
+  VfsNode node = make_node(100);
+  uint8_t buf[16] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, 10, 5), 10);
+  ASSERT_EQ(buf[0], store[5]);
+  ASSERT_EQ(cache_read(&node, buf, 10, 50), 10);
+  ASSERT_EQ(buf[9], store[59]);
+
+  ASSERT_EQ(page_reads, 1U);
+  const PageCache::Stats st = PageCache::stats();
+  ASSERT_EQ(st.misses, 1U);
+  ASSERT_EQ(st.hits, 1U);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, read_is_bounded_by_size) {
+  VfsNode node = make_node(PAGE_SIZE + 8);
+  uint8_t buf[32] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), PAGE_SIZE), 8);
+  ASSERT_EQ(buf[7], store[PAGE_SIZE + 7]);
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), PAGE_SIZE + 8), 0);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, read_spans_pages) {
+  VfsNode node = make_node(2 * PAGE_SIZE);
+  uint8_t buf[8] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), PAGE_SIZE - 4), 8);
+  ASSERT_EQ(buf[3], store[PAGE_SIZE - 1]);
+  ASSERT_EQ(buf[4], store[PAGE_SIZE]);
+  ASSERT_EQ(page_reads, 2U);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, miss_fills_rest_of_read_in_one_call) {
+  VfsNode node = make_node(3 * PAGE_SIZE, &store_run_ops);
+  static uint8_t buf[3 * PAGE_SIZE];
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), 0), static_cast<int32_t>(sizeof(buf)));
+  ASSERT_EQ(run_reads, 1U);
+  ASSERT_EQ(page_reads, 0U);
+  ASSERT_EQ(buf[2 * PAGE_SIZE + 5], store[2 * PAGE_SIZE + 5]);
+  ASSERT_EQ(PageCache::stats().misses, 1U);
+  ASSERT_EQ(PageCache::stats().hits, 2U);
+  PageCache::invalidate(&node);
+}
+
+// ===========================================================================
+// Read-ahead
+// ===========================================================================
+
+TEST(page_cache, sequential_reads_grow_window) {
+  VfsNode node = make_node(kStorePages * PAGE_SIZE, &store_run_ops);
+  PageCache::ReadAhead ra = {};
+  static uint8_t buf[PAGE_SIZE];
+
+  ASSERT_EQ(cache_read(&node, buf, PAGE_SIZE, 0, &ra), static_cast<int32_t>(PAGE_SIZE));
+  ASSERT_EQ(ra.window, PageCache::kReadAheadMinPages);
+  ASSERT_EQ(PageCache::stats().readahead, PageCache::kReadAheadMinPages);
+
+  for (uint32_t i = 1; i < kStorePages; ++i) {
+    ASSERT_EQ(cache_read(&node, buf, PAGE_SIZE, i * PAGE_SIZE, &ra),
+              static_cast<int32_t>(PAGE_SIZE));
+    ASSERT_EQ(buf[1], store[(i * PAGE_SIZE) + 1]);
+  }
+  ASSERT_EQ(ra.window, PageCache::kReadAheadMaxPages);
+  // Runs of 5, 6, 12 and 24 pages, then the last page on its own.
+  ASSERT_EQ(run_reads, 4U);
+  ASSERT_EQ(page_reads, 1U);
+  ASSERT_EQ(PageCache::stats().misses, 1U);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, random_read_shrinks_window) {
+  VfsNode node = make_node(kStorePages * PAGE_SIZE, &store_run_ops);
+  PageCache::ReadAhead ra = {.next = 0, .window = PageCache::kReadAheadMaxPages, .end = 0};
+  uint8_t buf[16] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), 20 * PAGE_SIZE, &ra), 16);
+  ASSERT_EQ(ra.window, PageCache::kReadAheadMaxPages / 2);
+  ASSERT_EQ(PageCache::stats().readahead, 0U);
+  ASSERT_EQ(PageCache::stats().resident, 1U);
+
+  // Continuing from there is sequential again and reads ahead, up to the
+  // end of the file.
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), (20 * PAGE_SIZE) + 16, &ra), 16);
+  ASSERT_EQ(ra.window, PageCache::kReadAheadMaxPages);
+  ASSERT_EQ(PageCache::stats().resident, kStorePages - 20);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, restarted_read_stays_sequential) {
+  VfsNode node = make_node(kStorePages * PAGE_SIZE, &store_run_ops);
+  PageCache::ReadAhead ra = {.next = 4 * PAGE_SIZE, .window = 8, .end = 0};
+  static uint8_t buf[PAGE_SIZE];
+
+  // The backend is busy: nothing is read and the state is left alone.
+  busy_reads = 1;
+  ASSERT_EQ(cache_read(&node, buf, PAGE_SIZE, 4 * PAGE_SIZE, &ra), kSyscallRestart);
+  ASSERT_EQ(ra.next, 4 * PAGE_SIZE);
+  ASSERT_EQ(ra.window, 8U);
+  ASSERT_EQ(PageCache::stats().resident, 0U);
+
+  // The restarted read continues the sequential run and grows the window.
+  ASSERT_EQ(cache_read(&node, buf, PAGE_SIZE, 4 * PAGE_SIZE, &ra),
+            static_cast<int32_t>(PAGE_SIZE));
+  ASSERT_EQ(buf[1], store[(4 * PAGE_SIZE) + 1]);
+  ASSERT_EQ(ra.next, 5 * PAGE_SIZE);
+  ASSERT_EQ(ra.window, 16U);
+  ASSERT_EQ(ra.end, 21U);
+  ASSERT_EQ(PageCache::stats().readahead, 16U);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, read_ahead_stops_at_end_of_file) {
+  VfsNode node = make_node((2 * PAGE_SIZE) + 1, &store_run_ops);
+  PageCache::ReadAhead ra = {};
+  uint8_t buf[16] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), 0, &ra), 16);
+  ASSERT_EQ(ra.end, 3U);
+  ASSERT_EQ(PageCache::stats().resident, 3U);
+  PageCache::invalidate(&node);
+}
+
+// ===========================================================================
+// Writes and write-back
+// ===========================================================================
+
+TEST(page_cache, write_is_cached_until_fsync) {
+  VfsNode node = make_node(0);
+  const uint8_t data[] = "cached";
+
+  ASSERT_EQ(cache_write(&node, data, 6, 0), 6);
+  ASSERT_EQ(node.size, 6U);
+  ASSERT_EQ(page_writes, 0U);
+  ASSERT_EQ(PageCache::stats().dirty, 1U);
+
+  uint8_t buf[8] = {};
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), 0), 6);
+  ASSERT_EQ(memcmp(buf, "cached", 6), 0);
+
+  ASSERT_EQ(PageCache::fsync(&node), 0);
+  ASSERT_EQ(page_writes, 1U);
+  ASSERT_EQ(memcmp(store, "cached", 6), 0);
+  ASSERT_EQ(PageCache::stats().dirty, 0U);
+  ASSERT_EQ(PageCache::stats().writebacks, 1U);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, only_partial_writes_inside_file_read_the_page) {
+  VfsNode node = make_node(2 * PAGE_SIZE);
+  static uint8_t page[PAGE_SIZE];
+
+  // A whole page, then a partial write past the end of the file.
+  ASSERT_EQ(cache_write(&node, page, PAGE_SIZE, 0), static_cast<int32_t>(PAGE_SIZE));
+  ASSERT_EQ(cache_write(&node, page, 4, 3 * PAGE_SIZE), 4);
+  ASSERT_EQ(page_reads, 0U);
+
+  // Part of a page that holds file data.
+  const uint8_t byte = 0xAB;
+  ASSERT_EQ(cache_write(&node, &byte, 1, PAGE_SIZE + 1), 1);
+  ASSERT_EQ(page_reads, 1U);
+  uint8_t buf[2] = {};
+  ASSERT_EQ(cache_read(&node, buf, 2, PAGE_SIZE), 2);
+  ASSERT_EQ(buf[0], store[PAGE_SIZE]);
+  ASSERT_EQ(buf[1], 0xAB);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, fsync_writes_highest_page_first) {
+  VfsNode node = make_node(0);
+  const uint8_t byte = 'x';
+
+  ASSERT_EQ(cache_write(&node, &byte, 1, 2 * PAGE_SIZE), 1);
+  ASSERT_EQ(cache_write(&node, &byte, 1, 0), 1);
+  ASSERT_EQ(PageCache::fsync(&node), 0);
+  ASSERT_EQ(page_writes, 2U);
+  ASSERT_EQ(last_written, 0U);
+  ASSERT_EQ(store_size, 2 * PAGE_SIZE + 1);
+  ASSERT_EQ(node.size, 2 * PAGE_SIZE + 1);
+  PageCache::invalidate(&node);
+}
+
+TEST(page_cache, invalidate_discards_dirty_pages) {
+  VfsNode node = make_node(0);
+  const uint32_t before = PageCache::stats().resident;
+  const uint8_t data[] = "lost";
+
+  ASSERT_EQ(cache_write(&node, data, 4, 0), 4);
+  ASSERT_EQ(PageCache::stats().resident, before + 1);
+  PageCache::invalidate(&node);
+  ASSERT_EQ(PageCache::stats().resident, before);
+  ASSERT_EQ(PageCache::fsync(&node), 0);
+  ASSERT_EQ(page_writes, 0U);
+}
+
+TEST(page_cache, shrink_frees_only_clean_pages) {
+  VfsNode node = make_node(PAGE_SIZE);
+  ASSERT_EQ(PageCache::stats().resident, 0U);
+  uint8_t buf[4] = {};
+
+  ASSERT_EQ(cache_read(&node, buf, sizeof(buf), 0), 4);
+  ASSERT_EQ(cache_write(&node, buf, sizeof(buf), PAGE_SIZE), 4);
+  ASSERT_EQ(PageCache::shrink(2), 1U);
+  ASSERT_EQ(PageCache::stats().resident, 1U);
+  ASSERT_EQ(PageCache::stats().dirty, 1U);
+
+  ASSERT_EQ(PageCache::fsync(&node), 0);
+  ASSERT_EQ(PageCache::shrink(1), 1U);
+  ASSERT_EQ(PageCache::stats().resident, 0U);
+}
+
+// ===========================================================================
+// Through the VFS
+// ===========================================================================
+
+TEST(page_cache, vfs_io_goes_through_cache) {
+  Vfs::init();
+  reset_store(0);
+  VfsNode* node = Vfs::register_node("/pc/file", VfsNodeType::File, &store_ops);
+  ASSERT_NOT_NULL(node);
+
+  const int32_t fd = Vfs::open("/pc/file", O_RDWR);
+  ASSERT_TRUE(fd >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd)];
+  ASSERT_NOT_NULL(desc);
+
+  const uint8_t data[] = "hello";
+  ASSERT_EQ(file_write(desc, std::span<const uint8_t>(data, 5)), 5);
+  ASSERT_EQ(node->size, 5U);
+  ASSERT_EQ(page_writes, 0U);
+
+  uint8_t buf[8] = {};
+  ASSERT_EQ(Vfs::pread(desc, std::span<uint8_t>(buf, sizeof(buf)), 1), 4);
+  ASSERT_EQ(memcmp(buf, "ello", 4), 0);
+
+  ASSERT_EQ(Vfs::fsync(desc), 0);
+  ASSERT_EQ(page_writes, 1U);
+  ASSERT_EQ(memcmp(store, "hello", 5), 0);
+
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd)));
+  Vfs::init();
+}
+
+TEST(page_cache, removing_node_writes_back_its_pages) {
+  Vfs::init();
+  reset_store(0);
+  const uint32_t before = PageCache::stats().resident;
+  VfsNode* node = Vfs::register_node("/pc/gone", VfsNodeType::File, &store_ops);
+  ASSERT_NOT_NULL(node);
+
+  const uint8_t data[] = "data";
+  ASSERT_EQ(cache_write(node, data, 4, 0), 4);
+  ASSERT_EQ(PageCache::stats().resident, before + 1);
+  Vfs::unregister_node("/pc/gone");
+  ASSERT_EQ(PageCache::stats().resident, before);
+  ASSERT_EQ(page_writes, 1U);
+  ASSERT_EQ(memcmp(store, "data", 4), 0);
+}
+
+TEST(page_cache, moved_node_keeps_pages_and_open_files) {
+  Vfs::init();
+  reset_store(0);
+  VfsNode* node = Vfs::register_node("/pc/old", VfsNodeType::File, &store_ops);
+  ASSERT_NOT_NULL(node);
+  const int32_t fd = Vfs::open("/pc/old", O_RDWR);
+  ASSERT_TRUE(fd >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd)];
+
+  ASSERT_EQ(Vfs::move_node("/pc/old", "/pc/new"), 0);
+  ASSERT_NULL(Vfs::lookup("/pc/old"));
+  ASSERT_EQ(Vfs::lookup("/pc/new"), node);
+
+  // Writes through the open file land in the moved node, size included.
+  const uint8_t data[] = "moved";
+  ASSERT_EQ(file_write(desc, std::span<const uint8_t>(data, 5)), 5);
+  ASSERT_EQ(node->size, 5U);
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd)));
+  ASSERT_EQ(page_writes, 0U);
+  ASSERT_EQ(PageCache::fsync(node), 0);
+  ASSERT_EQ(memcmp(store, "moved", 5), 0);
+  Vfs::init();
+}
+
+TEST(page_cache, closing_detached_node_writes_back_its_pages) {
+  Vfs::init();
+  reset_store(0);
+  VfsNode* node = Vfs::register_node("/pc/detached", VfsNodeType::File, &store_ops);
+  ASSERT_NOT_NULL(node);
+  const int32_t fd = Vfs::open("/pc/detached", O_RDWR);
+  ASSERT_TRUE(fd >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd)];
+
+  Vfs::unregister_node("/pc/detached");
+  const uint8_t data[] = "late";
+  ASSERT_EQ(file_write(desc, std::span<const uint8_t>(data, 4)), 4);
+  ASSERT_EQ(page_writes, 0U);
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd)));
+  ASSERT_EQ(page_writes, 1U);
+  ASSERT_EQ(memcmp(store, "late", 4), 0);
+}
@@ -1,3 +1,5 @@
+#include <errno.h>
+#include <fcntl.h>
 #include <span.h>
 #include <string.h>
 #include <sys/syscall.h>
@@ -8,6 +10,7 @@
 #include "pipe.h"
 #include "process.h"
 #include "scheduler.h"
+#include "syscall.h"
 
 namespace {
 
@@ -16,13 +19,13 @@ namespace {
 bool make_pipe(uint32_t& rfd, uint32_t& wfd) {
   Process* proc = Scheduler::current();
 
-  auto rfd_opt = fd_alloc(proc->fds);
+  auto rfd_opt = proc->fds.alloc();
   if (!rfd_opt) {
     return false;
   }
   rfd = *rfd_opt;
 
-  auto wfd_opt = fd_alloc_from(proc->fds, rfd + 1);
+  auto wfd_opt = proc->fds.alloc(rfd + 1);
   if (!wfd_opt) {
     return false;
   }
@@ -34,9 +37,11 @@ bool make_pipe(uint32_t& rfd, uint32_t& wfd) {
   }
 
   auto rd = std::make_unique<FileDescription>(FileDescription{
-      .type = FileType::PipeRead, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr});
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = 0});
   auto wr = std::make_unique<FileDescription>(FileDescription{
-      .type = FileType::PipeWrite, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr});
+      .type = FileType::PipeWrite, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = 0});
   if (!rd || !wr) {
     return false;
   }
@@ -44,17 +49,17 @@ bool make_pipe(uint32_t& rfd, uint32_t& wfd) {
   ++pipe->readers;
   ++pipe->writers;
 
-  proc->fds[rfd] = rd.release();
-  proc->fds[wfd] = wr.release();
+  proc->fds.install(rfd, rd.release());
+  proc->fds.install(wfd, wr.release());
   (void)pipe.release();
   return true;
 }
 
 void close_fd(uint32_t fd_num) {
   Process* proc = Scheduler::current();
-  if (fd_num < kMaxFds && (proc->fds[fd_num] != nullptr)) {
-    file_close(proc->fds[fd_num]);
-    proc->fds[fd_num] = nullptr;
+  FileDescription* desc = proc->fds.remove(fd_num);
+  if (desc != nullptr) {
+    file_close(desc);
   }
 }
 
@@ -189,6 +194,77 @@ TEST(pipe, buffer_full_returns_restart) {
   close_fd(wfd);
 }
 
+// ===========================================================================
+// O_NONBLOCK
+// ===========================================================================
+
+TEST(pipe, nonblocking_read_empty_returns_eagain) {
+  uint32_t rfd;
+  uint32_t wfd;
+  ASSERT_TRUE(make_pipe(rfd, wfd));
+
+  Process* proc = Scheduler::current();
+  proc->fds[rfd]->status_flags = O_NONBLOCK;
+
+  uint8_t buf[4];
+  ASSERT_EQ(file_read(proc->fds[rfd], buf), -EAGAIN);
+  ASSERT_NULL(proc->wait_queue);
+
+  close_fd(rfd);
+  close_fd(wfd);
+}
+
+TEST(pipe, nonblocking_write_full_returns_eagain) {
+  uint32_t rfd;
+  uint32_t wfd;
+  ASSERT_TRUE(make_pipe(rfd, wfd));
+
+  Process* proc = Scheduler::current();
+  proc->fds[wfd]->status_flags = O_NONBLOCK;
+
+  uint8_t fill[kPipeBufferSize];
+  memset(fill, 'A', sizeof(fill));
+  ASSERT_EQ(file_write(proc->fds[wfd], fill), static_cast<int32_t>(kPipeBufferSize));
+  const uint8_t extra = 'B';
+  ASSERT_EQ(file_write(proc->fds[wfd], std::span<const uint8_t>(&extra, 1)), -EAGAIN);
+
+  close_fd(rfd);
+  close_fd(wfd);
+}
+
+TEST(pipe, fcntl_setfl_toggles_nonblock) {
+  uint32_t rfd;
+  uint32_t wfd;
+  ASSERT_TRUE(make_pipe(rfd, wfd));
+
+  TrapFrame frame = {};
+  frame.eax = SYS_FCNTL;
+  frame.ebx = rfd;
+  frame.ecx = F_SETFL;
+  frame.edx = O_NONBLOCK;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+  ASSERT_EQ(frame.eax, 0U);
+  ASSERT_EQ(Scheduler::current()->fds[rfd]->status_flags, O_NONBLOCK);
+
+  frame = {};
+  frame.eax = SYS_FCNTL;
+  frame.ebx = rfd;
+  frame.ecx = F_GETFL;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+  ASSERT_EQ(frame.eax, static_cast<uint32_t>(O_RDONLY | O_NONBLOCK));
+
+  frame = {};
+  frame.eax = SYS_FCNTL;
+  frame.ebx = rfd;
+  frame.ecx = F_SETFL;
+  frame.edx = 0;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+  ASSERT_EQ(Scheduler::current()->fds[rfd]->status_flags, 0);
+
+  close_fd(rfd);
+  close_fd(wfd);
+}
+
 // ===========================================================================
 // Pipe close semantics
 // ===========================================================================
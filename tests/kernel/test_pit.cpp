@@ -25,3 +25,30 @@ TEST(pit, sleep_ms_waits) {
   // Should be approximately 10 ticks (100ms / 10ms per tick), ±5.
   ASSERT(abs(static_cast<int>(delta) - 10) <= 5);
 }
+
+// ===========================================================================
+// PIT::now_ns / PIT::set_deadline
+// ===========================================================================
+
+TEST(pit, now_ns_has_sub_tick_resolution) {
+  // Spin until the clock moves; it must move by less than a whole tick.
+  const uint64_t t0 = PIT::now_ns();
+  uint64_t t1 = t0;
+  while (t1 == t0) {
+    t1 = PIT::now_ns();
+  }
+  ASSERT(t1 > t0);
+  ASSERT(t1 - t0 < PIT::kTickNs);
+}
+
+TEST(pit, one_shot_deadline_fires_before_next_tick) {
+  const uint64_t t0 = PIT::now_ns();
+  const uint64_t target = t0 + 2'000'000;  // 2 ms, well under one tick
+  PIT::set_deadline(target);
+  while (PIT::now_ns() < target) {
+    __asm__ volatile("hlt");
+  }
+  const uint64_t elapsed = PIT::now_ns() - t0;
+  ASSERT(elapsed >= 2'000'000);
+  ASSERT(elapsed < PIT::kTickNs);
+}
@@ -0,0 +1,145 @@
+#include <poll.h>
+#include <span.h>
+#include <string.h>
+#include <unique_ptr.h>
+
+#include "file.h"
+#include "ktest.h"
+#include "pipe.h"
+#include "poller.h"
+#include "process.h"
+#include "scheduler.h"
+
+namespace {
+
+// Installs both ends of a fresh pipe in the current fd table.
+bool make_pipe(uint32_t& rfd, uint32_t& wfd) {
+  Process* proc = Scheduler::current();
+
+  auto rfd_opt = proc->fds.alloc();
+  if (!rfd_opt) {
+    return false;
+  }
+  rfd = *rfd_opt;
+
+  auto wfd_opt = proc->fds.alloc(rfd + 1);
+  if (!wfd_opt) {
+    return false;
+  }
+  wfd = *wfd_opt;
+
+  auto pipe = std::make_unique<Pipe>();
+  auto rd = std::make_unique<FileDescription>(FileDescription{
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = 0});
+  auto wr = std::make_unique<FileDescription>(FileDescription{
+      .type = FileType::PipeWrite, .ref_count = 1, .pipe = pipe.get(), .vfs = nullptr,
+      .status_flags = 0});
+  if (!pipe || !rd || !wr) {
+    return false;
+  }
+
+  ++pipe->readers;
+  ++pipe->writers;
+
+  proc->fds.install(rfd, rd.release());
+  proc->fds.install(wfd, wr.release());
+  (void)pipe.release();
+  return true;
+}
+
+void close_fd(uint32_t fd_num) {
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds.remove(fd_num);
+  if (desc != nullptr) {
+    file_close(desc);
+  }
+}
+
+pollfd watch(uint32_t fd_num, int16_t events) {
+  return pollfd{.fd = static_cast<int32_t>(fd_num), .events = events, .revents = 0};
+}
+
+}  // namespace
+
+// ===========================================================================
+// Pipe readiness
+// ===========================================================================
+
+TEST(poll, pipe_empty_is_writable_only) {
+  Pipe pipe;
+  pipe.readers = 1;
+  pipe.writers = 1;
+  ASSERT_EQ(pipe_poll_read(&pipe), 0U);
+  ASSERT_EQ(pipe_poll_write(&pipe), static_cast<uint32_t>(POLLOUT));
+}
+
+TEST(poll, pipe_with_data_is_readable) {
+  Pipe pipe;
+  pipe.readers = 1;
+  pipe.writers = 1;
+  ASSERT_TRUE(pipe.buffer.push('x'));
+  ASSERT_EQ(pipe_poll_read(&pipe), static_cast<uint32_t>(POLLIN));
+}
+
+TEST(poll, pipe_hangup_and_broken) {
+  Pipe pipe;
+  pipe.readers = 0;
+  pipe.writers = 0;
+  ASSERT_EQ(pipe_poll_read(&pipe) & POLLHUP, static_cast<uint32_t>(POLLHUP));
+  ASSERT_EQ(pipe_poll_write(&pipe) & POLLERR, static_cast<uint32_t>(POLLERR));
+}
+
+// ===========================================================================
+// Poll::poll
+// ===========================================================================
+
+TEST(poll, reports_ready_pipe_ends) {
+  uint32_t rfd = 0;
+  uint32_t wfd = 0;
+  ASSERT_TRUE(make_pipe(rfd, wfd));
+
+  pollfd fds[2] = {watch(rfd, POLLIN), watch(wfd, POLLOUT)};
+  ASSERT_EQ(Poll::poll(std::span<pollfd>(fds, 2), 0), 1);
+  ASSERT_EQ(fds[0].revents, 0);
+  ASSERT_EQ(fds[1].revents, POLLOUT);
+
+  const char byte = 'a';
+  ASSERT_EQ(file_write(Scheduler::current()->fds[wfd],
+                       std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&byte), 1)),
+            1);
+  ASSERT_EQ(Poll::poll(std::span<pollfd>(fds, 2), 0), 2);
+  ASSERT_EQ(fds[0].revents, POLLIN);
+
+  close_fd(rfd);
+  close_fd(wfd);
+}
+
+TEST(poll, hangup_reported_without_asking) {
+  uint32_t rfd = 0;
+  uint32_t wfd = 0;
+  ASSERT_TRUE(make_pipe(rfd, wfd));
+  close_fd(wfd);
+
+  pollfd fds[1] = {watch(rfd, 0)};
+  ASSERT_EQ(Poll::poll(std::span<pollfd>(fds, 1), 0), 1);
+  ASSERT_EQ(fds[0].revents, POLLHUP);
+
+  close_fd(rfd);
+}
+
+TEST(poll, bad_and_negative_fds) {
+  pollfd fds[2] = {
+      pollfd{.fd = -1, .events = POLLIN, .revents = 0x7F},
+      pollfd{.fd = static_cast<int32_t>(kMaxFds), .events = POLLIN, .revents = 0},
+  };
+  ASSERT_EQ(Poll::poll(std::span<pollfd>(fds, 2), 0), 1);
+  ASSERT_EQ(fds[0].revents, 0);
+  ASSERT_EQ(fds[1].revents, POLLNVAL);
+}
+
+TEST(poll, zero_timeout_returns_immediately) {
+  pollfd fds[1] = {pollfd{.fd = -1, .events = POLLIN, .revents = 0}};
+  ASSERT_EQ(Poll::poll(std::span<pollfd>(fds, 1), 0), 0);
+  ASSERT_EQ(Scheduler::current()->poll_deadline_ns, 0U);
+}
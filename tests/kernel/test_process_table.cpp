@@ -0,0 +1,90 @@
+#include "ktest.h"
+#include "process.h"
+#include "process_table.h"
+
+// ===========================================================================
+// Allocation and lookup
+// ===========================================================================
+
+TEST(process_table, idle_is_pid_zero) {
+  const Process* idle = ProcessTable::find(0);
+  ASSERT_NOT_NULL(idle);
+  ASSERT_EQ(idle->pid, 0U);
+}
+
+TEST(process_table, alloc_assigns_unique_pids) {
+  Process* a = ProcessTable::alloc();
+  Process* b = ProcessTable::alloc();
+  ASSERT_NOT_NULL(a);
+  ASSERT_NOT_NULL(b);
+  ASSERT_NE(a->pid, b->pid);
+  ASSERT_NE(a->pid, 0U);
+  ASSERT_EQ(a->state, ProcessState::Ready);
+  ASSERT_NULL(a->cwd);
+  ASSERT_EQ(ProcessTable::find(a->pid), a);
+  ASSERT_EQ(ProcessTable::find(b->pid), b);
+  ProcessTable::free(a);
+  ProcessTable::free(b);
+}
+
+TEST(process_table, free_removes_from_lookup_and_count) {
+  const uint32_t before = ProcessTable::count();
+  Process* p = ProcessTable::alloc();
+  ASSERT_NOT_NULL(p);
+  const uint32_t pid = p->pid;
+  ASSERT_EQ(ProcessTable::count(), before + 1);
+  ProcessTable::free(p);
+  ASSERT_NULL(ProcessTable::find(pid));
+  ASSERT_EQ(ProcessTable::count(), before);
+}
+
+TEST(process_table, freed_pcb_is_recycled) {
+  Process* p = ProcessTable::alloc();
+  ASSERT_NOT_NULL(p);
+  const uint32_t old_pid = p->pid;
+  ProcessTable::free(p);
+  Process* q = ProcessTable::alloc();
+  ASSERT_EQ(q, p);
+  // PIDs advance rather than being handed straight back.
+  ASSERT_NE(q->pid, old_pid);
+  ProcessTable::free(q);
+}
+
+TEST(process_table, head_lists_live_processes) {
+  Process* p = ProcessTable::alloc();
+  ASSERT_NOT_NULL(p);
+  bool seen = false;
+  uint32_t n = 0;
+  for (const Process* it = ProcessTable::head(); it != nullptr; it = it->table_next) {
+    seen = seen || it == p;
+    ++n;
+  }
+  ASSERT_TRUE(seen);
+  ASSERT_EQ(n, ProcessTable::count());
+  ProcessTable::free(p);
+}
+
+// ===========================================================================
+// Child lists
+// ===========================================================================
+
+TEST(process_table, child_list_add_and_remove) {
+  Process* parent = ProcessTable::alloc();
+  Process* c1 = ProcessTable::alloc();
+  Process* c2 = ProcessTable::alloc();
+  ProcessTable::add_child(parent, c1);
+  ProcessTable::add_child(parent, c2);
+  ASSERT_EQ(parent->first_child, c2);
+  ASSERT_EQ(c2->next_sibling, c1);
+  ASSERT_EQ(c1->parent, parent);
+
+  ProcessTable::remove_child(c2);
+  ASSERT_EQ(parent->first_child, c1);
+  ASSERT_NULL(c2->parent);
+  ProcessTable::remove_child(c1);
+  ASSERT_NULL(parent->first_child);
+
+  ProcessTable::free(c1);
+  ProcessTable::free(c2);
+  ProcessTable::free(parent);
+}
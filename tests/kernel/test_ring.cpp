@@ -0,0 +1,222 @@
+#include <errno.h>
+#include <string.h>
+#include <sys/ring.h>
+#include <sys/syscall.h>
+
+#include "file.h"
+#include "ktest.h"
+#include "process.h"
+#include "ring.h"
+
+namespace {
+
+constexpr uint32_t kEntries = 4;
+
+// A ring in kernel memory: Ring:: itself never checks where it lives.
+alignas(ring) uint8_t ring_mem[RING_SIZE(kEntries)];
+
+ring* shared() { return reinterpret_cast<ring*>(ring_mem); }
+
+void submit(uint32_t nr, uint32_t arg, uint32_t user_data) {
+  ring* r = shared();
+  ring_sqe& sqe = ring_sqes(r)[r->sq_tail & (kEntries - 1)];
+  sqe = ring_sqe{.nr = nr, .args = {arg, 0, 0}, .user_data = user_data};
+  r->sq_tail = r->sq_tail + 1;
+}
+
+ring_cqe reap() {
+  ring* r = shared();
+  const ring_cqe cqe = ring_cqes(r)[r->cq_head & (kEntries - 1)];
+  r->cq_head = r->cq_head + 1;
+  return cqe;
+}
+
+// Completes with nr + args[0]; SYS_READ with args[0] == 0 "blocks" until
+// blocked_reads_left reaches zero.
+uint32_t calls;
+uint32_t blocked_reads_left;
+
+int32_t fake_call(const ring_sqe& sqe) {
+  ++calls;
+  if (sqe.nr == SYS_READ && sqe.args[0] == 0 && blocked_reads_left > 0) {
+    --blocked_reads_left;
+    return kSyscallRestart;
+  }
+  return static_cast<int32_t>(sqe.nr + sqe.args[0]);
+}
+
+// SYS_READ parks unless args[0] is ready_fd, like a read from a pipe that
+// is still empty; everything else completes with nr + args[0].
+uint32_t ready_fd;
+
+int32_t fd_call(const ring_sqe& sqe) {
+  ++calls;
+  if (sqe.nr == SYS_READ && sqe.args[0] != ready_fd) {
+    return kSyscallRestart;
+  }
+  return static_cast<int32_t>(sqe.nr + sqe.args[0]);
+}
+
+struct RingFixture {
+  Process proc{};
+
+  RingFixture() {
+    calls = 0;
+    blocked_reads_left = 0;
+    ready_fd = UINT32_MAX;
+    memset(ring_mem, 0xAB, sizeof(ring_mem));
+  }
+  ~RingFixture() { Ring::release(&proc); }
+};
+
+}  // namespace
+
+// ===========================================================================
+// Setup
+// ===========================================================================
+
+TEST(ring, setup_rejects_bad_entry_counts) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), 0), -EINVAL);
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), 3), -EINVAL);
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), RING_MAX_ENTRIES * 2), -EINVAL);
+  ASSERT_NULL(f.proc.ring);
+}
+
+TEST(ring, setup_resets_the_queues) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  ASSERT_NOT_NULL(f.proc.ring);
+  ASSERT_EQ(shared()->sq_head, 0U);
+  ASSERT_EQ(shared()->sq_tail, 0U);
+  ASSERT_EQ(shared()->cq_head, 0U);
+  ASSERT_EQ(shared()->cq_tail, 0U);
+  ASSERT_EQ(shared()->entries, kEntries);
+}
+
+TEST(ring, enter_without_ring_fails) {
+  RingFixture f;
+  ASSERT_EQ(Ring::enter(&f.proc, 1, 0, fake_call), -ENXIO);
+}
+
+// ===========================================================================
+// Submission and completion
+// ===========================================================================
+
+TEST(ring, batch_completes_in_one_enter) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  submit(SYS_WRITE, 10, 100);
+  submit(SYS_STAT, 20, 101);
+  submit(SYS_CLOSE, 30, 102);
+
+  ASSERT_EQ(Ring::enter(&f.proc, 3, 3, fake_call), 3);
+  ASSERT_EQ(calls, 3U);
+  ASSERT_EQ(shared()->sq_head, 3U);
+
+  ring_cqe cqe = reap();
+  ASSERT_EQ(cqe.user_data, 100U);
+  ASSERT_EQ(cqe.res, static_cast<int32_t>(SYS_WRITE + 10));
+  cqe = reap();
+  ASSERT_EQ(cqe.user_data, 101U);
+  cqe = reap();
+  ASSERT_EQ(cqe.user_data, 102U);
+  ASSERT_EQ(cqe.res, static_cast<int32_t>(SYS_CLOSE + 30));
+}
+
+TEST(ring, to_submit_limits_the_batch) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  submit(SYS_WRITE, 1, 1);
+  submit(SYS_WRITE, 2, 2);
+  ASSERT_EQ(Ring::enter(&f.proc, 1, 0, fake_call), 1);
+  ASSERT_EQ(shared()->sq_head, 1U);
+  ASSERT_EQ(Ring::enter(&f.proc, 8, 0, fake_call), 2);
+  ASSERT_EQ(shared()->sq_head, 2U);
+}
+
+TEST(ring, full_cq_stops_submission) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  for (uint32_t i = 0; i < kEntries; ++i) {
+    submit(SYS_WRITE, i, i);
+  }
+  ASSERT_EQ(Ring::enter(&f.proc, kEntries, 0, fake_call), static_cast<int32_t>(kEntries));
+
+  // No room for another completion until the program reads one.
+  submit(SYS_WRITE, 9, 9);
+  ASSERT_EQ(Ring::enter(&f.proc, 1, 0, fake_call), static_cast<int32_t>(kEntries));
+  ASSERT_EQ(shared()->sq_head, kEntries);
+  static_cast<void>(reap());
+  ASSERT_EQ(Ring::enter(&f.proc, 1, 0, fake_call), static_cast<int32_t>(kEntries));
+  ASSERT_EQ(shared()->sq_head, kEntries + 1);
+}
+
+// ===========================================================================
+// Parked calls
+// ===========================================================================
+
+TEST(ring, blocking_call_does_not_hold_up_the_batch) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  blocked_reads_left = 1;
+  submit(SYS_READ, 0, 50);
+  submit(SYS_WRITE, 5, 51);
+
+  // The read parks; the write behind it completes at once.
+  ASSERT_EQ(Ring::enter(&f.proc, 2, 0, fake_call), 1);
+  ASSERT_EQ(f.proc.ring->parked, 1U);
+  ASSERT_EQ(reap().user_data, 51U);
+
+  // The next enter retries the read, which now completes.
+  ASSERT_EQ(Ring::enter(&f.proc, 0, 0, fake_call), 1);
+  ASSERT_EQ(f.proc.ring->parked, 0U);
+  const ring_cqe cqe = reap();
+  ASSERT_EQ(cqe.user_data, 50U);
+  ASSERT_EQ(cqe.res, static_cast<int32_t>(SYS_READ));
+}
+
+TEST(ring, parked_calls_reserve_cq_slots) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  blocked_reads_left = 100;
+  for (uint32_t i = 0; i < kEntries; ++i) {
+    submit(SYS_READ, 0, i);
+  }
+  submit(SYS_WRITE, 1, 99);
+  ASSERT_EQ(Ring::enter(&f.proc, kEntries + 1, 0, fake_call), 0);
+  ASSERT_EQ(f.proc.ring->parked, kEntries);
+  ASSERT_EQ(shared()->sq_head, kEntries);
+}
+
+TEST(ring, restarted_enter_waits_for_any_parked_call) {
+  RingFixture f;
+  ASSERT_EQ(Ring::setup(&f.proc, shared(), kEntries), 0);
+  submit(SYS_READ, 3, 60);
+  submit(SYS_READ, 4, 61);
+
+  // Both reads park; min_complete 1 sends the caller to sleep.
+  ASSERT_EQ(Ring::enter(&f.proc, 2, 1, fd_call), kSyscallRestart);
+  ASSERT_EQ(f.proc.ring->parked, 2U);
+  ASSERT_EQ(shared()->sq_head, 2U);
+
+  // The program queues more work while it sleeps. The restarted enter()
+  // comes back with the same to_submit but must not take it.
+  submit(SYS_WRITE, 7, 62);
+  ASSERT_EQ(Ring::enter(&f.proc, 2, 1, fd_call), kSyscallRestart);
+  ASSERT_EQ(shared()->sq_head, 2U);
+
+  // Only the second read becomes ready: that alone ends the wait.
+  ready_fd = 4;
+  ASSERT_EQ(Ring::enter(&f.proc, 2, 1, fd_call), 1);
+  ASSERT_EQ(f.proc.ring->parked, 1U);
+  ASSERT_EQ(shared()->sq_head, 2U);
+  const ring_cqe cqe = reap();
+  ASSERT_EQ(cqe.user_data, 61U);
+  ASSERT_EQ(cqe.res, static_cast<int32_t>(SYS_READ + 4));
+
+  // The next enter() is a fresh call and takes the queued write.
+  ASSERT_EQ(Ring::enter(&f.proc, 1, 0, fd_call), 1);
+  ASSERT_EQ(shared()->sq_head, 3U);
+  ASSERT_EQ(reap().user_data, 62U);
+}
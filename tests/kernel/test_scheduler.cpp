@@ -1,8 +1,11 @@
+#include <signal.h>
 #include <span.h>
 #include <string.h>
+#include <sys/schedstat.h>
 
 #include "address_space.h"
 #include "elf.h"
+#include "gdt.h"
 #include "ktest.h"
 #include "paging.h"
 #include "pmm.h"
@@ -235,3 +238,83 @@ TEST(scheduler, create_multiple_processes) {
   ASSERT_NE(p2->pid, p3->pid);
   ASSERT_TRUE(p3->pid > p1->pid);
 }
+
+// ===========================================================================
+// Kernel threads
+// ===========================================================================
+
+namespace {
+
+void kthread_noop([[maybe_unused]] void* arg) {}
+
+}  // namespace
+
+TEST(scheduler, kthread_create_builds_ring0_process) {
+  int token = 0;
+  const Process* p = Scheduler::kthread_create(kthread_noop, &token);
+  ASSERT_NOT_NULL(p);
+  ASSERT_NE(p->pid, 0U);
+  ASSERT_EQ(p->state, ProcessState::Ready);
+  ASSERT_TRUE(p->kernel_thread);
+  ASSERT_EQ(p->kthread_arg, static_cast<void*>(&token));
+  ASSERT_EQ(p->page_directory, &boot_page_directory);
+
+  const auto* frame = reinterpret_cast<const TrapFrame*>(p->kernel_esp);
+  ASSERT_EQ(frame->cs, static_cast<uint32_t>(GDT::KERNEL_CODE_SELECTOR));
+  ASSERT_EQ(frame->ds, static_cast<uint32_t>(GDT::KERNEL_DATA_SELECTOR));
+  ASSERT_EQ(frame->eflags & 0x200U, 0U);  // runs with interrupts disabled
+}
+
+TEST(scheduler, kthreads_are_not_user_processes) {
+  const Process* p = Scheduler::kthread_create(kthread_noop, nullptr);
+  ASSERT_NOT_NULL(p);
+  // Signals are not delivered to kernel threads.
+  Scheduler::send_signal(p->pid, SIGINT);
+  ASSERT_EQ(p->pending_signals, 0U);
+}
+
+// ===========================================================================
+// Statistics
+// ===========================================================================
+
+TEST(scheduler, set_name_uses_basename) {
+  Process p{};
+  Scheduler::set_name(&p, "/bin/sh");
+  ASSERT_EQ(strcmp(p.name, "sh"), 0);
+  Scheduler::set_name(&p, "a_very_long_program_name");
+  ASSERT_EQ(strlen(p.name), kProcessNameLen - 1);
+}
+
+TEST(scheduler, get_stats_reports_processes) {
+  TestElf elf;
+  make_test_elf(elf, 0x00400000);
+  const Process* p = Scheduler::create_process(
+      std::span<const uint8_t>{reinterpret_cast<const uint8_t*>(&elf), sizeof(elf)}, "/bin/stat");
+  ASSERT_NOT_NULL(p);
+
+  static sched_stat stat;
+  static proc_stat procs[64];
+  const uint32_t n = Scheduler::get_stats(&stat, procs);
+  ASSERT_EQ(stat.cpu_count, 1U);
+  ASSERT_TRUE(stat.uptime_ns > 0);
+  ASSERT_EQ(n, stat.nr_procs);
+
+  const proc_stat* found = nullptr;
+  for (uint32_t i = 0; i < n; ++i) {
+    ASSERT_NE(procs[i].pid, 0U);  // idle is reported as idle_ns only
+    if (procs[i].pid == p->pid) {
+      found = &procs[i];
+    }
+  }
+  ASSERT_NOT_NULL(found);
+  ASSERT_EQ(strcmp(found->name, "stat"), 0);
+  ASSERT_EQ(found->state, PROC_STATE_READY);
+  ASSERT_EQ(found->kernel_thread, 0U);
+}
+
+TEST(scheduler, get_stats_respects_buffer_size) {
+  static sched_stat stat;
+  proc_stat one{};
+  ASSERT_TRUE(Scheduler::get_stats(&stat, std::span<proc_stat>{&one, 1}) <= 1U);
+  ASSERT_EQ(Scheduler::get_stats(&stat, std::span<proc_stat>{}), 0U);
+}
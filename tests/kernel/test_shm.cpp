@@ -143,6 +143,34 @@ TEST(shm, last_detach_frees_region) {
   AddressSpace::destroy(pd, pd_phys);
 }
 
+TEST(shm, detach_unmaps_every_page_of_a_range) {
+  auto [pd_phys, pd] = AddressSpace::create();
+  ASSERT_NOT_NULL(pd);
+
+  Process* proc = Scheduler::current();
+  PageTable* orig_pd = proc->page_directory;
+  const paddr_t orig_pd_phys = proc->page_directory_phys;
+  proc->page_directory = pd;
+  proc->page_directory_phys = pd_phys;
+
+  const int32_t id = Shm::create(3 * PAGE_SIZE);
+  ASSERT(id >= 0);
+  const vaddr_t va{0x00A00000};
+  ASSERT_NE(Shm::attach(static_cast<uint32_t>(id), va), -1);
+
+  // ktests run on the BSP alone, so no other CPU can cache the mapping
+  // and detach needs no shootdown.
+  ASSERT_FALSE(Scheduler::group_running_elsewhere(proc->group()));
+  ASSERT_NE(Shm::detach(va, 3 * PAGE_SIZE), -1);
+  for (uint32_t p = 0; p < 3; ++p) {
+    ASSERT_FALSE(AddressSpace::is_user_mapped(pd, va + p * PAGE_SIZE, /*writeable=*/false));
+  }
+
+  proc->page_directory = orig_pd;
+  proc->page_directory_phys = orig_pd_phys;
+  AddressSpace::destroy(pd, pd_phys);
+}
+
 // ===========================================================================
 // AddressSpace::unmap_nofree
 // ===========================================================================
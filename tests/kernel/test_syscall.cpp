@@ -1,4 +1,5 @@
 #include <errno.h>
+#include <stdio.h>
 #include <string.h>
 #include <sys/syscall.h>
 
@@ -10,7 +11,9 @@
 #include "process.h"
 #include "scheduler.h"
 #include "syscall.h"
+#include "tss.h"
 #include "vfs.h"
+#include "x86.h"
 
 namespace {
 
@@ -20,7 +23,35 @@ int32_t stub_read([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<uin
   return 0;
 }
 const VfsOps kStubOps = {
-    .read = stub_read, .write = nullptr, .ioctl = nullptr, .truncate = nullptr};
+    .read = stub_read,
+    .write = nullptr,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
+
+// Point the current process's cwd at the directory at path, or back at
+// the root for nullptr, moving the node reference like chdir does.
+void set_cwd(const char* path) {
+  Process* proc = Scheduler::current();
+  VfsNode* node = path != nullptr ? Vfs::lookup(path) : nullptr;
+  Vfs::node_get(node);
+  Vfs::node_put(proc->cwd);
+  proc->cwd = node;
+}
+
+// The current process's cwd as a path ("" if it cannot be built).
+const char* cwd_path() {
+  static char buf[kMaxPathLen];
+  if (Vfs::node_path(Scheduler::current()->cwd, buf, sizeof(buf)) < 0) {
+    buf[0] = '\0';
+  }
+  return buf;
+}
 
 // Maps a fresh physical page at kUserAddr in the CURRENT process's page
 // directory (so the existing CR3 sees it), writes `str` into it via the
@@ -38,7 +69,7 @@ struct UserPathPage {
 
     const Process* proc = Scheduler::current();
     // Map into the currently active page directory so that both
-    // validate_user_buffer and direct kernel reads of the user pointer work.
+    // the copy routines and direct kernel reads of the user pointer work.
     AddressSpace::map(proc->page_directory, kUserAddr, page_phys,
                       /*writeable=*/true, /*user=*/true);
   }
@@ -71,6 +102,51 @@ TEST(syscall, getpid) {
   ASSERT_EQ(frame.eax, 0U);
 }
 
+// ===========================================================================
+// Fast entry (sysenter)
+// ===========================================================================
+
+extern "C" void sysenter_entry();
+
+TEST(syscall, sysenter_msrs_point_at_entry) {
+  if (!Syscall::has_sysenter()) {
+    return;  // int 0x80 only on this CPU
+  }
+  ASSERT_EQ(rdmsr(0x174), static_cast<uint64_t>(GDT::KERNEL_CODE_SELECTOR));
+  ASSERT_EQ(rdmsr(0x175), static_cast<uint64_t>(reinterpret_cast<uint32_t>(&TSS::tss[0].esp0)));
+  ASSERT_EQ(rdmsr(0x176), static_cast<uint64_t>(reinterpret_cast<uint32_t>(sysenter_entry)));
+}
+
+// Microbenchmark: getpid round trips through the int 0x80 gate, against the
+// dispatch cost alone. ktests run in ring 0 with no user process, so the
+// sysenter stub (which returns to ring 3) cannot be timed here; what it
+// saves is part of the difference between the two figures.
+TEST(syscall, getpid_round_trip_latency) {
+  static constexpr uint32_t kIterations = 1000;
+
+  const uint64_t trap_start = rdtsc();
+  for (uint32_t i = 0; i < kIterations; ++i) {
+    int32_t pid = -1;
+    __asm__ volatile("int $0x80" : "=a"(pid) : "a"(SYS_GETPID) : "memory");
+    ASSERT_EQ(pid, 0);
+  }
+  const uint64_t trap_cycles = rdtsc() - trap_start;
+
+  const uint64_t dispatch_start = rdtsc();
+  for (uint32_t i = 0; i < kIterations; ++i) {
+    TrapFrame frame = {};
+    frame.eax = SYS_GETPID;
+    syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+    ASSERT_EQ(frame.eax, 0U);
+  }
+  const uint64_t dispatch_cycles = rdtsc() - dispatch_start;
+
+  printf("[getpid: int 0x80 %u cycles, dispatch only %u cycles] ",
+         static_cast<unsigned>(trap_cycles / kIterations),
+         static_cast<unsigned>(dispatch_cycles / kIterations));
+  ASSERT_TRUE(trap_cycles > 0);
+}
+
 // ===========================================================================
 // SYS_WRITE
 // ===========================================================================
@@ -230,7 +306,7 @@ TEST(syscall, sbrk_allocates_page) {
 // SYS_EXEC
 // ===========================================================================
 
-// A name pointer at or above KERNEL_VMA fails validate_user_buffer immediately.
+// A name pointer at or above KERNEL_VMA fails the user range check immediately.
 TEST(syscall, exec_name_in_kernel_space) {
   TrapFrame frame = {};
   frame.eax = SYS_EXEC;
@@ -308,9 +384,8 @@ TEST(syscall, chdir_path_in_kernel_space) {
 }
 
 TEST(syscall, getcwd_returns_current_cwd) {
-  Process* proc = Scheduler::current();
   // Put a known CWD in the process.
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 
   // Allocate a user-space page to receive the result.
   const UserPathPage up("");
@@ -327,15 +402,14 @@ TEST(syscall, getcwd_returns_current_cwd) {
   ASSERT_STR_EQ(kva, "/");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_absolute_path) {
   Vfs::init();
   ASSERT_NOT_NULL(Vfs::register_node("/bin/sh", VfsNodeType::File, &kStubOps));
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd("/");
 
   const UserPathPage up("/bin");
 
@@ -344,18 +418,17 @@ TEST(syscall, chdir_absolute_path) {
   frame.ebx = UserPathPage::kUserAddr;
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, 0U);
-  ASSERT_STR_EQ(proc->cwd, "/bin");
+  ASSERT_STR_EQ(cwd_path(), "/bin");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_relative_path) {
   Vfs::init();
   ASSERT_NOT_NULL(Vfs::register_node("/bin/sh", VfsNodeType::File, &kStubOps));
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd("/");
 
   // Relative path "bin" from "/" should resolve to "/bin".
   const UserPathPage up("bin");
@@ -365,18 +438,17 @@ TEST(syscall, chdir_relative_path) {
   frame.ebx = UserPathPage::kUserAddr;
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, 0U);
-  ASSERT_STR_EQ(proc->cwd, "/bin");
+  ASSERT_STR_EQ(cwd_path(), "/bin");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_dot_dot) {
   Vfs::init();
   ASSERT_NOT_NULL(Vfs::register_node("/bin/sh", VfsNodeType::File, &kStubOps));
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/bin", sizeof(proc->cwd));
+  set_cwd("/bin");
 
   const UserPathPage up("..");
 
@@ -385,18 +457,17 @@ TEST(syscall, chdir_dot_dot) {
   frame.ebx = UserPathPage::kUserAddr;
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, 0U);
-  ASSERT_STR_EQ(proc->cwd, "/");
+  ASSERT_STR_EQ(cwd_path(), "/");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_dot) {
   Vfs::init();
   ASSERT_NOT_NULL(Vfs::register_node("/bin/sh", VfsNodeType::File, &kStubOps));
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/bin", sizeof(proc->cwd));
+  set_cwd("/bin");
 
   const UserPathPage up(".");
 
@@ -405,17 +476,16 @@ TEST(syscall, chdir_dot) {
   frame.ebx = UserPathPage::kUserAddr;
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, 0U);
-  ASSERT_STR_EQ(proc->cwd, "/bin");
+  ASSERT_STR_EQ(cwd_path(), "/bin");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_dot_dot_at_root_stays_root) {
   Vfs::init();
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd("/");
 
   const UserPathPage up("..");
 
@@ -424,17 +494,16 @@ TEST(syscall, chdir_dot_dot_at_root_stays_root) {
   frame.ebx = UserPathPage::kUserAddr;
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, 0U);
-  ASSERT_STR_EQ(proc->cwd, "/");
+  ASSERT_STR_EQ(cwd_path(), "/");
 
   UserPathPage::restore();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd(nullptr);
 }
 
 TEST(syscall, chdir_nonexistent) {
   Vfs::init();
 
-  Process* proc = Scheduler::current();
-  strncpy(proc->cwd, "/", sizeof(proc->cwd));
+  set_cwd("/");
 
   const UserPathPage up("/nonexistent");
 
@@ -444,7 +513,27 @@ TEST(syscall, chdir_nonexistent) {
   syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
   ASSERT_EQ(frame.eax, static_cast<uint32_t>(-ENOENT));
   // CWD must be unchanged on failure.
-  ASSERT_STR_EQ(proc->cwd, "/");
+  ASSERT_STR_EQ(cwd_path(), "/");
+
+  UserPathPage::restore();
+  set_cwd(nullptr);
+}
+
+TEST(syscall, chdir_to_file_is_enotdir) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/bin/sh", VfsNodeType::File, &kStubOps));
+
+  set_cwd("/bin");
+
+  const UserPathPage up("sh");
+
+  TrapFrame frame = {};
+  frame.eax = SYS_CHDIR;
+  frame.ebx = UserPathPage::kUserAddr;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+  ASSERT_EQ(frame.eax, static_cast<uint32_t>(-ENOTDIR));
+  ASSERT_STR_EQ(cwd_path(), "/bin");
 
   UserPathPage::restore();
+  set_cwd(nullptr);
 }
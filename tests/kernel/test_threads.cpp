@@ -0,0 +1,66 @@
+#include "gdt.h"
+#include "ktest.h"
+#include "process.h"
+#include "scheduler.h"
+#include "smp.h"
+
+// ===========================================================================
+// Per-CPU TLS descriptors
+// ===========================================================================
+
+TEST(threads, tls_selectors_are_distinct_user_selectors) {
+  for (uint32_t cpu = 0; cpu < Smp::kMaxCpus; ++cpu) {
+    const uint16_t sel = GDT::tls_selector(cpu);
+    ASSERT_EQ(sel & 3U, 3U);
+    ASSERT_TRUE(GDT::is_tls_selector(sel));
+    ASSERT_NE(sel, GDT::tss_selector(cpu) | 3U);
+    if (cpu > 0) {
+      ASSERT_NE(sel, GDT::tls_selector(cpu - 1));
+    }
+  }
+}
+
+TEST(threads, flat_selectors_are_not_tls) {
+  ASSERT_FALSE(GDT::is_tls_selector(GDT::USER_DATA_SELECTOR));
+  ASSERT_FALSE(GDT::is_tls_selector(GDT::KERNEL_DATA_SELECTOR));
+  ASSERT_FALSE(GDT::is_tls_selector(0));
+}
+
+TEST(threads, set_tls_base_is_visible_through_gs) {
+  static uint32_t block[2] = {0xC0FFEE, 0};
+  GDT::set_tls(0, reinterpret_cast<uint32_t>(block));
+
+  uint32_t saved_gs;
+  uint32_t value;
+  const uint32_t sel = GDT::tls_selector(0);
+  asm volatile(
+      "mov %%gs, %0\n"
+      "mov %2, %%gs\n"
+      "mov %%gs:0, %1\n"
+      "mov %0, %%gs\n"
+      : "=&r"(saved_gs), "=&r"(value)
+      : "r"(sel)
+      : "memory");
+  ASSERT_EQ(value, 0xC0FFEEU);
+  GDT::set_tls(0, 0);
+}
+
+// ===========================================================================
+// Thread groups
+// ===========================================================================
+
+TEST(threads, process_is_its_own_group) {
+  Process* self = Scheduler::current();
+  ASSERT_NOT_NULL(self);
+  ASSERT_NULL(self->group_leader);
+  ASSERT_TRUE(self->group() == self);
+}
+
+TEST(threads, thread_group_is_its_leader) {
+  static Process leader{};
+  static Process thread{};
+  thread.group_leader = &leader;
+  ASSERT_TRUE(thread.group() == &leader);
+  ASSERT_TRUE(static_cast<const Process&>(thread).group() == &leader);
+  ASSERT_TRUE(leader.group() == &leader);
+}
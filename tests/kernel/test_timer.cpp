@@ -0,0 +1,106 @@
+#include "ktest.h"
+#include "pit.h"
+#include "timer.h"
+
+// The scheduler is not started during ktests, so nothing else runs timers;
+// each test drives run_timers() with an explicit "now".
+
+namespace {
+
+uint32_t fired_order[8];
+uint32_t fired_count = 0;
+
+void record(void* arg) {
+  fired_order[fired_count++] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
+}
+
+void reset_record() { fired_count = 0; }
+
+}  // namespace
+
+// ===========================================================================
+// add_timer / run_timers
+// ===========================================================================
+
+TEST(timer, fires_in_deadline_order) {
+  reset_record();
+  Timer a{};
+  Timer b{};
+  Timer c{};
+  add_timer(&b, 200, record, reinterpret_cast<void*>(2));
+  add_timer(&c, 300, record, reinterpret_cast<void*>(3));
+  add_timer(&a, 100, record, reinterpret_cast<void*>(1));
+  ASSERT_EQ(next_timer_deadline(), 100U);
+
+  run_timers(250);
+  ASSERT_EQ(fired_count, 2U);
+  ASSERT_EQ(fired_order[0], 1U);
+  ASSERT_EQ(fired_order[1], 2U);
+  ASSERT_FALSE(timer_pending(&a));
+  ASSERT_TRUE(timer_pending(&c));
+  ASSERT_EQ(next_timer_deadline(), 300U);
+
+  run_timers(300);
+  ASSERT_EQ(fired_count, 3U);
+  ASSERT_EQ(next_timer_deadline(), PIT::kNoDeadline);
+}
+
+TEST(timer, readd_moves_deadline) {
+  reset_record();
+  Timer a{};
+  Timer b{};
+  add_timer(&a, 100, record, reinterpret_cast<void*>(1));
+  add_timer(&b, 200, record, reinterpret_cast<void*>(2));
+  add_timer(&a, 300, record, reinterpret_cast<void*>(1));
+  ASSERT_EQ(next_timer_deadline(), 200U);
+
+  run_timers(1000);
+  ASSERT_EQ(fired_count, 2U);
+  ASSERT_EQ(fired_order[0], 2U);
+  ASSERT_EQ(fired_order[1], 1U);
+}
+
+// ===========================================================================
+// cancel_timer
+// ===========================================================================
+
+TEST(timer, cancel_removes_from_middle) {
+  reset_record();
+  Timer t[5] = {};
+  for (uint32_t i = 0; i < 5; ++i) {
+    add_timer(&t[i], 100 * (i + 1), record, reinterpret_cast<void*>(i));
+  }
+  ASSERT_TRUE(cancel_timer(&t[2]));
+  ASSERT_TRUE(cancel_timer(&t[0]));
+  ASSERT_FALSE(cancel_timer(&t[0]));
+  ASSERT_EQ(next_timer_deadline(), 200U);
+
+  run_timers(1000);
+  ASSERT_EQ(fired_count, 3U);
+  ASSERT_EQ(fired_order[0], 1U);
+  ASSERT_EQ(fired_order[1], 3U);
+  ASSERT_EQ(fired_order[2], 4U);
+}
+
+TEST(timer, no_limit_on_pending_timers) {
+  // More than the old fixed-size heap held, armed in reverse order.
+  static Timer t[600] = {};
+  for (uint32_t i = 600; i > 0; --i) {
+    add_timer(&t[i - 1], 1000 + i, [](void*) {}, nullptr);
+  }
+  ASSERT_TRUE(cancel_timer(&t[300]));
+  ASSERT_EQ(next_timer_deadline(), 1001U);
+
+  run_timers(1300);
+  ASSERT_FALSE(timer_pending(&t[298]));
+  ASSERT_TRUE(timer_pending(&t[300 + 1]));
+  ASSERT_EQ(next_timer_deadline(), 1302U);
+  run_timers(2000);
+  ASSERT_EQ(next_timer_deadline(), PIT::kNoDeadline);
+}
+
+TEST(timer, cancel_idle_timer_returns_false) {
+  Timer t{};
+  ASSERT_FALSE(timer_pending(&t));
+  ASSERT_FALSE(cancel_timer(&t));
+}
@@ -0,0 +1,114 @@
+#include <array.h>
+#include <span.h>
+#include <sys/syscall.h>
+#include <sys/trace.h>
+
+#include "file.h"
+#include "ktest.h"
+#include "process.h"
+#include "scheduler.h"
+#include "syscall.h"
+#include "trace.h"
+
+namespace {
+
+// Issue SYS_GETPID through the real dispatch path with recognisable args.
+void dispatch_getpid() {
+  TrapFrame frame = {};
+  frame.eax = SYS_GETPID;
+  frame.ebx = 0x11;
+  frame.ecx = 0x22;
+  frame.edx = 0x33;
+  syscall_dispatch(reinterpret_cast<uint32_t>(&frame));
+}
+
+}  // namespace
+
+// ===========================================================================
+// Recording
+// ===========================================================================
+
+TEST(trace, disabled_records_nothing) {
+  Trace::start(TRACE_ALL);
+  Trace::stop();
+  dispatch_getpid();
+
+  trace_event event;
+  ASSERT_EQ(Trace::read(std::span<trace_event>(&event, 1)), 0U);
+}
+
+TEST(trace, records_traced_pid) {
+  Trace::start(Scheduler::current()->pid);
+  dispatch_getpid();
+  Trace::stop();
+
+  trace_event event = {};
+  ASSERT_EQ(Trace::read(std::span<trace_event>(&event, 1)), 1U);
+  ASSERT_EQ(event.seq, 0U);
+  ASSERT_EQ(event.pid, Scheduler::current()->pid);
+  ASSERT_EQ(event.nr, static_cast<uint32_t>(SYS_GETPID));
+  ASSERT_EQ(event.args[0], 0x11U);
+  ASSERT_EQ(event.args[2], 0x33U);
+  ASSERT_EQ(event.ret, static_cast<int32_t>(Scheduler::current()->pid));
+}
+
+TEST(trace, other_pid_not_recorded) {
+  Trace::start(Scheduler::current()->pid + 1000);
+  dispatch_getpid();
+  Trace::stop();
+
+  trace_event event;
+  ASSERT_EQ(Trace::read(std::span<trace_event>(&event, 1)), 0U);
+}
+
+// ===========================================================================
+// Buffer and statistics
+// ===========================================================================
+
+TEST(trace, full_buffer_drops_and_counts) {
+  Trace::start(TRACE_ALL);
+  const uint32_t args[3] = {0, 0, 0};
+  for (size_t i = 0; i < Trace::kCapacity + 4; ++i) {
+    Trace::record(0, SYS_GETPID, args, 0, 100);
+  }
+  Trace::stop();
+
+  // One slot stays reserved for exit events.
+  std::array<trace_hist, SYS_MAX> hists = {};
+  ASSERT_EQ(Trace::stats(std::span<trace_hist>(hists.data(), hists.size())), 5U);
+  ASSERT_EQ(hists[SYS_GETPID].count, static_cast<uint32_t>(Trace::kCapacity + 4));
+  ASSERT_EQ(hists[SYS_GETPID].buckets[6], static_cast<uint32_t>(Trace::kCapacity + 4));
+  ASSERT_EQ(hists[SYS_GETPID].max_cycles, 100U);
+}
+
+TEST(trace, histogram_buckets_by_log2) {
+  Trace::start(TRACE_ALL);
+  const uint32_t args[3] = {0, 0, 0};
+  Trace::record(0, SYS_READ, args, -9, 1);
+  Trace::record(0, SYS_READ, args, 0, 1024);
+  Trace::record(0, SYS_READ, args, kSyscallRestart, 0x100000000ULL);
+  Trace::stop();
+
+  std::array<trace_hist, SYS_MAX> hists = {};
+  ASSERT_EQ(Trace::stats(std::span<trace_hist>(hists.data(), hists.size())), 0U);
+  const trace_hist& read = hists[SYS_READ];
+  ASSERT_EQ(read.count, 3U);
+  ASSERT_EQ(read.errors, 1U);
+  ASSERT_EQ(read.buckets[0], 1U);
+  ASSERT_EQ(read.buckets[10], 1U);
+  ASSERT_EQ(read.buckets[TRACE_BUCKETS - 1], 1U);
+}
+
+TEST(trace, start_resets_previous_trace) {
+  Trace::start(TRACE_ALL);
+  const uint32_t args[3] = {0, 0, 0};
+  Trace::record(0, SYS_READ, args, 0, 1);
+  Trace::start(TRACE_ALL);
+  Trace::stop();
+
+  trace_event event;
+  ASSERT_EQ(Trace::read(std::span<trace_event>(&event, 1)), 0U);
+  std::array<trace_hist, SYS_MAX> hists = {};
+  ASSERT_EQ(Trace::stats(std::span<trace_hist>(hists.data(), hists.size())), 0U);
+  ASSERT_EQ(hists[SYS_READ].count, 0U);
+}
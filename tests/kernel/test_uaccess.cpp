@@ -0,0 +1,120 @@
+#include <errno.h>
+#include <string.h>
+
+#include "address_space.h"
+#include "ktest.h"
+#include "paging.h"
+#include "pmm.h"
+#include "process.h"
+#include "scheduler.h"
+#include "uaccess.h"
+
+namespace {
+
+// Nothing is mapped at low user addresses in the kernel's own page
+// directory, so touching this faults and exercises the fixup path.
+constexpr uint32_t kUnmappedAddr = 0x00001000;
+
+// A user page mapped into the active page directory for one test.
+struct UserPage {
+  static constexpr uint32_t kAddr = 0x00400000;
+
+  paddr_t phys;
+
+  explicit UserPage(bool writeable) : phys(kPmm.alloc()) {
+    memset(phys_to_virt(phys).ptr<char>(), 0, PAGE_SIZE);
+    AddressSpace::map(Scheduler::current()->page_directory, kAddr, phys, writeable,
+                      /*user=*/true);
+  }
+  ~UserPage() { AddressSpace::unmap(Scheduler::current()->page_directory, kAddr); }
+
+  char* kva() const { return phys_to_virt(phys).ptr<char>(); }
+};
+
+}  // namespace
+
+// ===========================================================================
+// Range checks
+// ===========================================================================
+
+TEST(uaccess, range_ok_rejects_kernel_and_overflow) {
+  ASSERT_TRUE(user_range_ok(0x1000, 16));
+  ASSERT_TRUE(user_range_ok(static_cast<uint32_t>(KERNEL_VMA) - 16, 16));
+  ASSERT_TRUE(user_range_ok(static_cast<uint32_t>(KERNEL_VMA), 0));
+  ASSERT_FALSE(user_range_ok(static_cast<uint32_t>(KERNEL_VMA) - 16, 17));
+  ASSERT_FALSE(user_range_ok(0xFFFFFFF0, 0x20));
+}
+
+TEST(uaccess, kernel_pointer_is_efault) {
+  char buf[8] = {};
+  const auto kernel_addr = reinterpret_cast<uint32_t>(buf);
+  ASSERT_EQ(copy_from_user(buf, kernel_addr, sizeof(buf)), -EFAULT);
+  ASSERT_EQ(copy_to_user(kernel_addr, buf, sizeof(buf)), -EFAULT);
+  ASSERT_EQ(strncpy_from_user(buf, kernel_addr, sizeof(buf)), -EFAULT);
+}
+
+// ===========================================================================
+// Faults
+// ===========================================================================
+
+TEST(uaccess, unmapped_source_faults_to_efault) {
+  char buf[8];
+  ASSERT_EQ(copy_from_user(buf, kUnmappedAddr, sizeof(buf)), -EFAULT);
+  ASSERT_EQ(strncpy_from_user(buf, kUnmappedAddr, sizeof(buf)), -EFAULT);
+}
+
+TEST(uaccess, unmapped_destination_faults_to_efault) {
+  const char buf[8] = "abcdefg";
+  ASSERT_EQ(copy_to_user(kUnmappedAddr, buf, sizeof(buf)), -EFAULT);
+}
+
+TEST(uaccess, copy_stops_at_end_of_mapping) {
+  const UserPage page(/*writeable=*/true);
+  char buf[16];
+  // The last 8 bytes of the page are readable; the next page is not.
+  ASSERT_EQ(copy_from_user(buf, UserPage::kAddr + PAGE_SIZE - 8, 8), 0);
+  ASSERT_EQ(copy_from_user(buf, UserPage::kAddr + PAGE_SIZE - 8, sizeof(buf)), -EFAULT);
+}
+
+TEST(uaccess, read_only_page_rejects_writes) {
+  const UserPage page(/*writeable=*/false);
+  const uint32_t value = 0xDEADBEEF;
+  ASSERT_EQ(copy_to_user(UserPage::kAddr, &value, sizeof(value)), -EFAULT);
+  uint32_t out = 0;
+  ASSERT_EQ(copy_from_user(&out, UserPage::kAddr, sizeof(out)), 0);
+  ASSERT_EQ(out, 0U);
+}
+
+// ===========================================================================
+// Round trips
+// ===========================================================================
+
+TEST(uaccess, copy_round_trip) {
+  const UserPage page(/*writeable=*/true);
+  const char msg[] = "hello";
+  ASSERT_EQ(copy_to_user(UserPage::kAddr + 100, msg, sizeof(msg)), 0);
+  ASSERT_STR_EQ(page.kva() + 100, "hello");
+
+  char back[sizeof(msg)] = {};
+  ASSERT_EQ(copy_from_user(back, UserPage::kAddr + 100, sizeof(back)), 0);
+  ASSERT_STR_EQ(back, "hello");
+}
+
+TEST(uaccess, strncpy_lengths) {
+  const UserPage page(/*writeable=*/true);
+  strcpy(page.kva(), "path/to/file");
+
+  char buf[32];
+  ASSERT_EQ(strncpy_from_user(buf, UserPage::kAddr, sizeof(buf)), 12);
+  ASSERT_STR_EQ(buf, "path/to/file");
+
+  ASSERT_EQ(strncpy_from_user(buf, UserPage::kAddr, 5), -ENAMETOOLONG);
+  ASSERT_STR_EQ(buf, "path");
+}
+
+TEST(uaccess, strncpy_unterminated_at_end_of_mapping) {
+  const UserPage page(/*writeable=*/true);
+  memset(page.kva() + PAGE_SIZE - 4, 'x', 4);
+  char buf[16];
+  ASSERT_EQ(strncpy_from_user(buf, UserPage::kAddr + PAGE_SIZE - 4, sizeof(buf)), -EFAULT);
+}
@@ -0,0 +1,55 @@
+#include <sys/vdso.h>
+
+#include "address_space.h"
+#include "ktest.h"
+#include "pmm.h"
+#include "vdso.h"
+
+// Vdso::init() runs before the ktests, so the time page already exists.
+
+// ===========================================================================
+// Publishing
+// ===========================================================================
+
+TEST(vdso, page_is_initialised) {
+  const vdso_time* page = Vdso::page();
+  ASSERT_NOT_NULL(page);
+  ASSERT_EQ(page->seq & 1U, 0U);
+}
+
+TEST(vdso, update_bumps_seq_by_two) {
+  const vdso_time* page = Vdso::page();
+  ASSERT_NOT_NULL(page);
+  const uint32_t seq = page->seq;
+  const uint64_t ns = page->ns;
+  Vdso::update();
+  ASSERT_EQ(page->seq, seq + 2);
+  ASSERT_TRUE(page->ns >= ns);
+}
+
+// ===========================================================================
+// Mapping
+// ===========================================================================
+
+TEST(vdso, map_is_user_read_only) {
+  auto [pd_phys, pd] = AddressSpace::create();
+  Vdso::map(pd);
+  ASSERT_TRUE(AddressSpace::is_user_mapped(pd, Vdso::kTimePageVA, /*writeable=*/false));
+  ASSERT_FALSE(AddressSpace::is_user_mapped(pd, Vdso::kTimePageVA, /*writeable=*/true));
+  AddressSpace::destroy(pd, pd_phys);
+}
+
+TEST(vdso, copy_and_destroy_share_the_frame) {
+  const size_t before = kPmm.get_free_count();
+  auto [pd_phys, pd] = AddressSpace::create();
+  Vdso::map(pd);
+  auto [copy_phys, copy_pd] = AddressSpace::copy(pd);
+  ASSERT_TRUE(AddressSpace::is_user_mapped(copy_pd, Vdso::kTimePageVA, /*writeable=*/false));
+  AddressSpace::destroy(copy_pd, copy_phys);
+  AddressSpace::destroy(pd, pd_phys);
+  // Only the directories and page tables were allocated and freed; the
+  // shared time page itself must still be owned by the kernel.
+  ASSERT_EQ(kPmm.get_free_count(), before);
+  Vdso::update();
+  ASSERT_EQ(Vdso::page()->seq & 1U, 0U);
+}
@@ -1,5 +1,6 @@
 #include <algorithm.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 
 #include "file.h"
@@ -27,13 +28,83 @@ int32_t counting_write([[maybe_unused]] VfsNode* node, std::span<const uint8_t>
   return static_cast<int32_t>(buf.size());
 }
 
+// Byte i of the node reads as i, up to node->size.
+int32_t offset_read(VfsNode* node, std::span<uint8_t> buf, uint32_t offset) {
+  if (offset >= node->size) {
+    return 0;
+  }
+  const size_t available = node->size - offset;
+  const size_t n = std::min(buf.size(), available);
+  for (size_t i = 0; i < n; ++i) {
+    buf[i] = static_cast<uint8_t>(offset + i);
+  }
+  return static_cast<int32_t>(n);
+}
+
+const VfsOps offset_ops = {
+    .read = offset_read,
+    .write = counting_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
+
 const VfsOps counting_ops = {
-    .read = counting_read, .write = counting_write, .ioctl = nullptr, .truncate = nullptr};
+    .read = counting_read,
+    .write = counting_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 const VfsOps read_only_ops = {
-    .read = counting_read, .write = nullptr, .ioctl = nullptr, .truncate = nullptr};
+    .read = counting_read,
+    .write = nullptr,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 const VfsOps write_only_ops = {
-    .read = nullptr, .write = counting_write, .ioctl = nullptr, .truncate = nullptr};
+    .read = nullptr,
+    .write = counting_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
+
+// A backend that is always busy: every read asks the caller to park.
+int32_t busy_read([[maybe_unused]] VfsNode* node, [[maybe_unused]] std::span<uint8_t> buf,
+                  [[maybe_unused]] uint32_t offset) {
+  return kSyscallRestart;
+}
+
+const VfsOps busy_ops = {
+    .read = busy_read,
+    .write = counting_write,
+    .ioctl = nullptr,
+    .truncate = nullptr,
+    .readv = nullptr,
+    .writev = nullptr,
+    .poll = nullptr,
+    .read_page = nullptr,
+    .write_page = nullptr,
+};
 
 }  // namespace
 
@@ -157,7 +228,8 @@ TEST(vfs, read_chardev) {
 
   VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   uint8_t buf[8] = {};
   const int32_t n = Vfs::read(&desc, std::span<uint8_t>(buf, sizeof(buf)));
@@ -176,7 +248,8 @@ TEST(vfs, write_chardev) {
 
   VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   const uint8_t data[] = "test";
   const int32_t n = Vfs::write(&desc, std::span<const uint8_t>(data, 4));
@@ -192,7 +265,8 @@ TEST(vfs, read_null_ops) {
 
   VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   uint8_t buf[4] = {};
   const int32_t n = Vfs::read(&desc, std::span<uint8_t>(buf, sizeof(buf)));
@@ -206,7 +280,8 @@ TEST(vfs, write_null_ops) {
 
   VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   const uint8_t data[] = "x";
   const int32_t n = Vfs::write(&desc, std::span<const uint8_t>(data, 1));
@@ -238,7 +313,8 @@ TEST(vfs, ramfs_read_advances_offset) {
   // Build VfsFileDescription manually with the node.
   VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   // File nodes without ops should fail (we set ops to nullptr above).
   uint8_t buf[4] = {};
@@ -246,6 +322,118 @@ TEST(vfs, ramfs_read_advances_offset) {
   ASSERT_EQ(n, -1);
 }
 
+// ===========================================================================
+// Scatter/gather and positional I/O
+// ===========================================================================
+
+TEST(vfs, readv_fills_buffers_in_order) {
+  Vfs::init();
+  VfsNode* node = Vfs::register_node("/dev/seq", VfsNodeType::CharDev, &offset_ops);
+  ASSERT_NOT_NULL(node);
+  node->size = 32;
+  VfsFileDescription vfs_fd = {.node = node, .offset = 2, .open_flags = 0};
+  FileDescription desc = {
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
+
+  uint8_t a[3] = {};
+  uint8_t b[5] = {};
+  const std::span<uint8_t> iov[] = {a, b};
+  ASSERT_EQ(file_readv(&desc, iov), 8);
+  ASSERT_EQ(a[0], 2);
+  ASSERT_EQ(a[2], 4);
+  ASSERT_EQ(b[0], 5);
+  ASSERT_EQ(b[4], 9);
+  ASSERT_EQ(vfs_fd.offset, 10U);
+}
+
+TEST(vfs, readv_stops_at_short_read) {
+  Vfs::init();
+  VfsNode* node = Vfs::register_node("/dev/seq", VfsNodeType::CharDev, &offset_ops);
+  ASSERT_NOT_NULL(node);
+  node->size = 6;
+  VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
+  FileDescription desc = {
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
+
+  uint8_t a[4] = {};
+  uint8_t b[4] = {};
+  uint8_t c[4] = {};
+  const std::span<uint8_t> iov[] = {a, b, c};
+  ASSERT_EQ(file_readv(&desc, iov), 6);
+  ASSERT_EQ(vfs_fd.offset, 6U);
+  ASSERT_EQ(file_readv(&desc, iov), 0);
+}
+
+TEST(vfs, writev_sums_buffers) {
+  Vfs::init();
+  VfsNode* node = Vfs::register_node("/dev/sink", VfsNodeType::CharDev, &counting_ops);
+  ASSERT_NOT_NULL(node);
+  VfsFileDescription vfs_fd = {.node = node, .offset = 0, .open_flags = 0};
+  FileDescription desc = {
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
+
+  const uint8_t a[] = {1, 2};
+  const uint8_t b[] = {3, 4, 5};
+  const std::span<const uint8_t> iov[] = {a, b};
+  ASSERT_EQ(file_writev(&desc, iov), 5);
+  ASSERT_EQ(vfs_fd.offset, 5U);
+}
+
+TEST(vfs, pread_leaves_offset_alone) {
+  Vfs::init();
+  VfsNode* node = Vfs::register_node("/dev/seq", VfsNodeType::CharDev, &offset_ops);
+  ASSERT_NOT_NULL(node);
+  node->size = 32;
+  VfsFileDescription vfs_fd = {.node = node, .offset = 4, .open_flags = 0};
+  FileDescription desc = {
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
+
+  uint8_t buf[4] = {};
+  ASSERT_EQ(file_pread(&desc, buf, 20), 4);
+  ASSERT_EQ(buf[0], 20);
+  ASSERT_EQ(buf[3], 23);
+  ASSERT_EQ(vfs_fd.offset, 4U);
+
+  const uint8_t data[] = {9, 9};
+  ASSERT_EQ(file_pwrite(&desc, data, 0), 2);
+  ASSERT_EQ(vfs_fd.offset, 4U);
+}
+
+TEST(vfs, pread_on_pipe_is_espipe) {
+  FileDescription desc = {
+      .type = FileType::PipeRead, .ref_count = 1, .pipe = nullptr, .vfs = nullptr,
+      .status_flags = 0};
+  uint8_t buf[1];
+  ASSERT_EQ(file_pread(&desc, buf, 0), -ESPIPE);
+}
+
+TEST(vfs, iov_scatter_and_gather_cross_buffers) {
+  uint8_t a[2] = {};
+  uint8_t b[3] = {};
+  const std::span<uint8_t> iov[] = {a, b};
+  ASSERT_EQ(iov_length(IoVec(iov)), 5U);
+
+  const uint8_t src[] = {7, 8, 9};
+  iov_scatter(iov, 1, src, 3);
+  ASSERT_EQ(a[0], 0);
+  ASSERT_EQ(a[1], 7);
+  ASSERT_EQ(b[0], 8);
+  ASSERT_EQ(b[1], 9);
+  ASSERT_EQ(b[2], 0);
+
+  const std::span<const uint8_t> out[] = {a, b};
+  uint8_t dst[4] = {};
+  iov_gather(out, 1, dst, 4);
+  ASSERT_EQ(dst[0], 7);
+  ASSERT_EQ(dst[1], 8);
+  ASSERT_EQ(dst[2], 9);
+  ASSERT_EQ(dst[3], 0);
+}
+
 // ===========================================================================
 // Vfs::open
 // ===========================================================================
@@ -262,8 +450,7 @@ TEST(vfs, open_returns_fd) {
   // Clean up: close the fd.
   Process* proc = Scheduler::current();
   ASSERT_NOT_NULL(proc->fds[static_cast<uint32_t>(fd)]);
-  file_close(proc->fds[static_cast<uint32_t>(fd)]);
-  proc->fds[static_cast<uint32_t>(fd)] = nullptr;
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd)));
 }
 
 TEST(vfs, open_not_found) {
@@ -298,8 +485,188 @@ TEST(vfs, open_read_write_through_fd) {
   ASSERT_EQ(n, 2);
 
   // Clean up.
-  file_close(desc);
-  proc->fds[static_cast<uint32_t>(fd_num)] = nullptr;
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+}
+
+// ===========================================================================
+// O_NONBLOCK
+// ===========================================================================
+
+TEST(vfs, nonblock_applies_to_char_devices_only) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/busy/file", VfsNodeType::File, &busy_ops));
+  ASSERT_NOT_NULL(Vfs::register_node("/busy/dev", VfsNodeType::CharDev, &busy_ops));
+  Process* proc = Scheduler::current();
+  uint8_t buf[4];
+
+  // A regular file ignores O_NONBLOCK and still waits for its backend.
+  const int32_t file_fd = Vfs::open("/busy/file", O_RDONLY | O_NONBLOCK);
+  ASSERT_TRUE(file_fd >= 0);
+  FileDescription* file = proc->fds[static_cast<uint32_t>(file_fd)];
+  ASSERT_EQ(file_read(file, std::span<uint8_t>(buf, sizeof(buf))), kSyscallRestart);
+  file_close(proc->fds.remove(static_cast<uint32_t>(file_fd)));
+
+  const int32_t dev_fd = Vfs::open("/busy/dev", O_RDONLY | O_NONBLOCK);
+  ASSERT_TRUE(dev_fd >= 0);
+  FileDescription* dev = proc->fds[static_cast<uint32_t>(dev_fd)];
+  ASSERT_EQ(file_read(dev, std::span<uint8_t>(buf, sizeof(buf))), -EAGAIN);
+  file_close(proc->fds.remove(static_cast<uint32_t>(dev_fd)));
+}
+
+// ===========================================================================
+// Vfs::getdents
+// ===========================================================================
+
+TEST(vfs, getdents_resumes_at_cursor) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/d/a", VfsNodeType::File, &counting_ops));
+  ASSERT_NOT_NULL(Vfs::register_node("/d/b", VfsNodeType::File, &counting_ops));
+  ASSERT_NOT_NULL(Vfs::register_node("/d/c", VfsNodeType::File, &counting_ops));
+
+  const int32_t fd_num = Vfs::open("/d", 0);
+  ASSERT_TRUE(fd_num >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd_num)];
+
+  dirent entries[2];
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 2), false), 2);
+  const char first = entries[0].d_name[0];
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 2), false), 1);
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 2), false), 0);
+
+  // Rewinding the offset starts the listing over.
+  desc->vfs->offset = 0;
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 1), false), 1);
+  ASSERT_EQ(entries[0].d_name[0], first);
+
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+}
+
+TEST(vfs, getdents_sees_entries_created_during_listing) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/d/a", VfsNodeType::File, &counting_ops));
+  ASSERT_NOT_NULL(Vfs::register_node("/d/b", VfsNodeType::File, &counting_ops));
+
+  const int32_t fd_num = Vfs::open("/d", 0);
+  ASSERT_TRUE(fd_num >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd_num)];
+
+  dirent entries[2];
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 1), false), 1);
+  ASSERT_STR_EQ(entries[0].d_name, "a");
+  ASSERT_NOT_NULL(Vfs::register_node("/d/c", VfsNodeType::File, &counting_ops));
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(entries, 2), false), 2);
+  ASSERT_STR_EQ(entries[0].d_name, "b");
+  ASSERT_STR_EQ(entries[1].d_name, "c");
+
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+}
+
+TEST(vfs, getdents_attrs_fill_size_and_mode) {
+  Vfs::init();
+  VfsNode* node = Vfs::register_node("/d/f", VfsNodeType::File, &counting_ops);
+  ASSERT_NOT_NULL(node);
+  node->size = 42;
+
+  const int32_t fd_num = Vfs::open("/d", 0);
+  ASSERT_TRUE(fd_num >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd_num)];
+
+  dirent entry;
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(&entry, 1), false), 1);
+  ASSERT_STR_EQ(entry.d_name, "f");
+  ASSERT_EQ(entry.d_type, DT_REG);
+  ASSERT_EQ(entry.d_mode, 0U);
+
+  desc->vfs->offset = 0;
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(&entry, 1), true), 1);
+  ASSERT_EQ(entry.d_size, 42U);
+  ASSERT_EQ(entry.d_mode, node->mode);
+
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+}
+
+TEST(vfs, getdents_on_file_is_enotdir) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/d/f", VfsNodeType::File, &counting_ops));
+
+  const int32_t fd_num = Vfs::open("/d/f", 0);
+  ASSERT_TRUE(fd_num >= 0);
+  Process* proc = Scheduler::current();
+  FileDescription* desc = proc->fds[static_cast<uint32_t>(fd_num)];
+
+  dirent entry;
+  ASSERT_EQ(Vfs::getdents(desc, std::span<dirent>(&entry, 1), false), -ENOTDIR);
+
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+}
+
+// ===========================================================================
+// Relative lookup and node references
+// ===========================================================================
+
+TEST(vfs, lookup_at_walks_from_base) {
+  Vfs::init();
+  VfsNode* file = Vfs::register_node("/a/b/f", VfsNodeType::File, &counting_ops);
+  ASSERT_NOT_NULL(file);
+  VfsNode* dir = Vfs::lookup("/a/b");
+  ASSERT_NOT_NULL(dir);
+
+  ASSERT_EQ(Vfs::lookup_at(dir, "f"), file);
+  ASSERT_EQ(Vfs::lookup_at(dir, "./f"), file);
+  ASSERT_EQ(Vfs::lookup_at(dir, "../b//f"), file);
+  ASSERT_EQ(Vfs::lookup_at(dir, ".."), Vfs::lookup("/a"));
+  ASSERT_EQ(Vfs::lookup_at(dir, "/a/b"), dir);
+  ASSERT_EQ(Vfs::lookup_at(nullptr, "a/b"), dir);
+  ASSERT_NULL(Vfs::lookup_at(dir, "missing"));
+}
+
+TEST(vfs, open_at_directory_pins_node) {
+  Vfs::init();
+  VfsNode* file = Vfs::register_node("/d/f", VfsNodeType::File, &counting_ops);
+  ASSERT_NOT_NULL(file);
+  VfsNode* dir = Vfs::lookup("/d");
+
+  ASSERT_EQ(Vfs::open_at(dir, "f", O_DIRECTORY), -ENOTDIR);
+
+  const int32_t fd_num = Vfs::open_at(nullptr, "/d", O_DIRECTORY);
+  ASSERT_TRUE(fd_num >= 0);
+  ASSERT_EQ(dir->refs, 1U);
+
+  Process* proc = Scheduler::current();
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
+  ASSERT_EQ(dir->refs, 0U);
+}
+
+TEST(vfs, node_path_builds_absolute_path) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/a/b/f", VfsNodeType::File, &counting_ops));
+
+  char buf[kMaxPathLen];
+  ASSERT_EQ(Vfs::node_path(nullptr, buf, sizeof(buf)), 1);
+  ASSERT_STR_EQ(buf, "/");
+  ASSERT_EQ(Vfs::node_path(Vfs::lookup("/a/b/f"), buf, sizeof(buf)), 6);
+  ASSERT_STR_EQ(buf, "/a/b/f");
+  ASSERT_EQ(Vfs::node_path(Vfs::lookup("/a/b/f"), buf, 6), -ERANGE);
+}
+
+TEST(vfs, referenced_node_outlives_its_tree) {
+  Vfs::init();
+  ASSERT_NOT_NULL(Vfs::register_node("/d/f", VfsNodeType::File, &counting_ops));
+  VfsNode* dir = Vfs::lookup("/d");
+  Vfs::node_get(dir);
+
+  // Rebuilding the tree detaches the referenced node instead of freeing it.
+  Vfs::init();
+  ASSERT_NULL(Vfs::lookup("/d"));
+  ASSERT_NULL(dir->first_child);
+  char buf[kMaxPathLen];
+  ASSERT_EQ(Vfs::node_path(dir, buf, sizeof(buf)), -ENOENT);
+  ASSERT_NULL(Vfs::lookup_at(dir, "f"));
+
+  Vfs::node_put(dir);
 }
 
 // ===========================================================================
@@ -315,7 +682,8 @@ TEST(vfs, devfs_null_read_eof) {
 
   VfsFileDescription vfs_fd = {.node = null_node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   uint8_t buf[4] = {};
   const int32_t n = Vfs::read(&desc, std::span<uint8_t>(buf, sizeof(buf)));
@@ -331,7 +699,8 @@ TEST(vfs, devfs_null_write_discards) {
 
   VfsFileDescription vfs_fd = {.node = null_node, .offset = 0, .open_flags = 0};
   FileDescription desc = {
-      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd};
+      .type = FileType::VfsNode, .ref_count = 1, .pipe = nullptr, .vfs = &vfs_fd,
+      .status_flags = 0};
 
   const uint8_t data[] = "discard me";
   const int32_t n = Vfs::write(&desc, std::span<const uint8_t>(data, 10));
@@ -370,6 +739,5 @@ TEST(vfs, close_vfs_fd) {
   ASSERT_EQ(desc->ref_count, 1U);
 
   // Close via file_close (which dispatches to Vfs::close).
-  file_close(desc);
-  proc->fds[static_cast<uint32_t>(fd_num)] = nullptr;
+  file_close(proc->fds.remove(static_cast<uint32_t>(fd_num)));
 }
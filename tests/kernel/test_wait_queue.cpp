@@ -0,0 +1,91 @@
+#include "ktest.h"
+#include "process.h"
+#include "scheduler.h"
+#include "wait_queue.h"
+
+// ===========================================================================
+// WaitQueue list operations
+// ===========================================================================
+
+TEST(wait_queue, zero_initialised_is_empty) {
+  WaitQueue wq{};
+  ASSERT_TRUE(wq.empty());
+  ASSERT_NULL(wq.pop());
+}
+
+TEST(wait_queue, pop_is_fifo) {
+  WaitQueue wq{};
+  Process a{};
+  Process b{};
+  Process c{};
+  wq.push(&a);
+  wq.push(&b);
+  wq.push(&c);
+  ASSERT_FALSE(wq.empty());
+
+  ASSERT_EQ(wq.pop(), &a);
+  ASSERT_EQ(wq.pop(), &b);
+  ASSERT_EQ(wq.pop(), &c);
+  ASSERT_TRUE(wq.empty());
+  ASSERT_NULL(wq.tail);
+}
+
+TEST(wait_queue, remove_middle_and_tail) {
+  WaitQueue wq{};
+  Process a{};
+  Process b{};
+  Process c{};
+  wq.push(&a);
+  wq.push(&b);
+  wq.push(&c);
+
+  ASSERT_TRUE(wq.remove(&b));
+  ASSERT_TRUE(wq.remove(&c));
+  ASSERT_EQ(wq.tail, &a);
+
+  // Appending after removing the tail must link from the new tail.
+  wq.push(&c);
+  ASSERT_EQ(wq.pop(), &a);
+  ASSERT_EQ(wq.pop(), &c);
+  ASSERT_TRUE(wq.empty());
+}
+
+TEST(wait_queue, remove_absent_returns_false) {
+  WaitQueue wq{};
+  Process a{};
+  Process b{};
+  wq.push(&a);
+  ASSERT_FALSE(wq.remove(&b));
+  ASSERT_EQ(wq.pop(), &a);
+}
+
+// ===========================================================================
+// Scheduler integration
+// ===========================================================================
+
+TEST(wait_queue, wait_on_is_noop_for_idle) {
+  // ktests run as the idle process, which must never be parked.
+  WaitQueue wq{};
+  Scheduler::wait_on(wq);
+  ASSERT_NULL(Scheduler::current()->wait_queue);
+  ASSERT_TRUE(wq.empty());
+}
+
+TEST(wait_queue, wake_all_drains_queue) {
+  // Processes that are not Blocked are unlinked but not made runnable.
+  WaitQueue wq{};
+  Process a{};
+  Process b{};
+  a.state = ProcessState::Zombie;
+  b.state = ProcessState::Zombie;
+  a.wait_queue = &wq;
+  b.wait_queue = &wq;
+  wq.push(&a);
+  wq.push(&b);
+
+  Scheduler::wake_all(wq);
+  ASSERT_TRUE(wq.empty());
+  ASSERT_NULL(a.wait_queue);
+  ASSERT_NULL(b.wait_queue);
+  ASSERT(a.state == ProcessState::Zombie);
+}
@@ -7,17 +7,24 @@
 // ====================================================================
 // Mock getdents
 // ====================================================================
+//
+// opendir() opens its path with the host's open(), so the tests use "/",
+// which always exists; the mock ignores which fd it is given.
 
 namespace {
 
 // Configurable mock state.
-struct dirent g_mock_entries[DIR_BUF_SIZE];
-int g_mock_count = 0;      // entries to return (-1 for error)
-bool g_mock_fail = false;  // if true, getdents returns -1
+struct dirent g_mock_entries[DIR_BUF_SIZE * 2];
+int g_mock_count = 0;       // entries in the mock directory
+int g_mock_pos = 0;         // entries already returned (the fd's cursor)
+bool g_mock_fail = false;   // if true, getdents returns -1
+unsigned g_mock_flags = 0;  // flags of the last getdents call
 
 void mock_reset() {
   g_mock_count = 0;
+  g_mock_pos = 0;
   g_mock_fail = false;
+  g_mock_flags = 0;
   memset(g_mock_entries, 0, sizeof(g_mock_entries));
 }
 
@@ -32,13 +39,15 @@ void mock_add_entry(const char* name, uint8_t type, uint32_t size) {
 
 }  // namespace
 
-extern "C" int getdents(const char* /*path*/, struct dirent* buf, unsigned int count) {
+extern "C" int getdents(int /*fd*/, struct dirent* buf, unsigned int count, unsigned int flags) {
   if (g_mock_fail) {
     return -1;
   }
-  int n = g_mock_count;
+  g_mock_flags = flags;
+  int n = g_mock_count - g_mock_pos;
   n = std::min(n, static_cast<int>(count));
-  memcpy(buf, g_mock_entries, static_cast<size_t>(n) * sizeof(struct dirent));
+  memcpy(buf, &g_mock_entries[g_mock_pos], static_cast<size_t>(n) * sizeof(struct dirent));
+  g_mock_pos += n;
   return n;
 }
 
@@ -52,16 +61,22 @@ TEST(dirent, opendir_null_path_returns_null) {
   ASSERT_NULL(d);
 }
 
+TEST(dirent, opendir_open_failure_returns_null) {
+  mock_reset();
+  const DIR* d = opendir("/nonexistent");
+  ASSERT_NULL(d);
+}
+
 TEST(dirent, opendir_getdents_failure_returns_null) {
   mock_reset();
   g_mock_fail = true;
-  const DIR* d = opendir("/nonexistent");
+  const DIR* d = opendir("/");
   ASSERT_NULL(d);
 }
 
 TEST(dirent, opendir_empty_directory) {
   mock_reset();
-  DIR* d = opendir("/empty");
+  DIR* d = opendir("/");
   ASSERT_NOT_NULL(d);
   ASSERT_NULL(readdir(d));
   ASSERT_EQ(closedir(d), 0);
@@ -70,7 +85,7 @@ TEST(dirent, opendir_empty_directory) {
 TEST(dirent, opendir_succeeds) {
   mock_reset();
   mock_add_entry("file.txt", DT_REG, 100);
-  DIR* d = opendir("/test");
+  DIR* d = opendir("/");
   ASSERT_NOT_NULL(d);
   closedir(d);
 }
@@ -85,7 +100,7 @@ TEST(dirent, readdir_single_entry) {
   mock_reset();
   mock_add_entry("hello.txt", DT_REG, 42);
 
-  DIR* d = opendir("/test");
+  DIR* d = opendir("/");
   ASSERT_NOT_NULL(d);
 
   struct dirent* e = readdir(d);
@@ -149,6 +164,33 @@ TEST(dirent, readdir_exhausted_returns_null_repeatedly) {
   closedir(d);
 }
 
+TEST(dirent, readdir_refills_past_one_batch) {
+  mock_reset();
+  const int total = DIR_BUF_SIZE + 3;
+  for (int i = 0; i < total; ++i) {
+    mock_add_entry("f", DT_REG, static_cast<uint32_t>(i));
+  }
+
+  DIR* d = opendir("/");
+  ASSERT_NOT_NULL(d);
+  int seen = 0;
+  const struct dirent* e;
+  while ((e = readdir(d)) != nullptr) {
+    ASSERT_EQ(e->d_size, static_cast<uint32_t>(seen));
+    ++seen;
+  }
+  ASSERT_EQ(seen, total);
+  closedir(d);
+}
+
+TEST(dirent, readdir_requests_attributes) {
+  mock_reset();
+  DIR* d = opendir("/");
+  ASSERT_NOT_NULL(d);
+  ASSERT_EQ(g_mock_flags, static_cast<unsigned>(GETDENTS_ATTRS));
+  closedir(d);
+}
+
 // ====================================================================
 // closedir()
 // ====================================================================
@@ -157,7 +199,7 @@ TEST(dirent, closedir_null_returns_error) { ASSERT_EQ(closedir(nullptr), -1); }
 
 TEST(dirent, closedir_returns_zero) {
   mock_reset();
-  DIR* d = opendir("/test");
+  DIR* d = opendir("/");
   ASSERT_NOT_NULL(d);
   ASSERT_EQ(closedir(d), 0);
 }
@@ -83,7 +83,7 @@ static unsigned char translate_key(uint8_t k) {
   }
 }
 
-void DG_Init(void) { s_kbd_fd = open("/dev/kbd", O_RDONLY); }
+void DG_Init(void) { s_kbd_fd = open("/dev/kbd", O_RDONLY | O_NONBLOCK); }
 
 void DG_DrawFrame(void) { fb_flip(DG_ScreenBuffer, DOOMGENERIC_RESX, DOOMGENERIC_RESY); }
 
@@ -106,10 +106,11 @@ int main(void) {
 
   for (;;) {
     struct kbd_event ev;
+    /* Blocks until the next key event. */
     ssize_t n = read(fd, &ev, sizeof(ev));
-    if (n <= 0) {
-      msleep(10);
-      continue;
+    if (n != (ssize_t)sizeof(ev)) {
+      printf("kbd_test: read from /dev/kbd failed\n");
+      break;
     }
     printf("[%s] key=%d (%s)\n", ev.pressed ? "press  " : "release", ev.key, key_name(ev.key));
     fflush(stdout);
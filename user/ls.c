@@ -1,12 +1,38 @@
 #include <dirent.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+/* Print "drwxr-xr-x" style type and permission bits. */
+static void print_mode(uint32_t mode) {
+  static const char kRwx[] = "rwxrwxrwx";
+  char buf[11];
+  buf[0] = S_ISDIR(mode) ? 'd' : (S_ISCHR(mode) ? 'c' : '-');
+  for (int i = 0; i < 9; ++i) {
+    buf[1 + i] = (mode & (0400U >> i)) != 0 ? kRwx[i] : '-';
+  }
+  buf[10] = '\0';
+  printf("%s", buf);
+}
+
 int main(int argc, char* argv[]) {
   const char* path = "/";
+  int long_format = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "l")) != -1) {
+    switch (opt) {
+      case 'l':
+        long_format = 1;
+        break;
+      default:
+        printf("usage: ls [-l] [dir]\n");
+        return 1;
+    }
+  }
 
-  if (argc >= 2) {
-    path = argv[1];
+  if (optind < argc) {
+    path = argv[optind];
   } else {
     /* Default to CWD when available. */
     static char cwd_buf[128];
@@ -21,9 +47,13 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  /* readdir() entries carry size and mode, so -l needs no stat() calls. */
   const struct dirent* e;
   while ((e = readdir(d)) != NULL) {
-    if (e->d_type == DT_DIR) {
+    if (long_format) {
+      print_mode(e->d_mode);
+      printf(" %8u %s%s\n", e->d_size, e->d_name, e->d_type == DT_DIR ? "/" : "");
+    } else if (e->d_type == DT_DIR) {
       printf("%s/\n", e->d_name);
     } else if (e->d_type == DT_CHR) {
       printf("%s  [dev]\n", e->d_name);
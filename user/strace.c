@@ -0,0 +1,219 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/trace.h>
+#include <unistd.h>
+
+/*
+ * strace: run a command and print the syscalls it makes.
+ *
+ * Usage: strace [-c] command [args...]
+ *
+ * Prints one line per syscall with its raw arguments and return value, as
+ * the kernel tracer records them. With -c, prints a per-syscall summary of
+ * call counts, errors and latencies (in TSC cycles) instead.
+ *
+ * Only the command's own thread group is traced, not processes it forks.
+ * Calls that block show up once per attempt, with "= restart" for the
+ * attempts that went to sleep.
+ */
+
+#define PATH_MAX 128
+#define BATCH 32
+#define POLL_MS 10
+
+static const char* const names[SYS_MAX] = {
+    [SYS_EXIT] = "exit",
+    [SYS_FORK] = "fork",
+    [SYS_READ] = "read",
+    [SYS_WRITE] = "write",
+    [SYS_OPEN] = "open",
+    [SYS_CLOSE] = "close",
+    [SYS_WAITPID] = "waitpid",
+    [SYS_EXEC] = "exec",
+    [SYS_LSEEK] = "lseek",
+    [SYS_GETPID] = "getpid",
+    [SYS_PIPE] = "pipe",
+    [SYS_SBRK] = "sbrk",
+    [SYS_DUP2] = "dup2",
+    [SYS_CLOCK_GETTIME] = "clock_gettime",
+    [SYS_SLEEP] = "sleep",
+    [SYS_SHMGET] = "shmget",
+    [SYS_SHMAT] = "shmat",
+    [SYS_SHMDT] = "shmdt",
+    [SYS_FB_FLIP] = "fb_flip",
+    [SYS_KILL] = "kill",
+    [SYS_SIGACTION] = "sigaction",
+    [SYS_SIGRETURN] = "sigreturn",
+    [SYS_CHDIR] = "chdir",
+    [SYS_GETCWD] = "getcwd",
+    [SYS_GETDENTS] = "getdents",
+    [SYS_IOCTL] = "ioctl",
+    [SYS_STAT] = "stat",
+    [SYS_FSTAT] = "fstat",
+    [SYS_MKDIR] = "mkdir",
+    [SYS_UNLINK] = "unlink",
+    [SYS_RENAME] = "rename",
+    [SYS_FCNTL] = "fcntl",
+    [SYS_MOUNT] = "mount",
+    [SYS_UMOUNT] = "umount",
+    [SYS_NANOSLEEP] = "nanosleep",
+    [SYS_SCHEDSTAT] = "schedstat",
+    [SYS_FUTEX] = "futex",
+    [SYS_CLONE] = "clone",
+    [SYS_EXIT_THREAD] = "exit_thread",
+    [SYS_RING_SETUP] = "ring_setup",
+    [SYS_RING_ENTER] = "ring_enter",
+    [SYS_READV] = "readv",
+    [SYS_WRITEV] = "writev",
+    [SYS_PREAD] = "pread",
+    [SYS_PWRITE] = "pwrite",
+    [SYS_POLL] = "poll",
+    [SYS_TRACE] = "trace",
+    [SYS_OPENAT] = "openat",
+    [SYS_MKDIRAT] = "mkdirat",
+    [SYS_FSTATAT] = "fstatat",
+    [SYS_UNLINKAT] = "unlinkat",
+    [SYS_GETRLIMIT] = "getrlimit",
+    [SYS_SETRLIMIT] = "setrlimit",
+    [SYS_FSYNC] = "fsync",
+};
+
+static struct trace_event events[BATCH];
+static struct trace_hist hists[SYS_MAX];
+
+static const char* name_of(uint32_t nr) {
+  return nr < SYS_MAX && names[nr] != NULL ? names[nr] : "unknown";
+}
+
+static void print_event(const struct trace_event* e) {
+  if (e->nr == TRACE_EXIT_NR) {
+    printf("[%u] +++ exited with %d +++\n", e->pid, e->ret);
+    return;
+  }
+  printf("[%u] %s(0x%x, 0x%x, 0x%x)", e->pid, name_of(e->nr), e->args[0], e->args[1],
+         e->args[2]);
+  if (e->nr == SYS_EXIT || e->nr == SYS_EXIT_THREAD) {
+    printf(" = ?\n");
+  } else if (e->ret == TRACE_RET_RESTART) {
+    printf(" = restart\n");
+  } else {
+    printf(" = %d\n", e->ret);
+  }
+}
+
+/* Histogram bucket holding the median call: half took under 2^(i+1) cycles. */
+static unsigned median_log2(const struct trace_hist* h) {
+  uint32_t seen = 0;
+  for (unsigned i = 0; i < TRACE_BUCKETS; ++i) {
+    seen += h->buckets[i];
+    if (seen * 2 >= h->count) {
+      return i;
+    }
+  }
+  return TRACE_BUCKETS - 1;
+}
+
+static void print_summary(void) {
+  const int dropped = trace_stats(hists, SYS_MAX);
+  if (dropped < 0) {
+    printf("strace: trace_stats failed\n");
+    return;
+  }
+  printf("%-14s %8s %7s %12s %12s %8s\n", "syscall", "calls", "errors", "avg cycles",
+         "max cycles", "median");
+  for (unsigned nr = 0; nr < SYS_MAX; ++nr) {
+    const struct trace_hist* h = &hists[nr];
+    if (h->count == 0) {
+      continue;
+    }
+    printf("%-14s %8u %7u %12u %12u %5s%u\n", name_of(nr), h->count, h->errors,
+           (unsigned)(h->total_cycles / h->count), (unsigned)h->max_cycles, "2^",
+           median_log2(h));
+  }
+  if (dropped > 0) {
+    printf("strace: %d events dropped\n", dropped);
+  }
+}
+
+/* Drain the trace until the child's exit event, printing each event unless
+ * summarising. */
+static void follow(int pid, int summary) {
+  for (;;) {
+    const int n = trace_read(events, BATCH);
+    if (n < 0) {
+      printf("strace: trace_read failed\n");
+      return;
+    }
+    for (int i = 0; i < n; ++i) {
+      if (!summary) {
+        print_event(&events[i]);
+      }
+      if (events[i].nr == TRACE_EXIT_NR && events[i].pid == (uint32_t)pid) {
+        return;
+      }
+    }
+    if (n == 0) {
+      msleep(POLL_MS);
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int summary = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "c")) != -1) {
+    switch (opt) {
+      case 'c':
+        summary = 1;
+        break;
+      default:
+        printf("usage: strace [-c] command [args...]\n");
+        return 1;
+    }
+  }
+  if (optind >= argc) {
+    printf("usage: strace [-c] command [args...]\n");
+    return 1;
+  }
+
+  char path[PATH_MAX];
+  const char* name = argv[optind];
+  if (strchr(name, '/') != NULL) {
+    strncpy(path, name, PATH_MAX - 1);
+  } else {
+    /* Bare command names live in /bin, as in sh. */
+    strncpy(path, "/bin/", 6);
+    strncpy(path + 5, name, PATH_MAX - 6);
+  }
+  path[PATH_MAX - 1] = '\0';
+
+  const int pid = fork();
+  if (pid < 0) {
+    printf("strace: fork failed\n");
+    return 1;
+  }
+  if (pid == 0) {
+    /* Start the trace from the child so nothing before exec is missed. */
+    if (trace_on((uint32_t)getpid()) < 0) {
+      printf("strace: trace_on failed\n");
+      _exit(1);
+    }
+    exec(path, &argv[optind], environ);
+    printf("strace: not found: %s\n", name);
+    _exit(1);
+  }
+
+  follow(pid, summary);
+  trace_off();
+
+  int code = 0;
+  waitpid(pid, &code);
+  if (summary) {
+    print_summary();
+  }
+  return code;
+}
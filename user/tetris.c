@@ -538,7 +538,7 @@ static int run_game(void) {
 // ======================================================================
 
 int main(void) {
-  kbd_fd = open("/dev/kbd", 0);
+  kbd_fd = open("/dev/kbd", O_RDONLY | O_NONBLOCK);
   if (kbd_fd < 0) {
     printf("tetris: failed to open /dev/kbd\n");
     return 1;
@@ -0,0 +1,139 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/schedstat.h>
+#include <termctl.h>
+#include <unistd.h>
+
+/*
+ * top: periodically display scheduler statistics.
+ *
+ * Usage: top [-d seconds] [-n iterations]
+ *
+ * Shows the load averages, per-CPU idle time and, for every process, its
+ * share of CPU time over the last interval, accumulated user/system/wait
+ * times and context switch counts. Runs until interrupted unless -n is
+ * given.
+ */
+
+#define MAX_PROCS 64
+#define NS_PER_MS 1000000ULL
+
+static struct sched_stat stat;
+static struct proc_stat procs[MAX_PROCS];
+
+/* Previous sample, for per-interval CPU usage. */
+static uint64_t prev_uptime_ns;
+static uint64_t prev_idle_ns[SCHEDSTAT_MAX_CPUS];
+static uint32_t prev_pids[MAX_PROCS];
+static uint64_t prev_busy_ns[MAX_PROCS];
+static int prev_count;
+
+static uint64_t busy_ns(const struct proc_stat* p) { return p->user_ns + p->system_ns; }
+
+static uint64_t prev_busy_for(uint32_t pid) {
+  for (int i = 0; i < prev_count; ++i) {
+    if (prev_pids[i] == pid) {
+      return prev_busy_ns[i];
+    }
+  }
+  return 0;
+}
+
+/* Per-mille share of `part` in `whole`, clamped to 100.0%. */
+static unsigned permille(uint64_t part, uint64_t whole) {
+  if (whole == 0) {
+    return 0;
+  }
+  const uint64_t pm = (part * 1000) / whole;
+  return pm > 1000 ? 1000 : (unsigned)pm;
+}
+
+/* Print a fixed-point load average with two decimals. */
+static void print_load(uint32_t load) {
+  const unsigned whole = load >> LOAD_FSHIFT;
+  const unsigned frac = ((load & (LOAD_FIXED_1 - 1)) * 100) >> LOAD_FSHIFT;
+  printf("%u.%02u", whole, frac);
+}
+
+static void print_ms(uint64_t ns) { printf(" %9u", (unsigned)(ns / NS_PER_MS)); }
+
+static void show(int count) {
+  const uint64_t interval = stat.uptime_ns - prev_uptime_ns;
+  const unsigned up_sec = (unsigned)(stat.uptime_ns / 1000000000ULL);
+
+  printf("top - up %u:%02u:%02u, load average: ", up_sec / 3600, (up_sec / 60) % 60, up_sec % 60);
+  print_load(stat.loadavg[0]);
+  printf(", ");
+  print_load(stat.loadavg[1]);
+  printf(", ");
+  print_load(stat.loadavg[2]);
+  printf("\nTasks: %u total, %u running\n", stat.nr_procs, stat.nr_running);
+
+  for (uint32_t cpu = 0; cpu < stat.cpu_count && cpu < SCHEDSTAT_MAX_CPUS; ++cpu) {
+    const unsigned idle = permille(stat.idle_ns[cpu] - prev_idle_ns[cpu], interval);
+    printf("cpu%u: %3u.%u%% busy  ", cpu, (1000 - idle) / 10, (1000 - idle) % 10);
+  }
+  printf("\n\n");
+
+  printf("  PID  PPID NAME             S CPU  %%CPU   USER(ms)    SYS(ms)   WAIT(ms)   VCSW  "
+         "IVCSW\n");
+  for (int i = 0; i < count; ++i) {
+    const struct proc_stat* p = &procs[i];
+    const unsigned cpu = permille(busy_ns(p) - prev_busy_for(p->pid), interval);
+    printf("%5u %5u %-16s %c %3u %3u.%u", p->pid, p->ppid, p->name, p->state, p->cpu, cpu / 10,
+           cpu % 10);
+    print_ms(p->user_ns);
+    print_ms(p->system_ns);
+    print_ms(p->wait_ns);
+    printf(" %6u %6u\n", p->voluntary_switches, p->involuntary_switches);
+  }
+}
+
+static void remember(int count) {
+  prev_uptime_ns = stat.uptime_ns;
+  memcpy(prev_idle_ns, stat.idle_ns, sizeof(prev_idle_ns));
+  for (int i = 0; i < count; ++i) {
+    prev_pids[i] = procs[i].pid;
+    prev_busy_ns[i] = busy_ns(&procs[i]);
+  }
+  prev_count = count;
+}
+
+int main(int argc, char* argv[]) {
+  unsigned delay = 2;
+  int iterations = -1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:n:")) != -1) {
+    switch (opt) {
+      case 'd':
+        delay = (unsigned)atoi(optarg);
+        break;
+      case 'n':
+        iterations = atoi(optarg);
+        break;
+      default:
+        printf("usage: top [-d seconds] [-n iterations]\n");
+        return 1;
+    }
+  }
+  if (delay == 0) {
+    delay = 1;
+  }
+
+  for (int i = 0; iterations < 0 || i < iterations; ++i) {
+    const int count = schedstat(&stat, procs, MAX_PROCS);
+    if (count < 0) {
+      printf("top: schedstat failed\n");
+      return 1;
+    }
+    clear_screen();
+    set_cursor(0, 0);
+    show(count);
+    remember(count);
+    sleep(delay);
+  }
+  return 0;
+}